@@ -8,6 +8,9 @@
 #include <unordered_map>
 #include <string>
 #include <SOIL2\SOIL2.h>
+#include "Texture_Array.h"
+#include "Meshlet.h"
+#include "Vertex_Arena.h"
 #include <sstream>
 
 #define max(x, y) x > y ? x : y
@@ -92,8 +95,8 @@ static vec3 min_vec(const vec3& v1, const vec3& v2)
 
 struct Material
 {
-	GLuint Texture_Kd_Id = 0;
-	GLuint Texture_Mask_Id = 0;
+	Texture_Slot Kd_Slot;
+	Texture_Slot Mask_Slot;
 	bool useTexture = false;
 	bool useMask = 0;
 	vec3 Ka;
@@ -642,12 +645,14 @@ struct Index
 
 	vector<int> index;
 	int mtl;
+	//range of Model::meshlets, index is sorted so each meshlet is contiguous
+	int first_meshlet = 0;
+	int meshlet_count = 0;
 	//bool useTexture;
-	unsigned int vao;
-	unsigned int vbo_vertices;
-	unsigned int vbo_texcoords;
-	unsigned int vbo_normals;
-	unsigned int IBO;
+	//position, normal and texcoord of each vertex side by side, what gets uploaded
+	vector<Vertex> interleaved;
+	//where interleaved and index sit in the Vertex_Arena
+	Arena_Range range;
 
 };
 
@@ -677,6 +682,8 @@ struct Model
 
 	vector<Material> mats;
 
+	vector<Meshlet> meshlets;
+
 	unordered_map<string, int> material_map;
 
 	vec3 light_pos;
@@ -690,6 +697,16 @@ struct Model
 
 	void Clear_Before_Render()
 	{
+		//everything is in the Vertex_Arena now
+		for (int i = 0; i < indices.size(); ++i)
+		{
+			indices[i].vertices.swap(vector<vec3>());
+			indices[i].texcoords.swap(vector<vec2>());
+			indices[i].normals.swap(vector<vec3>());
+			indices[i].interleaved.swap(vector<Vertex>());
+			indices[i].index.swap(vector<int>());
+		}
+
 		//vertices.swap(vector<vec3>());
 		//texcoords.swap(vector<vec2>());
 		//normals.swap(vector<vec3>());
@@ -707,6 +724,7 @@ struct Model
 	{
 		indices.swap(vector<Index>());
 		mats.swap(vector<Material>());
+		meshlets.swap(vector<Meshlet>());
 
 		//vertices.swap(vector<vec3>());
 		//texcoords.swap(vector<vec2>());
@@ -730,25 +748,15 @@ struct Model
 			cout << "Mtl file not exist\n";
 
 		char line[256];
-		int numberOfMaterial = 0;
-		while (f.getline(line, 256))
-		{
-			if (line[0] == 'n' && line[1] == 'e' && line[2] == 'w')
-				numberOfMaterial++;
-		}
-
-		mats.resize(numberOfMaterial);
 
-
-		f.clear();
-		f.seekg(0, ios::beg);
+		//maps are only collected here and decoded together afterwards
+		Material_Texture_Requests textures;
 
 
 		int countMaterial = -1;
 		int countTexture = -1;
 
 
-		unordered_map<string, int> texture_map;
 
 		while (f.getline(line, 256))
 		{
@@ -775,6 +783,7 @@ struct Model
 				}
 
 				material_map[name] = countMaterial;
+				mats.emplace_back();
 				mats[countMaterial].name = name;
 			}
 			else if (t[0] == 'N')
@@ -825,17 +834,7 @@ struct Model
 
 				string path = direction + realname;
 				//cout << path << "\n";
-				if (texture_map.find(realname) == texture_map.end())
-				{
-					GLuint TextureId = LoadTexture(path);
-					texture_map[realname] = TextureId;
-					mats[countMaterial].Texture_Kd_Id = TextureId;
-				}
-				else
-				{
-					GLuint TextureId = texture_map[realname];
-					mats[countMaterial].Texture_Kd_Id = texture_map[realname];
-				}
+				textures.Add(path, countMaterial, false);
 			}
 			else if (strncmp(t, "map_d", 5) == 0)
 			{
@@ -854,19 +853,11 @@ struct Model
 
 				string path = direction + tex_path + realname;
 
-				if (texture_map.find(realname) == texture_map.end())
-				{
-					GLuint TextureId = LoadTexture(path);
-					texture_map[realname] = TextureId;
-					mats[countMaterial].Texture_Mask_Id = TextureId;
-				}
-				else
-				{
-					GLuint TextureId = texture_map[realname];
-					mats[countMaterial].Texture_Mask_Id = texture_map[realname];
-				}
+				textures.Add(path, countMaterial, true);
 			}
 		}
+
+		textures.Resolve(mats);
 		//cout << "End Read mtl section: \n";
 	}
 
@@ -1354,6 +1345,32 @@ struct Model
 
 		//cout<<"vertices :" << v.size() << "\n";
 
+		Vertex_Cache_Stats before, after;
+		for (int i = 0; i < indices.size(); ++i)
+		{
+			Index& mesh = indices[i];
+			if (mesh.index.empty())
+				continue;
+			before.Add(Analyze_Vertex_Cache(&mesh.index[0], mesh.index.size()));
+
+			mesh.first_meshlet = meshlets.size();
+			Build_Meshlets(mesh.vertices, mesh.index, i, meshlets);
+			mesh.meshlet_count = meshlets.size() - mesh.first_meshlet;
+			Optimize_Meshlets(mesh.vertices, mesh.index, meshlets, mesh.first_meshlet);
+
+			vector<int> remap = Optimize_Vertex_Fetch(&mesh.index[0], mesh.index.size(), mesh.vertices.size());
+			Remap_Vertices(mesh.vertices, remap);
+			Remap_Vertices(mesh.texcoords, remap);
+			Remap_Vertices(mesh.normals, remap);
+
+			after.Add(Analyze_Vertex_Cache(&mesh.index[0], mesh.index.size()));
+
+			Interleave(mesh.vertices, mesh.normals, mesh.texcoords, mesh.interleaved);
+		}
+		cout << "meshlets: " << meshlets.size() << "\n";
+		cout << "ACMR: " << before.Acmr() << " -> " << after.Acmr() << "\n";
+		cout << "ATVR: " << before.Atvr() << " -> " << after.Atvr() << "\n";
+
 		cout << "faces: " << c << "\n";
 		cout << "v:" << v.size() << "\n";
 		cout << "indices: " << indices.size() << "\n";
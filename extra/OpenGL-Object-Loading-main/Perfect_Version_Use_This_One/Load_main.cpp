@@ -45,15 +45,64 @@ GLuint mvpLoc;
 GLuint nLoc;
 
 //material base
-GLuint useTextureLoc;
-//GLuint useBumpMappingLoc;
-GLuint useMaskLoc;
-GLuint DiffuseLoc;
-GLuint KsLoc;
+GLuint materialLoc;
+GLuint materialSSBO;
+
+//std430 layout of struct Material in fs.glsl
+struct Material_Data
+{
+	vec4 Kd;
+	int kd_array;
+	int kd_layer;
+	int mask_array;
+	int mask_layer;
+	float Ns;
+	float pad[3];
+};
 
 //Num Mesh
 int num_mesh;
 
+//vertices and indices of every material, see Vertex_Arena.h
+Vertex_Arena arena;
+
+//Meshlet culling, see cull.glsl
+#define PYRAMID_UNIT MAX_TEXTURE_ARRAYS
+//frames a triangle count may be in flight before the CPU reads it
+#define STATS_FRAMES 3
+
+struct Draw_Command
+{
+	GLuint count;
+	GLuint instanceCount;
+	GLuint firstIndex;
+	GLint baseVertex;
+	GLuint baseInstance;
+};
+
+GLuint cullProgram;
+GLuint reduceProgram;
+GLuint meshletSSBO;
+GLuint commandBuffer;
+GLuint occludedSSBO;
+GLuint statsSSBO[STATS_FRAMES];
+GLsync statsFence[STATS_FRAMES] = {};
+int stats_frame = 0;
+
+GLuint sceneFBO;
+GLuint colorRBO;
+GLuint depthTexture;
+GLuint pyramidTexture;
+int pyramid_levels;
+bool has_pyramid = false;
+
+bool cone_culling = true;
+bool occlusion_culling = true;
+
+int num_meshlet = 0;
+unsigned int total_triangles = 0;
+unsigned int visible_triangles = 0;
+
 //Light Loc
 
 GLuint globalAmbLoc;
@@ -98,88 +147,250 @@ void init_data(Model& model)
 	mvpLoc = glGetUniformLocation(program, "mvp_matrix");
 	nLoc = glGetUniformLocation(program, "normal_matrix");
 	
-	useTextureLoc = glGetUniformLocation(program, "useTexture");
-	useMaskLoc = glGetUniformLocation(program, "useMask");
-	//useBumpMappingLoc = glGetUniformLocation(program, "useBumpMapping");
-	
+	materialLoc = glGetUniformLocation(program, "materialIndex");
+
+	//every material in one SSBO, a draw only needs its index
+	vector<Material_Data> material_data(model.mats.size());
+	for (int i = 0; i < model.mats.size(); ++i)
+	{
+		material_data[i].Kd = vec4(model.mats[i].Kd, 1.0f);
+		material_data[i].kd_array = model.mats[i].useTexture ? model.mats[i].Kd_Slot.array : -1;
+		material_data[i].kd_layer = model.mats[i].Kd_Slot.layer;
+		material_data[i].mask_array = model.mats[i].useMask ? model.mats[i].Mask_Slot.array : -1;
+		material_data[i].mask_layer = model.mats[i].Mask_Slot.layer;
+		material_data[i].Ns = model.mats[i].Ns;
+	}
 
-	DiffuseLoc = glGetUniformLocation(program, "Kd");
-	KsLoc = glGetUniformLocation(program, "Ks");
+	glGenBuffers(1, &materialSSBO);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, materialSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, material_data.size() * sizeof(Material_Data), &material_data[0], GL_STATIC_DRAW);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, materialSSBO);
 
+	//every material is a range of one vertex and one index buffer, meshlets
+	//carry the offsets so the indirect commands can be drawn with one VAO
 	for (int i = 0; i < model.indices.size(); ++i)
 	{
-		glGenVertexArrays(1, &model.indices[i].vao);
-		glBindVertexArray(model.indices[i].vao);
+		Index& mesh = model.indices[i];
+		mesh.range = arena.Add(mesh.interleaved, mesh.index);
 
-		if (model.mats[i].useTexture)
+		for (int j = mesh.first_meshlet; j < mesh.first_meshlet + mesh.meshlet_count; ++j)
 		{
-			glGenBuffers(1, &model.indices[i].vbo_vertices);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_vertices);
-			glBufferData(GL_ARRAY_BUFFER, model.indices[i].vertices.size() * sizeof(vec3), &model.indices[i].vertices[0], GL_STATIC_DRAW);
+			model.meshlets[j].first_index += mesh.range.first_index;
+			model.meshlets[j].base_vertex = mesh.range.base_vertex;
+		}
+	}
+	arena.Upload();
 
-			glGenBuffers(1, &model.indices[i].vbo_texcoords);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_texcoords);
-			glBufferData(GL_ARRAY_BUFFER, model.indices[i].texcoords.size() * sizeof(vec2), &model.indices[i].texcoords[0], GL_STATIC_DRAW);
+	//diffuseLoc = glGetUniformLocation(program, "DiffuseTexture");
+	
+	
 
-			glGenBuffers(1, &model.indices[i].vbo_normals);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_normals);
-			glBufferData(GL_ARRAY_BUFFER, model.indices[i].normals.size() * sizeof(vec3), &model.indices[i].normals[0], GL_STATIC_DRAW);
+	num_mesh = model.indices.size();
+}
 
-			glEnableVertexAttribArray(0);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_vertices);
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+void init_culling(Model& model)
+{
+	Utility utils;
+	cullProgram = utils.CreateComputeProgram("cull.glsl");
+	reduceProgram = utils.CreateComputeProgram("depth_reduce.glsl");
+
+	num_meshlet = model.meshlets.size();
+	total_triangles = 0;
+	for (int i = 0; i < model.meshlets.size(); ++i)
+		total_triangles += model.meshlets[i].index_count / 3;
+
+	glGenBuffers(1, &meshletSSBO);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, meshletSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, model.meshlets.size() * sizeof(Meshlet), &model.meshlets[0], GL_STATIC_DRAW);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, meshletSSBO);
+
+	//one command per meshlet, the cull pass sets instanceCount to 0 or 1
+	glGenBuffers(1, &commandBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, model.meshlets.size() * sizeof(Draw_Command), NULL, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commandBuffer);
+
+	//meshlets the first pass hid behind last frame's depth, the late pass retests them
+	vector<GLuint> occluded(model.meshlets.size(), 0);
+	glGenBuffers(1, &occludedSSBO);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, occludedSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, occluded.size() * sizeof(GLuint), &occluded[0], GL_DYNAMIC_COPY);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, occludedSSBO);
+
+	//one counter per frame in flight, see Begin_Stats
+	GLuint zero = 0;
+	glGenBuffers(STATS_FRAMES, statsSSBO);
+	for (int i = 0; i < STATS_FRAMES; ++i)
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, statsSSBO[i]);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), &zero, GL_DYNAMIC_READ);
+	}
+	stats_frame = 0;
+
+	//the scene is drawn into a depth texture so next frame can cull against it
+	glGenRenderbuffers(1, &colorRBO);
+	glBindRenderbuffer(GL_RENDERBUFFER, colorRBO);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenTextures(1, &depthTexture);
+	glBindTexture(GL_TEXTURE_2D, depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	glGenFramebuffers(1, &sceneFBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRBO);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		cout << "Scene framebuffer incomplete\n";
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	pyramid_levels = 1;
+	for (int size = width > height ? width : height; size > 1; size >>= 1)
+		++pyramid_levels;
+
+	glGenTextures(1, &pyramidTexture);
+	glBindTexture(GL_TEXTURE_2D, pyramidTexture);
+	glTexStorage2D(GL_TEXTURE_2D, pyramid_levels, GL_R32F, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glProgramUniform1ui(cullProgram, glGetUniformLocation(cullProgram, "meshletCount"), num_meshlet);
+	glProgramUniform1i(cullProgram, glGetUniformLocation(cullProgram, "depthPyramid"), PYRAMID_UNIT);
+	glProgramUniform2f(cullProgram, glGetUniformLocation(cullProgram, "pyramidSize"), width, height);
+	glProgramUniform1i(reduceProgram, glGetUniformLocation(reduceProgram, "inputDepth"), PYRAMID_UNIT);
+}
 
-			glEnableVertexAttribArray(1);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_normals);
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
+//Max depth mip chain of what has been drawn so far, the late pass of this
+//frame and the first pass of the next one cull against it
+static void Build_Depth_Pyramid()
+{
+	glUseProgram(reduceProgram);
+	glActiveTexture(GL_TEXTURE0 + PYRAMID_UNIT);
 
-			glEnableVertexAttribArray(2);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_texcoords);
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, 0);
+	GLint inputLevelLoc = glGetUniformLocation(reduceProgram, "inputLevel");
+	GLint inputSizeLoc = glGetUniformLocation(reduceProgram, "inputSize");
+	GLint outputSizeLoc = glGetUniformLocation(reduceProgram, "outputSize");
 
-			
-		}
-		else
-		{
-			glGenBuffers(1, &model.indices[i].vbo_vertices);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_vertices);
-			glBufferData(GL_ARRAY_BUFFER, model.indices[i].vertices.size() * sizeof(vec3), &model.indices[i].vertices[0], GL_STATIC_DRAW);
+	int w = width;
+	int h = height;
+	for (int level = 0; level < pyramid_levels; ++level)
+	{
+		int out_w = level == 0 ? w : (w / 2 > 0 ? w / 2 : 1);
+		int out_h = level == 0 ? h : (h / 2 > 0 ? h / 2 : 1);
 
-			//glGenBuffers(1, &model.indices[i].vbo_texcoords);
-			//glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_texcoords);
-			//glBufferData(GL_ARRAY_BUFFER, model.indices[i].texcoords.size() * sizeof(vec2), &model.indices[i].texcoords[0], GL_STATIC_DRAW);
+		glBindTexture(GL_TEXTURE_2D, level == 0 ? depthTexture : pyramidTexture);
+		glBindImageTexture(0, pyramidTexture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		glUniform1i(inputLevelLoc, level - 1);
+		glUniform2i(inputSizeLoc, w, h);
+		glUniform2i(outputSizeLoc, out_w, out_h);
 
-			glGenBuffers(1, &model.indices[i].vbo_normals);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_normals);
-			glBufferData(GL_ARRAY_BUFFER, model.indices[i].normals.size() * sizeof(vec3), &model.indices[i].normals[0], GL_STATIC_DRAW);
+		glDispatchCompute((out_w + 7) / 8, (out_h + 7) / 8, 1);
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
 
-			glEnableVertexAttribArray(0);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_vertices);
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+		w = out_w;
+		h = out_h;
+	}
+	has_pyramid = true;
+}
 
-			//glEnableVertexAttribArray(1);
-			//glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_texcoords);
-			//glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, 0);
+//Pick this frame's counter. The count it held STATS_FRAMES frames ago is
+//read only if its fence has passed, otherwise the title keeps the old one
+//instead of stalling the pipeline
+static void Begin_Stats()
+{
+	int slot = stats_frame % STATS_FRAMES;
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, statsSSBO[slot]);
+	if (statsFence[slot] != NULL)
+	{
+		GLenum state = glClientWaitSync(statsFence[slot], 0, 0);
+		if (state == GL_ALREADY_SIGNALED || state == GL_CONDITION_SATISFIED)
+			glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &visible_triangles);
+		glDeleteSync(statsFence[slot]);
+		statsFence[slot] = NULL;
+	}
 
-			glEnableVertexAttribArray(1);
-			glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_normals);
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
+	GLuint zero = 0;
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &zero);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, statsSSBO[slot]);
+}
 
-		}
+//Both cull passes have counted into the frame's counter
+static void End_Stats()
+{
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+	statsFence[stats_frame % STATS_FRAMES] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	++stats_frame;
+}
 
-		glGenBuffers(1, &model.indices[i].IBO);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.indices[i].IBO);
+//Write one indirect command per meshlet: frustum, normal cone and occlusion test
+//against last frame's pyramid. Meshlets hidden only by occlusion are marked for
+//Cull_Late_Meshlets
+static void Cull_Meshlets(const mat4& mvpMat, const vec3& camera_pos)
+{
+	//Gribb/Hartmann plane extraction, the model matrix is identity
+	vec4 row0(mvpMat[0][0], mvpMat[1][0], mvpMat[2][0], mvpMat[3][0]);
+	vec4 row1(mvpMat[0][1], mvpMat[1][1], mvpMat[2][1], mvpMat[3][1]);
+	vec4 row2(mvpMat[0][2], mvpMat[1][2], mvpMat[2][2], mvpMat[3][2]);
+	vec4 row3(mvpMat[0][3], mvpMat[1][3], mvpMat[2][3], mvpMat[3][3]);
+	vec4 planes[6] = { row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2 };
+	for (int i = 0; i < 6; ++i)
+		planes[i] /= length(vec3(planes[i]));
+
+	glUseProgram(cullProgram);
+	glUniform4fv(glGetUniformLocation(cullProgram, "frustum"), 6, value_ptr(planes[0]));
+	glUniform3fv(glGetUniformLocation(cullProgram, "cameraPos"), 1, value_ptr(camera_pos));
+	glUniformMatrix4fv(glGetUniformLocation(cullProgram, "mvp_matrix"), 1, GL_FALSE, value_ptr(mvpMat));
+	glUniform1i(glGetUniformLocation(cullProgram, "coneCulling"), cone_culling);
+	glUniform1i(glGetUniformLocation(cullProgram, "occlusionCulling"), occlusion_culling && has_pyramid);
+	glUniform1i(glGetUniformLocation(cullProgram, "latePass"), GL_FALSE);
+
+	glActiveTexture(GL_TEXTURE0 + PYRAMID_UNIT);
+	glBindTexture(GL_TEXTURE_2D, pyramidTexture);
+
+	glDispatchCompute((num_meshlet + 63) / 64, 1, 1);
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
 
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, model.indices[i].index.size() * 4, &model.indices[i].index[0], GL_STATIC_DRAW);
+	glUseProgram(program);
+}
 
-		glUniform1i(useMaskLoc, model.mats[i].useMask);
-	}
+//Retest the marked meshlets against the pyramid of this frame's first pass,
+//so geometry that was hidden last frame shows up now instead of a frame late.
+//The other uniforms are still set from Cull_Meshlets
+static void Cull_Late_Meshlets()
+{
+	glUseProgram(cullProgram);
+	glUniform1i(glGetUniformLocation(cullProgram, "latePass"), GL_TRUE);
 
-	//diffuseLoc = glGetUniformLocation(program, "DiffuseTexture");
-	
-	
+	glActiveTexture(GL_TEXTURE0 + PYRAMID_UNIT);
+	glBindTexture(GL_TEXTURE_2D, pyramidTexture);
 
-	num_mesh = model.indices.size();
+	glDispatchCompute((num_meshlet + 63) / 64, 1, 1);
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+	glUseProgram(program);
+}
+
+//One indirect multi-draw per material over its meshlet commands
+static void Draw_Meshlets(Model& model)
+{
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+	arena.Bind();
+	for (int i = 0; i < model.indices.size(); ++i)
+	{
+		//textures stay bound, see Texture_Array_Manager::Bind
+		glUniform1i(materialLoc, i);
+
+		//one command per meshlet of this material, culled ones have no instance
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)(model.indices[i].first_meshlet * sizeof(Draw_Command)), model.indices[i].meshlet_count, 0);
+
+		//int size = model.indices[i].ind.size();
+		//glDrawArrays(GL_TRIANGLES, start, size / 2);
+		//start += size / 2;
+	}
 }
 
 static void Draw_Model(GLFWwindow*& window, Model& model, Camera& cam)
@@ -192,6 +403,9 @@ static void Draw_Model(GLFWwindow*& window, Model& model, Camera& cam)
 	mat4 nMat = transpose(inverse(mvMat));
 	//mat4 nMat = transpose(inverse(cam.vMat));
 
+	Begin_Stats();
+	Cull_Meshlets(mvpMat, cam.p);
+
 	glUniformMatrix4fv(mvLoc, 1, GL_FALSE, value_ptr(mvMat));
 	glUniformMatrix4fv(pLoc, 1, GL_FALSE, value_ptr(pMat));
 	glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, value_ptr(mvpMat));
@@ -357,7 +571,7 @@ static void Draw_Model(GLFWwindow*& window, Model& model, Camera& cam)
 329 Rectangle005 p
 330 che_rem*/
 
-	for(int i = 0; i < model.mats.size(); ++i)
+	//for(int i = 0; i < model.mats.size(); ++i)
 	//for(int i = 262; i < 265; ++i)
 	//for(int i = 241; i <= 245; ++i)
 	//for(int i = 320; i < 344; ++i)
@@ -369,47 +583,16 @@ static void Draw_Model(GLFWwindow*& window, Model& model, Camera& cam)
 
 	//200 - 212 co 1 que ngang mau trang dang ngo
 	//for(int i = 212; i < 214; ++i)
-	{
-		
-		glBindVertexArray(model.indices[i].vao);
-
-		/*glEnableVertexAttribArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_vertices);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-		glEnableVertexAttribArray(1);
-		glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_texcoords);
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, 0);
+	Draw_Meshlets(model);
 
-		glEnableVertexAttribArray(2);
-		glBindBuffer(GL_ARRAY_BUFFER, model.indices[i].vbo_normals);
-		glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, 0);*/
-
-		if (model.mats[i].useTexture)
-		{
-			glUniform1i(useTextureLoc, 1);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, model.mats[i].Texture_Kd_Id);
-		}
-		else
-		{
-			glUniform1i(useTextureLoc, 0);
-			vec3 Kd = model.mats[i].Kd;
-			glUniform4f(DiffuseLoc, Kd.x, Kd.y, Kd.z, 1.0f);
-		}
-	
-		float Ns = model.mats[i].Ns;
-		glUniform1f(KsLoc, Ns);
-
-		
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.indices[i].IBO);
-		glDrawElements(GL_TRIANGLES, model.indices[i].index.size(), GL_UNSIGNED_INT, 0);
-
-		//int size = model.indices[i].ind.size();
-		//glDrawArrays(GL_TRIANGLES, start, size / 2);
-		//start += size / 2;
+	//nothing was marked without a pyramid to test against
+	if (occlusion_culling && has_pyramid)
+	{
+		Build_Depth_Pyramid();
+		Cull_Late_Meshlets();
+		Draw_Meshlets(model);
 	}
+	End_Stats();
 	//glBindVertexArray(0);
 }
 
@@ -731,6 +914,7 @@ void main()
 	Camera cam(width, height);
 
 	init_data(model);
+	init_culling(model);
 
 	vec3 max_vector = model.max_vector;
 	vec3 min_vector = model.min_vector;
@@ -745,6 +929,8 @@ void main()
 
 	init_light(program, light_position);
 
+	Texture_Array_Manager::Shared().Bind(program);
+
 	glClearColor(0.0, 0.0, 0.0, 1.0);
 
 	//cout << model.fs.size() << "\n";
@@ -768,7 +954,8 @@ void main()
 		
 
 		string str = "Pos: " + std::to_string(cam.p.x) + "," + std::to_string(cam.p.y) + "," + std::to_string(cam.p.z)
-			+ " direction: " + to_string(cam.d.x) + " " + to_string(cam.d.y) + " " + to_string(cam.d.z);
+			+ " direction: " + to_string(cam.d.x) + " " + to_string(cam.d.y) + " " + to_string(cam.d.z)
+			+ " triangles: " + to_string(visible_triangles) + "/" + to_string(total_triangles);
 
 		px = cam.p.x;
 		py = cam.p.y;
@@ -779,10 +966,19 @@ void main()
 		dz = cam.d.z;
 
 		glfwSetWindowTitle(window, str.c_str());
+		glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		Draw_Model(window, model, cam);
 
+		//includes what the late pass drew, for next frame's first pass
+		Build_Depth_Pyramid();
+		glUseProgram(program);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFBO);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 	}
@@ -799,28 +995,23 @@ void main()
 
 	model.ClearMemory();
 
-	for (int i = 0; i < model.mats.size(); ++i)
-	{
-		glBindVertexArray(0);
-		glDeleteVertexArrays(1, &model.indices[i].vao);
-
-		glBindBuffer(model.indices[i].vbo_vertices, 0);
-		glDeleteBuffers(1, &model.indices[i].vbo_vertices);
-
-		glBindBuffer(model.indices[i].vbo_texcoords, 0);
-		glDeleteBuffers(1, &model.indices[i].vbo_texcoords);
-
-		glBindBuffer(model.indices[i].vbo_normals, 0);
-		glDeleteBuffers(1, &model.indices[i].vbo_normals);
-	}
-	for (int i = 0; i < model.indices.size(); ++i)
-	{
-		glBindBuffer(model.indices[i].IBO, 0);
-	}
-	for (int i = 0; i < model.mats.size(); ++i)
+	arena.Clear();
+	glDeleteBuffers(1, &materialSSBO);
+	glDeleteBuffers(1, &meshletSSBO);
+	glDeleteBuffers(1, &commandBuffer);
+	glDeleteBuffers(1, &occludedSSBO);
+	glDeleteBuffers(STATS_FRAMES, statsSSBO);
+	for (int i = 0; i < STATS_FRAMES; ++i)
 	{
-		glDeleteTextures(1, &model.mats[i].Texture_Kd_Id);
+		if (statsFence[i] != NULL)
+			glDeleteSync(statsFence[i]);
+		statsFence[i] = NULL;
 	}
+	glDeleteFramebuffers(1, &sceneFBO);
+	glDeleteRenderbuffers(1, &colorRBO);
+	glDeleteTextures(1, &depthTexture);
+	glDeleteTextures(1, &pyramidTexture);
+	Texture_Array_Manager::Shared().Clear();
 	//glBindBuffer(ibo, 0);
 }
 
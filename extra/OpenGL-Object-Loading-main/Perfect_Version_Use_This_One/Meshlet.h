@@ -0,0 +1,180 @@
+#ifndef _MESHLET_H_
+#define _MESHLET_H_
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <glm\glm.hpp>
+#include "Mesh_Optimizer.h"
+
+using namespace std;
+using namespace glm;
+
+//Triangles per cluster, small enough that one material spanning the whole scene
+//is split into pieces the GPU can cull one by one
+#define MESHLET_TRIANGLES 124
+
+//Same layout as struct Meshlet in cull.glsl (std430)
+struct Meshlet
+{
+	vec4 sphere;//xyz center, w radius
+	vec4 cone;//xyz axis, w cutoff, cutoff >= 1 means never backface culled
+	unsigned int first_index;
+	unsigned int index_count;
+	unsigned int mesh;
+	int base_vertex;//of the mesh in the Vertex_Arena, set by init_data
+};
+
+//Spread the lower 10 bits of x so there are two zero bits between each of them
+static unsigned int Part_1_By_2(unsigned int x)
+{
+	x &= 0x000003ff;
+	x = (x ^ (x << 16)) & 0xff0000ff;
+	x = (x ^ (x << 8)) & 0x0300f00f;
+	x = (x ^ (x << 4)) & 0x030c30c3;
+	x = (x ^ (x << 2)) & 0x09249249;
+	return x;
+}
+
+//p in [0, 1]
+static unsigned int Morton_Code(const vec3& p)
+{
+	unsigned int x = (unsigned int)(glm::clamp(p.x, 0.0f, 1.0f) * 1023.0f);
+	unsigned int y = (unsigned int)(glm::clamp(p.y, 0.0f, 1.0f) * 1023.0f);
+	unsigned int z = (unsigned int)(glm::clamp(p.z, 0.0f, 1.0f) * 1023.0f);
+	return (Part_1_By_2(z) << 2) | (Part_1_By_2(y) << 1) | Part_1_By_2(x);
+}
+
+//Reorder the triangles of one material along a Morton curve of their centroids
+//and cut them into meshlets of MESHLET_TRIANGLES. Each meshlet is a contiguous
+//range of index, so it can be drawn with one indirect command.
+static void Build_Meshlets(const vector<vec3>& vertices, vector<int>& index, unsigned int mesh, vector<Meshlet>& meshlets)
+{
+	int num_triangle = index.size() / 3;
+	if (num_triangle == 0)
+		return;
+
+	vec3 bmin(1e20f);
+	vec3 bmax(-1e20f);
+	vector<vec3> centroids(num_triangle);
+	for (int i = 0; i < num_triangle; ++i)
+	{
+		centroids[i] = (vertices[index[3 * i]] + vertices[index[3 * i + 1]] + vertices[index[3 * i + 2]]) / 3.0f;
+		bmin = glm::min(bmin, centroids[i]);
+		bmax = glm::max(bmax, centroids[i]);
+	}
+
+	vec3 extent = bmax - bmin;
+	float scale = extent.x > extent.y ? extent.x : extent.y;
+	scale = scale > extent.z ? scale : extent.z;
+	scale = scale > 0.0f ? 1.0f / scale : 0.0f;
+
+	vector<pair<unsigned int, int>> keys(num_triangle);
+	for (int i = 0; i < num_triangle; ++i)
+		keys[i] = make_pair(Morton_Code((centroids[i] - bmin) * scale), i);
+	sort(keys.begin(), keys.end());
+
+	vector<int> sorted(num_triangle * 3);
+	for (int i = 0; i < num_triangle; ++i)
+	{
+		int t = keys[i].second;
+		sorted[3 * i] = index[3 * t];
+		sorted[3 * i + 1] = index[3 * t + 1];
+		sorted[3 * i + 2] = index[3 * t + 2];
+	}
+	index.swap(sorted);
+
+	for (int start = 0; start < num_triangle; start += MESHLET_TRIANGLES)
+	{
+		int end = start + MESHLET_TRIANGLES < num_triangle ? start + MESHLET_TRIANGLES : num_triangle;
+
+		vec3 cmin(1e20f);
+		vec3 cmax(-1e20f);
+		vec3 normal_sum(0.0f);
+		vector<vec3> normals;
+		for (int t = start; t < end; ++t)
+		{
+			vec3 v0 = vertices[index[3 * t]];
+			vec3 v1 = vertices[index[3 * t + 1]];
+			vec3 v2 = vertices[index[3 * t + 2]];
+
+			cmin = glm::min(cmin, glm::min(v0, glm::min(v1, v2)));
+			cmax = glm::max(cmax, glm::max(v0, glm::max(v1, v2)));
+
+			vec3 n = cross(v1 - v0, v2 - v0);
+			float len = length(n);
+			if (len > 0.0f)
+			{
+				normals.emplace_back(n / len);
+				normal_sum += n / len;
+			}
+		}
+
+		Meshlet m;
+		vec3 center = (cmin + cmax) * 0.5f;
+		float radius = 0.0f;
+		for (int t = 3 * start; t < 3 * end; ++t)
+		{
+			float d = length(vertices[index[t]] - center);
+			radius = radius > d ? radius : d;
+		}
+		m.sphere = vec4(center, radius);
+
+		//normal cone, the cluster is back facing when the camera sees every
+		//triangle normal from behind
+		vec3 axis(0.0f, 0.0f, 1.0f);
+		float cutoff = 1.0f;
+		if (length(normal_sum) > 0.0f)
+		{
+			axis = normalize(normal_sum);
+			float min_dp = 1.0f;
+			for (int i = 0; i < normals.size(); ++i)
+			{
+				float dp = dot(normals[i], axis);
+				min_dp = min_dp < dp ? min_dp : dp;
+			}
+			if (min_dp > 0.0f)
+				cutoff = sqrt(1.0f - min_dp * min_dp);
+		}
+		m.cone = vec4(axis, cutoff);
+
+		m.first_index = 3 * start;
+		m.index_count = 3 * (end - start);
+		m.mesh = mesh;
+		m.base_vertex = 0;
+		meshlets.emplace_back(m);
+	}
+}
+
+//Run after Build_Meshlets on the same material. Every meshlet gets its
+//triangles reordered for the vertex cache, then the meshlets of the material
+//are sorted so the outward facing ones are drawn first to cut overdraw.
+//Meshlets stay contiguous ranges of index, only first_index changes.
+static void Optimize_Meshlets(const vector<vec3>& vertices, vector<int>& index, vector<Meshlet>& meshlets, int first_meshlet)
+{
+	int num_meshlet = meshlets.size() - first_meshlet;
+	if (num_meshlet <= 0)
+		return;
+
+	vector<int> clusters(num_meshlet);
+	for (int i = 0; i < num_meshlet; ++i)
+	{
+		Meshlet& m = meshlets[first_meshlet + i];
+		Optimize_Vertex_Cache(&index[m.first_index], m.index_count);
+		clusters[i] = m.first_index / 3;
+	}
+
+	vector<int> order;
+	Optimize_Overdraw(&index[0], index.size(), &vertices[0].x, clusters, &order);
+
+	vector<Meshlet> sorted(num_meshlet);
+	unsigned int first_index = 0;
+	for (int i = 0; i < num_meshlet; ++i)
+	{
+		sorted[i] = meshlets[first_meshlet + order[i]];
+		sorted[i].first_index = first_index;
+		first_index += sorted[i].index_count;
+	}
+	copy(sorted.begin(), sorted.end(), meshlets.begin() + first_meshlet);
+}
+
+#endif // !_MESHLET_H_
@@ -0,0 +1,401 @@
+#ifndef _TEXTURE_ARRAY_H_
+#define _TEXTURE_ARRAY_H_
+#include <gl\glew.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <unordered_map>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <SOIL2\SOIL2.h>
+#include <SOIL2\image_helper.h>
+
+using namespace std;
+
+//Must match the size of textureArrays[] in fs.glsl
+#define MAX_TEXTURE_ARRAYS 16
+#define MIN_LAYER_SIZE 64
+#define MAX_LAYER_SIZE 2048
+
+//Where a texture lives after packing: textureArrays[array], layer
+struct Texture_Slot
+{
+	int array = -1;
+	int layer = -1;
+};
+
+struct Texture_Array
+{
+	int width;
+	int height;
+	GLuint id = 0;
+	//decoded RGBA8 pixels, one entry per layer, freed after Upload()
+	vector<unsigned char*> layers;
+};
+
+//One image decoded by a worker thread
+struct Texture_Job
+{
+	string path;
+	unsigned long long hash = 0;
+	int width = 0;
+	int height = 0;
+	unsigned char* pixels = NULL;
+	bool decode_failed = false;//SOIL could not decode the bytes
+	string error;
+};
+
+//FNV-1a, two files with the same bytes share one layer
+static unsigned long long Hash_Bytes(const vector<char>& bytes)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	for (int i = 0; i < bytes.size(); ++i)
+	{
+		h ^= (unsigned char)bytes[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+static bool Read_File(const string& path, vector<char>& bytes)
+{
+	ifstream f(path, ios::binary);
+	if (!f)
+		return false;
+	bytes.assign(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+	return true;
+}
+
+//A matching hash only says the files are probably the same
+static bool Same_File_Bytes(const string& a, const string& b)
+{
+	if (a == b)
+		return true;
+	vector<char> bytes_a, bytes_b;
+	return Read_File(a, bytes_a) && Read_File(b, bytes_b) && bytes_a == bytes_b;
+}
+
+//Packs every texture into a handful of GL_TEXTURE_2D_ARRAYs.
+//OpenGL only allows 32 textures bound at once, so instead of one GL_TEXTURE_2D
+//per map (San Miguel has 354) images are resampled to a power of two size and
+//stacked as layers of the array with that size. All arrays are bound once and a
+//material only has to tell the shader which array and which layer to sample.
+//There is one manager for the whole process so models loaded one after another
+//reuse the layers of textures they have in common.
+struct Texture_Array_Manager
+{
+	vector<Texture_Array> arrays;
+	//every path requested so far, failed ones keep an empty slot
+	unordered_map<string, Texture_Slot> path_map;
+	//content hash -> the files packed with it, more than one on a collision
+	unordered_map<unsigned long long, vector<pair<string, Texture_Slot>>> slot_map;
+	GLint max_layers = 0;
+
+	static Texture_Array_Manager& Shared()
+	{
+		static Texture_Array_Manager manager;
+		return manager;
+	}
+
+	static int Round_Size(int n)
+	{
+		int size = MIN_LAYER_SIZE;
+		while (size < n && size < MAX_LAYER_SIZE)
+			size <<= 1;
+		return size;
+	}
+
+	int Find_Array(int width, int height)
+	{
+		if (max_layers == 0)
+			glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+
+		for (int i = 0; i < arrays.size(); ++i)
+		{
+			//uploaded arrays have immutable storage, only pending ones can grow
+			if (arrays[i].id == 0 && arrays[i].width == width && arrays[i].height == height && arrays[i].layers.size() < max_layers)
+				return i;
+		}
+
+		if (arrays.size() == MAX_TEXTURE_ARRAYS)
+			return -1;
+
+		Texture_Array a;
+		a.width = width;
+		a.height = height;
+		arrays.emplace_back(a);
+		return arrays.size() - 1;
+	}
+
+	//Resample RGBA pixels to the layer size, takes ownership of data.
+	//Images larger than the layer are box filtered by halving them like a mip
+	//chain until they are less than twice the layer size, only the last step
+	//(and any upscale) is bilinear. up_scale_image alone would skip most of
+	//the texels of a 4096 or 8192 map and alias badly.
+	static unsigned char* Resample(unsigned char* data, int w, int h, int array_w, int array_h)
+	{
+		while (w >= 2 * array_w || h >= 2 * array_h)
+		{
+			int block_x = w >= 2 * array_w ? 2 : 1;
+			int block_y = h >= 2 * array_h ? 2 : 1;
+			unsigned char* half = (unsigned char*)malloc((w / block_x) * (h / block_y) * 4);
+			mipmap_image(data, w, h, 4, half, block_x, block_y);
+			free(data);
+			data = half;
+			w /= block_x;
+			h /= block_y;
+		}
+
+		if (w == array_w && h == array_h)
+			return data;
+
+		unsigned char* layer = (unsigned char*)malloc(array_w * array_h * 4);
+		up_scale_image(data, w, h, 4, layer, array_w, array_h);
+		free(data);
+		return layer;
+	}
+
+	//Runs on a worker thread: read, hash, decode and resample one image.
+	//No GL calls here, the upload happens on the GL thread in Upload()
+	static void Decode(Texture_Job& job)
+	{
+		vector<char> bytes;
+		if (!Read_File(job.path, bytes))
+		{
+			job.error = "cannot open file";
+			return;
+		}
+		if (bytes.empty())
+		{
+			job.error = "empty file";
+			return;
+		}
+		job.hash = Hash_Bytes(bytes);
+
+		int w, h, channels;
+		unsigned char* data = SOIL_load_image_from_memory((const unsigned char*)&bytes[0], bytes.size(), &w, &h, &channels, SOIL_LOAD_RGBA);
+		if (data == NULL)
+		{
+			//SOIL_last_result() is one global for all workers, Request() asks
+			//for the reason once the workers are done
+			job.decode_failed = true;
+			return;
+		}
+
+		int array_w = Round_Size(w);
+		int array_h = Round_Size(h);
+
+		unsigned char* layer = Resample(data, w, h, array_w, array_h);
+
+		//same as SOIL_FLAG_INVERT_Y
+		int row = array_w * 4;
+		vector<unsigned char> tmp(row);
+		for (int y = 0; y < array_h / 2; ++y)
+		{
+			unsigned char* top = layer + y * row;
+			unsigned char* bottom = layer + (array_h - 1 - y) * row;
+			memcpy(&tmp[0], top, row);
+			memcpy(top, bottom, row);
+			memcpy(bottom, &tmp[0], row);
+		}
+
+		job.width = array_w;
+		job.height = array_h;
+		job.pixels = layer;
+	}
+
+	//Decode every image not seen before on all cores and reserve a layer for it.
+	//Layers are handed out in request order so the packing does not depend on
+	//which thread finished first.
+	vector<Texture_Slot> Request(const vector<string>& paths)
+	{
+		vector<Texture_Job> jobs;
+		unordered_map<string, int> job_map;
+		for (int i = 0; i < paths.size(); ++i)
+		{
+			if (path_map.find(paths[i]) == path_map.end() && job_map.find(paths[i]) == job_map.end())
+			{
+				job_map[paths[i]] = jobs.size();
+				Texture_Job job;
+				job.path = paths[i];
+				jobs.emplace_back(job);
+			}
+		}
+
+		int num_thread = thread::hardware_concurrency();
+		if (num_thread < 1)
+			num_thread = 1;
+		if (num_thread > jobs.size())
+			num_thread = jobs.size();
+
+		atomic<int> next(0);
+		vector<thread> workers;
+		for (int t = 0; t < num_thread; ++t)
+		{
+			workers.emplace_back([&]()
+			{
+				for (int j = next++; j < jobs.size(); j = next++)
+					Decode(jobs[j]);
+			});
+		}
+		for (int t = 0; t < workers.size(); ++t)
+			workers[t].join();
+
+		for (int j = 0; j < jobs.size(); ++j)
+		{
+			Texture_Job& job = jobs[j];
+			if (job.decode_failed)
+			{
+				//only this thread uses SOIL now, so the reason is this image's
+				Decode(job);
+				if (job.pixels == NULL)
+					job.error = SOIL_last_result();
+			}
+			if (job.pixels == NULL)
+			{
+				cout << "Load Texture " << job.path << " Fail: " << job.error << "\n";
+				path_map[job.path] = Texture_Slot();
+				continue;
+			}
+
+			vector<pair<string, Texture_Slot>>& same_hash = slot_map[job.hash];
+			int shared = -1;
+			for (int k = 0; k < same_hash.size() && shared < 0; ++k)
+			{
+				if (Same_File_Bytes(same_hash[k].first, job.path))
+					shared = k;
+			}
+			if (shared >= 0)
+			{
+				path_map[job.path] = same_hash[shared].second;
+				free(job.pixels);
+				continue;
+			}
+
+			Texture_Slot slot;
+			int a = Find_Array(job.width, job.height);
+			if (a < 0)
+			{
+				cout << "Texture arrays full, " << job.path << " is skipped\n";
+				free(job.pixels);
+			}
+			else
+			{
+				slot.array = a;
+				slot.layer = arrays[a].layers.size();
+				arrays[a].layers.emplace_back(job.pixels);
+			}
+			same_hash.emplace_back(job.path, slot);
+			path_map[job.path] = slot;
+		}
+
+		vector<Texture_Slot> slots(paths.size());
+		for (int i = 0; i < paths.size(); ++i)
+			slots[i] = path_map[paths[i]];
+		return slots;
+	}
+
+	void Upload()
+	{
+		bool anisotropic = glewIsSupported("GL_EXT_texture_filter_anisotropic");
+		GLfloat anisoset = 0.0f;
+		if (anisotropic)
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &anisoset);
+
+		for (int i = 0; i < arrays.size(); ++i)
+		{
+			Texture_Array& a = arrays[i];
+			if (a.id != 0 || a.layers.empty())
+				continue;
+
+			int levels = 1;
+			for (int size = a.width > a.height ? a.width : a.height; size > 1; size >>= 1)
+				++levels;
+
+			glGenTextures(1, &a.id);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, a.id);
+			glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, GL_RGBA8, a.width, a.height, a.layers.size());
+
+			for (int j = 0; j < a.layers.size(); ++j)
+			{
+				glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, j, a.width, a.height, 1, GL_RGBA, GL_UNSIGNED_BYTE, a.layers[j]);
+				free(a.layers[j]);
+			}
+			a.layers.swap(vector<unsigned char*>());
+
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+			if (anisotropic)
+				glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisoset);
+
+			cout << "texture array " << i << ": " << a.width << "x" << a.height << "\n";
+		}
+	}
+
+	//Bind every array once, texture unit i holds textureArrays[i]
+	void Bind(GLuint program)
+	{
+		for (int i = 0; i < arrays.size(); ++i)
+		{
+			glActiveTexture(GL_TEXTURE0 + i);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, arrays[i].id);
+
+			string name = "textureArrays[" + to_string(i) + "]";
+			glProgramUniform1i(program, glGetUniformLocation(program, name.c_str()), i);
+		}
+	}
+
+	void Clear()
+	{
+		for (int i = 0; i < arrays.size(); ++i)
+		{
+			for (int j = 0; j < arrays[i].layers.size(); ++j)
+				free(arrays[i].layers[j]);
+			glDeleteTextures(1, &arrays[i].id);
+		}
+		arrays.swap(vector<Texture_Array>());
+		path_map.clear();
+		slot_map.clear();
+	}
+};
+
+//The maps one MTL file asks for. The loaders collect them while parsing and
+//Resolve() decodes them together and hands every material its slots
+struct Material_Texture_Requests
+{
+	vector<string> paths;
+	vector<int> materials;
+	vector<bool> is_mask;
+
+	void Add(const string& path, int material, bool mask)
+	{
+		paths.emplace_back(path);
+		materials.emplace_back(material);
+		is_mask.emplace_back(mask);
+	}
+
+	//Material is the loader's own struct with Kd_Slot and Mask_Slot
+	template <class Material>
+	void Resolve(vector<Material>& mats)
+	{
+		Texture_Array_Manager& texture_arrays = Texture_Array_Manager::Shared();
+		vector<Texture_Slot> slots = texture_arrays.Request(paths);
+		for (int i = 0; i < slots.size(); ++i)
+		{
+			if (is_mask[i])
+				mats[materials[i]].Mask_Slot = slots[i];
+			else
+				mats[materials[i]].Kd_Slot = slots[i];
+		}
+		texture_arrays.Upload();
+	}
+};
+
+#endif // !_TEXTURE_ARRAY_H_
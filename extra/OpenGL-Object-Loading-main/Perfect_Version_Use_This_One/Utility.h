@@ -102,6 +102,7 @@ struct Utility
 			if (shaderType == 36487) cout << "Tess Eval ";
 			if (shaderType == 36313) cout << "Geometry ";
 			if (shaderType == 35632) cout << "Fragment ";
+			if (shaderType == 37305) cout << "Compute ";
 			cout << "shader compilation error." << endl;
 			PrintShaderLog(ShaderReference);
 		}
@@ -138,6 +139,19 @@ struct Utility
 		return program;
 	}
 
+	GLuint CreateComputeProgram(const string& cs_name)
+	{
+		GLuint cs = CreateShader(GL_COMPUTE_SHADER, cs_name);
+
+		GLuint program = glCreateProgram();
+
+		glAttachShader(program, cs);
+
+		program = LinkingProgram(program);
+
+		return program;
+	}
+
 	//Check Errors
 	bool CheckOpenGLError()
 	{
@@ -0,0 +1,154 @@
+#ifndef _VERTEX_ARENA_H_
+#define _VERTEX_ARENA_H_
+#include <gl\glew.h>
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <glm\glm.hpp>
+#include <glm\gtc\packing.hpp>
+
+using namespace std;
+using namespace glm;
+
+//0: plain floats, 32 bytes per vertex. 1: normal packed as
+//GL_INT_2_10_10_10_REV and texcoord as two half floats, 20 bytes per vertex.
+//Quantizing is lossy, half floats lose texels on texcoords that tile far
+//past 1, so it is opt in: define it to 1 before including this header
+#ifndef QUANTIZE_VERTICES
+#define QUANTIZE_VERTICES 0
+#endif
+
+//One interleaved vertex, attribute locations match vs.glsl
+#if QUANTIZE_VERTICES
+struct Vertex
+{
+	vec3 position;
+	GLuint normal;
+	GLuint texcoord;
+};
+#else
+struct Vertex
+{
+	vec3 position;
+	vec3 normal;
+	vec2 texcoord;
+};
+#endif
+
+static Vertex Make_Vertex(const vec3& position, const vec3& normal, const vec2& texcoord)
+{
+	Vertex v;
+	v.position = position;
+#if QUANTIZE_VERTICES
+	v.normal = packSnorm3x10_1x2(vec4(normal, 0.0f));
+	v.texcoord = packHalf2x16(texcoord);
+#else
+	v.normal = normal;
+	v.texcoord = texcoord;
+#endif
+	return v;
+}
+
+//Build the interleaved array of a mesh from its separate streams, missing
+//normals or texcoords (materials without a map) are left zero
+static void Interleave(const vector<vec3>& positions, const vector<vec3>& normals, const vector<vec2>& texcoords, vector<Vertex>& out)
+{
+	out.resize(positions.size());
+	for (int i = 0; i < positions.size(); ++i)
+	{
+		vec3 n = i < normals.size() ? normals[i] : vec3(0.0f);
+		vec2 t = i < texcoords.size() ? texcoords[i] : vec2(0.0f);
+		out[i] = Make_Vertex(positions[i], n, t);
+	}
+}
+
+//Where a mesh landed in the arena, what a draw needs as baseVertex/firstIndex
+struct Arena_Range
+{
+	int base_vertex = 0;
+	int first_index = 0;
+};
+
+//Every mesh of a model in one vertex buffer and one index buffer behind a
+//single VAO. Instead of three VBOs, an IBO and a VAO per material (over a
+//thousand objects on San Miguel) the driver sees three, and a draw only
+//changes baseVertex and firstIndex. Meshes are staged with Add() and the
+//buffers are created once in Upload().
+struct Vertex_Arena
+{
+	GLuint vao = 0;
+	GLuint vbo = 0;
+	GLuint ibo = 0;
+
+	vector<Vertex> vertices;
+	vector<GLuint> indices;
+
+	Arena_Range Add(const vector<Vertex>& mesh_vertices, const vector<int>& mesh_indices)
+	{
+		Arena_Range range;
+		range.base_vertex = vertices.size();
+		range.first_index = indices.size();
+		vertices.insert(vertices.end(), mesh_vertices.begin(), mesh_vertices.end());
+		indices.insert(indices.end(), mesh_indices.begin(), mesh_indices.end());
+		return range;
+	}
+
+	void Upload()
+	{
+		glGenBuffers(1, &vbo);
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.empty() ? NULL : &vertices[0], GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		glGenVertexArrays(1, &vao);
+		glBindVertexArray(vao);
+
+		//the format lives in the VAO, the buffer is attached to binding 0
+		glEnableVertexAttribArray(0);
+		glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
+		glVertexAttribBinding(0, 0);
+
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+#if QUANTIZE_VERTICES
+		glVertexAttribFormat(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(Vertex, normal));
+		glVertexAttribFormat(2, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(Vertex, texcoord));
+#else
+		glVertexAttribFormat(1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal));
+		glVertexAttribFormat(2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texcoord));
+#endif
+		glVertexAttribBinding(1, 0);
+		glVertexAttribBinding(2, 0);
+
+		glBindVertexBuffer(0, vbo, 0, sizeof(Vertex));
+
+		glGenBuffers(1, &ibo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.empty() ? NULL : &indices[0], GL_STATIC_DRAW);
+
+		glBindVertexArray(0);
+
+		cout << "vertex arena: " << vertices.size() << " vertices, " << (vertices.size() * sizeof(Vertex) + indices.size() * sizeof(GLuint)) / (1024 * 1024) << " MB\n";
+
+		vertices.swap(vector<Vertex>());
+		indices.swap(vector<GLuint>());
+	}
+
+	void Bind()
+	{
+		glBindVertexArray(vao);
+	}
+
+	void Clear()
+	{
+		glBindVertexArray(0);
+		glDeleteVertexArrays(1, &vao);
+		glDeleteBuffers(1, &vbo);
+		glDeleteBuffers(1, &ibo);
+		vao = vbo = ibo = 0;
+		vertices.swap(vector<Vertex>());
+		indices.swap(vector<GLuint>());
+	}
+};
+
+#endif // !_VERTEX_ARENA_H_
@@ -0,0 +1,149 @@
+#version 430
+
+layout (local_size_x = 64) in;
+
+//Same layout as Meshlet in Meshlet.h
+struct Meshlet
+{
+	vec4 sphere;
+	vec4 cone;
+	uint firstIndex;
+	uint indexCount;
+	uint mesh;
+	int baseVertex;
+};
+
+//DrawElementsIndirectCommand
+struct DrawCommand
+{
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int baseVertex;
+	uint baseInstance;
+};
+
+layout (std430, binding = 1) readonly buffer Meshlets
+{
+	Meshlet meshlets[];
+};
+
+layout (std430, binding = 2) writeonly buffer Commands
+{
+	DrawCommand commands[];
+};
+
+layout (std430, binding = 3) buffer Stats
+{
+	uint visibleTriangles;
+};
+
+//1 for meshlets the first pass rejected only because of occlusion
+layout (std430, binding = 4) buffer Occluded
+{
+	uint occluded[];
+};
+
+uniform uint meshletCount;
+uniform vec4 frustum[6];
+uniform vec3 cameraPos;
+uniform mat4 mvp_matrix;
+
+uniform bool coneCulling;
+uniform bool occlusionCulling;
+uniform bool latePass;
+uniform sampler2D depthPyramid;
+uniform vec2 pyramidSize;
+
+
+bool Frustum_Visible(vec3 c, float r)
+{
+	for(int i = 0; i < 6; ++i)
+	{
+		if(dot(frustum[i].xyz, c) + frustum[i].w < -r)
+			return false;
+	}
+	return true;
+}
+
+bool Cone_Visible(vec3 c, float r, vec4 cone)
+{
+	vec3 d = c - cameraPos;
+	return dot(d, cone.xyz) < cone.w * length(d) + r;
+}
+
+//Compare the nearest depth of the sphere's box against the farthest depth
+//of the depth pyramid over the screen rectangle it covers
+bool Occlusion_Visible(vec3 c, float r)
+{
+	vec2 ndc_min = vec2(1.0f);
+	vec2 ndc_max = vec2(-1.0f);
+	float nearest = 1.0f;
+
+	for(int i = 0; i < 8; ++i)
+	{
+		vec3 corner = c + r * vec3((i & 1) != 0 ? 1.0f : -1.0f, (i & 2) != 0 ? 1.0f : -1.0f, (i & 4) != 0 ? 1.0f : -1.0f);
+		vec4 clip = mvp_matrix * vec4(corner, 1.0f);
+		if(clip.w <= 0.0f)
+			return true;//crosses the near plane
+
+		vec3 ndc = clip.xyz / clip.w;
+		ndc_min = min(ndc_min, ndc.xy);
+		ndc_max = max(ndc_max, ndc.xy);
+		nearest = min(nearest, ndc.z * 0.5f + 0.5f);
+	}
+
+	vec2 uv_min = clamp(ndc_min * 0.5f + 0.5f, 0.0f, 1.0f);
+	vec2 uv_max = clamp(ndc_max * 0.5f + 0.5f, 0.0f, 1.0f);
+
+	vec2 size = (uv_max - uv_min) * pyramidSize;
+	float level = ceil(log2(max(max(size.x, size.y), 1.0f)));
+
+	float farthest = textureLod(depthPyramid, uv_min, level).r;
+	farthest = max(farthest, textureLod(depthPyramid, vec2(uv_max.x, uv_min.y), level).r);
+	farthest = max(farthest, textureLod(depthPyramid, vec2(uv_min.x, uv_max.y), level).r);
+	farthest = max(farthest, textureLod(depthPyramid, uv_max, level).r);
+
+	return nearest <= farthest;
+}
+
+void main()
+{
+	uint id = gl_GlobalInvocationID.x;
+	if(id >= meshletCount)
+		return;
+
+	Meshlet m = meshlets[id];
+	vec3 c = m.sphere.xyz;
+	float r = m.sphere.w;
+
+	bool visible;
+	if(latePass)
+	{
+		//the pyramid now holds this frame's first pass, draw what it no
+		//longer hides, everything else was drawn already or stays culled
+		visible = occluded[id] != 0 && Occlusion_Visible(c, r);
+	}
+	else
+	{
+		//first pass tests against last frame's pyramid
+		visible = Frustum_Visible(c, r);
+		if(visible && coneCulling)
+			visible = Cone_Visible(c, r, m.cone);
+
+		bool hidden = false;
+		if(visible && occlusionCulling)
+			hidden = !Occlusion_Visible(c, r);
+		occluded[id] = hidden ? 1 : 0;
+		visible = visible && !hidden;
+	}
+
+	commands[id].count = m.indexCount;
+	commands[id].instanceCount = visible ? 1 : 0;
+	commands[id].firstIndex = m.firstIndex;
+	commands[id].baseVertex = m.baseVertex;
+	commands[id].baseInstance = 0;
+
+	if(visible)
+		atomicAdd(visibleTriangles, m.indexCount / 3);
+}
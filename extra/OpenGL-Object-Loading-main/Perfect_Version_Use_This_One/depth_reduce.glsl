@@ -0,0 +1,45 @@
+#version 430
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+//inputLevel < 0: copy the depth buffer into level 0 of the pyramid
+//otherwise:      max of 2x2 texels of inputLevel into the next level
+uniform sampler2D inputDepth;
+uniform int inputLevel;
+uniform ivec2 inputSize;
+uniform ivec2 outputSize;
+
+layout (r32f, binding = 0) writeonly uniform image2D outputDepth;
+
+
+void main()
+{
+	ivec2 p = ivec2(gl_GlobalInvocationID.xy);
+	if(p.x >= outputSize.x || p.y >= outputSize.y)
+		return;
+
+	float d;
+	if(inputLevel < 0)
+	{
+		d = texelFetch(inputDepth, p, 0).r;
+	}
+	else
+	{
+		//the last row/column of an odd sized level also takes the texel
+		//that has no partner, so the max stays conservative
+		ivec2 q = p * 2;
+		ivec2 last = inputSize - 1;
+		ivec2 end = q + 1;
+		if((inputSize.x & 1) != 0 && p.x == outputSize.x - 1)
+			end.x += 1;
+		if((inputSize.y & 1) != 0 && p.y == outputSize.y - 1)
+			end.y += 1;
+
+		d = 0.0f;
+		for(int y = q.y; y <= end.y; ++y)
+			for(int x = q.x; x <= end.x; ++x)
+				d = max(d, texelFetch(inputDepth, min(ivec2(x, y), last), inputLevel).r);
+	}
+
+	imageStore(outputDepth, p, vec4(d));
+}
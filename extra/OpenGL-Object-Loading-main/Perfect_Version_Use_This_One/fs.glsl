@@ -10,12 +10,24 @@ in vec3 varyingHalfVector;
 
 out vec4 frag_color;
 
-uniform vec4 Kd;
-uniform float Ns;
-uniform sampler2D DiffuseTexture;
-uniform sampler2D MaskTexture;
-uniform bool useTexture;
-uniform bool useMask;
+//Same layout as Material_Data in Load_main.cpp
+struct Material
+{
+	vec4 Kd;
+	int kdArray;
+	int kdLayer;
+	int maskArray;
+	int maskLayer;
+	float Ns;
+};
+
+layout (std430, binding = 0) buffer Materials
+{
+	Material materials[];
+};
+
+uniform int materialIndex;
+uniform sampler2DArray textureArrays[16];
 
 uniform vec4 globalAmbient;
 
@@ -33,19 +45,19 @@ uniform Light light;
 void main()
 {
 	vec4 color;
+	Material m = materials[materialIndex];
 
-	if(useTexture)
+	if(m.maskArray >= 0)
 	{
-		vec4 a = texture(MaskTexture, tex);
+		vec4 a = texture(textureArrays[m.maskArray], vec3(tex, m.maskLayer));
 		if(a.w < 0.5f)
 			discard;
-		else
-			color = texture2D(DiffuseTexture, tex);
-			//if(color.w<0.5f)
-			//discard;
 	}
+
+	if(m.kdArray >= 0)
+		color = texture(textureArrays[m.kdArray], vec3(tex, m.kdLayer));
 	else
-		color = Kd;
+		color = m.Kd;
 	
 	vec3 L = normalize(varyingLightDir);
 	vec3 N = normalize(varyingNormal);
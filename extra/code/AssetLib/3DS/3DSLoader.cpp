@@ -53,6 +53,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 namespace Assimp {
 
@@ -99,7 +101,7 @@ static constexpr aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 Discreet3DSImporter::Discreet3DSImporter() :
-        stream(), mLastNodeIndex(), mCurrentNode(), mRootNode(), mScene(), mMasterScale(), bHasBG(), bIsPrj() {
+        stream(), mLastNodeIndex(), mCurrentNode(), mRootNode(), mScene(), mMasterScale(), bHasBG(), bIsPrj(), configUseGrid() {
     // empty
 }
 
@@ -118,8 +120,8 @@ const aiImporterDesc *Discreet3DSImporter::GetInfo() const {
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
-void Discreet3DSImporter::SetupProperties(const Importer * /*pImp*/) {
-    // nothing to be done for the moment
+void Discreet3DSImporter::SetupProperties(const Importer *pImp) {
+    configUseGrid = pImp->GetPropertyBool(AI_CONFIG_GLOB_SPATIAL_GRID, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -171,7 +173,7 @@ void Discreet3DSImporter::InternReadFile(const std::string &pFile,
         }
         CheckIndices(mesh);
         MakeUnique(mesh);
-        ComputeNormalsWithSmoothingsGroups<D3DS::Face>(mesh);
+        ComputeNormalsWithSmoothingsGroups<D3DS::Face>(mesh, configUseGrid);
     }
 
     // Replace all occurrences of the default material with a
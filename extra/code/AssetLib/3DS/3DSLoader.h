@@ -276,6 +276,9 @@ protected:
 
     /** true if PRJ file */
     bool bIsPrj;
+
+    /** Configuration option: smooth with a SpatialGrid */
+    bool configUseGrid;
 };
 
 } // end of namespace Assimp
@@ -253,6 +253,10 @@ private:
     // evaluated if the value is true.
     bool configEvalSubdivision;
 
+    // Threads used to evaluate subdivision surfaces,
+    // see #AI_CONFIG_PP_NUM_THREADS
+    unsigned int mNumThreads;
+
     // counts how many objects we have in the tree.
     // basing on this information we can find a
     // good estimate how many meshes we'll have in the final scene.
@@ -82,7 +82,7 @@ static constexpr aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ASEImporter::ASEImporter() :
-        mParser(), mBuffer(), pcScene(), configRecomputeNormals(), noSkeletonMesh() {
+        mParser(), mBuffer(), pcScene(), configRecomputeNormals(), noSkeletonMesh(), configUseGrid() {
     // empty
 }
 
@@ -108,6 +108,7 @@ void ASEImporter::SetupProperties(const Importer *pImp) {
                                       false);
 
     noSkeletonMesh = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES, 0) != 0;
+    configUseGrid = pImp->GetPropertyBool(AI_CONFIG_GLOB_SPATIAL_GRID, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1263,7 +1264,7 @@ bool ASEImporter::GenerateNormals(ASE::Mesh &mesh) {
         }
     }
     // The array is reused.
-    ComputeNormalsWithSmoothingsGroups<ASE::Face>(mesh);
+    ComputeNormalsWithSmoothingsGroups<ASE::Face>(mesh, configUseGrid);
     return false;
 }
 
@@ -182,6 +182,9 @@ protected:
         for 3DS Max broken ASE normal export */
     bool configRecomputeNormals;
     bool noSkeletonMesh;
+
+    /** Config option: smooth with a SpatialGrid */
+    bool configUseGrid;
 };
 
 #endif // ASSIMP_BUILD_NO_3DS_IMPORTER
@@ -711,13 +711,22 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
         uLongf uncompressedSize = Read<uint32_t>(stream);
         uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
 
-        unsigned char *compressedData = new unsigned char[compressedSize];
-        size_t len = stream->Read(compressedData, 1, compressedSize);
-        ai_assert(len == compressedSize);
+        // inflate straight from the mapping if the stream has one
+        unsigned char *compressedData = nullptr;
+        const unsigned char *source = stream->GetMappedData();
+        size_t len = compressedSize;
+        if (nullptr != source) {
+            source += stream->Tell();
+        } else {
+            compressedData = new unsigned char[compressedSize];
+            len = stream->Read(compressedData, 1, compressedSize);
+            ai_assert(len == compressedSize);
+            source = compressedData;
+        }
 
         unsigned char *uncompressedData = new unsigned char[uncompressedSize];
 
-        int res = uncompress(uncompressedData, &uncompressedSize, compressedData, (uLong)len);
+        int res = uncompress(uncompressedData, &uncompressedSize, source, (uLong)len);
         if (res != Z_OK) {
             delete[] uncompressedData;
             delete[] compressedData;
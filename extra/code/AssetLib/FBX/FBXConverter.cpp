@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXParser.h"
 #include "FBXProperties.h"
 #include "FBXUtil.h"
+#include "Common/FaceIndexAllocator.h"
 
 #include <assimp/MathFunctions.h>
 #include <assimp/StringComparison.h>
@@ -65,6 +66,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <sstream>
 
 namespace Assimp {
@@ -1055,15 +1057,17 @@ std::vector<unsigned int> FBXConverter::ConvertLine(const LineGeometry &line, ai
     unsigned int scount = out_mesh->mNumFaces = pcount - epcount;
 
     aiFace *fac = out_mesh->mFaces = new aiFace[scount]();
+    FaceIndexAllocator faceIndices(doc.Settings().poolFaceIndices, 2 * static_cast<size_t>(scount));
     for (unsigned int i = 0; i < pcount; ++i) {
         if (indices[i] < 0) continue;
         aiFace &f = *fac++;
         f.mNumIndices = 2; //2 == aiPrimitiveType_LINE
-        f.mIndices = new unsigned int[2];
+        f.mIndices = faceIndices.Allocate(2);
         f.mIndices[0] = indices[i];
         int segid = indices[(i + 1 == pcount ? 0 : i + 1)]; //If we have reached he last point, wrap around
         f.mIndices[1] = (segid < 0 ? (segid + 1) * -1 : segid); //Convert EndPoint Index to normal Index
     }
+    faceIndices.Attach(out_mesh);
     temp.push_back(static_cast<unsigned int>(mMeshes.size() - 1));
     return temp;
 }
@@ -1133,12 +1137,13 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, c
     // generate dummy faces
     out_mesh->mNumFaces = static_cast<unsigned int>(faces.size());
     aiFace *fac = out_mesh->mFaces = new aiFace[faces.size()]();
+    FaceIndexAllocator faceIndices(doc.Settings().poolFaceIndices, std::accumulate(faces.begin(), faces.end(), size_t(0)));
 
     unsigned int cursor = 0;
     for (unsigned int pcount : faces) {
         aiFace &f = *fac++;
         f.mNumIndices = pcount;
-        f.mIndices = new unsigned int[pcount];
+        f.mIndices = faceIndices.Allocate(pcount);
         switch (pcount) {
             case 1:
                 out_mesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
@@ -1157,6 +1162,7 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, c
             f.mIndices[i] = cursor++;
         }
     }
+    faceIndices.Attach(out_mesh);
 
     // copy normals
     const std::vector<aiVector3D> &normals = mesh.GetNormals();
@@ -1358,6 +1364,7 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
 
     out_mesh->mNumFaces = count_faces;
     aiFace *fac = out_mesh->mFaces = new aiFace[count_faces]();
+    FaceIndexAllocator faceIndices(doc.Settings().poolFaceIndices, count_vertices);
 
     // allocate normals
     const std::vector<aiVector3D> &normals = mesh.GetNormals();
@@ -1432,7 +1439,7 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
         aiFace &f = *fac++;
 
         f.mNumIndices = pcount;
-        f.mIndices = new unsigned int[pcount];
+        f.mIndices = faceIndices.Allocate(pcount);
         switch (pcount) {
             case 1:
                 out_mesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
@@ -1477,6 +1484,7 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
             }
         }
     }
+    faceIndices.Attach(out_mesh);
 
     ConvertMaterialForMesh(out_mesh, model, mesh, index);
 
@@ -159,6 +159,9 @@ struct ImportSettings {
 
     // Set to true to ignore the axis configuration in the file
     bool ignoreUpDirection = false;
+
+    // Set to true to store the face indices of a mesh in one pool
+    bool poolFaceIndices = false;
 };
 
 } // namespace FBX
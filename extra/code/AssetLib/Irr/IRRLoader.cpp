@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "IRRLoader.h"
 #include "Common/Importer.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/GenericProperty.h>
 #include <assimp/MathFunctions.h>
@@ -82,7 +83,7 @@ static constexpr aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 IRRImporter::IRRImporter() :
-        fps(), configSpeedFlag() {
+        fps(), configSpeedFlag(), mNumThreads(1) {
     // empty
 }
 
@@ -113,6 +114,9 @@ void IRRImporter::SetupProperties(const Importer *pImp) {
 
     // AI_CONFIG_FAVOUR_SPEED
     configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 0));
+
+    // AI_CONFIG_PP_NUM_THREADS
+    mNumThreads = GetNumThreads(pImp->GetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 1));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -597,6 +601,7 @@ void SetupMapping(aiMaterial *mat, aiTextureMapping mode, const aiVector3D &axis
     }
     mat->mNumProperties = (unsigned int)p.size();
     ::memcpy(mat->mProperties, &p[0], sizeof(void *) * mat->mNumProperties);
+    mat->InvalidatePropertyIndex();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1222,6 +1227,7 @@ void IRRImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 
     // Batch loader used to load external models
     BatchLoader batch(pIOHandler);
+    batch.setNumThreads(mNumThreads);
     // batch.SetBasePath(pFile);
 
     cameras.reserve(1); // Probably only one camera in entire scene
@@ -280,6 +280,9 @@ private:
     /// Configuration option: speed flag was set?
     bool configSpeedFlag;
 
+    /// Configuration option: number of threads to load the referenced files
+    unsigned int mNumThreads;
+
     std::vector<aiCamera*> cameras;
     std::vector<aiLight*> lights;
     unsigned int guessedMeshCnt;
@@ -92,6 +92,7 @@ LWOImporter::LWOImporter() :
         fileSize(),
         mScene(nullptr),
         configSpeedFlag(),
+        configUseGrid(),
         configLayerIndex(),
         hasNamedLayer() {
     // empty
@@ -116,6 +117,7 @@ bool LWOImporter::CanRead(const std::string &file, IOSystem *pIOHandler, bool /*
 // Setup configuration properties
 void LWOImporter::SetupProperties(const Importer *pImp) {
     configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 0) ? true : false);
+    configUseGrid = pImp->GetPropertyBool(AI_CONFIG_GLOB_SPATIAL_GRID, false);
     configLayerIndex = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_LWO_ONE_LAYER_ONLY, UINT_MAX);
     configLayerName = pImp->GetPropertyString(AI_CONFIG_IMPORT_LWO_ONE_LAYER_ONLY, "");
 }
@@ -495,6 +497,7 @@ void LWOImporter::ComputeNormals(aiMesh *mesh, const std::vector<unsigned int> &
 
     // Now generate the spatial sort tree
     SGSpatialSort sSort;
+    sSort.SetUseGrid(configUseGrid);
     std::vector<unsigned int>::const_iterator it = smoothingGroups.begin();
     for (begin = mesh->mFaces; begin != end; ++begin, ++it) {
         aiFace &face = *begin;
@@ -396,6 +396,9 @@ protected:
     /** Configuration option: speed flag set? */
     bool configSpeedFlag;
 
+    /** Configuration option: smooth with a SpatialGrid */
+    bool configUseGrid;
+
     /** Configuration option: index of layer to be loaded */
     unsigned int configLayerIndex;
 
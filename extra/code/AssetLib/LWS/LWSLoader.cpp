@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "LWSLoader.h"
 #include "Common/Importer.h"
+#include "Common/ParallelFor.h"
 #include "PostProcessing/ConvertToLHProcess.h"
 
 #include <assimp/GenericProperty.h>
@@ -142,7 +143,8 @@ LWSImporter::LWSImporter() :
         first(),
         last(),
         fps(),
-        noSkeletonMesh() {
+        noSkeletonMesh(),
+        mNumThreads(1) {
     // nothing to do here
 }
 
@@ -183,6 +185,9 @@ void LWSImporter::SetupProperties(const Importer *pImp) {
     }
 
     noSkeletonMesh = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES, 0) != 0;
+
+    // AI_CONFIG_PP_NUM_THREADS
+    mNumThreads = GetNumThreads(pImp->GetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 1));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -513,6 +518,7 @@ void LWSImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 
     // Construct a Batch-importer to read more files recursively
     BatchLoader batch(pIOHandler);
+    batch.setNumThreads(mNumThreads);
 
     // Construct an array to receive the flat output graph
     std::list<LWS::NodeDesc> nodes;
@@ -230,6 +230,7 @@ private:
     IOSystem *io;
     double first, last, fps;
     bool noSkeletonMesh;
+    unsigned int mNumThreads;
 };
 
 } // end of namespace Assimp
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "MD3Loader.h"
 #include "Common/Importer.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/GenericProperty.h>
 #include <assimp/ParsingUtils.h>
@@ -341,7 +342,7 @@ void Q3Shader::ConvertShaderToMaterial(aiMaterial *out, const ShaderDataBlock &s
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 MD3Importer::MD3Importer() :
-        configFrameID(0), configHandleMP(true), configSpeedFlag(), pcHeader(), mBuffer(), fileSize(), mScene(), mIOHandler() {}
+        configFrameID(0), configHandleMP(true), configSpeedFlag(), mNumThreads(1), pcHeader(), mBuffer(), fileSize(), mScene(), mIOHandler() {}
 
 // ------------------------------------------------------------------------------------------------
 // Destructor, private as well
@@ -449,6 +450,9 @@ void MD3Importer::SetupProperties(const Importer *pImp) {
 
     // AI_CONFIG_FAVOUR_SPEED
     configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 0));
+
+    // AI_CONFIG_PP_NUM_THREADS
+    mNumThreads = GetNumThreads(pImp->GetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 1));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -548,6 +552,7 @@ bool MD3Importer::ReadMultipartFile() {
 
         // now read these three files
         BatchLoader batch(mIOHandler);
+        batch.setNumThreads(mNumThreads);
         const unsigned int _lower = batch.AddLoadRequest(lower, 0, &props);
         const unsigned int _upper = batch.AddLoadRequest(upper, 0, &props);
         const unsigned int _head = batch.AddLoadRequest(head, 0, &props);
@@ -284,6 +284,9 @@ protected:
     /** Configuration option: speed flag was set? */
     bool configSpeedFlag;
 
+    /** Configuration option: number of threads to load the parts of a multi-part model */
+    unsigned int mNumThreads;
+
     /** Header of the MD3 file */
     BE_NCONST MD3::Header *pcHeader;
 
@@ -56,21 +56,48 @@ struct Object;
 struct Face;
 struct Material;
 
+// ------------------------------------------------------------------------------------------------
+//! \struct IndexRange
+//! \brief  A run of indices inside one of the flat index arrays of a Mesh
+// ------------------------------------------------------------------------------------------------
+struct IndexRange {
+    //! First index in the owning array
+    unsigned int mOffset;
+    //! Number of indices
+    unsigned int mCount;
+
+    IndexRange() :
+            mOffset(0), mCount(0) {
+        // empty
+    }
+
+    size_t size() const {
+        return mCount;
+    }
+
+    bool empty() const {
+        return mCount == 0;
+    }
+};
+
 // ------------------------------------------------------------------------------------------------
 //! \struct Face
 //! \brief  Data structure for a simple obj-face, describes discredit,l.ation and materials
+//!
+//! The indices are not stored in the face itself, the ranges point into the flat index arrays
+//! of the mesh owning the face. A face is a plain value, storing one costs no allocation.
 // ------------------------------------------------------------------------------------------------
 struct Face {
     using IndexArray = std::vector<unsigned int>;
 
     //! Primitive type
     aiPrimitiveType mPrimitiveType;
-    //! Vertex indices
-    IndexArray m_vertices;
-    //! Normal indices
-    IndexArray m_normals;
-    //! Texture coordinates indices
-    IndexArray m_texturCoords;
+    //! Vertex indices, range in Mesh::m_vertexIndices
+    IndexRange m_vertices;
+    //! Normal indices, range in Mesh::m_normalIndices
+    IndexRange m_normals;
+    //! Texture coordinates indices, range in Mesh::m_texturCoordIndices
+    IndexRange m_texturCoords;
     //! Pointer to assigned material
     Material *m_pMaterial;
 
@@ -231,8 +258,14 @@ struct Mesh {
     static const unsigned int NoMaterial = ~0u;
     /// The name for the mesh
     std::string m_name;
-    /// Array with pointer to all stored faces
-    std::vector<Face*> m_Faces;
+    /// Array with all stored faces
+    std::vector<Face> m_Faces;
+    /// Vertex indices of all faces, in face order
+    Face::IndexArray m_vertexIndices;
+    /// Normal indices of all faces, in face order
+    Face::IndexArray m_normalIndices;
+    /// Texture coordinate indices of all faces, in face order
+    Face::IndexArray m_texturCoordIndices;
     /// Assigned material
     Material *m_pMaterial;
     /// Number of stored indices.
@@ -255,11 +288,39 @@ struct Mesh {
     }
 
     /// Destructor
-    ~Mesh() {
-        for (std::vector<Face *>::iterator it = m_Faces.begin();
-                it != m_Faces.end(); ++it) {
-            delete *it;
-        }
+    ~Mesh() = default;
+
+    /// Returns the i-th vertex index of a face of this mesh.
+    unsigned int vertexIndex(const Face &face, size_t i) const {
+        return m_vertexIndices[face.m_vertices.mOffset + i];
+    }
+
+    /// Returns the i-th normal index of a face of this mesh.
+    unsigned int normalIndex(const Face &face, size_t i) const {
+        return m_normalIndices[face.m_normals.mOffset + i];
+    }
+
+    /// Returns the i-th texture coordinate index of a face of this mesh.
+    unsigned int texturCoordIndex(const Face &face, size_t i) const {
+        return m_texturCoordIndices[face.m_texturCoords.mOffset + i];
+    }
+
+    /// Appends a face, the index arrays are copied into the flat arrays of the mesh.
+    void addFace(Face face, const Face::IndexArray &vertices, const Face::IndexArray &texturCoords,
+            const Face::IndexArray &normals) {
+        face.m_vertices.mOffset = static_cast<unsigned int>(m_vertexIndices.size());
+        face.m_vertices.mCount = static_cast<unsigned int>(vertices.size());
+        m_vertexIndices.insert(m_vertexIndices.end(), vertices.begin(), vertices.end());
+
+        face.m_texturCoords.mOffset = static_cast<unsigned int>(m_texturCoordIndices.size());
+        face.m_texturCoords.mCount = static_cast<unsigned int>(texturCoords.size());
+        m_texturCoordIndices.insert(m_texturCoordIndices.end(), texturCoords.begin(), texturCoords.end());
+
+        face.m_normals.mOffset = static_cast<unsigned int>(m_normalIndices.size());
+        face.m_normals.mCount = static_cast<unsigned int>(normals.size());
+        m_normalIndices.insert(m_normalIndices.end(), normals.begin(), normals.end());
+
+        m_Faces.push_back(face);
     }
 };
 
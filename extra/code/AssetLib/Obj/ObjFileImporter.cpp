@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/ObjMaterial.h>
+#include <assimp/config.h>
 #include <memory>
 
 static constexpr aiImporterDesc desc = {
@@ -78,7 +79,8 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
         m_Buffer(),
         m_pRootObject(nullptr),
-        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())) {
+        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())),
+        m_bPoolFaceIndices(false) {
     // empty
 }
 
@@ -95,6 +97,12 @@ bool ObjFileImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bo
     return BaseImporter::SearchFileHeaderForToken(pIOHandler, pFile, tokens, AI_COUNT_OF(tokens), 200, false, true);
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Reads the configuration properties.
+void ObjFileImporter::SetupProperties(const Importer *pImp) {
+    m_bPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FACE_INDEX_POOL, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *ObjFileImporter::GetInfo() const {
     return &desc;
@@ -329,11 +337,7 @@ std::unique_ptr<aiMesh> ObjFileImporter::createTopology(const ObjFile::Model *pM
     }
 
     for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++) {
-        const ObjFile::Face *inp = pObjMesh->m_Faces[index];
-        if (inp == nullptr) {
-            continue;
-        }
-
+        const ObjFile::Face *inp = &pObjMesh->m_Faces[index];
         if (inp->mPrimitiveType == aiPrimitiveType_LINE) {
             pMesh->mNumFaces += static_cast<unsigned int>(inp->m_vertices.size() - 1);
             pMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
@@ -360,31 +364,40 @@ std::unique_ptr<aiMesh> ObjFileImporter::createTopology(const ObjFile::Model *pM
         unsigned int outIndex = 0u;
 
         // Copy all data from all stored meshes
-        for (auto &face : pObjMesh->m_Faces) {
-            const ObjFile::Face *inp = face;
+        for (const ObjFile::Face &face : pObjMesh->m_Faces) {
+            const ObjFile::Face *inp = &face;
             if (inp->mPrimitiveType == aiPrimitiveType_LINE) {
                 for (size_t i = 0; i < inp->m_vertices.size() - 1; ++i) {
                     aiFace &f = pMesh->mFaces[outIndex++];
                     uiIdxCount += f.mNumIndices = 2;
-                    f.mIndices = new unsigned int[2];
+                    if (!m_bPoolFaceIndices) {
+                        f.mIndices = new unsigned int[2];
+                    }
                 }
                 continue;
             } else if (inp->mPrimitiveType == aiPrimitiveType_POINT) {
                 for (size_t i = 0; i < inp->m_vertices.size(); ++i) {
                     aiFace &f = pMesh->mFaces[outIndex++];
                     uiIdxCount += f.mNumIndices = 1;
-                    f.mIndices = new unsigned int[1];
+                    if (!m_bPoolFaceIndices) {
+                        f.mIndices = new unsigned int[1];
+                    }
                 }
                 continue;
             }
 
             aiFace *pFace = &pMesh->mFaces[outIndex++];
-            const unsigned int uiNumIndices = (unsigned int)face->m_vertices.size();
+            const unsigned int uiNumIndices = (unsigned int)face.m_vertices.size();
             uiIdxCount += pFace->mNumIndices = (unsigned int)uiNumIndices;
-            if (pFace->mNumIndices > 0) {
+            if (pFace->mNumIndices > 0 && !m_bPoolFaceIndices) {
                 pFace->mIndices = new unsigned int[uiNumIndices];
             }
         }
+
+        // the index counts are known, allocate the indices of all faces at once
+        if (m_bPoolFaceIndices) {
+            pMesh->PoolFaceIndices();
+        }
     }
 
     // Create mesh vertices
@@ -442,10 +455,11 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
     // Copy vertices, normals and textures into aiMesh instance
     bool normalsok = true, uvok = true;
     unsigned int newIndex = 0, outIndex = 0;
-    for (auto sourceFace : pObjMesh->m_Faces) {
-        // Copy all index arrays
+    for (const ObjFile::Face &face : pObjMesh->m_Faces) {
+        const ObjFile::Face *sourceFace = &face;
+        // Copy all index arrays, they live in the flat arrays of the mesh
         for (size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < sourceFace->m_vertices.size(); vertexIndex++) {
-            const unsigned int vertex = sourceFace->m_vertices.at(vertexIndex);
+            const unsigned int vertex = pObjMesh->vertexIndex(face, vertexIndex);
             if (vertex >= pModel->mVertices.size()) {
                 throw DeadlyImportError("OBJ: vertex index out of range");
             }
@@ -458,7 +472,7 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
 
             // Copy all normals
             if (normalsok && !pModel->mNormals.empty() && vertexIndex < sourceFace->m_normals.size()) {
-                const unsigned int normal = sourceFace->m_normals.at(vertexIndex);
+                const unsigned int normal = pObjMesh->normalIndex(face, vertexIndex);
                 if (normal >= pModel->mNormals.size()) {
                     normalsok = false;
                 } else {
@@ -474,7 +488,7 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
 
             // Copy all texture coordinates
             if (uvok && !pModel->mTextureCoord.empty() && vertexIndex < sourceFace->m_texturCoords.size()) {
-                const unsigned int tex = sourceFace->m_texturCoords.at(vertexIndex);
+                const unsigned int tex = pObjMesh->texturCoordIndex(face, vertexIndex);
 
                 if (tex >= pModel->mTextureCoord.size()) {
                     uvok = false;
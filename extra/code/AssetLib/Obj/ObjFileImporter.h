@@ -73,6 +73,9 @@ public:
     /// \remark See BaseImporter::CanRead() for details.
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler, bool checkSig) const override;
 
+    /// \brief  Reads the configuration properties.
+    void SetupProperties(const Importer *pImp) override;
+
 protected:
     //! \brief  Appends the supported extension.
     const aiImporterDesc *GetInfo() const override;
@@ -114,6 +117,8 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Allocate the face indices of a mesh at once, see AI_CONFIG_IMPORT_FACE_INDEX_POOL
+    bool m_bPoolFaceIndices;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -445,7 +445,11 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
         return;
     }
 
-    ObjFile::Face *face = new ObjFile::Face(type);
+    // The indices are collected in scratch arrays which keep their capacity from face to face
+    ObjFile::Face face(type);
+    m_faceVertices.clear();
+    m_faceTexturCoords.clear();
+    m_faceNormals.clear();
     bool hasNormal = false;
 
     const int vSize = static_cast<unsigned int>(m_pModel->mVertices.size());
@@ -501,11 +505,11 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
             if (iVal > 0) {
                 // Store parsed index
                 if (0 == iPos) {
-                    face->m_vertices.push_back(iVal - 1);
+                    m_faceVertices.push_back(iVal - 1);
                 } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(iVal - 1);
+                    m_faceTexturCoords.push_back(iVal - 1);
                 } else if (2 == iPos) {
-                    face->m_normals.push_back(iVal - 1);
+                    m_faceNormals.push_back(iVal - 1);
                     hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
@@ -513,37 +517,35 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
             } else if (iVal < 0) {
                 // Store relatively index
                 if (0 == iPos) {
-                    face->m_vertices.push_back(vSize + iVal);
+                    m_faceVertices.push_back(vSize + iVal);
                 } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(vtSize + iVal);
+                    m_faceTexturCoords.push_back(vtSize + iVal);
                 } else if (2 == iPos) {
-                    face->m_normals.push_back(vnSize + iVal);
+                    m_faceNormals.push_back(vnSize + iVal);
                     hasNormal = true;
                 } else {
                     reportErrorTokenInFace();
                 }
             } else {
                 //On error, std::atoi will return 0 which is not a valid value
-                delete face;
                 throw DeadlyImportError("OBJ: Invalid face index.");
             }
         }
         m_DataIt += iStep;
     }
 
-    if (face->m_vertices.empty()) {
+    if (m_faceVertices.empty()) {
         ASSIMP_LOG_ERROR("Obj: Ignoring empty face");
-        // skip line and clean up
+        // skip line
         m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-        delete face;
         return;
     }
 
     // Set active material, if one set
     if (nullptr != m_pModel->mCurrentMaterial) {
-        face->m_pMaterial = m_pModel->mCurrentMaterial;
+        face.m_pMaterial = m_pModel->mCurrentMaterial;
     } else {
-        face->m_pMaterial = m_pModel->mDefaultMaterial;
+        face.m_pMaterial = m_pModel->mDefaultMaterial;
     }
 
     // Create a default object, if nothing is there
@@ -557,9 +559,9 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
     }
 
     // Store the face
-    m_pModel->mCurrentMesh->m_Faces.emplace_back(face);
-    m_pModel->mCurrentMesh->m_uiNumIndices += static_cast<unsigned int>(face->m_vertices.size());
-    m_pModel->mCurrentMesh->m_uiUVCoordinates[0] += static_cast<unsigned int>(face->m_texturCoords.size());
+    m_pModel->mCurrentMesh->addFace(face, m_faceVertices, m_faceTexturCoords, m_faceNormals);
+    m_pModel->mCurrentMesh->m_uiNumIndices += static_cast<unsigned int>(m_faceVertices.size());
+    m_pModel->mCurrentMesh->m_uiUVCoordinates[0] += static_cast<unsigned int>(m_faceTexturCoords.size());
     if (!m_pModel->mCurrentMesh->m_hasNormals && hasNormal) {
         m_pModel->mCurrentMesh->m_hasNormals = true;
     }
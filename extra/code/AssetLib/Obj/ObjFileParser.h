@@ -152,6 +152,10 @@ private:
     ProgressHandler *m_progress;
     /// Path to the current model, name of the obj file where the buffer comes from
     const std::string m_originalObjFileName;
+    /// Scratch index arrays of the face being parsed, reused to avoid an allocation per face
+    ObjFile::Face::IndexArray m_faceVertices;
+    ObjFile::Face::IndexArray m_faceTexturCoords;
+    ObjFile::Face::IndexArray m_faceNormals;
 };
 
 } // Namespace Assimp
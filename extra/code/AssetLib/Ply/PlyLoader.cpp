@@ -47,10 +47,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "PlyLoader.h"
+#include "Common/ParallelFor.h"
+#include <assimp/ByteSwapper.h>
 #include <assimp/IOStreamBuffer.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/PointBatchHandler.hpp>
+#include <algorithm>
 #include <memory>
 
 namespace Assimp {
@@ -102,6 +107,93 @@ namespace {
         return isBigEndian;
     }
 
+    // ------------------------------------------------------------------------------------------------
+    // Binary vertices and faces are decoded in batches of this many instances,
+    // one batch per thread. It is also the batch size a point handler gets.
+    constexpr unsigned int InstancesPerBatch = 1u << 16;
+
+    // ------------------------------------------------------------------------------------------------
+    // Vertex channels the loader extracts, in the order of the output arrays
+    enum VertexChannel {
+        PositionX, PositionY, PositionZ,
+        NormalX, NormalY, NormalZ,
+        ColorR, ColorG, ColorB, ColorA,
+        TexCoordU, TexCoordV,
+        NumVertexChannels
+    };
+
+    // ------------------------------------------------------------------------------------------------
+    static int GetVertexChannel(PLY::ESemantic semantic) {
+        switch (semantic) {
+        case PLY::EST_XCoord: return PositionX;
+        case PLY::EST_YCoord: return PositionY;
+        case PLY::EST_ZCoord: return PositionZ;
+        case PLY::EST_XNormal: return NormalX;
+        case PLY::EST_YNormal: return NormalY;
+        case PLY::EST_ZNormal: return NormalZ;
+        case PLY::EST_Red: return ColorR;
+        case PLY::EST_Green: return ColorG;
+        case PLY::EST_Blue: return ColorB;
+        case PLY::EST_Alpha: return ColorA;
+        case PLY::EST_UTextureCoord: return TexCoordU;
+        case PLY::EST_VTextureCoord: return TexCoordV;
+        default: break;
+        }
+        return -1;
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    template <typename T>
+    inline void SwapBytes(T *t) {
+        ByteSwap::Swap(t);
+    }
+    inline void SwapBytes(int8_t *) {}
+    inline void SwapBytes(uint8_t *) {}
+
+    // ------------------------------------------------------------------------------------------------
+    // Converts count values which are stride bytes apart. The byte order
+    // test is hoisted out of the loop so both loops stay branch free.
+    template <typename T>
+    void DecodeChannel(const char *src, size_t stride, unsigned int count, bool bBE, ai_real *dst, size_t dstStride) {
+        T t;
+        if (bBE) {
+            for (unsigned int i = 0; i < count; ++i, src += stride) {
+                memcpy(&t, src, sizeof(T));
+                SwapBytes(&t);
+                dst[i * dstStride] = static_cast<ai_real>(t);
+            }
+        } else {
+            for (unsigned int i = 0; i < count; ++i, src += stride) {
+                memcpy(&t, src, sizeof(T));
+                dst[i * dstStride] = static_cast<ai_real>(t);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    static void DecodeChannel(const char *src, size_t stride, unsigned int count, PLY::EDataType eType, bool bBE,
+            ai_real *dst, size_t dstStride) {
+        switch (eType) {
+        case EDT_Char: DecodeChannel<int8_t>(src, stride, count, bBE, dst, dstStride); break;
+        case EDT_UChar: DecodeChannel<uint8_t>(src, stride, count, bBE, dst, dstStride); break;
+        case EDT_Short: DecodeChannel<int16_t>(src, stride, count, bBE, dst, dstStride); break;
+        case EDT_UShort: DecodeChannel<uint16_t>(src, stride, count, bBE, dst, dstStride); break;
+        case EDT_Int: DecodeChannel<int32_t>(src, stride, count, bBE, dst, dstStride); break;
+        case EDT_UInt: DecodeChannel<uint32_t>(src, stride, count, bBE, dst, dstStride); break;
+        case EDT_Float: DecodeChannel<float>(src, stride, count, bBE, dst, dstStride); break;
+        case EDT_Double: DecodeChannel<double>(src, stride, count, bBE, dst, dstStride); break;
+        default: break;
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------
+    // Decodes one unsigned integer, e.g. a list size or vertex index
+    inline unsigned int DecodeIndex(const char *src, PLY::EDataType eType, bool bBE) {
+        PLY::PropertyInstance::ValueUnion v;
+        PLY::PropertyInstance::DecodeValueBinary(src, eType, &v, bBE);
+        return PLY::PropertyInstance::ConvertTo<unsigned int>(v, eType);
+    }
+
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -109,7 +201,11 @@ namespace {
 PLYImporter::PLYImporter() :
         mBuffer(nullptr),
         pcDOM(nullptr),
-        mGeneratedMesh(nullptr) {
+        mGeneratedMesh(nullptr),
+        mNumThreads(1),
+        mPoolFaceIndices(false),
+        mPointHandler(nullptr),
+        mPointsStreamed(false) {
     // empty
 }
 
@@ -130,6 +226,13 @@ const aiImporterDesc *PLYImporter::GetInfo() const {
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::SetupProperties(const Importer *pImp) {
+    mNumThreads = GetNumThreads(pImp->GetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 1));
+    mPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FACE_INDEX_POOL, false);
+    mPointHandler = static_cast<PointBatchHandler *>(pImp->GetPropertyPointer(AI_CONFIG_IMPORT_POINT_BATCH_HANDLER));
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure.
 void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
@@ -171,6 +274,7 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     // determine the format of the file data and construct the aiMesh
     PLY::DOM sPlyDom;
     this->pcDOM = &sPlyDom;
+    mPointsStreamed = false;
 
     if (TokenMatch(szMe, "format", 6)) {
         if (TokenMatch(szMe, "ascii", 5)) {
@@ -221,6 +325,13 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     // free the file buffer
     streamedBuffer.close();
 
+    // the points went to the point handler, there is nothing left to build
+    if (mPointsStreamed) {
+        pScene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
+        pScene->mRootNode = new aiNode();
+        return;
+    }
+
     if (mGeneratedMesh == nullptr) {
         throw DeadlyImportError("Invalid .ply file: Unable to extract mesh data ");
     }
@@ -230,6 +341,9 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     bool pointsOnly = mGeneratedMesh->mFaces == nullptr ? true : false;
     if (pointsOnly) {
         mGeneratedMesh->mPrimitiveTypes = aiPrimitiveType::aiPrimitiveType_POINT;
+    } else if (mPoolFaceIndices && nullptr == mGeneratedMesh->mFaceIndices) {
+        // faces read element by element were allocated one by one
+        mGeneratedMesh->PoolFaceIndices();
     }
 
     // now load a list of all materials
@@ -476,6 +590,281 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+bool PLYImporter::LoadVerticesBinary(const PLY::Element *pcElement, const PLY::FixedLayout &layout,
+        IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char *&pCur, size_t &bufferSize, bool bBE) {
+    ai_assert(nullptr != pcElement);
+
+    // a second vertex element is merged vertex by vertex
+    if (nullptr != mGeneratedMesh && nullptr != mGeneratedMesh->mVertices) {
+        return false;
+    }
+
+    // find the property of each channel, the last one wins like in LoadVertex()
+    const PLY::Property *props[NumVertexChannels] = {};
+    unsigned int offsets[NumVertexChannels] = {};
+    unsigned int cnt = 0;
+    for (size_t a = 0; a < pcElement->alProperties.size(); ++a) {
+        const int channel = GetVertexChannel(pcElement->alProperties[a].Semantic);
+        if (channel >= 0) {
+            props[channel] = &pcElement->alProperties[a];
+            offsets[channel] = layout.Offsets[a];
+            ++cnt;
+        }
+    }
+
+    const size_t numVertices = pcElement->NumOccur;
+    if (0 == numVertices) {
+        return true;
+    }
+    const size_t stride = layout.Stride;
+    const bool haveNormal = props[NormalX] || props[NormalY] || props[NormalZ];
+    const bool haveColor = props[ColorR] || props[ColorG] || props[ColorB] || props[ColorA];
+    const bool haveTextureCoords = props[TexCoordU] || props[TexCoordV];
+
+    // point clouds go to the point handler instead of into the mesh
+    bool stream = nullptr != mPointHandler && 0 != cnt;
+    for (const PLY::Element &element : pcDOM->alElements) {
+        if ((element.eSemantic == EEST_Face || element.eSemantic == EEST_TriStrip) && 0 != element.NumOccur) {
+            stream = false;
+        }
+    }
+
+    aiVector3D *positions = nullptr, *normals = nullptr, *textureCoords = nullptr;
+    aiColor4D *colors = nullptr;
+    std::vector<aiVector3D> batchPositions, batchNormals, batchTextureCoords;
+    std::vector<aiColor4D> batchColors;
+    if (stream) {
+        // one batch per thread is in flight at a time
+        const size_t batchSize = std::min(numVertices, static_cast<size_t>(InstancesPerBatch) * mNumThreads);
+        batchPositions.resize(batchSize);
+        positions = batchPositions.data();
+        if (haveNormal) {
+            batchNormals.resize(batchSize);
+            normals = batchNormals.data();
+        }
+        if (haveColor) {
+            batchColors.resize(batchSize);
+            colors = batchColors.data();
+        }
+        if (haveTextureCoords) {
+            batchTextureCoords.resize(batchSize);
+            textureCoords = batchTextureCoords.data();
+        }
+        mPointsStreamed = true;
+    } else if (0 != cnt) {
+        if (nullptr == mGeneratedMesh) {
+            mGeneratedMesh = new aiMesh();
+            mGeneratedMesh->mMaterialIndex = 0;
+        }
+        mGeneratedMesh->mNumVertices = pcElement->NumOccur;
+        positions = mGeneratedMesh->mVertices = new aiVector3D[numVertices];
+        if (haveNormal) {
+            normals = mGeneratedMesh->mNormals = new aiVector3D[numVertices];
+        }
+        if (haveColor) {
+            colors = mGeneratedMesh->mColors[0] = new aiColor4D[numVertices];
+        }
+        if (haveTextureCoords) {
+            mGeneratedMesh->mNumUVComponents[0] = 2;
+            textureCoords = mGeneratedMesh->mTextureCoords[0] = new aiVector3D[numVertices];
+        }
+    }
+
+    // decode the vertices [first, first + count) of the current window,
+    // src points to the first of them and out is its index in the arrays
+    auto decodeBatch = [&](const char *src, unsigned int count, size_t out) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            if (props[PositionX + c]) {
+                DecodeChannel(src + offsets[PositionX + c], stride, count, props[PositionX + c]->eType, bBE, &positions[out].x + c, 3);
+            }
+            if (props[NormalX + c]) {
+                DecodeChannel(src + offsets[NormalX + c], stride, count, props[NormalX + c]->eType, bBE, &normals[out].x + c, 3);
+            }
+        }
+        for (unsigned int c = 0; c < 2; ++c) {
+            if (props[TexCoordU + c]) {
+                DecodeChannel(src + offsets[TexCoordU + c], stride, count, props[TexCoordU + c]->eType, bBE, &textureCoords[out].x + c, 3);
+            }
+        }
+        if (haveColor) {
+            for (unsigned int c = 0; c < 4; ++c) {
+                ai_real *dst = &colors[out].r + c;
+                if (nullptr == props[ColorR + c]) {
+                    // assume 1.0 for the alpha channel if it is not set
+                    for (unsigned int i = 0; i < count; ++i) {
+                        dst[i * 4] = (c == 3) ? 1.0f : 0.0f;
+                    }
+                    continue;
+                }
+                const PLY::EDataType eType = props[ColorR + c]->eType;
+                const char *value = src + offsets[ColorR + c];
+                for (unsigned int i = 0; i < count; ++i, value += stride) {
+                    PLY::PropertyInstance::ValueUnion v;
+                    PLY::PropertyInstance::DecodeValueBinary(value, eType, &v, bBE);
+                    dst[i * 4] = NormalizeColorValue(v, eType);
+                }
+            }
+        }
+    };
+
+    const size_t windowSize = static_cast<size_t>(InstancesPerBatch) * mNumThreads;
+    for (size_t first = 0; first < numVertices;) {
+        const size_t count = std::min(numVertices - first, windowSize);
+        if (!PLY::ElementInstanceList::ReserveBinary(streamBuffer, buffer, pCur, bufferSize, count * stride)) {
+            throw DeadlyImportError("Invalid .ply file: File corrupted");
+        }
+
+        if (0 != cnt) {
+            const unsigned int numBatches = static_cast<unsigned int>((count + InstancesPerBatch - 1) / InstancesPerBatch);
+            const char *window = pCur;
+            ParallelFor(numBatches, mNumThreads, [&](unsigned int b) {
+                const size_t begin = static_cast<size_t>(b) * InstancesPerBatch;
+                const unsigned int batchCount = static_cast<unsigned int>(std::min(count - begin, static_cast<size_t>(InstancesPerBatch)));
+                decodeBatch(window + begin * stride, batchCount, stream ? begin : first + begin);
+            });
+
+            for (unsigned int b = 0; stream && b < numBatches; ++b) {
+                const size_t begin = static_cast<size_t>(b) * InstancesPerBatch;
+                const unsigned int batchCount = static_cast<unsigned int>(std::min(count - begin, static_cast<size_t>(InstancesPerBatch)));
+                if (!mPointHandler->HandleBatch(first + begin, batchCount, positions + begin,
+                            normals ? normals + begin : nullptr, colors ? colors + begin : nullptr,
+                            textureCoords ? textureCoords + begin : nullptr)) {
+                    throw DeadlyImportError("PLY: Loading was aborted by the point batch handler");
+                }
+            }
+        }
+
+        pCur += count * stride;
+        bufferSize -= count * stride;
+        first += count;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLYImporter::LoadTrianglesBinary(const PLY::Element *pcElement,
+        IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char *&pCur, size_t &bufferSize, bool bBE) {
+    ai_assert(nullptr != pcElement);
+
+    if (pcElement->alProperties.size() != 1 || nullptr == mGeneratedMesh || nullptr != mGeneratedMesh->mFaces) {
+        return false;
+    }
+    const PLY::Property &prop = pcElement->alProperties.front();
+    const unsigned int sizeSize = PLY::PropertyInstance::SizeOfBinary(prop.eFirstType);
+    const unsigned int indexSize = PLY::PropertyInstance::SizeOfBinary(prop.eType);
+    if (PLY::EST_VertexIndex != prop.Semantic || !prop.bIsList || 0 == sizeSize || 0 == indexSize) {
+        return false;
+    }
+
+    const size_t numFaces = pcElement->NumOccur;
+    if (0 == numFaces) {
+        return true;
+    }
+    mGeneratedMesh->mNumFaces = pcElement->NumOccur;
+    mGeneratedMesh->mFaces = new aiFace[numFaces];
+
+    // with a face index pool the indices are collected first and the faces
+    // are pointed into the pool once the total count is known
+    std::vector<unsigned int> pooledIndices;
+    if (mPoolFaceIndices) {
+        pooledIndices.reserve(numFaces * 3);
+    }
+
+    // as long as all faces are triangles every face has the same size,
+    // so a window of them can be checked and decoded in parallel
+    const size_t stride = sizeSize + 3 * indexSize;
+    const size_t windowSize = static_cast<size_t>(InstancesPerBatch) * mNumThreads;
+    for (size_t first = 0; first < numFaces;) {
+        const size_t count = std::min(numFaces - first, windowSize);
+        const unsigned int numBatches = static_cast<unsigned int>((count + InstancesPerBatch - 1) / InstancesPerBatch);
+
+        bool triangles = PLY::ElementInstanceList::ReserveBinary(streamBuffer, buffer, pCur, bufferSize, count * stride);
+        if (triangles) {
+            std::vector<char> batchIsTriangles(numBatches, 0);
+            const char *window = pCur;
+            ParallelFor(numBatches, mNumThreads, [&](unsigned int b) {
+                const size_t end = std::min(count, (static_cast<size_t>(b) + 1) * InstancesPerBatch);
+                for (size_t i = static_cast<size_t>(b) * InstancesPerBatch; i < end; ++i) {
+                    if (3 != DecodeIndex(window + i * stride, prop.eFirstType, bBE)) {
+                        return;
+                    }
+                }
+                batchIsTriangles[b] = 1;
+            });
+            triangles = std::find(batchIsTriangles.begin(), batchIsTriangles.end(), 0) == batchIsTriangles.end();
+        }
+
+        if (triangles) {
+            const char *window = pCur;
+            unsigned int *pooled = nullptr;
+            if (mPoolFaceIndices) {
+                const size_t base = pooledIndices.size();
+                pooledIndices.resize(base + count * 3);
+                pooled = pooledIndices.data() + base;
+            }
+            ParallelFor(numBatches, mNumThreads, [&](unsigned int b) {
+                const size_t end = std::min(count, (static_cast<size_t>(b) + 1) * InstancesPerBatch);
+                for (size_t i = static_cast<size_t>(b) * InstancesPerBatch; i < end; ++i) {
+                    const char *src = window + i * stride + sizeSize;
+                    aiFace &face = mGeneratedMesh->mFaces[first + i];
+                    face.mNumIndices = 3;
+                    unsigned int *indices = pooled ? pooled + i * 3 : (face.mIndices = new unsigned int[3]);
+                    for (unsigned int a = 0; a < 3; ++a, src += indexSize) {
+                        indices[a] = DecodeIndex(src, prop.eType, bBE);
+                    }
+                }
+            });
+            pCur += count * stride;
+            bufferSize -= count * stride;
+        } else {
+            // polygons of other sizes, read this window face by face
+            for (size_t i = 0; i < count; ++i) {
+                if (!PLY::ElementInstanceList::ReserveBinary(streamBuffer, buffer, pCur, bufferSize, sizeSize)) {
+                    throw DeadlyImportError("Invalid .ply file: File corrupted");
+                }
+                const unsigned int iNum = DecodeIndex(pCur, prop.eFirstType, bBE);
+                pCur += sizeSize;
+                bufferSize -= sizeSize;
+
+                if (!PLY::ElementInstanceList::ReserveBinary(streamBuffer, buffer, pCur, bufferSize, static_cast<size_t>(iNum) * indexSize)) {
+                    throw DeadlyImportError("Invalid .ply file: File corrupted");
+                }
+                aiFace &face = mGeneratedMesh->mFaces[first + i];
+                face.mNumIndices = iNum;
+                unsigned int *indices;
+                if (mPoolFaceIndices) {
+                    pooledIndices.resize(pooledIndices.size() + iNum);
+                    indices = pooledIndices.data() + pooledIndices.size() - iNum;
+                } else {
+                    indices = face.mIndices = new unsigned int[iNum];
+                }
+                for (unsigned int a = 0; a < iNum; ++a) {
+                    indices[a] = DecodeIndex(pCur, prop.eType, bBE);
+                    pCur += indexSize;
+                }
+                bufferSize -= static_cast<size_t>(iNum) * indexSize;
+            }
+        }
+        first += count;
+    }
+
+    if (mPoolFaceIndices) {
+        mGeneratedMesh->mNumFaceIndices = static_cast<unsigned int>(pooledIndices.size());
+        mGeneratedMesh->mFaceIndices = new unsigned int[pooledIndices.size()];
+        std::copy(pooledIndices.begin(), pooledIndices.end(), mGeneratedMesh->mFaceIndices);
+        unsigned int *indices = mGeneratedMesh->mFaceIndices;
+        for (size_t i = 0; i < numFaces; ++i) {
+            aiFace &face = mGeneratedMesh->mFaces[i];
+            face.mIndices = face.mNumIndices ? indices : nullptr;
+            indices += face.mNumIndices;
+        }
+    }
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Convert a color component to [0...1]
 ai_real PLYImporter::NormalizeColorValue(PLY::PropertyInstance::ValueUnion val, PLY::EDataType eType) {
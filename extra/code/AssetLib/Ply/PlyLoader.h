@@ -57,6 +57,8 @@ struct aiMesh;
 
 namespace Assimp {
 
+class PointBatchHandler;
+
 using namespace PLY;
 
 // ---------------------------------------------------------------------------
@@ -84,6 +86,27 @@ public:
     */
     void LoadFace(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos);
 
+    // -------------------------------------------------------------------
+    /** Extract all vertices of a binary element with a fixed layout.
+     *  Batches of vertices are decoded in parallel and, for point clouds,
+     *  passed to the point batch handler if one is set. Returns false
+     *  without consuming any data if the element has to be read
+     *  vertex by vertex.
+     */
+    bool LoadVerticesBinary(const PLY::Element *pcElement, const PLY::FixedLayout &layout,
+            IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+            const char *&pCur, size_t &bufferSize, bool bBE);
+
+    // -------------------------------------------------------------------
+    /** Extract all faces of a binary element holding nothing but the
+     *  vertex index list. Batches of triangles are decoded in parallel.
+     *  Returns false without consuming any data if the element has to
+     *  be read face by face.
+     */
+    bool LoadTrianglesBinary(const PLY::Element *pcElement,
+            IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+            const char *&pCur, size_t &bufferSize, bool bBE);
+
 protected:
     // -------------------------------------------------------------------
     /** Return importer meta information.
@@ -91,6 +114,12 @@ protected:
      */
     const aiImporterDesc *GetInfo() const override;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ReadFile().
+     *  See BaseImporter::SetupProperties() for details.
+     */
+    void SetupProperties(const Importer *pImp) override;
+
     // -------------------------------------------------------------------
     /** Imports the given file into the given scene structure.
     * See BaseImporter::InternReadFile() for details
@@ -124,6 +153,10 @@ private:
     unsigned char *mBuffer;
     PLY::DOM *pcDOM;
     aiMesh *mGeneratedMesh;
+    unsigned int mNumThreads;
+    bool mPoolFaceIndices;
+    PointBatchHandler *mPointHandler;
+    bool mPointsStreamed;
 };
 
 } // end of namespace Assimp
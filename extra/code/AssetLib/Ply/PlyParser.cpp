@@ -495,7 +495,7 @@ bool PLY::DOM::ParseElementInstanceLists(IOStreamBuffer<char> &streamBuffer, std
 // ------------------------------------------------------------------------------------------------
 bool PLY::DOM::ParseElementInstanceListsBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
         const char *&pCur,
-        unsigned int &bufferSize,
+        size_t &bufferSize,
         PLYImporter *loader,
         bool p_bBE) {
     ASSIMP_LOG_VERBOSE_DEBUG("PLY::DOM::ParseElementInstanceListsBinary() begin");
@@ -533,10 +533,17 @@ bool PLY::DOM::ParseInstanceBinary(IOStreamBuffer<char> &streamBuffer, DOM *p_pc
         return false;
     }
 
-    streamBuffer.getNextBlock(buffer);
-
-    unsigned int bufferSize = static_cast<unsigned int>(buffer.size());
-    const char *pCur = (char *)&buffer[0];
+    // parse a mapped file in place, otherwise block by block
+    const char *pCur = nullptr;
+    size_t bufferSize = 0;
+    const char *mapped = nullptr;
+    if (streamBuffer.getMappedRemainder(mapped, bufferSize)) {
+        pCur = mapped;
+    } else {
+        streamBuffer.getNextBlock(buffer);
+        bufferSize = buffer.size();
+        pCur = (char *)&buffer[0];
+    }
     if (!p_pcOut->ParseElementInstanceListsBinary(streamBuffer, buffer, pCur, bufferSize, loader, p_bBE)) {
         ASSIMP_LOG_VERBOSE_DEBUG("PLY::DOM::ParseInstanceBinary() failure");
         return false;
@@ -624,13 +631,28 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
         IOStreamBuffer<char> &streamBuffer,
         std::vector<char> &buffer,
         const char *&pCur,
-        unsigned int &bufferSize,
+        size_t &bufferSize,
         const PLY::Element *pcElement,
         PLY::ElementInstanceList *p_pcOut,
         PLYImporter *loader,
         bool p_bBE /* = false */) {
     ai_assert(nullptr != pcElement);
 
+    // vertices and faces with a fixed size per instance are decoded as a
+    // whole, without building an element instance for each of them
+    if (nullptr == p_pcOut && nullptr != loader) {
+        PLY::FixedLayout layout;
+        if (pcElement->eSemantic == EEST_Vertex && PLY::FixedLayout::Compile(*pcElement, layout)) {
+            if (loader->LoadVerticesBinary(pcElement, layout, streamBuffer, buffer, pCur, bufferSize, p_bBE)) {
+                return true;
+            }
+        } else if (pcElement->eSemantic == EEST_Face) {
+            if (loader->LoadTrianglesBinary(pcElement, streamBuffer, buffer, pCur, bufferSize, p_bBE)) {
+                return true;
+            }
+        }
+    }
+
     // we can add special handling code for unknown element semantics since
     // we can't skip it as a whole block (we don't know its exact size
     // due to the fact that lists could be contained in the property list
@@ -658,6 +680,50 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool PLY::ElementInstanceList::ReserveBinary(
+        IOStreamBuffer<char> &streamBuffer,
+        std::vector<char> &buffer,
+        const char *&pCur,
+        size_t &bufferSize,
+        size_t numBytes) {
+    if (bufferSize >= numBytes) {
+        return true;
+    }
+
+    // concat the rest of the buffer and as many file blocks as needed
+    std::vector<char> joined(pCur, pCur + bufferSize);
+    std::vector<char> nbuffer;
+    bool ret = true;
+    while (joined.size() < numBytes) {
+        if (!streamBuffer.getNextBlock(nbuffer)) {
+            ret = false;
+            break;
+        }
+        joined.insert(joined.end(), nbuffer.begin(), nbuffer.end());
+    }
+    buffer.swap(joined);
+    bufferSize = buffer.size();
+    pCur = buffer.empty() ? nullptr : (char *)&buffer[0];
+    return ret;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::FixedLayout::Compile(const PLY::Element &element, PLY::FixedLayout &out) {
+    out.Stride = 0;
+    out.Offsets.clear();
+    out.Offsets.reserve(element.alProperties.size());
+    for (const PLY::Property &prop : element.alProperties) {
+        const unsigned int size = PLY::PropertyInstance::SizeOfBinary(prop.eType);
+        if (prop.bIsList || 0 == size) {
+            return false;
+        }
+        out.Offsets.push_back(out.Stride);
+        out.Stride += size;
+    }
+    return 0 != out.Stride;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::ElementInstance::ParseInstance(const char *&pCur, const char *end,
         const PLY::Element *pcElement,
@@ -687,7 +753,7 @@ bool PLY::ElementInstance::ParseInstanceBinary(
         IOStreamBuffer<char> &streamBuffer,
         std::vector<char> &buffer,
         const char *&pCur,
-        unsigned int &bufferSize,
+        size_t &bufferSize,
         const PLY::Element *pcElement,
         PLY::ElementInstance *p_pcOut,
         bool p_bBE /* = false */) {
@@ -751,7 +817,7 @@ bool PLY::PropertyInstance::ParseInstance(const char *&pCur, const char *end, co
 // ------------------------------------------------------------------------------------------------
 bool PLY::PropertyInstance::ParseInstanceBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
         const char *&pCur,
-        unsigned int &bufferSize,
+        size_t &bufferSize,
         const PLY::Property *prop,
         PLY::PropertyInstance *p_pcOut,
         bool p_bBE) {
@@ -848,64 +914,42 @@ bool PLY::PropertyInstance::ParseValue(const char *&pCur,
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
-        std::vector<char> &buffer,
-        const char *&pCur,
-        unsigned int &bufferSize,
-        PLY::EDataType eType,
-        PLY::PropertyInstance::ValueUnion *out,
-        bool p_bBE) {
-    ai_assert(nullptr != out);
-
-    // calc element size
-    unsigned int lsize = 0;
+unsigned int PLY::PropertyInstance::SizeOfBinary(PLY::EDataType eType) {
     switch (eType) {
     case EDT_Char:
     case EDT_UChar:
-        lsize = 1;
-        break;
+        return 1;
 
     case EDT_UShort:
     case EDT_Short:
-        lsize = 2;
-        break;
+        return 2;
 
     case EDT_UInt:
     case EDT_Int:
     case EDT_Float:
-        lsize = 4;
-        break;
+        return 4;
 
     case EDT_Double:
-        lsize = 8;
-        break;
+        return 8;
 
     case EDT_INVALID:
     default:
         break;
     }
+    return 0;
+}
 
-    // read the next file block if needed
-    if (bufferSize < lsize) {
-        std::vector<char> nbuffer;
-        if (streamBuffer.getNextBlock(nbuffer)) {
-            // concat buffer contents
-            buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
-            buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
-            nbuffer.clear();
-            bufferSize = static_cast<unsigned int>(buffer.size());
-            pCur = (char *)&buffer[0];
-        } else {
-            throw DeadlyImportError("Invalid .ply file: File corrupted");
-        }
-    }
+// ------------------------------------------------------------------------------------------------
+void PLY::PropertyInstance::DecodeValueBinary(const char *pCur,
+        PLY::EDataType eType,
+        PLY::PropertyInstance::ValueUnion *out,
+        bool p_bBE) {
+    ai_assert(nullptr != out);
 
-    bool ret = true;
     switch (eType) {
     case EDT_UInt: {
         uint32_t t;
         memcpy(&t, pCur, sizeof(uint32_t));
-        pCur += sizeof(uint32_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -916,7 +960,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_UShort: {
         uint16_t t;
         memcpy(&t, pCur, sizeof(uint16_t));
-        pCur += sizeof(uint16_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -927,7 +970,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_UChar: {
         uint8_t t;
         memcpy(&t, pCur, sizeof(uint8_t));
-        pCur += sizeof(uint8_t);
         out->iUInt = t;
         break;
     }
@@ -935,7 +977,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Int: {
         int32_t t;
         memcpy(&t, pCur, sizeof(int32_t));
-        pCur += sizeof(int32_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -946,7 +987,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Short: {
         int16_t t;
         memcpy(&t, pCur, sizeof(int16_t));
-        pCur += sizeof(int16_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -957,7 +997,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Char: {
         int8_t t;
         memcpy(&t, pCur, sizeof(int8_t));
-        pCur += sizeof(int8_t);
         out->iInt = t;
         break;
     }
@@ -965,7 +1004,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Float: {
         float t;
         memcpy(&t, pCur, sizeof(float));
-        pCur += sizeof(float);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -975,7 +1013,6 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     case EDT_Double: {
         double t;
         memcpy(&t, pCur, sizeof(double));
-        pCur += sizeof(double);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
@@ -983,12 +1020,36 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
         break;
     }
     default:
-        ret = false;
+        break;
     }
+}
 
+// ------------------------------------------------------------------------------------------------
+bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
+        std::vector<char> &buffer,
+        const char *&pCur,
+        size_t &bufferSize,
+        PLY::EDataType eType,
+        PLY::PropertyInstance::ValueUnion *out,
+        bool p_bBE) {
+    ai_assert(nullptr != out);
+
+    // calc element size
+    const unsigned int lsize = SizeOfBinary(eType);
+    if (0 == lsize) {
+        return false;
+    }
+
+    // read the next file block if needed
+    if (!PLY::ElementInstanceList::ReserveBinary(streamBuffer, buffer, pCur, bufferSize, lsize)) {
+        throw DeadlyImportError("Invalid .ply file: File corrupted");
+    }
+
+    DecodeValueBinary(pCur, eType, out, p_bBE);
+    pCur += lsize;
     bufferSize -= lsize;
 
-    return ret;
+    return true;
 }
 
 } // namespace Assimp
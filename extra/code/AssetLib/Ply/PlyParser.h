@@ -288,6 +288,26 @@ public:
     static EElementSemantic ParseSemantic(std::vector<char> &buffer);
 };
 
+// ---------------------------------------------------------------------------------
+/** \brief Binary layout of an element without list properties.
+ *
+ * All instances of such an element have the same size, instance i starts
+ * i * Stride bytes after the first one.
+ */
+class FixedLayout {
+public:
+    //! Size of an instance in bytes
+    unsigned int Stride = 0;
+
+    //! Byte offset of each property within an instance
+    std::vector<unsigned int> Offsets;
+
+    // -------------------------------------------------------------------
+    //! Compute the layout of an element. Returns false if the element
+    //! contains lists or properties of unknown type
+    static bool Compile(const Element &element, FixedLayout &out);
+};
+
 // ---------------------------------------------------------------------------------
 /** \brief Instance of a property in a PLY file
  */
@@ -330,7 +350,7 @@ public:
     // -------------------------------------------------------------------
     //! Parse a property instance in binary format
     static bool ParseInstanceBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
-        const char* &pCur, unsigned int &bufferSize, const Property* prop, PropertyInstance* p_pcOut, bool p_bBE);
+        const char* &pCur, size_t &bufferSize, const Property* prop, PropertyInstance* p_pcOut, bool p_bBE);
 
     // -------------------------------------------------------------------
     //! Get the default value for a given data type
@@ -343,7 +363,16 @@ public:
     // -------------------------------------------------------------------
     //! Parse a binary value
     static bool ParseValueBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
-        const char* &pCur, unsigned int &bufferSize, EDataType eType, ValueUnion* out, bool p_bBE);
+        const char* &pCur, size_t &bufferSize, EDataType eType, ValueUnion* out, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Size of a binary value in bytes, 0 for invalid types
+    static unsigned int SizeOfBinary(EDataType eType);
+
+    // -------------------------------------------------------------------
+    //! Decode a binary value from memory holding at least
+    //! SizeOfBinary(eType) bytes
+    static void DecodeValueBinary(const char *pCur, EDataType eType, ValueUnion *out, bool p_bBE);
 
     // -------------------------------------------------------------------
     //! Convert a property value to a given type TYPE
@@ -370,7 +399,7 @@ public:
     // -------------------------------------------------------------------
     //! Parse a binary element instance
     static bool ParseInstanceBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
-        const char* &pCur, unsigned int &bufferSize, const Element* pcElement, ElementInstance* p_pcOut, bool p_bBE);
+        const char* &pCur, size_t &bufferSize, const Element* pcElement, ElementInstance* p_pcOut, bool p_bBE);
 };
 
 // ---------------------------------------------------------------------------------
@@ -394,7 +423,14 @@ public:
     // -------------------------------------------------------------------
     //! Parse a binary element instance list
     static bool ParseInstanceListBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
-        const char* &pCur, unsigned int &bufferSize, const Element* pcElement, ElementInstanceList* p_pcOut, PLYImporter* loader, bool p_bBE);
+        const char* &pCur, size_t &bufferSize, const Element* pcElement, ElementInstanceList* p_pcOut, PLYImporter* loader, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Make sure that at least numBytes bytes are available at pCur,
+    //! reading further blocks of the file if needed. Returns false
+    //! if the file ends before
+    static bool ReserveBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char* &pCur, size_t &bufferSize, size_t numBytes);
 };
 // ---------------------------------------------------------------------------------
 /** \brief Class to represent the document object model of an ASCII or binary
@@ -441,7 +477,7 @@ private:
 
     // -------------------------------------------------------------------
     //! Read in all element instance lists for a binary file format
-    bool ParseElementInstanceListsBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer, const char* &pCur, unsigned int &bufferSize, PLYImporter* loader, bool p_bBE);
+    bool ParseElementInstanceListsBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer, const char* &pCur, size_t &bufferSize, PLYImporter* loader, bool p_bBE);
 };
 
 // ---------------------------------------------------------------------------------
@@ -50,6 +50,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include "Common/ParallelFor.h"
+#include "Common/FaceIndexAllocator.h"
+
+#include <algorithm>
 #include <memory>
 
 namespace Assimp {
@@ -81,11 +87,118 @@ static bool IsBinarySTL(const char *buffer, size_t fileSize) {
     const char *facecount_pos = buffer + 80;
     uint32_t faceCount(0);
     ::memcpy(&faceCount, facecount_pos, sizeof(uint32_t));
-    const uint32_t expectedBinaryFileSize = faceCount * 50 + 84;
+    const uint64_t expectedBinaryFileSize = faceCount * 50ull + 84ull;
 
     return expectedBinaryFileSize == fileSize;
 }
 
+// Size of a binary facet: normal, three corners and the attribute word
+static constexpr size_t FacetSize = 50;
+
+// Facets converted by one work item of the binary reader
+static constexpr unsigned int FacetsPerChunk = 1u << 16;
+
+// Bit 15 of the attribute word marks a facet color
+static constexpr uint16_t FacetColorFlag = 1u << 15;
+
+static uint16_t ReadFacetAttribute(const unsigned char *facet) {
+    uint16_t attribute;
+    ::memcpy(&attribute, facet + 48, sizeof(uint16_t));
+    return attribute;
+}
+
+static aiColor4D DecodeFacetColor(uint16_t color, bool bIsMaterialise, const aiColor4D &defaultColor) {
+    if (!(color & FacetColorFlag)) {
+        return defaultColor;
+    }
+    aiColor4D clr;
+    clr.a = 1.0;
+    const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
+    if (bIsMaterialise) // this is reversed
+    {
+        clr.r = (color & 0x1fu) * invVal;
+        clr.g = ((color & (0x1fu << 5)) >> 5u) * invVal;
+        clr.b = ((color & (0x1fu << 10)) >> 10u) * invVal;
+    } else {
+        clr.b = (color & 0x1fu) * invVal;
+        clr.g = ((color & (0x1fu << 5)) >> 5u) * invVal;
+        clr.r = ((color & (0x1fu << 10)) >> 10u) * invVal;
+    }
+    return clr;
+}
+
+static uint32_t HashFloat(float v) {
+    // 0 and -0 are equal, they need the same hash
+    if (v == 0.0f) {
+        v = 0.0f;
+    }
+    uint32_t bits;
+    ::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+// Open addressing table of corner positions, used to weld binary facets. It is
+// sized once for an upper bound of the positions it will see and never grows.
+class CornerTable {
+public:
+    explicit CornerTable(size_t maxPositions) {
+        size_t capacity = 16;
+        while (capacity < maxPositions * 2) {
+            capacity <<= 1;
+        }
+        mSlots.resize(capacity);
+        mMask = capacity - 1;
+    }
+
+    // Returns the index of pos in positions, appends it first if it is new
+    unsigned int Insert(const aiVector3f &pos, std::vector<aiVector3f> &positions, bool &inserted) {
+        uint32_t hash = HashFloat(pos.x) * 0x9e3779b1u;
+        hash = (hash ^ HashFloat(pos.y)) * 0x85ebca6bu;
+        hash = (hash ^ HashFloat(pos.z)) * 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+
+        for (size_t i = hash & mMask;; i = (i + 1) & mMask) {
+            Slot &slot = mSlots[i];
+            if (slot.index == Empty) {
+                slot.hash = hash;
+                slot.index = static_cast<unsigned int>(positions.size());
+                positions.push_back(pos);
+                inserted = true;
+                return slot.index;
+            }
+            if (slot.hash == hash && positions[slot.index] == pos) {
+                inserted = false;
+                return slot.index;
+            }
+        }
+    }
+
+private:
+    static constexpr unsigned int Empty = ~0u;
+
+    struct Slot {
+        uint32_t hash = 0;
+        unsigned int index = Empty;
+    };
+
+    std::vector<Slot> mSlots;
+    size_t mMask;
+};
+
+// Corners of one chunk of facets, welded among themselves
+struct WeldedChunk {
+    std::vector<aiVector3f> positions;
+    std::vector<aiVector3f> normals;    // sum of the facet normals
+    std::vector<uint16_t> attributes;   // of the first facet using the corner
+    std::vector<unsigned int> indices;  // three per facet, into positions
+    std::vector<unsigned int> remap;    // chunk position -> mesh vertex
+    bool hasColors = false;
+};
+
 static const size_t BufferSize = 500;
 static const char UnicodeBoundary = 127;
 
@@ -128,7 +241,10 @@ static bool IsAsciiSTL(const char *buffer, size_t fileSize) {
 STLImporter::STLImporter() :
         mBuffer(),
         mFileSize(0),
-        mScene() {
+        mScene(),
+        mWeldVertices(false),
+        mNumThreads(1),
+        mPoolFaceIndices(false) {
     // empty
 }
 
@@ -148,16 +264,26 @@ const aiImporterDesc *STLImporter::GetInfo() const {
     return &desc;
 }
 
-void addFacesToMesh(aiMesh *pMesh) {
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties
+void STLImporter::SetupProperties(const Importer *pImp) {
+    mWeldVertices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, false);
+    mNumThreads = GetNumThreads(pImp->GetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 1));
+    mPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FACE_INDEX_POOL, false);
+}
+
+void addFacesToMesh(aiMesh *pMesh, bool pooled) {
     pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    FaceIndexAllocator faceIndices(pooled, pMesh->mNumFaces * size_t(3));
     for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i) {
 
         aiFace &face = pMesh->mFaces[i];
-        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        face.mIndices = faceIndices.Allocate(face.mNumIndices = 3);
         for (unsigned int o = 0; o < 3; ++o, ++p) {
             face.mIndices[o] = p;
         }
     }
+    faceIndices.Attach(pMesh);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -172,13 +298,18 @@ void STLImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 
     mFileSize = file->FileSize();
 
-    // allocate storage and copy the contents of the file to a memory buffer
-    // (terminate it with zero)
+    // binary files are parsed straight from a mapped stream, everything else
+    // is copied to a memory buffer (terminated with zero)
     std::vector<char> buffer2;
-    TextFileToBuffer(file.get(), buffer2);
+    const char *mapped = reinterpret_cast<const char *>(file->GetMappedData());
+    if (nullptr != mapped && IsBinarySTL(mapped, mFileSize)) {
+        mBuffer = mapped;
+    } else {
+        TextFileToBuffer(file.get(), buffer2);
+        mBuffer = &buffer2[0];
+    }
 
     mScene = pScene;
-    mBuffer = &buffer2[0];
 
     // the default vertex color is light gray.
     mClrColorDefault.r = mClrColorDefault.g = mClrColorDefault.b = mClrColorDefault.a = 0.6f;
@@ -375,7 +506,7 @@ void STLImporter::LoadASCIIFile(aiNode *root) {
         }
 
         // now copy faces
-        addFacesToMesh(pMesh);
+        addFacesToMesh(pMesh, mPoolFaceIndices);
 
         // assign the meshes to the current node
         pushMeshesToNode(meshIndices, node);
@@ -445,91 +576,72 @@ bool STLImporter::LoadBinaryFile() {
         throw DeadlyImportError("STL: file is empty. There are no facets defined");
     }
 
-    pMesh->mNumVertices = pMesh->mNumFaces * 3;
-
-    aiVector3D *vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-    aiVector3D *vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
+    const unsigned char *facets = sz;
+    const unsigned int numChunks = (pMesh->mNumFaces + FacetsPerChunk - 1) / FacetsPerChunk;
+    bool hasColors = false;
 
-    aiVector3f *theVec;
-    aiVector3f theVec3F;
+    if (mWeldVertices) {
+        hasColors = LoadBinaryFacetsWelded(pMesh, facets, bIsMaterialise);
+    } else {
+        pMesh->mNumVertices = pMesh->mNumFaces * 3;
+        aiVector3D *vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+        aiVector3D *vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        // Facets are independent, every chunk writes its own range of the arrays.
         // NOTE: Blender sometimes writes empty normals ... this is not
         // our fault ... the RemoveInvalidData helper step should fix that
+        std::vector<char> chunkHasColors(numChunks, 0);
+        ParallelFor(numChunks, mNumThreads, [&](unsigned int chunk) {
+            const unsigned int begin = chunk * FacetsPerChunk;
+            const unsigned int end = std::min(begin + FacetsPerChunk, pMesh->mNumFaces);
+            uint16_t attributes = 0;
+            for (unsigned int i = begin; i < end; ++i) {
+                const unsigned char *facet = facets + i * FacetSize;
+                aiVector3f normal;
+                ::memcpy(&normal, facet, sizeof(aiVector3f));
+
+                // There's one normal for the face in the STL; use it three times
+                // for vertex normals
+#ifdef ASSIMP_DOUBLE_PRECISION
+                aiVector3f corners[3];
+                ::memcpy(corners, facet + 12, sizeof(corners));
+                for (unsigned int c = 0; c < 3; ++c) {
+                    vp[i * 3 + c] = aiVector3D(corners[c].x, corners[c].y, corners[c].z);
+                    vn[i * 3 + c] = aiVector3D(normal.x, normal.y, normal.z);
+                }
+#else
+                // the three corners are stored exactly like three aiVector3D
+                ::memcpy(&vp[i * 3], facet + 12, 3 * sizeof(aiVector3f));
+                vn[i * 3] = vn[i * 3 + 1] = vn[i * 3 + 2] = normal;
+#endif
+                attributes |= ReadFacetAttribute(facet);
+            }
+            chunkHasColors[chunk] = (attributes & FacetColorFlag) != 0;
+        });
+        hasColors = std::find(chunkHasColors.begin(), chunkHasColors.end(), 1) != chunkHasColors.end();
 
-        // There's one normal for the face in the STL; use it three times
-        // for vertex normals
-        theVec = (aiVector3f *)sz;
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3f));
-        vn->x = theVec3F.x;
-        vn->y = theVec3F.y;
-        vn->z = theVec3F.z;
-        *(vn + 1) = *vn;
-        *(vn + 2) = *vn;
-        ++theVec;
-        vn += 3;
-
-        // vertex 1
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3f));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 2
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3f));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 3
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3f));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        sz = (const unsigned char *)theVec;
-
-        uint16_t color = *((uint16_t *)sz);
-        sz += 2;
-
-        if (color & (1 << 15)) {
+        if (hasColors) {
             // seems we need to take the color
-            if (!pMesh->mColors[0]) {
-                pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int j = 0; j < pMesh->mNumVertices; ++j) {
-                    *pMesh->mColors[0]++ = mClrColorDefault;
+            aiColor4D *colors = pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+            ParallelFor(numChunks, mNumThreads, [&](unsigned int chunk) {
+                const unsigned int begin = chunk * FacetsPerChunk;
+                const unsigned int end = std::min(begin + FacetsPerChunk, pMesh->mNumFaces);
+                for (unsigned int i = begin; i < end; ++i) {
+                    const uint16_t color = ReadFacetAttribute(facets + i * FacetSize);
+                    // assign the color to all vertices of the face
+                    colors[i * 3] = colors[i * 3 + 1] = colors[i * 3 + 2] =
+                            DecodeFacetColor(color, bIsMaterialise, mClrColorDefault);
                 }
-                pMesh->mColors[0] -= pMesh->mNumVertices;
-
-                ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
-            }
-            aiColor4D *clr = &pMesh->mColors[0][i * 3];
-            clr->a = 1.0;
-            const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x1fu) * invVal;
-                clr->g = ((color & (0x1fu << 5)) >> 5u) * invVal;
-                clr->b = ((color & (0x1fu << 10)) >> 10u) * invVal;
-            } else {
-                clr->b = (color & 0x1fu) * invVal;
-                clr->g = ((color & (0x1fu << 5)) >> 5u) * invVal;
-                clr->r = ((color & (0x1fu << 10)) >> 10u) * invVal;
-            }
-            // assign the color to all vertices of the face
-            *(clr + 1) = *clr;
-            *(clr + 2) = *clr;
+            });
         }
+
+        // now copy faces
+        addFacesToMesh(pMesh, mPoolFaceIndices);
     }
 
-    // now copy faces
-    addFacesToMesh(pMesh);
+    if (hasColors) {
+        ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+    }
 
     aiNode *root = mScene->mRootNode;
 
@@ -555,6 +667,115 @@ bool STLImporter::LoadBinaryFile() {
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Read the facets of a binary STL file into an indexed mesh. Every chunk of facets is welded on
+// its own in parallel, the chunks are then merged in order, so vertices are numbered by their
+// first use just like a serial weld and the result does not depend on the number of threads.
+bool STLImporter::LoadBinaryFacetsWelded(aiMesh *pMesh, const unsigned char *facets, bool bIsMaterialise) {
+    const unsigned int numChunks = (pMesh->mNumFaces + FacetsPerChunk - 1) / FacetsPerChunk;
+    std::vector<WeldedChunk> chunks(numChunks);
+    ParallelFor(numChunks, mNumThreads, [&](unsigned int c) {
+        WeldedChunk &chunk = chunks[c];
+        const unsigned int begin = c * FacetsPerChunk;
+        const unsigned int end = std::min(begin + FacetsPerChunk, pMesh->mNumFaces);
+        CornerTable table((end - begin) * 3);
+        chunk.indices.resize((end - begin) * 3);
+        uint16_t allAttributes = 0;
+        for (unsigned int i = begin; i < end; ++i) {
+            const unsigned char *facet = facets + i * FacetSize;
+            aiVector3f normal, corners[3];
+            ::memcpy(&normal, facet, sizeof(aiVector3f));
+            ::memcpy(corners, facet + 12, sizeof(corners));
+            const uint16_t attribute = ReadFacetAttribute(facet);
+            allAttributes |= attribute;
+
+            for (unsigned int k = 0; k < 3; ++k) {
+                bool inserted;
+                const unsigned int index = table.Insert(corners[k], chunk.positions, inserted);
+                if (inserted) {
+                    chunk.normals.push_back(normal);
+                    chunk.attributes.push_back(attribute);
+                } else {
+                    chunk.normals[index] += normal;
+                }
+                chunk.indices[(i - begin) * 3 + k] = index;
+            }
+        }
+        chunk.hasColors = (allAttributes & FacetColorFlag) != 0;
+    });
+
+    // merge the chunks in order
+    size_t maxVertices = 0;
+    bool hasColors = false;
+    for (const WeldedChunk &chunk : chunks) {
+        maxVertices += chunk.positions.size();
+        hasColors |= chunk.hasColors;
+    }
+    CornerTable table(maxVertices);
+    std::vector<aiVector3f> positions, normals;
+    std::vector<uint16_t> attributes;
+    positions.reserve(maxVertices);
+    for (WeldedChunk &chunk : chunks) {
+        chunk.remap.resize(chunk.positions.size());
+        for (size_t i = 0; i < chunk.positions.size(); ++i) {
+            bool inserted;
+            const unsigned int index = table.Insert(chunk.positions[i], positions, inserted);
+            if (inserted) {
+                normals.push_back(chunk.normals[i]);
+                attributes.push_back(chunk.attributes[i]);
+            } else {
+                normals[index] += chunk.normals[i];
+            }
+            chunk.remap[i] = index;
+        }
+        std::vector<aiVector3f>().swap(chunk.positions);
+        std::vector<aiVector3f>().swap(chunk.normals);
+    }
+
+    pMesh->mNumVertices = static_cast<unsigned int>(positions.size());
+    pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+    pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
+    if (hasColors) {
+        pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+    }
+    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+    if (mPoolFaceIndices) {
+        pMesh->mNumFaceIndices = pMesh->mNumFaces * 3;
+        pMesh->mFaceIndices = new unsigned int[pMesh->mNumFaceIndices];
+    }
+
+    // the faces of a chunk and a range of vertices per work item
+    const size_t verticesPerChunk = (positions.size() + numChunks - 1) / numChunks;
+    ParallelFor(numChunks, mNumThreads, [&](unsigned int c) {
+        const WeldedChunk &chunk = chunks[c];
+        const unsigned int begin = c * FacetsPerChunk;
+        for (size_t i = 0; i < chunk.indices.size() / 3; ++i) {
+            aiFace &face = pMesh->mFaces[begin + i];
+            face.mNumIndices = 3;
+            face.mIndices = pMesh->mFaceIndices ? pMesh->mFaceIndices + (begin + i) * 3 : new unsigned int[3];
+            for (unsigned int k = 0; k < 3; ++k) {
+                face.mIndices[k] = chunk.remap[chunk.indices[i * 3 + k]];
+            }
+        }
+
+        const size_t vertexBegin = std::min(c * verticesPerChunk, positions.size());
+        const size_t vertexEnd = std::min(vertexBegin + verticesPerChunk, positions.size());
+        for (size_t v = vertexBegin; v < vertexEnd; ++v) {
+            pMesh->mVertices[v] = aiVector3D(positions[v].x, positions[v].y, positions[v].z);
+            // the normalized sum of the facet normals, empty normals stay empty
+            aiVector3D normal(normals[v].x, normals[v].y, normals[v].z);
+            const ai_real length = normal.Length();
+            pMesh->mNormals[v] = length > ai_real(0.0) ? normal / length : normal;
+            if (hasColors) {
+                pMesh->mColors[0][v] = DecodeFacetColor(attributes[v], bIsMaterialise, mClrColorDefault);
+            }
+        }
+    });
+
+    ASSIMP_LOG_DEBUG("STL: welded ", pMesh->mNumFaces * 3, " corners to ", pMesh->mNumVertices, " vertices");
+    return hasColors;
+}
+
 void STLImporter::pushMeshesToNode(std::vector<unsigned int> &meshIndices, aiNode *node) {
     ai_assert(nullptr != node);
     if (meshIndices.empty()) {
@@ -83,6 +83,12 @@ protected:
      */
     const aiImporterDesc* GetInfo () const override;
 
+    /**
+     * @brief   Called prior to ReadFile().
+     *  See BaseImporter::SetupProperties() for details.
+     */
+    void SetupProperties(const Importer* pImp) override;
+
     /**
      * @brief   Imports the given file into the given scene structure.
     * See BaseImporter::InternReadFile() for details
@@ -96,6 +102,13 @@ protected:
      */
     bool LoadBinaryFile();
 
+    /**
+     * @brief   Reads the facets of a binary .stl file into an indexed mesh,
+     *  merging corners with identical positions
+     * @return true if the file has per-facet colors
+     */
+    bool LoadBinaryFacetsWelded(aiMesh *pMesh, const unsigned char *facets, bool bIsMaterialise);
+
     /**
      * @brief   Loads a ASCII text .stl file
      */
@@ -116,6 +129,15 @@ protected:
 
     /** Default vertex color */
     aiColor4D mClrColorDefault;
+
+    /** Merge identical corners of binary files, see #AI_CONFIG_IMPORT_STL_WELD_VERTICES */
+    bool mWeldVertices;
+
+    /** Threads used to convert binary facets, see #AI_CONFIG_PP_NUM_THREADS */
+    unsigned int mNumThreads;
+
+    /** Allocate the face indices of a mesh at once, see #AI_CONFIG_IMPORT_FACE_INDEX_POOL */
+    bool mPoolFaceIndices;
 };
 
 } // end of namespace Assimp
@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *   KHR_materials_ior full
  *   KHR_materials_emissive_strength full
  *   KHR_materials_anisotropy full
+ *   EXT_meshopt_compression full
  */
 #ifndef GLTF2ASSET_H_INC
 #define GLTF2ASSET_H_INC
@@ -68,6 +69,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // clang-format off
@@ -120,6 +122,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/GltfMaterial.h>
 
 #include "AssetLib/glTFCommon/glTFCommon.h"
+#include "AssetLib/glTF2/glTF2MeshoptDecoder.h"
 
 namespace glTF2 {
 
@@ -484,7 +487,9 @@ public:
 
 private:
     shared_ptr<uint8_t> mData; //!< Pointer to the data
+    shared_ptr<const uint8_t> mMappedData; //!< Read-only data of a memory mapped stream, kept open by the deleter
     bool mIsSpecial; //!< Set to true for special cases (e.g. the body buffer)
+    bool mIsFallback; //!< Set to true for EXT_meshopt_compression fallback buffers
 
     /// \var EncodedRegion_List
     /// List of encoded regions.
@@ -498,7 +503,9 @@ public:
 
     void Read(Value &obj, Asset &r);
 
-    bool LoadFromStream(IOStream &stream, size_t length = 0, size_t baseOffset = 0);
+    /// Reads the buffer from the stream. A memory mapped stream is not
+    /// copied, the buffer keeps the stream open and points into it.
+    bool LoadFromStream(const std::shared_ptr<IOStream> &stream, size_t length = 0, size_t baseOffset = 0);
 
     /// \fn void EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
     /// Mark region of "bufferView" as encoded. When data is request from such region then "bufferView" use decoded data.
@@ -527,10 +534,23 @@ public:
     size_t AppendData(uint8_t *data, size_t length);
     void Grow(size_t amount);
 
-    uint8_t *GetPointer() { return mData.get(); }
+    /// Allocates zeroed data for a fallback buffer, which has none until
+    /// its compressed buffer views are known.
+    void AllocateFallback(size_t length);
+
+    /// Returns writable data. A buffer which aliases a mapped stream
+    /// copies the data first, the mapping itself is never written.
+    inline uint8_t *GetPointer();
+
+    /// Returns the data for reading, without copying a mapping.
+    const uint8_t *GetData() const { return mMappedData ? mMappedData.get() : mData.get(); }
 
     void MarkAsSpecial() { mIsSpecial = true; }
 
+    /// Returns true for an EXT_meshopt_compression fallback buffer, which has
+    /// no data of its own and receives the decoded buffer views.
+    bool IsFallback() const { return mIsFallback; }
+
     bool IsSpecial() const override { return mIsSpecial; }
 
     std::string GetURI() { return std::string(this->id) + ".bin"; }
@@ -548,7 +568,10 @@ struct BufferView : public Object {
     BufferViewTarget target; //! The target that the WebGL buffer should be bound to.
 
     void Read(Value &obj, Asset &r);
-    uint8_t *GetPointerAndTailSize(size_t accOffset, size_t& outTailSize);
+    const uint8_t *GetPointerAndTailSize(size_t accOffset, size_t& outTailSize);
+
+private:
+    void ReadMeshoptExtension(Value &ext, Asset &r);
 };
 
 //! A typed view into a BufferView. A BufferView contains raw binary data.
@@ -571,7 +594,7 @@ struct Accessor : public Object {
     unsigned int GetBytesPerComponent();
     unsigned int GetElementSize();
 
-    inline uint8_t *GetPointer();
+    inline const uint8_t *GetPointer();
     inline size_t GetStride();
     inline size_t GetMaxByteSize();
 
@@ -592,7 +615,7 @@ struct Accessor : public Object {
         Accessor &accessor;
 
     private:
-        uint8_t *data;
+        const uint8_t *data;
         size_t elemSize, stride;
 
         Indexer(Accessor &acc);
@@ -607,6 +630,10 @@ struct Accessor : public Object {
             return GetValue<unsigned int>(i);
         }
 
+        //! Accesses the values [0, count) at once, with one range check
+        //! instead of one per value
+        void GetUInts(size_t count, unsigned int *out);
+
         inline bool IsValid() const {
             return data != nullptr;
         }
@@ -1128,6 +1155,8 @@ class Asset {
     template <class T>
     friend class LazyDict;
     friend struct Buffer; // To access OpenFile
+    friend struct BufferView; // To queue compressed buffer views
+    friend struct Mesh; // To queue Draco compressed primitives
     friend class AssetWriter;
 
     std::vector<LazyDictBase *> mDicts;
@@ -1150,6 +1179,7 @@ public:
         bool KHR_draco_mesh_compression;
         bool FB_ngon_encoding;
         bool KHR_texture_basisu;
+        bool EXT_meshopt_compression;
 
         Extensions() :
                 KHR_materials_pbrSpecularGlossiness(false),
@@ -1166,7 +1196,8 @@ public:
                 KHR_materials_anisotropy(false),
                 KHR_draco_mesh_compression(false),
                 FB_ngon_encoding(false),
-                KHR_texture_basisu(false) {
+                KHR_texture_basisu(false),
+                EXT_meshopt_compression(false) {
             // empty
         }
     } extensionsUsed;
@@ -1175,8 +1206,9 @@ public:
     struct RequiredExtensions {
         bool KHR_draco_mesh_compression;
         bool KHR_texture_basisu;
+        bool EXT_meshopt_compression;
 
-        RequiredExtensions() : KHR_draco_mesh_compression(false), KHR_texture_basisu(false) {
+        RequiredExtensions() : KHR_draco_mesh_compression(false), KHR_texture_basisu(false), EXT_meshopt_compression(false) {
             // empty
         }
     } extensionsRequired;
@@ -1243,6 +1275,9 @@ public:
 
     Ref<Buffer> GetBodyBuffer() { return mBodyBuffer; }
 
+    //! Sets the number of threads used to decode compressed data
+    void SetNumThreads(unsigned int numThreads) { mNumThreads = numThreads; }
+
     Asset(Asset &) = delete;
     Asset &operator=(const Asset &) = delete;
 
@@ -1257,11 +1292,49 @@ private:
     void ReadExtensionsUsed(Document &doc);
     void ReadExtensionsRequired(Document &doc);
 
+    /// Decodes all EXT_meshopt_compression buffer views into their fallback buffers.
+    void DecodeMeshoptBufferViews(Document &doc);
+
+#ifdef ASSIMP_ENABLE_DRACO
+    /// Decodes all primitives queued by Mesh::Read and redirects their accessors.
+    void DecodeDracoPrimitives();
+#endif
+
     IOStream *OpenFile(const std::string &path, const char *mode, bool absolute = false);
 
 private:
+    //! A buffer view compressed with EXT_meshopt_compression
+    struct MeshoptBufferView {
+        std::string id;
+        Ref<Buffer> buffer; //!< Fallback buffer which receives the decoded data
+        size_t byteOffset;
+        const uint8_t *data;
+        size_t length;
+        size_t count;
+        size_t byteStride;
+        Meshopt::Mode mode;
+        Meshopt::Filter filter;
+    };
+
+#ifdef ASSIMP_ENABLE_DRACO
+    //! A primitive compressed with KHR_draco_mesh_compression
+    struct DracoPrimitive {
+        const uint8_t *data;
+        size_t length;
+        std::string meshName;
+        unsigned int primitiveIndex;
+        Accessor *indices;
+        std::vector<std::pair<uint32_t, Accessor *>> attributes; //!< Draco attribute id and target accessor
+    };
+#endif
+
     IOSystem *mIOSystem;
     rapidjson::IRemoteSchemaDocumentProvider *mSchemaDocumentProvider;
+    unsigned int mNumThreads = 1;
+    std::vector<MeshoptBufferView> mMeshoptBufferViews;
+#ifdef ASSIMP_ENABLE_DRACO
+    std::vector<DracoPrimitive> mDracoPrimitives;
+#endif
     std::string mCurrentAssetDir;
     size_t mSceneLength;
     size_t mBodyOffset;
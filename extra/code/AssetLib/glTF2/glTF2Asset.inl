@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AssetLib/glTFCommon/glTFCommon.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/StringUtils.h>
@@ -173,6 +174,49 @@ inline void CopyData(size_t count, const uint8_t *src, size_t src_stride,
     }
 }
 
+// Copies count elements of N bytes each. With N known at compile time the
+// copies are inlined into plain (vector) loads and stores.
+template <size_t N>
+inline void CopyElements(size_t count, const uint8_t *src, size_t src_stride,
+        uint8_t *dst, size_t dst_stride) {
+    for (size_t i = 0; i < count; ++i, src += src_stride, dst += dst_stride) {
+        memcpy(dst, src, N);
+    }
+}
+
+template <size_t N>
+inline void GatherElements(size_t count, const uint8_t *src, size_t src_stride,
+        const unsigned int *indices, uint8_t *dst, size_t dst_stride) {
+    for (size_t i = 0; i < count; ++i, dst += dst_stride) {
+        memcpy(dst, src + indices[i] * src_stride, N);
+    }
+}
+
+// Copies count elements of elem_size bytes, element i comes from src + i * src_stride,
+// or src + indices[i] * src_stride if indices are given
+inline void CopyElements(size_t count, const uint8_t *src, size_t src_stride, size_t elem_size,
+        const unsigned int *indices, uint8_t *dst, size_t dst_stride) {
+    switch (elem_size) {
+    case 4:
+        indices ? GatherElements<4>(count, src, src_stride, indices, dst, dst_stride) : CopyElements<4>(count, src, src_stride, dst, dst_stride);
+        return;
+    case 8:
+        indices ? GatherElements<8>(count, src, src_stride, indices, dst, dst_stride) : CopyElements<8>(count, src, src_stride, dst, dst_stride);
+        return;
+    case 12:
+        indices ? GatherElements<12>(count, src, src_stride, indices, dst, dst_stride) : CopyElements<12>(count, src, src_stride, dst, dst_stride);
+        return;
+    case 16:
+        indices ? GatherElements<16>(count, src, src_stride, indices, dst, dst_stride) : CopyElements<16>(count, src, src_stride, dst, dst_stride);
+        return;
+    default:
+        break;
+    }
+    for (size_t i = 0; i < count; ++i, dst += dst_stride) {
+        memcpy(dst, src + (indices ? indices[i] : i) * src_stride, elem_size);
+    }
+}
+
 void SetVector(vec4 &v, const float (&in)[4]) {
     v[0] = in[0];
     v[1] = in[1];
@@ -280,12 +324,12 @@ inline void CopyFaceIndex_Draco(Buffer &decodedIndexBuffer, const draco::Mesh &d
     }
 }
 
-inline void SetDecodedIndexBuffer_Draco(const draco::Mesh &dracoMesh, Mesh::Primitive &prim) {
-    if (!prim.indices || dracoMesh.num_faces() == 0)
-        return;
+inline std::unique_ptr<Buffer> DecodeIndexBuffer_Draco(const draco::Mesh &dracoMesh, Accessor *indices) {
+    if (indices == nullptr || dracoMesh.num_faces() == 0)
+        return nullptr;
 
     // Create a decoded Index buffer (if there is one)
-    size_t componentBytes = prim.indices->GetBytesPerComponent();
+    size_t componentBytes = indices->GetBytesPerComponent();
 
     std::unique_ptr<Buffer> decodedIndexBuffer(new Buffer());
     decodedIndexBuffer->Grow(dracoMesh.num_faces() * 3 * componentBytes);
@@ -295,9 +339,7 @@ inline void SetDecodedIndexBuffer_Draco(const draco::Mesh &dracoMesh, Mesh::Prim
     // Usually uint32_t but shouldn't assume
     if (sizeof(dracoMesh.face(draco::FaceIndex(0))[0]) == componentBytes) {
         memcpy(decodedIndexBuffer->GetPointer(), &dracoMesh.face(draco::FaceIndex(0))[0], decodedIndexBuffer->byteLength);
-        // Assign this alternate data buffer to the accessor
-        prim.indices->decodedBuffer.swap(decodedIndexBuffer);
-        return;
+        return decodedIndexBuffer;
     }
 
     // Not same size, convert
@@ -316,14 +358,48 @@ inline void SetDecodedIndexBuffer_Draco(const draco::Mesh &dracoMesh, Mesh::Prim
         break;
     }
 
-    // Assign this alternate data buffer to the accessor
-    prim.indices->decodedBuffer.swap(decodedIndexBuffer);
+    return decodedIndexBuffer;
 }
 
+template <typename T>
+inline draco::DataType DataType_Draco();
+template <>
+inline draco::DataType DataType_Draco<int8_t>() { return draco::DT_INT8; }
+template <>
+inline draco::DataType DataType_Draco<uint8_t>() { return draco::DT_UINT8; }
+template <>
+inline draco::DataType DataType_Draco<int16_t>() { return draco::DT_INT16; }
+template <>
+inline draco::DataType DataType_Draco<uint16_t>() { return draco::DT_UINT16; }
+template <>
+inline draco::DataType DataType_Draco<uint32_t>() { return draco::DT_UINT32; }
+template <>
+inline draco::DataType DataType_Draco<float>() { return draco::DT_FLOAT32; }
+
 template <typename T>
 static bool GetAttributeForAllPoints_Draco(const draco::Mesh &dracoMesh,
         const draco::PointAttribute &dracoAttribute,
         Buffer &outBuffer) {
+    const size_t elementBytes = sizeof(T) * dracoAttribute.num_components();
+    const size_t numPoints = dracoMesh.num_points();
+    uint8_t *out = outBuffer.GetPointer();
+
+    // Values which are already stored as T are copied without conversion,
+    // as a single block if every point has its own value
+    if (dracoAttribute.data_type() == DataType_Draco<T>() && static_cast<size_t>(dracoAttribute.byte_stride()) == elementBytes) {
+        if (numPoints == 0) {
+            return true;
+        }
+        if (dracoAttribute.is_mapping_identity() && dracoAttribute.size() >= numPoints) {
+            memcpy(out, dracoAttribute.GetAddress(draco::AttributeValueIndex(0)), numPoints * elementBytes);
+            return true;
+        }
+        for (draco::PointIndex i(0); i < dracoMesh.num_points(); ++i) {
+            memcpy(out + i.value() * elementBytes, dracoAttribute.GetAddressOfMappedIndex(i), elementBytes);
+        }
+        return true;
+    }
+
     size_t byteOffset = 0;
     T values[4] = { 0, 0, 0, 0 };
     for (draco::PointIndex i(0); i < dracoMesh.num_points(); ++i) {
@@ -332,21 +408,21 @@ static bool GetAttributeForAllPoints_Draco(const draco::Mesh &dracoMesh,
             return false;
         }
 
-        memcpy(outBuffer.GetPointer() + byteOffset, &values[0], sizeof(T) * dracoAttribute.num_components());
-        byteOffset += sizeof(T) * dracoAttribute.num_components();
+        memcpy(out + byteOffset, &values[0], elementBytes);
+        byteOffset += elementBytes;
     }
 
     return true;
 }
 
-inline void SetDecodedAttributeBuffer_Draco(const draco::Mesh &dracoMesh, uint32_t dracoAttribId, Accessor &accessor) {
+inline std::unique_ptr<Buffer> DecodeAttributeBuffer_Draco(const draco::Mesh &dracoMesh, uint32_t dracoAttribId, const Accessor &accessor) {
     // Create decoded buffer
     const draco::PointAttribute *pDracoAttribute = dracoMesh.GetAttributeByUniqueId(dracoAttribId);
     if (pDracoAttribute == nullptr) {
         throw DeadlyImportError("GLTF: Invalid draco attribute id: ", dracoAttribId);
     }
 
-    size_t componentBytes = accessor.GetBytesPerComponent();
+    size_t componentBytes = ComponentTypeSize(accessor.componentType);
 
     std::unique_ptr<Buffer> decodedAttribBuffer(new Buffer());
     decodedAttribBuffer->Grow(dracoMesh.num_points() * pDracoAttribute->num_components() * componentBytes);
@@ -375,8 +451,7 @@ inline void SetDecodedAttributeBuffer_Draco(const draco::Mesh &dracoMesh, uint32
         break;
     }
 
-    // Assign this alternate data buffer to the accessor
-    accessor.decodedBuffer.swap(decodedAttribBuffer);
+    return decodedAttribBuffer;
 }
 
 #endif // ASSIMP_ENABLE_DRACO
@@ -565,7 +640,8 @@ inline Buffer::Buffer() :
         byteLength(0),
         type(Type_arraybuffer),
         EncodedRegion_Current(nullptr),
-        mIsSpecial(false) {}
+        mIsSpecial(false),
+        mIsFallback(false) {}
 
 inline Buffer::~Buffer() {
     for (SEncodedRegion *reg : EncodedRegion_List)
@@ -583,7 +659,14 @@ inline void Buffer::Read(Value &obj, Asset &r) {
     Value *it = FindString(obj, "uri");
     if (!it) {
         if (statedLength > 0) {
-            throw DeadlyImportError("GLTF: buffer with non-zero length missing the \"uri\" attribute");
+            // The data of a fallback buffer is produced by decoding the buffer views which use it
+            Value *meshoptExt = r.extensionsUsed.EXT_meshopt_compression ? FindExtension(obj, "EXT_meshopt_compression") : nullptr;
+            if (nullptr == meshoptExt || !MemberOrDefault(*meshoptExt, "fallback", false)) {
+                throw DeadlyImportError("GLTF: buffer with non-zero length missing the \"uri\" attribute");
+            }
+            // The data is allocated by DecodeMeshoptBufferViews, as large as the decoded views
+            // need, the stated length only bounds the buffer views
+            mIsFallback = true;
         }
         return;
     }
@@ -614,10 +697,10 @@ inline void Buffer::Read(Value &obj, Asset &r) {
         if (byteLength > 0) {
             std::string dir = !r.mCurrentAssetDir.empty() ? (r.mCurrentAssetDir.back() == '/' ? r.mCurrentAssetDir : r.mCurrentAssetDir + '/') : "";
 
-            IOStream *file = r.OpenFile(dir + uri, "rb");
+            std::shared_ptr<IOStream> file(r.OpenFile(dir + uri, "rb"));
             if (file) {
-                bool ok = LoadFromStream(*file, byteLength);
-                delete file;
+                bool ok = LoadFromStream(file, byteLength);
+                file.reset();
 
                 if (!ok)
                     throw DeadlyImportError("GLTF: error while reading referenced file \"", uri, "\"");
@@ -628,20 +711,31 @@ inline void Buffer::Read(Value &obj, Asset &r) {
     }
 }
 
-inline bool Buffer::LoadFromStream(IOStream &stream, size_t length, size_t baseOffset) {
-    byteLength = length ? length : stream.FileSize();
+inline bool Buffer::LoadFromStream(const std::shared_ptr<IOStream> &stream, size_t length, size_t baseOffset) {
+    byteLength = length ? length : stream->FileSize();
 
-    if (byteLength > stream.FileSize()) {
+    if (byteLength > stream->FileSize()) {
         throw DeadlyImportError("GLTF: Invalid byteLength exceeds size of actual data.");
     }
 
+    if (const uint8_t *mapped = stream->GetMappedData()) {
+        if (baseOffset > stream->FileSize() - byteLength) {
+            return false;
+        }
+        // alias the mapping read-only, the deleter keeps the stream open as long as the data is used
+        std::shared_ptr<IOStream> owner = stream;
+        mData.reset();
+        mMappedData.reset(mapped + baseOffset, [owner](const uint8_t *) {});
+        return true;
+    }
+
     if (baseOffset) {
-        stream.Seek(baseOffset, aiOrigin_SET);
+        stream->Seek(baseOffset, aiOrigin_SET);
     }
 
     mData.reset(new uint8_t[byteLength], std::default_delete<uint8_t[]>());
 
-    if (stream.Read(mData.get(), byteLength, 1) != 1) {
+    if (stream->Read(mData.get(), byteLength, 1) != 1) {
         return false;
     }
     return true;
@@ -701,13 +795,14 @@ inline bool Buffer::ReplaceData(const size_t pBufferData_Offset, const size_t pB
     const size_t new_data_size = byteLength + pReplace_Count - pBufferData_Count;
     uint8_t *new_data = new uint8_t[new_data_size];
     // Copy data which place before replacing part.
-    ::memcpy(new_data, mData.get(), pBufferData_Offset);
+    ::memcpy(new_data, GetData(), pBufferData_Offset);
     // Copy new data.
     ::memcpy(&new_data[pBufferData_Offset], pReplace_Data, pReplace_Count);
     // Copy data which place after replacing part.
-    ::memcpy(&new_data[pBufferData_Offset + pReplace_Count], &mData.get()[pBufferData_Offset + pBufferData_Count], pBufferData_Offset);
+    ::memcpy(&new_data[pBufferData_Offset + pReplace_Count], &GetData()[pBufferData_Offset + pBufferData_Count], pBufferData_Offset);
     // Apply new data
     mData.reset(new_data, std::default_delete<uint8_t[]>());
+    mMappedData.reset();
     byteLength = new_data_size;
 
     return true;
@@ -721,13 +816,14 @@ inline bool Buffer::ReplaceData_joint(const size_t pBufferData_Offset, const siz
     const size_t new_data_size = byteLength + pReplace_Count - pBufferData_Count;
     uint8_t *new_data = new uint8_t[new_data_size];
     // Copy data which place before replacing part.
-    memcpy(new_data, mData.get(), pBufferData_Offset);
+    memcpy(new_data, GetData(), pBufferData_Offset);
     // Copy new data.
     memcpy(&new_data[pBufferData_Offset], pReplace_Data, pReplace_Count);
     // Copy data which place after replacing part.
-    memcpy(&new_data[pBufferData_Offset + pReplace_Count], &mData.get()[pBufferData_Offset + pBufferData_Count], new_data_size - (pBufferData_Offset + pReplace_Count));
+    memcpy(&new_data[pBufferData_Offset + pReplace_Count], &GetData()[pBufferData_Offset + pBufferData_Count], new_data_size - (pBufferData_Offset + pReplace_Count));
     // Apply new data
     mData.reset(new_data, std::default_delete<uint8_t[]>());
+    mMappedData.reset();
     byteLength = new_data_size;
 
     return true;
@@ -744,6 +840,22 @@ inline size_t Buffer::AppendData(uint8_t *data, size_t length) {
     return offset;
 }
 
+inline uint8_t *Buffer::GetPointer() {
+    if (mMappedData) {
+        uint8_t *copy = new uint8_t[byteLength];
+        memcpy(copy, mMappedData.get(), byteLength);
+        mData.reset(copy, std::default_delete<uint8_t[]>());
+        mMappedData.reset();
+    }
+    return mData.get();
+}
+
+inline void Buffer::AllocateFallback(size_t length) {
+    capacity = length;
+    byteLength = length;
+    mData.reset(new uint8_t[length](), std::default_delete<uint8_t[]>());
+}
+
 inline void Buffer::Grow(size_t amount) {
     if (amount <= 0) {
         return;
@@ -759,10 +871,11 @@ inline void Buffer::Grow(size_t amount) {
     capacity = byteLength + amount;
 
     uint8_t *b = new uint8_t[capacity];
-    if (nullptr != mData) {
-        memcpy(b, mData.get(), byteLength);
+    if (nullptr != GetData()) {
+        memcpy(b, GetData(), byteLength);
     }
     mData.reset(b, std::default_delete<uint8_t[]>());
+    mMappedData.reset();
     byteLength += amount;
 }
 
@@ -786,14 +899,81 @@ inline void BufferView::Read(Value &obj, Asset &r) {
     if ((byteOffset + byteLength) > buffer->byteLength) {
         throw DeadlyImportError("GLTF: Buffer view with offset/length (", byteOffset, "/", byteLength, ") is out of range.");
     }
+
+    if (r.extensionsUsed.EXT_meshopt_compression) {
+        if (Value *meshoptExt = FindExtension(obj, "EXT_meshopt_compression")) {
+            ReadMeshoptExtension(*meshoptExt, r);
+        }
+    }
 }
 
-inline uint8_t *BufferView::GetPointerAndTailSize(size_t accOffset, size_t& outTailSize) {
+inline void BufferView::ReadMeshoptExtension(Value &ext, Asset &r) {
+    Ref<Buffer> source;
+    if (Value *bufferVal = FindUInt(ext, "buffer")) {
+        source = r.buffers.Retrieve(bufferVal->GetUint());
+    }
+    if (!source || source->IsFallback()) {
+        throw DeadlyImportError("GLTF: Compressed buffer view \"", id, "\" without valid buffer.");
+    }
+
+    const size_t sourceOffset = MemberOrDefault(ext, "byteOffset", size_t(0));
+    const size_t sourceLength = MemberOrDefault(ext, "byteLength", size_t(0));
+    const size_t stride = MemberOrDefault(ext, "byteStride", size_t(0));
+    const size_t count = MemberOrDefault(ext, "count", size_t(0));
+    if (sourceOffset > source->byteLength || sourceLength > source->byteLength - sourceOffset || nullptr == source->GetData()) {
+        throw DeadlyImportError("GLTF: Compressed buffer view \"", id, "\" with offset/length (", sourceOffset, "/", sourceLength, ") is out of range.");
+    }
+
+    Meshopt::Mode mode = Meshopt::Mode_ATTRIBUTES;
+    const char *modeStr = MemberOrDefault<const char *>(ext, "mode", "");
+    if (strcmp(modeStr, "TRIANGLES") == 0) {
+        mode = Meshopt::Mode_TRIANGLES;
+    } else if (strcmp(modeStr, "INDICES") == 0) {
+        mode = Meshopt::Mode_INDICES;
+    } else if (strcmp(modeStr, "ATTRIBUTES") != 0) {
+        throw DeadlyImportError("GLTF: Compressed buffer view \"", id, "\" with unknown mode \"", modeStr, "\".");
+    }
+
+    Meshopt::Filter filter = Meshopt::Filter_NONE;
+    const char *filterStr = MemberOrDefault<const char *>(ext, "filter", "NONE");
+    if (strcmp(filterStr, "OCTAHEDRAL") == 0) {
+        filter = Meshopt::Filter_OCTAHEDRAL;
+    } else if (strcmp(filterStr, "QUATERNION") == 0) {
+        filter = Meshopt::Filter_QUATERNION;
+    } else if (strcmp(filterStr, "EXPONENTIAL") == 0) {
+        filter = Meshopt::Filter_EXPONENTIAL;
+    } else if (strcmp(filterStr, "NONE") != 0) {
+        throw DeadlyImportError("GLTF: Compressed buffer view \"", id, "\" with unknown filter \"", filterStr, "\".");
+    }
+
+    if (!Meshopt::IsValidLayout(mode, filter, stride, count) || count > byteLength / stride) {
+        throw DeadlyImportError("GLTF: Compressed buffer view \"", id, "\" with invalid count/stride (", count, "/", stride, ").");
+    }
+
+    // A buffer with data of its own holds the uncompressed copy, which can be used as is
+    if (!buffer->IsFallback()) {
+        return;
+    }
+
+    Asset::MeshoptBufferView view;
+    view.id = id;
+    view.buffer = buffer;
+    view.byteOffset = byteOffset;
+    view.data = source->GetData() + sourceOffset;
+    view.length = sourceLength;
+    view.count = count;
+    view.byteStride = stride;
+    view.mode = mode;
+    view.filter = filter;
+    r.mMeshoptBufferViews.push_back(std::move(view));
+}
+
+inline const uint8_t *BufferView::GetPointerAndTailSize(size_t accOffset, size_t& outTailSize) {
     if (!buffer) {
         outTailSize = 0;
         return nullptr;
     }
-    uint8_t * const basePtr = buffer->GetPointer();
+    const uint8_t * const basePtr = buffer->GetData();
     if (!basePtr) {
         outTailSize = 0;
         return nullptr;
@@ -832,16 +1012,16 @@ inline void Accessor::Sparse::PopulateData(size_t numBytes, const uint8_t *bytes
 
 inline void Accessor::Sparse::PatchData(unsigned int elementSize) {
     size_t indicesTailDataSize;
-    uint8_t *pIndices = indices->GetPointerAndTailSize(indicesByteOffset, indicesTailDataSize);
+    const uint8_t *pIndices = indices->GetPointerAndTailSize(indicesByteOffset, indicesTailDataSize);
     const unsigned int indexSize = int(ComponentTypeSize(indicesType));
-    uint8_t *indicesEnd = pIndices + count * indexSize;
+    const uint8_t *indicesEnd = pIndices + count * indexSize;
 
     if ((uint64_t)indicesEnd > (uint64_t)pIndices + indicesTailDataSize) {
         throw DeadlyImportError("Invalid sparse accessor. Indices outside allocated memory.");
     }
 
     size_t valuesTailDataSize;
-    uint8_t* pValues = values->GetPointerAndTailSize(valuesByteOffset, valuesTailDataSize);
+    const uint8_t* pValues = values->GetPointerAndTailSize(valuesByteOffset, valuesTailDataSize);
 
     if (elementSize * count > valuesTailDataSize) {
         throw DeadlyImportError("Invalid sparse accessor. Indices outside allocated memory.");
@@ -853,10 +1033,10 @@ inline void Accessor::Sparse::PatchData(unsigned int elementSize) {
             offset = *pIndices;
             break;
         case ComponentType_UNSIGNED_SHORT:
-            offset = *reinterpret_cast<uint16_t *>(pIndices);
+            offset = *reinterpret_cast<const uint16_t *>(pIndices);
             break;
         case ComponentType_UNSIGNED_INT:
-            offset = *reinterpret_cast<uint32_t *>(pIndices);
+            offset = *reinterpret_cast<const uint32_t *>(pIndices);
             break;
         default:
             // have fun with float and negative values from signed types as indices.
@@ -974,15 +1154,15 @@ inline unsigned int Accessor::GetElementSize() {
     return GetNumComponents() * GetBytesPerComponent();
 }
 
-inline uint8_t *Accessor::GetPointer() {
+inline const uint8_t *Accessor::GetPointer() {
     if (decodedBuffer)
-        return decodedBuffer->GetPointer();
+        return decodedBuffer->GetData();
 
     if (sparse)
         return sparse->data.data();
 
     if (!bufferView || !bufferView->buffer) return nullptr;
-    uint8_t *basePtr = bufferView->buffer->GetPointer();
+    const uint8_t *basePtr = bufferView->buffer->GetData();
     if (!basePtr) return nullptr;
 
     size_t offset = byteOffset + bufferView->byteOffset;
@@ -1017,7 +1197,7 @@ inline size_t Accessor::GetMaxByteSize() {
 
 template <class T>
 size_t Accessor::ExtractData(T *&outData, const std::vector<unsigned int> *remappingIndices) {
-    uint8_t *data = GetPointer();
+    const uint8_t *data = GetPointer();
     if (!data) {
         throw DeadlyImportError("GLTF2: data is null when extracting data from ", getContextForErrorMessages(id, name));
     }
@@ -1036,27 +1216,25 @@ size_t Accessor::ExtractData(T *&outData, const std::vector<unsigned int> *remap
 
     const size_t maxSize = GetMaxByteSize();
 
-    outData = new T[usedCount];
-
     if (remappingIndices != nullptr) {
+        // check the largest index once instead of every element
         const unsigned int maxIndexCount = static_cast<unsigned int>(maxSize / stride);
-        for (size_t i = 0; i < usedCount; ++i) {
-            size_t srcIdx = (*remappingIndices)[i];
-            if (srcIdx >= maxIndexCount) {
-                throw DeadlyImportError("GLTF: index*stride ", (srcIdx * stride), " > maxSize ", maxSize, " in ", getContextForErrorMessages(id, name));
-            }
-            memcpy(outData + i, data + srcIdx * stride, elemSize);
+        const auto maxIdx = std::max_element(remappingIndices->begin(), remappingIndices->end());
+        if (maxIdx != remappingIndices->end() && *maxIdx >= maxIndexCount) {
+            const size_t srcIdx = *maxIdx;
+            throw DeadlyImportError("GLTF: index*stride ", (srcIdx * stride), " > maxSize ", maxSize, " in ", getContextForErrorMessages(id, name));
         }
+        outData = new T[usedCount];
+        CopyElements(usedCount, data, stride, elemSize, remappingIndices->data(), reinterpret_cast<uint8_t *>(outData), targetElemSize);
     } else { // non-indexed cases
         if (usedCount * stride > maxSize) {
             throw DeadlyImportError("GLTF: count*stride ", (usedCount * stride), " > maxSize ", maxSize, " in ", getContextForErrorMessages(id, name));
         }
+        outData = new T[usedCount];
         if (stride == elemSize && targetElemSize == elemSize) {
             memcpy(outData, data, totalSize);
         } else {
-            for (size_t i = 0; i < usedCount; ++i) {
-                memcpy(outData + i, data + i * stride, elemSize);
-            }
+            CopyElements(usedCount, data, stride, elemSize, nullptr, reinterpret_cast<uint8_t *>(outData), targetElemSize);
         }
     }
     return usedCount;
@@ -1125,6 +1303,43 @@ T Accessor::Indexer::GetValue(int i) {
     return value;
 }
 
+template <class T>
+inline void GetUIntsOfType(size_t count, const uint8_t *src, size_t stride, unsigned int *out) {
+    T value;
+    for (size_t i = 0; i < count; ++i, src += stride) {
+        memcpy(&value, src, sizeof(T));
+        out[i] = value;
+    }
+}
+
+inline void Accessor::Indexer::GetUInts(size_t count, unsigned int *out) {
+    ai_assert(data);
+    if (0 == count) {
+        return;
+    }
+    if ((count - 1) * stride >= accessor.GetMaxByteSize()) {
+        throw DeadlyImportError("GLTF: Invalid index ", count - 1, ", count out of range for buffer with stride ", stride, " and size ", accessor.GetMaxByteSize(), ".");
+    }
+
+    // Assume platform endianness matches GLTF binary data (which is little-endian).
+    switch (elemSize) {
+    case 1:
+        GetUIntsOfType<uint8_t>(count, data, stride, out);
+        break;
+    case 2:
+        GetUIntsOfType<uint16_t>(count, data, stride, out);
+        break;
+    case 4:
+        GetUIntsOfType<uint32_t>(count, data, stride, out);
+        break;
+    default:
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = GetValue<unsigned int>(static_cast<int>(i));
+        }
+        break;
+    }
+}
+
 inline Image::Image() :
         width(0),
         height(0),
@@ -1164,7 +1379,7 @@ inline void Image::Read(Value &obj, Asset &r) {
             // maybe this memcpy could be avoided if aiTexture does not delete[] pcData at destruction.
 
             this->mData.reset(new uint8_t[this->mDataLength]);
-            memcpy(this->mData.get(), buffer->GetPointer() + this->bufferView->byteOffset, this->mDataLength);
+            memcpy(this->mData.get(), buffer->GetData() + this->bufferView->byteOffset, this->mDataLength);
         } else {
             throw DeadlyImportError("GLTF2: ", getContextForErrorMessages(id, name), " should have either a URI of a bufferView and mimetype");
         }
@@ -1538,26 +1753,15 @@ inline void Mesh::Read(Value &pJSON_Object, Asset &pAsset_Root) {
                 // Skip if any missing
                 if (Value *dracoExt = FindExtension(primitive, "KHR_draco_mesh_compression")) {
                     if (Value *bufView = FindUInt(*dracoExt, "bufferView")) {
-                        // Attempt to load indices and attributes using draco compression
+                        // Queue the primitive, the decoding of all primitives runs in parallel
+                        // once the whole document was read
                         auto bufferView = pAsset_Root.bufferViews.Retrieve(bufView->GetUint());
-                        // Attempt to perform the draco decode on the buffer data
-                        const char *bufferViewData = reinterpret_cast<const char *>(bufferView->buffer->GetPointer() + bufferView->byteOffset);
-                        draco::DecoderBuffer decoderBuffer;
-                        decoderBuffer.Init(bufferViewData, bufferView->byteLength);
-                        draco::Decoder decoder;
-                        auto decodeResult = decoder.DecodeMeshFromBuffer(&decoderBuffer);
-                        if (!decodeResult.ok()) {
-                            // A corrupt Draco isn't actually fatal if the primitive data is also provided in a standard buffer, but does anyone do that?
-                            throw DeadlyImportError("GLTF: Invalid Draco mesh compression in mesh: ", name, " primitive: ", i, ": ", decodeResult.status().error_msg_string());
-                        }
-
-                        // Now we have a draco mesh
-                        const std::unique_ptr<draco::Mesh> &pDracoMesh = decodeResult.value();
-
-                        // Redirect the accessors to the decoded data
-
-                        // Indices
-                        SetDecodedIndexBuffer_Draco(*pDracoMesh, prim);
+                        Asset::DracoPrimitive dracoPrim;
+                        dracoPrim.data = bufferView->buffer->GetData() + bufferView->byteOffset;
+                        dracoPrim.length = bufferView->byteLength;
+                        dracoPrim.meshName = name;
+                        dracoPrim.primitiveIndex = i;
+                        dracoPrim.indices = prim.indices ? &(*prim.indices) : nullptr;
 
                         // Vertex attributes
                         if (Value *attrs = FindObject(*dracoExt, "attributes")) {
@@ -1585,10 +1789,12 @@ inline void Mesh::Read(Value &pJSON_Object, Asset &pAsset_Root) {
 
                                     // Redirect this accessor to the appropriate Draco vertex attribute data
                                     const uint32_t dracoAttribId = it->value.GetUint();
-                                    SetDecodedAttributeBuffer_Draco(*pDracoMesh, dracoAttribId, attribAccessor);
+                                    dracoPrim.attributes.emplace_back(dracoAttribId, &attribAccessor);
                                 }
                             }
                         }
+
+                        pAsset_Root.mDracoPrimitives.push_back(std::move(dracoPrim));
                     }
                 }
             }
@@ -2053,7 +2259,7 @@ inline void Asset::Load(const std::string &pFile, bool isBinary)
 
     // Fill the buffer instance for the current file embedded contents
     if (mBodyLength > 0) {
-        if (!mBodyBuffer->LoadFromStream(*stream, mBodyLength, mBodyOffset)) {
+        if (!mBodyBuffer->LoadFromStream(stream, mBodyLength, mBodyOffset)) {
             throw DeadlyImportError("GLTF: Unable to read gltf file");
         }
     }
@@ -2075,6 +2281,10 @@ inline void Asset::Load(const std::string &pFile, bool isBinary)
         mDicts[i]->AttachToDocument(doc);
     }
 
+    if (extensionsUsed.EXT_meshopt_compression) {
+        DecodeMeshoptBufferViews(doc);
+    }
+
     // Read the "extensions" property, then add it to each scene's metadata.
     CustomExtension customExtensions;
     if (Value *extensionsObject = FindObject(doc, "extensions")) {
@@ -2109,12 +2319,99 @@ inline void Asset::Load(const std::string &pFile, bool isBinary)
         }
     }
 
+#ifdef ASSIMP_ENABLE_DRACO
+    DecodeDracoPrimitives();
+#endif
+
     // Clean up
     for (size_t i = 0; i < mDicts.size(); ++i) {
         mDicts[i]->DetachFromDocument();
     }
 }
 
+inline void Asset::DecodeMeshoptBufferViews(Document &doc) {
+    Value *views = FindArray(doc, "bufferViews");
+    if (nullptr == views) {
+        return;
+    }
+
+    // Everything else may point into the decoded data, so all compressed
+    // buffer views are read and decoded before anything else
+    for (unsigned int i = 0; i < views->Size(); ++i) {
+        Value &view = (*views)[i];
+        if (!view.IsObject()) {
+            continue;
+        }
+        Value *exts = FindObject(view, "extensions");
+        if (nullptr != exts && exts->HasMember("EXT_meshopt_compression")) {
+            bufferViews.Retrieve(i);
+        }
+    }
+
+    // A fallback buffer only gets the memory its decoded views cover, not
+    // whatever length the file states for it
+    std::unordered_map<Buffer *, size_t> fallbackLengths;
+    for (MeshoptBufferView &view : mMeshoptBufferViews) {
+        size_t &length = fallbackLengths[&*view.buffer];
+        length = std::max(length, view.byteOffset + view.count * view.byteStride);
+    }
+    for (const auto &fallback : fallbackLengths) {
+        fallback.first->AllocateFallback(fallback.second);
+    }
+
+    std::vector<uint8_t *> targets(mMeshoptBufferViews.size());
+    for (size_t i = 0; i < mMeshoptBufferViews.size(); ++i) {
+        targets[i] = mMeshoptBufferViews[i].buffer->GetPointer() + mMeshoptBufferViews[i].byteOffset;
+    }
+
+    ParallelFor(static_cast<unsigned int>(mMeshoptBufferViews.size()), mNumThreads, [this, &targets](unsigned int i) {
+        const MeshoptBufferView &view = mMeshoptBufferViews[i];
+        if (!Meshopt::Decode(targets[i], view.count, view.byteStride, view.data, view.length, view.mode, view.filter)) {
+            throw DeadlyImportError("GLTF: Invalid EXT_meshopt_compression data in buffer view \"", view.id, "\".");
+        }
+    });
+    mMeshoptBufferViews.clear();
+}
+
+#ifdef ASSIMP_ENABLE_DRACO
+inline void Asset::DecodeDracoPrimitives() {
+    // The decoded index buffer of each primitive, followed by one buffer per attribute
+    std::vector<std::vector<std::unique_ptr<Buffer>>> decoded(mDracoPrimitives.size());
+
+    ParallelFor(static_cast<unsigned int>(mDracoPrimitives.size()), mNumThreads, [this, &decoded](unsigned int i) {
+        const DracoPrimitive &prim = mDracoPrimitives[i];
+        draco::DecoderBuffer decoderBuffer;
+        decoderBuffer.Init(reinterpret_cast<const char *>(prim.data), prim.length);
+        draco::Decoder decoder;
+        auto decodeResult = decoder.DecodeMeshFromBuffer(&decoderBuffer);
+        if (!decodeResult.ok()) {
+            // A corrupt Draco isn't actually fatal if the primitive data is also provided in a standard buffer, but does anyone do that?
+            throw DeadlyImportError("GLTF: Invalid Draco mesh compression in mesh: ", prim.meshName, " primitive: ", prim.primitiveIndex, ": ", decodeResult.status().error_msg_string());
+        }
+
+        // Now we have a draco mesh
+        const draco::Mesh &dracoMesh = *decodeResult.value();
+        decoded[i].reserve(prim.attributes.size() + 1);
+        decoded[i].push_back(DecodeIndexBuffer_Draco(dracoMesh, prim.indices));
+        for (const auto &attribute : prim.attributes) {
+            decoded[i].push_back(DecodeAttributeBuffer_Draco(dracoMesh, attribute.first, *attribute.second));
+        }
+    });
+
+    // Redirect the accessors to the decoded data, in the order the primitives were read
+    for (size_t i = 0; i < mDracoPrimitives.size(); ++i) {
+        const DracoPrimitive &prim = mDracoPrimitives[i];
+        if (decoded[i][0]) {
+            prim.indices->decodedBuffer = std::move(decoded[i][0]);
+        }
+        for (size_t j = 0; j < prim.attributes.size(); ++j) {
+            prim.attributes[j].second->decodedBuffer = std::move(decoded[i][j + 1]);
+        }
+    }
+    mDracoPrimitives.clear();
+}
+#endif
+
 inline bool Asset::CanRead(const std::string &pFile, bool isBinary) {
     try {
         shared_ptr<IOStream> stream(OpenFile(pFile.c_str(), "rb", true));
@@ -2157,6 +2454,7 @@ inline void Asset::ReadExtensionsRequired(Document &doc) {
 
     CHECK_REQUIRED_EXT(KHR_draco_mesh_compression);
     CHECK_REQUIRED_EXT(KHR_texture_basisu);
+    CHECK_REQUIRED_EXT(EXT_meshopt_compression);
 
 #undef CHECK_REQUIRED_EXT
 }
@@ -2187,6 +2485,7 @@ inline void Asset::ReadExtensionsUsed(Document &doc) {
     CHECK_EXT(KHR_materials_anisotropy);
     CHECK_EXT(KHR_draco_mesh_compression);
     CHECK_EXT(KHR_texture_basisu);
+    CHECK_EXT(EXT_meshopt_compression);
 
 #undef CHECK_EXT
 }
@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "glTF2Importer.h"
 #include "glTF2Asset.h"
+#include "Common/FaceIndexAllocator.h"
+#include "Common/ParallelFor.h"
 #include "PostProcessing/MakeVerboseFormat.h"
 
 #if !defined(ASSIMP_BUILD_NO_EXPORT)
@@ -408,41 +410,55 @@ void glTF2Importer::ImportMaterials(Asset &r) {
     }
 }
 
-static inline void SetFaceAndAdvance1(aiFace *&face, unsigned int numVertices, unsigned int a) {
+static inline void SetFaceAndAdvance1(aiFace *&face, FaceIndexAllocator &indices, unsigned int numVertices, unsigned int a) {
     if (a >= numVertices) {
         return;
     }
     face->mNumIndices = 1;
-    face->mIndices = new unsigned int[1];
+    face->mIndices = indices.Allocate(1);
     face->mIndices[0] = a;
     ++face;
 }
 
-static inline void SetFaceAndAdvance2(aiFace *&face, unsigned int numVertices,
+static inline void SetFaceAndAdvance2(aiFace *&face, FaceIndexAllocator &indices, unsigned int numVertices,
         unsigned int a, unsigned int b) {
     if ((a >= numVertices) || (b >= numVertices)) {
         return;
     }
     face->mNumIndices = 2;
-    face->mIndices = new unsigned int[2];
+    face->mIndices = indices.Allocate(2);
     face->mIndices[0] = a;
     face->mIndices[1] = b;
     ++face;
 }
 
-static inline void SetFaceAndAdvance3(aiFace *&face, unsigned int numVertices, unsigned int a,
+static inline void SetFaceAndAdvance3(aiFace *&face, FaceIndexAllocator &indices, unsigned int numVertices, unsigned int a,
         unsigned int b, unsigned int c) {
     if ((a >= numVertices) || (b >= numVertices) || (c >= numVertices)) {
         return;
     }
     face->mNumIndices = 3;
-    face->mIndices = new unsigned int[3];
+    face->mIndices = indices.Allocate(3);
     face->mIndices[0] = a;
     face->mIndices[1] = b;
     face->mIndices[2] = c;
     ++face;
 }
 
+// Upper bound for the number of face indices generated from count elements
+static size_t GetMaxFaceIndices(PrimitiveMode mode, size_t count) {
+    switch (mode) {
+    case PrimitiveMode_LINE_LOOP:
+    case PrimitiveMode_LINE_STRIP:
+        return 2 * count;
+    case PrimitiveMode_TRIANGLE_STRIP:
+    case PrimitiveMode_TRIANGLE_FAN:
+        return 3 * count;
+    default:
+        return count;
+    }
+}
+
 #ifdef ASSIMP_BUILD_DEBUG
 static inline bool CheckValidFacesIndices(aiFace *faces, unsigned nFaces, unsigned nVerts) {
     for (unsigned i = 0; i < nFaces; ++i) {
@@ -457,6 +473,15 @@ static inline bool CheckValidFacesIndices(aiFace *faces, unsigned nFaces, unsign
 }
 #endif // ASSIMP_BUILD_DEBUG
 
+static bool IsIdentityMapping(const std::vector<unsigned int> &mapping) {
+    for (size_t i = 0; i < mapping.size(); ++i) {
+        if (mapping[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template <typename T>
 aiColor4D *GetVertexColorsForType(Ref<Accessor> input, std::vector<unsigned int> *vertexRemappingTable) {
     constexpr float max = std::numeric_limits<T>::max();
@@ -514,7 +539,8 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
             if (useIndexBuffer) {
                 size_t count = prim.indices->count;
                 indexBuffer.resize(count);
-                reverseMappingIndices.clear();
+                const unsigned int unusedIndex = ~0u;
+                reverseMappingIndices.assign(numAllVertices, unusedIndex);
                 vertexRemappingTable = &mVertexRemappingTables[meshes.size()];
                 vertexRemappingTable->reserve(count / 3); // this is a very rough heuristic to reduce re-allocations
                 Accessor::Indexer data = prim.indices->GetIndexer();
@@ -524,23 +550,26 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
                 // Build the vertex remapping table and the modified index buffer (used later instead of the original one)
                 // In case no index buffer is used, the original vertex arrays are being used so no remapping is required in the first place.
-                const unsigned int unusedIndex = ~0u;
+                data.GetUInts(count, indexBuffer.data());
                 for (unsigned int i = 0; i < count; ++i) {
-                    unsigned int index = data.GetUInt(i);
+                    unsigned int index = indexBuffer[i];
                     if (index >= numAllVertices) {
                         // Out-of-range indices will be filtered out when adding the faces and then lead to a warning. At this stage, we just keep them.
-                        indexBuffer[i] = index;
                         continue;
                     }
-                    if (index >= reverseMappingIndices.size()) {
-                        reverseMappingIndices.resize(index + 1, unusedIndex);
-                    }
                     if (reverseMappingIndices[index] == unusedIndex) {
                         reverseMappingIndices[index] = static_cast<unsigned int>(vertexRemappingTable->size());
                         vertexRemappingTable->push_back(index);
                     }
                     indexBuffer[i] = reverseMappingIndices[index];
                 }
+
+                // indices which reference the vertices in order need no remapping,
+                // the vertex attributes are copied as a whole then
+                if (vertexRemappingTable->size() == numAllVertices && IsIdentityMapping(*vertexRemappingTable)) {
+                    std::vector<unsigned int>().swap(*vertexRemappingTable);
+                    vertexRemappingTable = nullptr;
+                }
             }
 
             aiMesh *aim = new aiMesh();
@@ -719,6 +748,8 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
             aiFace *facePtr = nullptr;
             size_t nFaces = 0;
 
+            FaceIndexAllocator faceIndices(mPoolFaceIndices,
+                    GetMaxFaceIndices(prim.mode, useIndexBuffer ? indexBuffer.size() : aim->mNumVertices));
             if (useIndexBuffer) {
                 size_t count = indexBuffer.size();
 
@@ -727,7 +758,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     nFaces = count;
                     facePtr = faces = new aiFace[nFaces];
                     for (unsigned int i = 0; i < count; ++i) {
-                        SetFaceAndAdvance1(facePtr, aim->mNumVertices, indexBuffer[i]);
+                        SetFaceAndAdvance1(facePtr, faceIndices, aim->mNumVertices, indexBuffer[i]);
                     }
                     break;
                 }
@@ -740,7 +771,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     }
                     facePtr = faces = new aiFace[nFaces];
                     for (unsigned int i = 0; i < count; i += 2) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, indexBuffer[i], indexBuffer[i + 1]);
+                        SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, indexBuffer[i], indexBuffer[i + 1]);
                     }
                     break;
                 }
@@ -749,12 +780,12 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                 case PrimitiveMode_LINE_STRIP: {
                     nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
                     facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, indexBuffer[0], indexBuffer[1]);
+                    SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, indexBuffer[0], indexBuffer[1]);
                     for (unsigned int i = 2; i < count; ++i) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, indexBuffer[i - 1], indexBuffer[i]);
+                        SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, indexBuffer[i - 1], indexBuffer[i]);
                     }
                     if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, indexBuffer[static_cast<int>(count) - 1], faces[0].mIndices[0]);
+                        SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, indexBuffer[static_cast<int>(count) - 1], faces[0].mIndices[0]);
                     }
                     break;
                 }
@@ -767,7 +798,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     }
                     facePtr = faces = new aiFace[nFaces];
                     for (unsigned int i = 0; i < count; i += 3) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, indexBuffer[i], indexBuffer[i + 1], indexBuffer[i + 2]);
+                        SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, indexBuffer[i], indexBuffer[i + 1], indexBuffer[i + 2]);
                     }
                     break;
                 }
@@ -778,10 +809,10 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                         // The ordering is to ensure that the triangles are all drawn with the same orientation
                         if ((i + 1) % 2 == 0) {
                             // For even n, vertices n + 1, n, and n + 2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, indexBuffer[i + 1], indexBuffer[i], indexBuffer[i + 2]);
+                            SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, indexBuffer[i + 1], indexBuffer[i], indexBuffer[i + 2]);
                         } else {
                             // For odd n, vertices n, n+1, and n+2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, indexBuffer[i], indexBuffer[i + 1], indexBuffer[i + 2]);
+                            SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, indexBuffer[i], indexBuffer[i + 1], indexBuffer[i + 2]);
                         }
                     }
                     break;
@@ -789,9 +820,9 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                 case PrimitiveMode_TRIANGLE_FAN:
                     nFaces = count - 2;
                     facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, indexBuffer[0], indexBuffer[1], indexBuffer[2]);
+                    SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, indexBuffer[0], indexBuffer[1], indexBuffer[2]);
                     for (unsigned int i = 1; i < nFaces; ++i) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, indexBuffer[0], indexBuffer[i + 1], indexBuffer[i + 2]);
+                        SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, indexBuffer[0], indexBuffer[i + 1], indexBuffer[i + 2]);
                     }
                     break;
                 }
@@ -805,7 +836,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     nFaces = count;
                     facePtr = faces = new aiFace[nFaces];
                     for (unsigned int i = 0; i < count; ++i) {
-                        SetFaceAndAdvance1(facePtr, aim->mNumVertices, i);
+                        SetFaceAndAdvance1(facePtr, faceIndices, aim->mNumVertices, i);
                     }
                     break;
                 }
@@ -818,7 +849,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     }
                     facePtr = faces = new aiFace[nFaces];
                     for (unsigned int i = 0; i < count; i += 2) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, i, i + 1);
+                        SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, i, i + 1);
                     }
                     break;
                 }
@@ -827,12 +858,12 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                 case PrimitiveMode_LINE_STRIP: {
                     nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
                     facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, 0, 1);
+                    SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, 0, 1);
                     for (unsigned int i = 2; i < count; ++i) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, i - 1, i);
+                        SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, i - 1, i);
                     }
                     if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, count - 1, 0);
+                        SetFaceAndAdvance2(facePtr, faceIndices, aim->mNumVertices, count - 1, 0);
                     }
                     break;
                 }
@@ -845,7 +876,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     }
                     facePtr = faces = new aiFace[nFaces];
                     for (unsigned int i = 0; i < count; i += 3) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
+                        SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, i, i + 1, i + 2);
                     }
                     break;
                 }
@@ -856,10 +887,10 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                         // The ordering is to ensure that the triangles are all drawn with the same orientation
                         if ((i + 1) % 2 == 0) {
                             // For even n, vertices n + 1, n, and n + 2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, i + 1, i, i + 2);
+                            SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, i + 1, i, i + 2);
                         } else {
                             // For odd n, vertices n, n+1, and n+2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
+                            SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, i, i + 1, i + 2);
                         }
                     }
                     break;
@@ -867,9 +898,9 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                 case PrimitiveMode_TRIANGLE_FAN:
                     nFaces = count - 2;
                     facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, 1, 2);
+                    SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, 0, 1, 2);
                     for (unsigned int i = 1; i < nFaces; ++i) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, i + 1, i + 2);
+                        SetFaceAndAdvance3(facePtr, faceIndices, aim->mNumVertices, 0, i + 1, i + 2);
                     }
                     break;
                 }
@@ -877,6 +908,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
             if (faces) {
                 aim->mFaces = faces;
+                faceIndices.Attach(aim);
                 const unsigned int actualNumFaces = static_cast<unsigned int>(facePtr - faces);
                 if (actualNumFaces < nFaces) {
                     ASSIMP_LOG_WARN("Some faces had out-of-range indices. Those faces were dropped.");
@@ -1709,6 +1741,7 @@ void glTF2Importer::InternReadFile(const std::string &pFile, aiScene *pScene, IO
 
     // read the asset file
     glTF2::Asset asset(pIOHandler, static_cast<rapidjson::IRemoteSchemaDocumentProvider *>(mSchemaDocumentProvider));
+    asset.SetNumThreads(mNumThreads);
     asset.Load(pFile,
                CheckMagicToken(
                    pIOHandler, pFile, AI_GLB_MAGIC_NUMBER, 1, 0,
@@ -1739,6 +1772,8 @@ void glTF2Importer::InternReadFile(const std::string &pFile, aiScene *pScene, IO
 
 void glTF2Importer::SetupProperties(const Importer *pImp) {
     mSchemaDocumentProvider = static_cast<rapidjson::IRemoteSchemaDocumentProvider *>(pImp->GetPropertyPointer(AI_CONFIG_IMPORT_SCHEMA_DOCUMENT_PROVIDER));
+    mNumThreads = GetNumThreads(pImp->GetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 1));
+    mPoolFaceIndices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FACE_INDEX_POOL, false);
 }
 
 #endif // ASSIMP_BUILD_NO_GLTF_IMPORTER
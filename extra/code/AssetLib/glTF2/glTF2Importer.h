@@ -86,6 +86,12 @@ private:
 
     /// An instance of rapidjson::IRemoteSchemaDocumentProvider
     void *mSchemaDocumentProvider = nullptr;
+
+    /// Number of threads used to decode compressed data
+    unsigned int mNumThreads = 1;
+
+    /// Whether the face indices of a mesh are stored in one pool
+    bool mPoolFaceIndices = false;
 };
 
 } // namespace Assimp
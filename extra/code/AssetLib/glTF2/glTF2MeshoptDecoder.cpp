@@ -0,0 +1,477 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file glTF2MeshoptDecoder.cpp
+ *  Implementation of the EXT_meshopt_compression decoder.
+ */
+#if !defined(ASSIMP_BUILD_NO_GLTF_IMPORTER) && !defined(ASSIMP_BUILD_NO_GLTF2_IMPORTER)
+
+#include "AssetLib/glTF2/glTF2MeshoptDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace glTF2 {
+namespace Meshopt {
+
+namespace {
+
+constexpr uint8_t VertexHeader = 0xa0;
+constexpr uint8_t IndexHeader = 0xe0;
+constexpr uint8_t SequenceHeader = 0xd0;
+
+constexpr size_t ByteGroupSize = 16;
+constexpr size_t VertexBlockSizeBytes = 8192;
+constexpr size_t VertexBlockMaxSize = 256;
+constexpr size_t TailMinSize = 32;
+
+template <typename T>
+inline T Load(const uint8_t *p) {
+    T v;
+    ::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+template <typename T>
+inline void Store(uint8_t *p, T v) {
+    ::memcpy(p, &v, sizeof(T));
+}
+
+inline uint8_t Unzigzag8(uint8_t v) {
+    return static_cast<uint8_t>(-(v & 1) ^ (v >> 1));
+}
+
+inline uint32_t Unzigzag32(uint32_t v) {
+    return (v >> 1) ^ (0u - (v & 1));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Attributes: every byte of the vertex is stored as a separate stream of zigzag
+// deltas, packed in groups of 16 with 0, 2, 4 or 8 bits per delta.
+const uint8_t *DecodeBytesGroup(const uint8_t *data, const uint8_t *end, uint8_t *out, unsigned int bitsLog2) {
+    if (bitsLog2 == 0) {
+        ::memset(out, 0, ByteGroupSize);
+        return data;
+    }
+    if (bitsLog2 == 3) {
+        if (static_cast<size_t>(end - data) < ByteGroupSize) {
+            return nullptr;
+        }
+        ::memcpy(out, data, ByteGroupSize);
+        return data + ByteGroupSize;
+    }
+
+    const unsigned int bits = 1u << bitsLog2;
+    const size_t packedSize = ByteGroupSize * bits / 8;
+    if (static_cast<size_t>(end - data) < packedSize) {
+        return nullptr;
+    }
+
+    // values which do not fit are marked with all bits set and follow the packed bits
+    const unsigned int sentinel = (1u << bits) - 1;
+    const uint8_t *extra = data + packedSize;
+    for (size_t i = 0; i < ByteGroupSize; ++i) {
+        const size_t bit = i * bits;
+        unsigned int v = (data[bit / 8] >> (8 - bits - bit % 8)) & sentinel;
+        if (v == sentinel) {
+            if (extra == end) {
+                return nullptr;
+            }
+            v = *extra++;
+        }
+        out[i] = static_cast<uint8_t>(v);
+    }
+    return extra;
+}
+
+bool DecodeVertexBuffer(uint8_t *dst, size_t count, size_t byteStride, const uint8_t *src, size_t srcLength) {
+    const size_t tailSize = std::max(byteStride, TailMinSize);
+    if (srcLength < 1 + tailSize || src[0] != VertexHeader) {
+        return false;
+    }
+
+    const uint8_t *data = src + 1;
+    const uint8_t *end = src + srcLength - tailSize;
+
+    // the tail holds the first vertex, which serves as base of the first deltas
+    uint8_t last[VertexBlockMaxSize];
+    ::memcpy(last, src + srcLength - byteStride, byteStride);
+
+    const size_t blockSize = std::min((VertexBlockSizeBytes / byteStride) & ~(ByteGroupSize - 1), VertexBlockMaxSize);
+    uint8_t deltas[VertexBlockMaxSize];
+
+    for (size_t first = 0; first < count; first += blockSize) {
+        const size_t n = std::min(blockSize, count - first);
+        const size_t numGroups = (n + ByteGroupSize - 1) / ByteGroupSize;
+        const size_t headerSize = (numGroups + 3) / 4;
+
+        for (size_t k = 0; k < byteStride; ++k) {
+            if (static_cast<size_t>(end - data) < headerSize) {
+                return false;
+            }
+            const uint8_t *header = data;
+            data += headerSize;
+            for (size_t g = 0; g < numGroups; ++g) {
+                const unsigned int bitsLog2 = (header[g / 4] >> ((g % 4) * 2)) & 3;
+                data = DecodeBytesGroup(data, end, deltas + g * ByteGroupSize, bitsLog2);
+                if (data == nullptr) {
+                    return false;
+                }
+            }
+
+            uint8_t p = last[k];
+            uint8_t *out = dst + first * byteStride + k;
+            for (size_t i = 0; i < n; ++i, out += byteStride) {
+                p = static_cast<uint8_t>(p + Unzigzag8(deltas[i]));
+                *out = p;
+            }
+            last[k] = p;
+        }
+    }
+
+    return data == end;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Triangles: every triangle is a code byte which refers to recently seen edges
+// and vertices, plus optional varint-encoded vertex indices.
+uint32_t DecodeVByte(const uint8_t *&data) {
+    const uint8_t lead = *data++;
+    if (lead < 128) {
+        return lead;
+    }
+
+    // at most 4 more bytes, so malformed data cannot run away
+    uint32_t result = lead & 127;
+    unsigned int shift = 7;
+    for (int i = 0; i < 4; ++i) {
+        const uint8_t group = *data++;
+        result |= static_cast<uint32_t>(group & 127) << shift;
+        shift += 7;
+        if (group < 128) {
+            break;
+        }
+    }
+    return result;
+}
+
+inline uint32_t DecodeIndex(const uint8_t *&data, uint32_t last) {
+    return last + Unzigzag32(DecodeVByte(data));
+}
+
+inline void WriteIndex(uint8_t *dst, size_t i, size_t byteStride, uint32_t index) {
+    if (byteStride == 2) {
+        Store(dst + i * 2, static_cast<uint16_t>(index));
+    } else {
+        Store(dst + i * 4, index);
+    }
+}
+
+struct TriangleFifos {
+    uint32_t edges[16][2];
+    uint32_t vertices[16];
+    size_t edgeOffset = 0;
+    size_t vertexOffset = 0;
+
+    TriangleFifos() {
+        ::memset(edges, -1, sizeof(edges));
+        ::memset(vertices, -1, sizeof(vertices));
+    }
+
+    void PushEdge(uint32_t a, uint32_t b) {
+        edges[edgeOffset][0] = a;
+        edges[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    }
+
+    void PushVertex(uint32_t v, bool cond = true) {
+        vertices[vertexOffset] = v;
+        vertexOffset = (vertexOffset + (cond ? 1 : 0)) & 15;
+    }
+};
+
+bool DecodeIndexBuffer(uint8_t *dst, size_t count, size_t byteStride, const uint8_t *src, size_t srcLength) {
+    // header, one code per triangle and the 16 byte table of auxiliary codes
+    if (srcLength < 1 + count / 3 + 16 || (src[0] & 0xf0) != IndexHeader) {
+        return false;
+    }
+    const unsigned int version = src[0] & 0x0f;
+    if (version > 1) {
+        return false;
+    }
+
+    TriangleFifos fifo;
+    uint32_t next = 0;
+    uint32_t last = 0;
+    const unsigned int fecMax = version >= 1 ? 13 : 15;
+
+    const uint8_t *code = src + 1;
+    const uint8_t *data = code + count / 3;
+    // a triangle reads at most 16 bytes, which always stay in front of the table
+    const uint8_t *dataSafeEnd = src + srcLength - 16;
+    const uint8_t *codeAuxTable = dataSafeEnd;
+
+    for (size_t i = 0; i < count; i += 3) {
+        if (data > dataSafeEnd) {
+            return false;
+        }
+
+        uint32_t a, b, c;
+        const uint8_t codeTri = *code++;
+        if (codeTri < 0xf0) {
+            // a recent edge plus a third vertex
+            const size_t fe = codeTri >> 4;
+            a = fifo.edges[(fifo.edgeOffset - 1 - fe) & 15][0];
+            b = fifo.edges[(fifo.edgeOffset - 1 - fe) & 15][1];
+
+            const unsigned int fec = codeTri & 15;
+            if (fec < fecMax) {
+                c = fec == 0 ? next++ : fifo.vertices[(fifo.vertexOffset - 1 - fec) & 15];
+                fifo.PushVertex(c, fec == 0);
+            } else {
+                // 13 and 14 are last - 1 and last + 1, 15 a free index
+                if (fec == 15) {
+                    c = DecodeIndex(data, last);
+                } else {
+                    c = fec == 13 ? last - 1 : last + 1;
+                }
+                last = c;
+                fifo.PushVertex(c);
+            }
+
+            fifo.PushEdge(c, b);
+            fifo.PushEdge(a, c);
+        } else {
+            unsigned int fea, feb, fec;
+            if (codeTri < 0xfe) {
+                // the codes for the three vertices come from the table
+                const uint8_t codeAux = codeAuxTable[codeTri & 15];
+                fea = 0;
+                feb = codeAux >> 4;
+                fec = codeAux & 15;
+            } else {
+                const uint8_t codeAux = *data++;
+                fea = codeTri == 0xfe ? 0 : 15;
+                feb = codeAux >> 4;
+                fec = codeAux & 15;
+                if (codeAux == 0) {
+                    next = 0;
+                }
+            }
+
+            a = fea == 0 ? next++ : 0;
+            b = feb == 0 ? next++ : fifo.vertices[(fifo.vertexOffset - feb) & 15];
+            c = fec == 0 ? next++ : fifo.vertices[(fifo.vertexOffset - fec) & 15];
+
+            if (fea == 15) {
+                last = a = DecodeIndex(data, last);
+            }
+            if (feb == 15) {
+                last = b = DecodeIndex(data, last);
+            }
+            if (fec == 15) {
+                last = c = DecodeIndex(data, last);
+            }
+
+            fifo.PushVertex(a);
+            fifo.PushVertex(b, feb == 0 || feb == 15);
+            fifo.PushVertex(c, fec == 0 || fec == 15);
+
+            fifo.PushEdge(b, a);
+            fifo.PushEdge(c, b);
+            fifo.PushEdge(a, c);
+        }
+
+        WriteIndex(dst, i + 0, byteStride, a);
+        WriteIndex(dst, i + 1, byteStride, b);
+        WriteIndex(dst, i + 2, byteStride, c);
+    }
+
+    return data == dataSafeEnd;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Indices: a varint per index, delta-encoded against one of two baselines.
+bool DecodeIndexSequence(uint8_t *dst, size_t count, size_t byteStride, const uint8_t *src, size_t srcLength) {
+    // header, at least one byte per index and a 4 byte tail
+    if (srcLength < 1 + count + 4 || (src[0] & 0xf0) != SequenceHeader || (src[0] & 0x0f) > 1) {
+        return false;
+    }
+
+    const uint8_t *data = src + 1;
+    const uint8_t *dataSafeEnd = src + srcLength - 4;
+    uint32_t last[2] = { 0, 0 };
+
+    for (size_t i = 0; i < count; ++i) {
+        if (data >= dataSafeEnd) {
+            return false;
+        }
+        const uint32_t v = DecodeVByte(data);
+        const uint32_t baseline = v & 1;
+        const uint32_t index = last[baseline] + Unzigzag32(v >> 1);
+        last[baseline] = index;
+        WriteIndex(dst, i, byteStride, index);
+    }
+
+    return data == dataSafeEnd;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Filters, applied in place after the attribute data was decoded.
+template <typename T>
+void DecodeOctahedralFilter(uint8_t *data, size_t count) {
+    const float max = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+    for (size_t i = 0; i < count; ++i, data += 4 * sizeof(T)) {
+        // x and y are stored, z is reconstructed from the encoded 1.0 in the third component
+        float x = static_cast<float>(Load<T>(data));
+        float y = static_cast<float>(Load<T>(data + sizeof(T)));
+        const float z = static_cast<float>(Load<T>(data + 2 * sizeof(T))) - std::fabs(x) - std::fabs(y);
+
+        // unfold the lower hemisphere
+        const float t = std::min(z, 0.f);
+        x += x >= 0.f ? t : -t;
+        y += y >= 0.f ? t : -t;
+
+        const float s = max / std::sqrt(x * x + y * y + z * z);
+        Store(data, static_cast<T>(std::lround(x * s)));
+        Store(data + sizeof(T), static_cast<T>(std::lround(y * s)));
+        Store(data + 2 * sizeof(T), static_cast<T>(std::lround(z * s)));
+    }
+}
+
+void DecodeQuaternionFilter(uint8_t *data, size_t count) {
+    const float scale = 1.f / std::sqrt(2.f);
+    for (size_t i = 0; i < count; ++i, data += 8) {
+        // the last component holds the scale and the index of the omitted component
+        const int16_t code = Load<int16_t>(data + 6);
+        const float ss = scale / static_cast<float>(code | 3);
+
+        const float x = static_cast<float>(Load<int16_t>(data)) * ss;
+        const float y = static_cast<float>(Load<int16_t>(data + 2)) * ss;
+        const float z = static_cast<float>(Load<int16_t>(data + 4)) * ss;
+        const float w = std::sqrt(std::max(1.f - x * x - y * y - z * z, 0.f));
+
+        const int qc = code & 3;
+        Store(data + ((qc + 1) & 3) * 2, static_cast<int16_t>(std::lround(x * 32767.f)));
+        Store(data + ((qc + 2) & 3) * 2, static_cast<int16_t>(std::lround(y * 32767.f)));
+        Store(data + ((qc + 3) & 3) * 2, static_cast<int16_t>(std::lround(z * 32767.f)));
+        Store(data + ((qc + 0) & 3) * 2, static_cast<int16_t>(std::lround(w * 32767.f)));
+    }
+}
+
+void DecodeExponentialFilter(uint8_t *data, size_t count) {
+    for (size_t i = 0; i < count; ++i, data += 4) {
+        // signed 24 bit mantissa and signed 8 bit exponent
+        const uint32_t v = Load<uint32_t>(data);
+        const int32_t m = static_cast<int32_t>(v << 8) >> 8;
+        const int32_t e = static_cast<int32_t>(v) >> 24;
+        Store(data, std::ldexp(static_cast<float>(m), e));
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+bool IsValidLayout(Mode mode, Filter filter, size_t byteStride, size_t count) {
+    switch (mode) {
+    case Mode_ATTRIBUTES:
+        if (byteStride == 0 || byteStride > VertexBlockMaxSize || byteStride % 4 != 0) {
+            return false;
+        }
+        switch (filter) {
+        case Filter_OCTAHEDRAL:
+            return byteStride == 4 || byteStride == 8;
+        case Filter_QUATERNION:
+            return byteStride == 8;
+        default:
+            return true;
+        }
+    case Mode_TRIANGLES:
+        return (byteStride == 2 || byteStride == 4) && count % 3 == 0 && filter == Filter_NONE;
+    case Mode_INDICES:
+        return (byteStride == 2 || byteStride == 4) && filter == Filter_NONE;
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Decode(uint8_t *dst, size_t count, size_t byteStride, const uint8_t *src, size_t srcLength, Mode mode, Filter filter) {
+    if (!IsValidLayout(mode, filter, byteStride, count)) {
+        return false;
+    }
+
+    switch (mode) {
+    case Mode_ATTRIBUTES:
+        if (!DecodeVertexBuffer(dst, count, byteStride, src, srcLength)) {
+            return false;
+        }
+        break;
+    case Mode_TRIANGLES:
+        return DecodeIndexBuffer(dst, count, byteStride, src, srcLength);
+    case Mode_INDICES:
+        return DecodeIndexSequence(dst, count, byteStride, src, srcLength);
+    }
+
+    switch (filter) {
+    case Filter_OCTAHEDRAL:
+        if (byteStride == 4) {
+            DecodeOctahedralFilter<int8_t>(dst, count);
+        } else {
+            DecodeOctahedralFilter<int16_t>(dst, count);
+        }
+        break;
+    case Filter_QUATERNION:
+        DecodeQuaternionFilter(dst, count);
+        break;
+    case Filter_EXPONENTIAL:
+        DecodeExponentialFilter(dst, count * byteStride / 4);
+        break;
+    case Filter_NONE:
+        break;
+    }
+    return true;
+}
+
+} // namespace Meshopt
+} // namespace glTF2
+
+#endif // !ASSIMP_BUILD_NO_GLTF_IMPORTER && !ASSIMP_BUILD_NO_GLTF2_IMPORTER
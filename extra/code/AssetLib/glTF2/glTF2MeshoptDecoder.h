@@ -0,0 +1,87 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file glTF2MeshoptDecoder.h
+ *  Decoder for buffer views compressed with EXT_meshopt_compression.
+ *
+ *  The bitstream is described in
+ *  https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/EXT_meshopt_compression
+ */
+#ifndef GLTF2MESHOPTDECODER_H_INC
+#define GLTF2MESHOPTDECODER_H_INC
+
+#if !defined(ASSIMP_BUILD_NO_GLTF_IMPORTER) && !defined(ASSIMP_BUILD_NO_GLTF2_IMPORTER)
+
+#include <cstddef>
+#include <cstdint>
+
+namespace glTF2 {
+namespace Meshopt {
+
+//! Values for the "mode" property of the extension
+enum Mode {
+    Mode_ATTRIBUTES,
+    Mode_TRIANGLES,
+    Mode_INDICES
+};
+
+//! Values for the "filter" property of the extension
+enum Filter {
+    Filter_NONE,
+    Filter_OCTAHEDRAL,
+    Filter_QUATERNION,
+    Filter_EXPONENTIAL
+};
+
+//! Returns true if the mode, filter and stride may be used together.
+bool IsValidLayout(Mode mode, Filter filter, size_t byteStride, size_t count);
+
+//! Decodes count elements of byteStride bytes each from the compressed
+//! data into dst, which must hold count * byteStride bytes.
+//! Returns false if the compressed data is malformed.
+bool Decode(uint8_t *dst, size_t count, size_t byteStride, const uint8_t *src, size_t srcLength, Mode mode, Filter filter);
+
+} // namespace Meshopt
+} // namespace glTF2
+
+#endif // !ASSIMP_BUILD_NO_GLTF_IMPORTER && !ASSIMP_BUILD_NO_GLTF2_IMPORTER
+
+#endif // GLTF2MESHOPTDECODER_H_INC
@@ -51,11 +51,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
+#include <assimp/Profiler.h>
 
 #include "CApi/CInterfaceIOWrapper.h"
 #include "Importer.h"
 #include "ScenePrivate.h"
 
+#include <fstream>
 #include <list>
 
 // ------------------------------------------------------------------------------------------------
@@ -522,6 +524,31 @@ void aiGetMemoryRequirements(const C_STRUCT aiScene *pIn,
     ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+aiReturn aiWriteProfilerTrace(const C_STRUCT aiScene *pIn, const char *pFile) {
+    ai_assert(nullptr != pFile);
+
+    // find the importer associated with this data
+    const ScenePrivateData *priv = ScenePriv(pIn);
+    if (!priv || !priv->mOrigImporter) {
+        ReportSceneNotFoundError();
+        return aiReturn_FAILURE;
+    }
+
+    const Profiling::Profiler *profiler = priv->mOrigImporter->GetProfiler();
+    if (nullptr == profiler) {
+        ASSIMP_LOG_ERROR("Unable to write profiler trace: AI_CONFIG_GLOB_MEASURE_TIME was not set");
+        return aiReturn_FAILURE;
+    }
+
+    std::ofstream out(pFile);
+    if (!out) {
+        return aiReturn_FAILURE;
+    }
+    profiler->WriteChromeTrace(out);
+    return out ? aiReturn_SUCCESS : aiReturn_FAILURE;
+}
+
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API const C_STRUCT aiTexture *aiGetEmbeddedTexture(const C_STRUCT aiScene *pIn, const char *filename) {
     return pIn->GetEmbeddedTexture(filename);
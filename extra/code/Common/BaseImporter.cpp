@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FileSystemFilter.h"
 #include "Importer.h"
+#include "ParallelFor.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/ByteSwapper.h>
 #include <assimp/ParsingUtils.h>
@@ -53,10 +54,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 
+#include <algorithm>
 #include <cctype>
 #include <ios>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <sstream>
 
 namespace {
@@ -514,13 +517,70 @@ struct LoadRequest {
     BatchLoader::PropertyMap map;
     unsigned int id;
 };
+
+// ------------------------------------------------------------------------------------------------
+// The IOSystem of a worker importer when loading on several threads. Calls
+// into the shared IOSystem are serialized, the directory stack belongs to
+// the worker and starts at the current directory of the shared one.
+class BatchIOSystem : public IOSystem {
+public:
+    BatchIOSystem(IOSystem *shared, std::mutex &mutex) :
+            mShared(shared), mMutex(mutex) {
+        if (mShared->StackSize() > 0) {
+            PushDirectory(mShared->CurrentDirectory());
+        }
+    }
+
+    bool Exists(const char *pFile) const override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mShared->Exists(pFile);
+    }
+
+    char getOsSeparator() const override {
+        return mShared->getOsSeparator();
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mShared->Open(pFile, pMode);
+    }
+
+    void Close(IOStream *pFile) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShared->Close(pFile);
+    }
+
+    bool ComparePaths(const char *one, const char *second) const override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mShared->ComparePaths(one, second);
+    }
+
+    bool CreateDirectory(const std::string &path) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mShared->CreateDirectory(path);
+    }
+
+    bool ChangeDirectory(const std::string &path) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mShared->ChangeDirectory(path);
+    }
+
+    bool DeleteFile(const std::string &file) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mShared->DeleteFile(file);
+    }
+
+private:
+    IOSystem *mShared;
+    std::mutex &mMutex;
+};
 } // namespace Assimp
 
 // ------------------------------------------------------------------------------------------------
 // BatchLoader::pimpl data structure
 struct Assimp::BatchData {
     BatchData(IOSystem *pIO, bool validate) :
-            pIOSystem(pIO), pImporter(nullptr), next_id(0xffff), validate(validate) {
+            pIOSystem(pIO), pImporter(nullptr), next_id(0xffff), validate(validate), numThreads(1) {
         ai_assert(nullptr != pIO);
 
         pImporter = new Importer();
@@ -530,6 +590,31 @@ struct Assimp::BatchData {
     ~BatchData() {
         pImporter->SetIOHandler(nullptr); /* get pointer back into our possession */
         delete pImporter;
+
+        // the worker importers own their BatchIOSystem
+        for (Importer *worker : workers) {
+            delete worker;
+        }
+    }
+
+    // Takes an idle worker importer or creates a new one, there are never
+    // more than numThreads of them
+    Importer *AcquireWorker() {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        if (idleWorkers.empty()) {
+            Importer *worker = new Importer();
+            worker->SetIOHandler(new BatchIOSystem(pIOSystem, ioMutex));
+            workers.push_back(worker);
+            return worker;
+        }
+        Importer *worker = idleWorkers.back();
+        idleWorkers.pop_back();
+        return worker;
+    }
+
+    void ReleaseWorker(Importer *worker) {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        idleWorkers.push_back(worker);
     }
 
     // IO system to be used for all imports
@@ -549,10 +634,50 @@ struct Assimp::BatchData {
 
     // Validation enabled state
     bool validate;
+
+    // Number of requests loaded at the same time
+    unsigned int numThreads;
+
+    // Importers used when loading on several threads, each with its own
+    // property maps, and the ones which are not in use
+    std::vector<Importer *> workers;
+    std::vector<Importer *> idleWorkers;
+    std::mutex workerMutex;
+
+    // Serializes the calls into pIOSystem
+    std::mutex ioMutex;
 };
 
 typedef std::list<LoadRequest>::iterator LoadReqIt;
 
+namespace {
+// Loads a single request with the given importer
+void LoadRequestWith(Importer &importer, LoadRequest &req, bool validate) {
+    // force validation in debug builds
+    unsigned int pp = req.flags;
+    if (validate) {
+        pp |= aiProcess_ValidateDataStructure;
+    }
+
+    // setup config properties if necessary
+    ImporterPimpl *pimpl = importer.Pimpl();
+    pimpl->mFloatProperties = req.map.floats;
+    pimpl->mIntProperties = req.map.ints;
+    pimpl->mStringProperties = req.map.strings;
+    pimpl->mMatrixProperties = req.map.matrices;
+
+    if (!DefaultLogger::isNullLogger()) {
+        ASSIMP_LOG_INFO("%%% BEGIN EXTERNAL FILE %%%");
+        ASSIMP_LOG_INFO("File: ", req.file);
+    }
+    importer.ReadFile(req.file, pp);
+    req.scene = importer.GetOrphanedScene();
+    req.loaded = true;
+
+    ASSIMP_LOG_INFO("%%% END EXTERNAL FILE %%%");
+}
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 BatchLoader::BatchLoader(IOSystem *pIO, bool validate) {
     ai_assert(nullptr != pIO);
@@ -579,6 +704,16 @@ bool BatchLoader::getValidation() const {
     return m_data->validate;
 }
 
+// ------------------------------------------------------------------------------------------------
+void BatchLoader::setNumThreads(unsigned int numThreads) {
+    m_data->numThreads = numThreads;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int BatchLoader::getNumThreads() const {
+    return m_data->numThreads;
+}
+
 // ------------------------------------------------------------------------------------------------
 unsigned int BatchLoader::AddLoadRequest(const std::string &file,
         unsigned int steps /*= 0*/, const PropertyMap *map /*= nullptr*/) {
@@ -586,6 +721,9 @@ unsigned int BatchLoader::AddLoadRequest(const std::string &file,
 
     // check whether we have this loading request already
     for (LoadReqIt it = m_data->requests.begin(); it != m_data->requests.end(); ++it) {
+        if ((*it).flags != steps) {
+            continue;
+        }
         // Call IOSystem's path comparison function here
         if (m_data->pIOSystem->ComparePaths((*it).file, file)) {
             if (map) {
@@ -622,29 +760,26 @@ aiScene *BatchLoader::GetImport(unsigned int which) {
 
 // ------------------------------------------------------------------------------------------------
 void BatchLoader::LoadAll() {
-    // no threaded implementation for the moment
+    std::vector<LoadRequest *> pending;
     for (LoadReqIt it = m_data->requests.begin(); it != m_data->requests.end(); ++it) {
-        // force validation in debug builds
-        unsigned int pp = (*it).flags;
-        if (m_data->validate) {
-            pp |= aiProcess_ValidateDataStructure;
+        if (!(*it).loaded) {
+            pending.push_back(&(*it));
         }
+    }
 
-        // setup config properties if necessary
-        ImporterPimpl *pimpl = m_data->pImporter->Pimpl();
-        pimpl->mFloatProperties = (*it).map.floats;
-        pimpl->mIntProperties = (*it).map.ints;
-        pimpl->mStringProperties = (*it).map.strings;
-        pimpl->mMatrixProperties = (*it).map.matrices;
-
-        if (!DefaultLogger::isNullLogger()) {
-            ASSIMP_LOG_INFO("%%% BEGIN EXTERNAL FILE %%%");
-            ASSIMP_LOG_INFO("File: ", (*it).file);
+    if (m_data->numThreads <= 1 || pending.size() <= 1) {
+        for (LoadRequest *req : pending) {
+            LoadRequestWith(*m_data->pImporter, *req, m_data->validate);
         }
-        m_data->pImporter->ReadFile((*it).file, pp);
-        (*it).scene = m_data->pImporter->GetOrphanedScene();
-        (*it).loaded = true;
-
-        ASSIMP_LOG_INFO("%%% END EXTERNAL FILE %%%");
+        return;
     }
+
+    // Every request is loaded by an importer of its own, the requests are
+    // handed out to at most numThreads threads
+    const unsigned int numThreads = std::min(m_data->numThreads, static_cast<unsigned int>(pending.size()));
+    ParallelFor(static_cast<unsigned int>(pending.size()), numThreads, [this, &pending](unsigned int i) {
+        Importer *worker = m_data->AcquireWorker();
+        LoadRequestWith(*worker, *pending[i], m_data->validate);
+        m_data->ReleaseWorker(worker);
+    });
 }
@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include "Importer.h"
+#include "ParallelFor.h"
+#include <assimp/config.h>
 #include <assimp/BaseImporter.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
@@ -53,7 +55,9 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess() AI_NO_EXCEPT
         : shared(),
-          progress() {
+          progress(),
+          mNumThreads(1),
+          mProfiler(nullptr) {
     // empty
 }
 
@@ -75,6 +79,8 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
         return;
     }
 
+    mNumThreads = GetNumThreads(pImp->GetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 1));
+    mProfiler = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? pImp->Pimpl()->mProfiler : nullptr;
     SetupProperties(pImp);
 
     // catch exceptions thrown inside the PostProcess-Step
@@ -101,3 +107,8 @@ void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
 bool BaseProcess::RequireVerboseFormat() const {
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ForEachMesh(unsigned int numMeshes, const std::function<void(unsigned int)> &func) const {
+    ParallelFor(numMeshes, mNumThreads, func);
+}
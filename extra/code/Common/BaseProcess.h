@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/GenericProperty.h>
 
+#include <functional>
 #include <map>
 
 struct aiScene;
@@ -53,6 +54,10 @@ namespace Assimp {
 
 class Importer;
 
+namespace Profiling {
+class Profiler;
+}
+
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
  *
@@ -243,11 +248,29 @@ public:
     }
 
 protected:
+    // -------------------------------------------------------------------
+    /** Calls func(i) for every mesh index i of the scene, on up to
+     *  #AI_CONFIG_PP_NUM_THREADS threads. Only for work which touches
+     *  nothing but the mesh i; per-mesh results must be stored by index
+     *  and combined in order afterwards to keep the output deterministic.
+     * @param numMeshes Number of meshes, usually pScene->mNumMeshes
+     * @param func      Work for one mesh
+     */
+    void ForEachMesh(unsigned int numMeshes, const std::function<void(unsigned int)> &func) const;
+
     /** See the doc of #SharedPostProcessInfo for more details */
     SharedPostProcessInfo *shared;
 
     /** Currently active progress handler */
     ProgressHandler *progress;
+
+    /** Threads the step may use, read from #AI_CONFIG_PP_NUM_THREADS */
+    unsigned int mNumThreads;
+
+    /** Profiler to record details of the step into, nullptr unless
+     *  #AI_CONFIG_GLOB_MEASURE_TIME is set. Only to be used from the
+     *  thread calling Execute(). */
+    Profiling::Profiler *mProfiler;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,200 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file CountingIOSystem.h
+ *  Wraps an IOSystem to count the files opened and the bytes read through it
+ */
+#pragma once
+#ifndef AI_COUNTINGIOSYSTEM_H_INC
+#define AI_COUNTINGIOSYSTEM_H_INC
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/ai_assert.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Byte and file counts collected by a CountingIOSystem */
+struct IOCounters {
+    std::atomic<uint64_t> mBytesRead{ 0 };
+    std::atomic<uint64_t> mBytesWritten{ 0 };
+    std::atomic<unsigned int> mFilesOpened{ 0 };
+};
+
+// ---------------------------------------------------------------------------
+/** Stream handed out by CountingIOSystem, forwards to the wrapped stream.
+ *  Importers either Close() a stream or delete it directly, so the wrapped
+ *  stream is closed in the destructor.
+ */
+class CountingIOStream : public IOStream {
+public:
+    CountingIOStream(IOStream *stream, IOSystem *system, IOCounters &counters) :
+            mStream(stream), mSystem(system), mCounters(counters) {
+        ai_assert(nullptr != mStream);
+    }
+
+    ~CountingIOStream() override {
+        mSystem->Close(mStream);
+    }
+
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override {
+        const size_t count = mStream->Read(pvBuffer, pSize, pCount);
+        mCounters.mBytesRead += count * pSize;
+        return count;
+    }
+
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override {
+        const size_t count = mStream->Write(pvBuffer, pSize, pCount);
+        mCounters.mBytesWritten += count * pSize;
+        return count;
+    }
+
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override {
+        return mStream->Seek(pOffset, pOrigin);
+    }
+
+    size_t Tell() const override {
+        return mStream->Tell();
+    }
+
+    size_t FileSize() const override {
+        return mStream->FileSize();
+    }
+
+    void Flush() override {
+        mStream->Flush();
+    }
+
+    /// Loaders parsing the mapping in place read the whole file once
+    const uint8_t *GetMappedData() const override {
+        const uint8_t *data = mStream->GetMappedData();
+        if (nullptr != data && !mMappedCounted) {
+            mCounters.mBytesRead += mStream->FileSize();
+            mMappedCounted = true;
+        }
+        return data;
+    }
+
+private:
+    IOStream *mStream;
+    IOSystem *mSystem;
+    IOCounters &mCounters;
+    mutable bool mMappedCounted = false;
+};
+
+// ---------------------------------------------------------------------------
+/** Forwards everything to the wrapped IOSystem and counts what goes through
+ *  the streams it opens. Used by the importer to attach I/O counters to the
+ *  profiler regions, see #AI_CONFIG_GLOB_MEASURE_TIME.
+ */
+class CountingIOSystem : public IOSystem {
+public:
+    CountingIOSystem(IOSystem *wrapped, IOCounters &counters) :
+            mWrapped(wrapped), mCounters(counters) {
+        ai_assert(nullptr != mWrapped);
+    }
+
+    ~CountingIOSystem() override = default;
+
+    bool Exists(const char *pFile) const override {
+        return mWrapped->Exists(pFile);
+    }
+
+    char getOsSeparator() const override {
+        return mWrapped->getOsSeparator();
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        IOStream *stream = mWrapped->Open(pFile, pMode);
+        if (nullptr == stream) {
+            return nullptr;
+        }
+        ++mCounters.mFilesOpened;
+        return new CountingIOStream(stream, mWrapped, mCounters);
+    }
+
+    void Close(IOStream *pFile) override {
+        delete pFile;
+    }
+
+    bool ComparePaths(const char *one, const char *second) const override {
+        return mWrapped->ComparePaths(one, second);
+    }
+
+    bool PushDirectory(const std::string &path) override {
+        return mWrapped->PushDirectory(path);
+    }
+
+    const std::string &CurrentDirectory() const override {
+        return mWrapped->CurrentDirectory();
+    }
+
+    size_t StackSize() const override {
+        return mWrapped->StackSize();
+    }
+
+    bool PopDirectory() override {
+        return mWrapped->PopDirectory();
+    }
+
+    bool CreateDirectory(const std::string &path) override {
+        return mWrapped->CreateDirectory(path);
+    }
+
+    bool ChangeDirectory(const std::string &path) override {
+        return mWrapped->ChangeDirectory(path);
+    }
+
+    bool DeleteFile(const std::string &file) override {
+        return mWrapped->DeleteFile(file);
+    }
+
+private:
+    IOSystem *mWrapped;
+    IOCounters &mCounters;
+};
+
+} // namespace Assimp
+
+#endif // AI_COUNTINGIOSYSTEM_H_INC
@@ -58,9 +58,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/NullLogger.hpp>
 #include <iostream>
 
-#ifndef ASSIMP_BUILD_SINGLETHREADED
+#include <atomic>
 #include <mutex>
 #include <thread>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
 std::mutex loggerMutex;
 #endif
 
@@ -321,9 +323,8 @@ bool DefaultLogger::attachStream(LogStream *pStream, unsigned int severity) {
         severity = SeverityAll;
     }
 
-#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // always taken, post processing steps may log from several threads
     std::lock_guard<std::mutex> lock(m_arrayMutex);
-#endif
 
     for (StreamIt it = m_StreamArray.begin();
             it != m_StreamArray.end();
@@ -350,9 +351,8 @@ bool DefaultLogger::detachStream(LogStream *pStream, unsigned int severity) {
         severity = SeverityAll;
     }
 
-#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // always taken, post processing steps may log from several threads
     std::lock_guard<std::mutex> lock(m_arrayMutex);
-#endif
 
     bool res(false);
     for (StreamIt it = m_StreamArray.begin(); it != m_StreamArray.end(); ++it) {
@@ -393,9 +393,8 @@ DefaultLogger::~DefaultLogger() {
 void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev) {
     ai_assert(nullptr != message);
 
-#ifndef ASSIMP_BUILD_SINGLETHREADED
+    // always taken, post processing steps may log from several threads
     std::lock_guard<std::mutex> lock(m_arrayMutex);
-#endif
 
     // Check whether this is a repeated message
     auto thisLen = ::strlen(message);
@@ -426,12 +425,13 @@ void DefaultLogger::WriteToStreams(const char *message, ErrorSeverity ErrorSev)
 // ----------------------------------------------------------------------------------
 //  Returns thread id, if not supported only a zero will be returned.
 unsigned int DefaultLogger::GetThreadID() {
-    // fixme: we can get this value via std::threads
-    // std::this_thread::get_id().hash() returns a (big) size_t, not sure if this is useful in this case.
 #ifdef WIN32
     return (unsigned int)::GetCurrentThreadId();
 #else
-    return 0; // not supported
+    // small sequential ids in the order threads first log, the first one is 0
+    static std::atomic<unsigned int> nextID(0);
+    thread_local unsigned int id = nextID++;
+    return id;
 #endif
 }
 
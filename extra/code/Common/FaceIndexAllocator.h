@@ -0,0 +1,158 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file Defines a helper to allocate the index arrays of new faces */
+#ifndef AI_FACEINDEXALLOCATOR_H_INC
+#define AI_FACEINDEXALLOCATOR_H_INC
+
+#include <assimp/mesh.h>
+#include <assimp/ai_assert.h>
+
+#include <cstring>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief Hands out the index arrays for the faces of a mesh under
+ *  construction.
+ *
+ *  In pooled mode all arrays are carved out of one allocation, which is
+ *  handed over to the mesh with Attach() (see aiMesh::mFaceIndices). A
+ *  pool which is never attached is released with the allocator. Otherwise
+ *  every array is allocated separately, as faces normally expect.
+ */
+class FaceIndexAllocator {
+public:
+    /** @param pooled      Whether to allocate from a pool.
+     *  @param numIndices  Total number of indices of all faces, only
+     *    needed in pooled mode. */
+    FaceIndexAllocator(bool pooled, size_t numIndices) :
+            mPool(pooled ? new unsigned int[numIndices] : nullptr),
+            mSize(numIndices),
+            mUsed(0) {
+        // empty
+    }
+
+    ~FaceIndexAllocator() {
+        delete[] mPool;
+    }
+
+    FaceIndexAllocator(const FaceIndexAllocator &) = delete;
+    FaceIndexAllocator &operator=(const FaceIndexAllocator &) = delete;
+
+    /** Returns true if the arrays come from a pool. */
+    bool IsPooled() const {
+        return mPool != nullptr;
+    }
+
+    /** Returns an uninitialized array for num indices. */
+    unsigned int *Allocate(unsigned int num) {
+        return AllocateAt(mUsed, num);
+    }
+
+    /** Returns an array holding the indices of face. Without a pool the
+     *  array is taken over from the face, which is left without indices. */
+    unsigned int *Move(aiFace &face) {
+        return MoveAt(mUsed, face);
+    }
+
+    /** Returns an uninitialized array for num indices, at most as many as
+     *  face has. Without a pool the array of the face is reused for it. */
+    unsigned int *Reuse(aiFace &face, unsigned int num) {
+        return ReuseAt(mUsed, face, num);
+    }
+
+    /** The At variants hand out the pool from offset on and advance it,
+     *  instead of keeping the position themselves. Faces whose offsets
+     *  are known in advance can so be filled from several threads. */
+    unsigned int *AllocateAt(size_t &offset, unsigned int num) {
+        if (nullptr == mPool) {
+            return new unsigned int[num];
+        }
+        ai_assert(offset + num <= mSize);
+        unsigned int *indices = mPool + offset;
+        offset += num;
+        return indices;
+    }
+
+    unsigned int *MoveAt(size_t &offset, aiFace &face) {
+        if (nullptr == mPool) {
+            unsigned int *indices = face.mIndices;
+            face.mIndices = nullptr;
+            return indices;
+        }
+        unsigned int *indices = AllocateAt(offset, face.mNumIndices);
+        ::memcpy(indices, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+        return indices;
+    }
+
+    unsigned int *ReuseAt(size_t &offset, aiFace &face, unsigned int num) {
+        ai_assert(num <= face.mNumIndices);
+        if (nullptr == mPool) {
+            unsigned int *indices = face.mIndices;
+            face.mIndices = nullptr;
+            return indices;
+        }
+        return AllocateAt(offset, num);
+    }
+
+    /** Hands the pool over to a mesh whose faces use it. The mesh must not
+     *  have a pool yet, call aiMesh::DeleteFaces() before. */
+    void Attach(aiMesh *mesh) {
+        if (nullptr == mPool) {
+            return;
+        }
+        ai_assert(nullptr == mesh->mFaceIndices);
+        mesh->mFaceIndices = mPool;
+        mesh->mNumFaceIndices = static_cast<unsigned int>(mSize);
+        mPool = nullptr;
+    }
+
+private:
+    unsigned int *mPool;
+    size_t mSize;
+    size_t mUsed;
+};
+
+} // namespace Assimp
+
+#endif // AI_FACEINDEXALLOCATOR_H_INC
@@ -64,6 +64,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // ------------------------------------------------------------------------------------------------
 #include "Common/Importer.h"
 #include "Common/BaseProcess.h"
+#include "Common/CountingIOSystem.h"
 #include "Common/DefaultProgressHandler.h"
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/ScenePreprocessor.h"
@@ -73,15 +74,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/GenericProperty.h>
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/Profiler.h>
+#include <assimp/SceneCombiner.h>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
-#include <assimp/Profiler.h>
 #include <assimp/commonMetaData.h>
 
 #include <exception>
 #include <set>
 #include <memory>
 #include <cctype>
+#include <typeinfo>
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -193,6 +195,8 @@ Importer::~Importer() {
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    delete pimpl->mProfiler;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -377,6 +381,115 @@ bool _ValidateFlags(unsigned int pFlags) {
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Returns the profiler to record into, nullptr if AI_CONFIG_GLOB_MEASURE_TIME is not set
+static Profiler *GetActiveProfiler(const Importer *importer, ImporterPimpl *pimpl) {
+    if (!importer->GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0)) {
+        return nullptr;
+    }
+    if (nullptr == pimpl->mProfiler) {
+        pimpl->mProfiler = new Profiler();
+    }
+    return pimpl->mProfiler;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Attach the size of the scene to the innermost open region, suffix is "in" or "out"
+static void AddSceneCounters(Profiler *profiler, const aiScene *scene, const std::string &suffix) {
+    if (nullptr == scene) {
+        return;
+    }
+    int64_t vertices = 0, faces = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        vertices += scene->mMeshes[i]->mNumVertices;
+        faces += scene->mMeshes[i]->mNumFaces;
+    }
+    profiler->AddCounter("meshes_" + suffix, scene->mNumMeshes);
+    profiler->AddCounter("vertices_" + suffix, vertices);
+    profiler->AddCounter("faces_" + suffix, faces);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Name of a post processing step for the profiler, the class name without namespaces
+static std::string GetStepName(const BaseProcess *process) {
+    const std::string name = typeid(*process).name();
+
+    // MSVC gives "class Assimp::JoinVerticesProcess"
+    if (name.find(' ') != std::string::npos) {
+        return name.substr(name.find_last_of(" :") + 1);
+    }
+
+    // Itanium ABI (gcc, clang) gives "N6Assimp19JoinVerticesProcessE" or "19JoinVerticesProcess",
+    // a list of length prefixed identifiers
+    std::string last;
+    for (size_t i = name.find_first_of("0123456789"); i < name.length() && ::isdigit(name[i]);) {
+        size_t len = 0;
+        while (i < name.length() && ::isdigit(name[i])) {
+            len = len * 10 + (name[i++] - '0');
+        }
+        last = name.substr(i, len);
+        i += len;
+    }
+    return last.empty() ? name : last;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Run one post processing step, recording it as its own region
+static void ExecuteStep(Importer *importer, ImporterPimpl *pimpl, Profiler *profiler, BaseProcess *process) {
+    if (nullptr == profiler) {
+        process->ExecuteOnScene(importer);
+        return;
+    }
+
+    const std::string name = GetStepName(process);
+    ScopedRegion region(profiler, name);
+    AddSceneCounters(profiler, pimpl->mScene, "in");
+    process->ExecuteOnScene(importer);
+    AddSceneCounters(profiler, pimpl->mScene, "out");
+}
+
+// ------------------------------------------------------------------------------------------------
+// Exchange the contents of two scenes, except for name, skeletons and private data
+static void SwapSceneContents(aiScene *a, aiScene *b) {
+    std::swap(a->mFlags, b->mFlags);
+    std::swap(a->mRootNode, b->mRootNode);
+    std::swap(a->mNumMeshes, b->mNumMeshes);
+    std::swap(a->mMeshes, b->mMeshes);
+    std::swap(a->mNumMaterials, b->mNumMaterials);
+    std::swap(a->mMaterials, b->mMaterials);
+    std::swap(a->mNumAnimations, b->mNumAnimations);
+    std::swap(a->mAnimations, b->mAnimations);
+    std::swap(a->mNumTextures, b->mNumTextures);
+    std::swap(a->mTextures, b->mTextures);
+    std::swap(a->mNumLights, b->mNumLights);
+    std::swap(a->mLights, b->mLights);
+    std::swap(a->mNumCameras, b->mNumCameras);
+    std::swap(a->mCameras, b->mCameras);
+    std::swap(a->mMetaData, b->mMetaData);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Move the contents of the current scene into an arena or back out of it. The aiScene object
+// itself is kept, so pointers returned by ReadFile() stay valid.
+static void UseSceneArena(ImporterPimpl *pimpl, Profiler *profiler, bool arena) {
+    aiScene *scene = pimpl->mScene;
+    if (nullptr == scene || (nullptr != ScenePriv(scene)->mArena) == arena) {
+        return;
+    }
+    ScopedRegion region(profiler, "arena");
+
+    aiScene *old = new aiScene();
+    SwapSceneContents(scene, old);
+    ScenePriv(old)->mArena = std::move(ScenePriv(scene)->mArena);
+    ScenePriv(old)->mPPStepsApplied = ScenePriv(scene)->mPPStepsApplied;
+    if (arena) {
+        SceneCombiner::CopySceneToArena(&scene, old, false);
+    } else {
+        SceneCombiner::CopyScene(&scene, old, false);
+    }
+    delete old;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Free the current scene
 void Importer::FreeScene( ) {
@@ -618,10 +731,12 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             return nullptr;
         }
 
-        std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+        // a new import starts a new trace, post processing applied later is appended to it
+        Profiler *profiler = GetActiveProfiler(this, pimpl);
         if (profiler) {
-            profiler->BeginRegion("total");
+            profiler->Clear();
         }
+        ScopedRegion total(profiler, "total");
 
         // Find an worker class which can handle the file extension.
         // Multiple importers may be able to handle the same extension (.xml!); gather them all.
@@ -703,15 +818,21 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         pimpl->mProgressHandler->UpdateFileRead( 0, fileSize );
 
         if (profiler) {
-            profiler->BeginRegion("import");
-        }
-
-        pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
-        pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
+            // count what the importer reads, including external files it opens
+            IOCounters io;
+            CountingIOSystem countingIO(pimpl->mIOHandler, io);
 
-        if (profiler) {
+            profiler->BeginRegion("import");
+            pimpl->mScene = imp->ReadFile( this, pFile, &countingIO);
+            profiler->AddCounter("file_size", fileSize);
+            profiler->AddCounter("bytes_read", io.mBytesRead);
+            profiler->AddCounter("files_opened", io.mFilesOpened);
+            AddSceneCounters(profiler, pimpl->mScene, "out");
             profiler->EndRegion("import");
+        } else {
+            pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
         }
+        pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
         SetPropertyString("sourceFilePath", pFile);
 
@@ -728,7 +849,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure) {
                 ValidateDSProcess ds;
-                ds.ExecuteOnScene (this);
+                ExecuteStep(this, pimpl, profiler, &ds);
                 if (!pimpl->mScene) {
                     return nullptr;
                 }
@@ -749,6 +870,8 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
             // Ensure that the validation process won't be called twice
             ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+            UseSceneArena(pimpl, profiler, GetPropertyBool(AI_CONFIG_IMPORT_SCENE_ARENA, false));
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -759,8 +882,10 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         // clear any data allocated by post-process steps
         pimpl->mPPShared->Clean();
 
-        if (profiler) {
-            profiler->EndRegion("total");
+        if (profiler && pimpl->mScene) {
+            aiMemoryInfo mem;
+            GetMemoryRequirements(mem);
+            profiler->AddCounter("scene_bytes", mem.total);
         }
     }
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
@@ -805,12 +930,18 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     ai_assert(_ValidateFlags(pFlags));
     ASSIMP_LOG_INFO("Entering post processing pipeline");
 
+    Profiler *profiler = GetActiveProfiler(this, pimpl);
+    ScopedRegion postprocess(profiler, "postprocess");
+
+    // the steps modify the scene, which an arena doesn't allow
+    UseSceneArena(pimpl, profiler, false);
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
     // list of post-processing steps, so we need to call it manually.
     if (pFlags & aiProcess_ValidateDataStructure) {
         ValidateDSProcess ds;
-        ds.ExecuteOnScene (this);
+        ExecuteStep(this, pimpl, profiler, &ds);
         if (!pimpl->mScene) {
             return nullptr;
         }
@@ -830,20 +961,11 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
         if( process->IsActive( pFlags)) {
-            if (profiler) {
-                profiler->BeginRegion("postprocess");
-            }
-
-            process->ExecuteOnScene ( this );
-
-            if (profiler) {
-                profiler->EndRegion("postprocess");
-            }
+            ExecuteStep(this, pimpl, profiler, process);
         }
         if( !pimpl->mScene) {
             break;
@@ -874,6 +996,7 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
 
     // clear any data allocated by post-process steps
     pimpl->mPPShared->Clean();
+    UseSceneArena(pimpl, profiler, GetPropertyBool(AI_CONFIG_IMPORT_SCENE_ARENA, false));
     ASSIMP_LOG_INFO("Leaving post processing pipeline");
 
     ASSIMP_END_EXCEPTION_REGION(const aiScene*);
@@ -925,17 +1048,11 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+    Profiler *profiler = GetActiveProfiler(this, pimpl);
+    ScopedRegion postprocess(profiler, "postprocess");
 
-    if ( profiler ) {
-        profiler->BeginRegion( "postprocess" );
-    }
-
-    rootProcess->ExecuteOnScene( this );
-
-    if ( profiler ) {
-        profiler->EndRegion( "postprocess" );
-    }
+    UseSceneArena(pimpl, profiler, false);
+    ExecuteStep(this, pimpl, profiler, rootProcess);
 
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // If the extra verbose mode is active, execute the ValidateDataStructureStep again - after each step
@@ -952,6 +1069,7 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
 
     // clear any data allocated by post-process steps
     pimpl->mPPShared->Clean();
+    UseSceneArena(pimpl, profiler, GetPropertyBool(AI_CONFIG_IMPORT_SCENE_ARENA, false));
     ASSIMP_LOG_INFO( "Leaving customized post processing pipeline" );
 
     ASSIMP_END_EXCEPTION_REGION( const aiScene* );
@@ -1174,6 +1292,13 @@ void AddNodeWeight(unsigned int& iScene,const aiNode* pcNode) {
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the timings of the last import
+const Profiler* Importer::GetProfiler() const {
+    ai_assert(nullptr != pimpl);
+    return pimpl->mProfiler;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get the memory requirements of the scene
 void Importer::GetMemoryRequirements(aiMemoryInfo& in) const {
@@ -59,6 +59,10 @@ namespace Assimp {
     class BaseProcess;
     class SharedPostProcessInfo;
 
+namespace Profiling {
+    class Profiler;
+}
+
 
 //! @cond never
 // ---------------------------------------------------------------------------
@@ -126,6 +130,10 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Timings of the last import, created on demand if
+     *  AI_CONFIG_GLOB_MEASURE_TIME is set */
+    Profiling::Profiler* mProfiler;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 
@@ -149,7 +157,8 @@ inline ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mMatrixProperties(),
         mPointerProperties(),
         bExtraVerbose( false ),
-        mPPShared( nullptr ) {
+        mPPShared( nullptr ),
+        mProfiler( nullptr ) {
     // empty
 }
 //! @endcond
@@ -160,8 +169,9 @@ struct BatchData;
 /** FOR IMPORTER PLUGINS ONLY: A helper class to the pleasure of importers
  *  that need to load many external meshes recursively.
  *
- *  The class uses several threads to load these meshes (or at least it
- *  could, this has not yet been implemented at the moment).
+ *  With more than one thread set, LoadAll() loads the requests on that
+ *  many threads at once, each with an Importer of its own. The calls into
+ *  the IOSystem are serialized then.
  *
  *  @note The class may not be used by more than one thread*/
 class ASSIMP_API BatchLoader {
@@ -210,8 +220,23 @@ public:
      */
     bool getValidation() const;
 
+    // -------------------------------------------------------------------
+    /** Sets the number of requests LoadAll() loads at the same time.
+     *  @param  numThreads  Number of threads, see GetNumThreads(). The
+     *    default of 1 loads all requests on the calling thread.
+     */
+    void setNumThreads( unsigned int numThreads );
+
+    // -------------------------------------------------------------------
+    /** Returns the number of requests loaded at the same time.
+     *  @return The number of threads.
+     */
+    unsigned int getNumThreads() const;
+
     // -------------------------------------------------------------------
     /** Add a new file to the list of files to be loaded.
+     *  A request for the same file with the same steps and properties
+     *  as an earlier one is loaded only once.
      *  @param file File to be loaded
      *  @param steps Post-processing steps to be executed on the file
      *  @param map Optional configuration properties
@@ -0,0 +1,222 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file MMapIOSystem.cpp
+ *  @brief IOSystem that maps files into memory instead of reading them
+ */
+
+#include <assimp/MMapIOSystem.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Only binary read modes are mapped, anything that may write or expects
+// newline translation goes to fopen()
+bool IsBinaryReadMode(const char *mode) {
+    return mode[0] == 'r' && nullptr == ::strchr(mode, '+') && nullptr == ::strchr(mode, 't');
+}
+
+// ------------------------------------------------------------------------------------------------
+// Maps the file copy-on-write, returns nullptr if the file cannot be mapped
+const uint8_t *MapFile(const char *file, size_t &size) {
+    size = 0;
+#ifdef _WIN32
+    const int len = MultiByteToWideChar(CP_UTF8, 0, file, -1, nullptr, 0);
+    if (len <= 0) {
+        return nullptr;
+    }
+    std::wstring name(static_cast<size_t>(len), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, file, -1, &name[0], len);
+
+    HANDLE fileHandle = ::CreateFileW(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0) {
+        ::CloseHandle(fileHandle);
+        return nullptr;
+    }
+    HANDLE mapping = ::CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    ::CloseHandle(fileHandle);
+    if (nullptr == mapping) {
+        return nullptr;
+    }
+    // the view keeps the mapping object alive
+    void *data = ::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (nullptr == data) {
+        return nullptr;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    return static_cast<const uint8_t *>(data);
+#else
+    const int fd = ::open(file, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat statbuf;
+    if (::fstat(fd, &statbuf) != 0 || !S_ISREG(statbuf.st_mode) || statbuf.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void *data = ::mmap(nullptr, static_cast<size_t>(statbuf.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    size = static_cast<size_t>(statbuf.st_size);
+#    ifdef POSIX_MADV_SEQUENTIAL
+    ::posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+#    endif
+    return static_cast<const uint8_t *>(data);
+#endif
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+MMapIOStream::MMapIOStream(const uint8_t *data, size_t size) AI_NO_EXCEPT :
+        mData(data),
+        mSize(size),
+        mPos(0) {
+    ai_assert(nullptr != mData);
+}
+
+// ------------------------------------------------------------------------------------------------
+MMapIOStream::~MMapIOStream() {
+#ifdef _WIN32
+    ::UnmapViewOfFile(mData);
+#else
+    ::munmap(const_cast<uint8_t *>(mData), mSize);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MMapIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    ai_assert(nullptr != pvBuffer);
+    if (0 == pSize || 0 == pCount) {
+        return 0;
+    }
+
+    const size_t cnt = std::min(pCount, (mSize - mPos) / pSize);
+    const size_t ofs = pSize * cnt;
+    ::memcpy(pvBuffer, mData + mPos, ofs);
+    mPos += ofs;
+
+    return cnt;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MMapIOStream::Write(const void *, size_t, size_t) {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn MMapIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    size_t base = 0;
+    if (aiOrigin_CUR == pOrigin) {
+        base = mPos;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        mPos = mSize - pOffset;
+        return AI_SUCCESS;
+    }
+    if (pOffset > mSize - base) {
+        return AI_FAILURE;
+    }
+    mPos = base + pOffset;
+
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MMapIOStream::Tell() const {
+    return mPos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MMapIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MMapIOStream::Flush() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+const uint8_t *MMapIOStream::GetMappedData() const {
+    return mData;
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream *MMapIOSystem::Open(const char *strFile, const char *strMode) {
+    ai_assert(strFile != nullptr);
+    ai_assert(strMode != nullptr);
+
+    if (IsBinaryReadMode(strMode)) {
+        size_t size = 0;
+        if (const uint8_t *data = MapFile(strFile, size)) {
+            return new MMapIOStream(data, size);
+        }
+    }
+
+    return DefaultIOSystem::Open(strFile, strMode);
+}
@@ -0,0 +1,82 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file Defines a helper to run independent work items on several threads */
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include <assimp/defs.h>
+
+#include <functional>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief Returns the number of threads to use for a requested count.
+ *
+ *  0 maps to the number of hardware threads, the result is never 0.
+ *  @param requested  Value of a thread count property, e.g.
+ *    #AI_CONFIG_PP_NUM_THREADS.
+ */
+ASSIMP_API unsigned int GetNumThreads(int requested);
+
+// ---------------------------------------------------------------------------
+/** @brief Calls func(i) for every i in [0, count).
+ *
+ *  The items are handed out one at a time from a shared counter, so a
+ *  thread which is done with a small item simply takes the next one and
+ *  large items do not hold the others back. The items must not depend on
+ *  each other; everything they write has to be indexed by i, which keeps
+ *  the result the same for any number of threads.
+ *  If an item throws, no further items are started and the exception of
+ *  the item with the lowest index is rethrown on the calling thread.
+ *  With numThreads <= 1 or count <= 1 no thread is started at all.
+ *  @param count       Number of items.
+ *  @param numThreads  Number of threads to use, see GetNumThreads().
+ *  @param func        The work for one item.
+ */
+ASSIMP_API void ParallelFor(unsigned int count, unsigned int numThreads,
+        const std::function<void(unsigned int)> &func);
+
+} // namespace Assimp
+
+#endif // AI_PARALLELFOR_H_INC
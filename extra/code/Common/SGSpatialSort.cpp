@@ -67,6 +67,12 @@ void SGSpatialSort::Add(const aiVector3D& vPosition, unsigned int index,
 // ------------------------------------------------------------------------------------------------
 void SGSpatialSort::Prepare()
 {
+    if (mUseGrid)
+    {
+        mGrid.Build(mPositions.empty() ? nullptr : &mPositions[0].mPosition,
+            (unsigned int)mPositions.size(), sizeof(Entry));
+        return;
+    }
     // now sort the array ascending by distance.
     std::sort( this->mPositions.begin(), this->mPositions.end());
 }
@@ -78,12 +84,27 @@ void SGSpatialSort::FindPositions( const aiVector3D& pPosition,
     std::vector<unsigned int>& poResults,
     bool exactMatch /*= false*/) const
 {
-    float dist = pPosition * mPlaneNormal;
-    float minDist = dist - pRadius, maxDist = dist + pRadius;
-
     // clear the array
     poResults.clear();
 
+    if (mUseGrid)
+    {
+        // same filters as the plane sort below
+        const float squareEpsilon = pRadius * pRadius;
+        mGrid.ForEachCandidate(pPosition, pRadius, [&](unsigned int i)
+        {
+            const Entry& e = mPositions[i];
+            if ((e.mPosition - pPosition).SquareLength() >= squareEpsilon)
+                return;
+            if (exactMatch ? e.mSmoothGroups == pSG : (!pSG || e.mSmoothGroups & pSG || !e.mSmoothGroups))
+                poResults.push_back(e.mIndex);
+        });
+        return;
+    }
+
+    float dist = pPosition * mPlaneNormal;
+    float minDist = dist - pRadius, maxDist = dist + pRadius;
+
     // quick check for positions outside the range
     if( mPositions.empty() )
         return;
@@ -0,0 +1,199 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file Defines a monotonic arena which owns the contents of a scene */
+#ifndef AI_SCENEARENA_H_INC
+#define AI_SCENEARENA_H_INC
+
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief Monotonic allocator for the contents of one scene.
+ *
+ *  Memory is carved out of a few large blocks and never given back one by
+ *  one; all of it is released together with the arena. Objects created in
+ *  the arena are not destroyed, so they must not own anything which lives
+ *  outside of it. See SceneCombiner::CopySceneToArena().
+ */
+class SceneArena {
+public:
+    /** @param blockSize  Size of the first block, later blocks grow up to
+     *    MaxBlockSize. */
+    explicit SceneArena(size_t blockSize = 64 * 1024) :
+            mBlocks(nullptr),
+            mCursor(nullptr),
+            mEnd(nullptr),
+            mBlockSize(blockSize),
+            mNumBytes(0) {
+        // empty
+    }
+
+    ~SceneArena() {
+        while (mBlocks) {
+            Block *next = mBlocks->mNext;
+            ::operator delete(mBlocks);
+            mBlocks = next;
+        }
+    }
+
+    SceneArena(const SceneArena &) = delete;
+    SceneArena &operator=(const SceneArena &) = delete;
+
+    /** Returns uninitialized memory for size bytes. */
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        ai_assert(alignment && 0 == (alignment & (alignment - 1)));
+        size_t space = static_cast<size_t>(mEnd - mCursor);
+        void *ptr = mCursor;
+        if (nullptr == mCursor || nullptr == std::align(alignment, size, ptr, space)) {
+            ptr = AllocateBlock(size, alignment);
+        } else {
+            mCursor = static_cast<char *>(ptr) + size;
+        }
+        mNumBytes += size;
+        return ptr;
+    }
+
+    /** Constructs an object in the arena, its destructor is never called. */
+    template <typename Type, typename... Args>
+    Type *New(Args &&...args) {
+        return new (Allocate(sizeof(Type), alignof(Type))) Type(std::forward<Args>(args)...);
+    }
+
+    /** Returns an uninitialized array of num trivial elements, nullptr
+     *  if num is zero. */
+    template <typename Type>
+    Type *AllocateArray(size_t num) {
+        return num ? static_cast<Type *>(Allocate(num * sizeof(Type), alignof(Type))) : nullptr;
+    }
+
+    /** Returns an array of num default constructed elements. */
+    template <typename Type>
+    Type *NewArray(size_t num) {
+        if (0 == num) {
+            return nullptr;
+        }
+        Type *data = static_cast<Type *>(Allocate(num * sizeof(Type), alignof(Type)));
+        for (size_t i = 0; i < num; ++i) {
+            new (data + i) Type();
+        }
+        return data;
+    }
+
+    /** Returns a copy of the num elements at src, nullptr for nullptr. */
+    template <typename Type>
+    Type *CopyArray(const Type *src, size_t num) {
+        if (nullptr == src || 0 == num) {
+            return nullptr;
+        }
+        Type *data = static_cast<Type *>(Allocate(num * sizeof(Type), alignof(Type)));
+        std::uninitialized_copy(src, src + num, data);
+        return data;
+    }
+
+    /** Returns the number of bytes handed out so far. */
+    size_t GetAllocatedBytes() const {
+        return mNumBytes;
+    }
+
+    static constexpr size_t MaxBlockSize = 4 * 1024 * 1024;
+
+private:
+    struct Block {
+        Block *mNext;
+    };
+
+    // Header space which keeps the payload of a block aligned
+    static constexpr size_t HeaderSize = (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    void *AllocateBlock(size_t size, size_t alignment) {
+        const size_t needed = size + alignment;
+        if (needed > mBlockSize / 4) {
+            // large arrays get a block of their own, behind the current one
+            Block *block = static_cast<Block *>(::operator new(HeaderSize + needed));
+            char *data = reinterpret_cast<char *>(block) + HeaderSize;
+            if (mBlocks) {
+                block->mNext = mBlocks->mNext;
+                mBlocks->mNext = block;
+            } else {
+                block->mNext = nullptr;
+                mBlocks = block;
+            }
+            return Align(data, alignment);
+        }
+
+        Block *block = static_cast<Block *>(::operator new(HeaderSize + mBlockSize));
+        block->mNext = mBlocks;
+        mBlocks = block;
+        char *data = reinterpret_cast<char *>(block) + HeaderSize;
+        mEnd = data + mBlockSize;
+        mBlockSize = std::min(mBlockSize * 2, MaxBlockSize);
+
+        char *ptr = Align(data, alignment);
+        mCursor = ptr + size;
+        return ptr;
+    }
+
+    static char *Align(char *ptr, size_t alignment) {
+        const size_t misalignment = reinterpret_cast<size_t>(ptr) & (alignment - 1);
+        return misalignment ? ptr + (alignment - misalignment) : ptr;
+    }
+
+    Block *mBlocks;
+    char *mCursor;
+    char *mEnd;
+    size_t mBlockSize;
+    size_t mNumBytes;
+};
+
+} // namespace Assimp
+
+#endif // AI_SCENEARENA_H_INC
@@ -52,6 +52,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
   */
 // ----------------------------------------------------------------------------
 #include "ScenePrivate.h"
+#include "FaceIndexAllocator.h"
+#include "Material/MaterialSystem.h"
 #include <assimp/Hash.h>
 #include <assimp/SceneCombiner.h>
 #include <assimp/StringUtils.h>
@@ -61,6 +63,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <unordered_map>
 #include <unordered_set>
 #include <ctime>
 #include <cstdio>
@@ -881,27 +884,39 @@ void SceneCombiner::MergeMeshes(aiMesh **_out, unsigned int /*flags*/,
 
     if (out->mNumFaces) // just for safety
     {
-        // copy faces
+        // copy faces, into a pool if any of the input meshes has one
         out->mFaces = new aiFace[out->mNumFaces];
         aiFace *pf2 = out->mFaces;
 
+        bool pooled = false;
+        size_t numIndices = 0;
+        for (MeshArray::const_iterator it = begin; it != end; ++it) {
+            pooled |= nullptr != (*it)->mFaceIndices;
+        }
+        for (MeshArray::const_iterator it = begin; pooled && it != end; ++it) {
+            for (unsigned int m = 0; m < (*it)->mNumFaces; ++m) {
+                numIndices += (*it)->mFaces[m].mNumIndices;
+            }
+        }
+        FaceIndexAllocator faceIndices(pooled, numIndices);
+
         unsigned int ofs = 0;
         for (MeshArray::const_iterator it = begin; it != end; ++it) {
             for (unsigned int m = 0; m < (*it)->mNumFaces; ++m, ++pf2) {
                 aiFace &face = (*it)->mFaces[m];
                 pf2->mNumIndices = face.mNumIndices;
-                pf2->mIndices = face.mIndices;
+                pf2->mIndices = faceIndices.Move(face);
 
                 if (ofs) {
                     // add the offset to the vertex
-                    for (unsigned int q = 0; q < face.mNumIndices; ++q) {
-                        face.mIndices[q] += ofs;
+                    for (unsigned int q = 0; q < pf2->mNumIndices; ++q) {
+                        pf2->mIndices[q] += ofs;
                     }
                 }
-                face.mIndices = nullptr;
             }
             ofs += (*it)->mNumVertices;
         }
+        faceIndices.Attach(out);
     }
 
     // bones - as this is quite lengthy, I moved the code to a separate function
@@ -1084,21 +1099,38 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
     GetArrayCopy(dest->mTangents, dest->mNumVertices);
     GetArrayCopy(dest->mBitangents, dest->mNumVertices);
 
-    unsigned int n = 0;
-    while (dest->HasTextureCoords(n)) {
-        GetArrayCopy(dest->mTextureCoords[n++], dest->mNumVertices);
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        GetArrayCopy(dest->mTextureCoords[n], dest->mNumVertices);
     }
 
-    n = 0;
-    while (dest->HasVertexColors(n)) {
-        GetArrayCopy(dest->mColors[n++], dest->mNumVertices);
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+        GetArrayCopy(dest->mColors[n], dest->mNumVertices);
     }
 
     // make a deep copy of all bones
     CopyPtrArray(dest->mBones, dest->mBones, dest->mNumBones);
 
-    // make a deep copy of all faces
-    GetArrayCopy(dest->mFaces, dest->mNumFaces);
+    // make a deep copy of all faces. Pooled index arrays are copied as a
+    // whole, the faces are pointed to the same offsets in the new pool.
+    if (src->mFaceIndices && src->mFaces) {
+        dest->mFaces = new aiFace[dest->mNumFaces];
+        dest->mFaceIndices = new unsigned int[src->mNumFaceIndices];
+        ::memcpy(dest->mFaceIndices, src->mFaceIndices, src->mNumFaceIndices * sizeof(unsigned int));
+        for (unsigned int i = 0; i < dest->mNumFaces; ++i) {
+            const aiFace &srcFace = src->mFaces[i];
+            aiFace &destFace = dest->mFaces[i];
+            if (src->IsPooledFaceIndices(srcFace.mIndices)) {
+                destFace.mNumIndices = srcFace.mNumIndices;
+                destFace.mIndices = dest->mFaceIndices + (srcFace.mIndices - src->mFaceIndices);
+            } else {
+                destFace = srcFace;
+            }
+        }
+    } else {
+        dest->mFaceIndices = nullptr;
+        dest->mNumFaceIndices = 0;
+        GetArrayCopy(dest->mFaces, dest->mNumFaces);
+    }
 
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
@@ -1129,13 +1161,13 @@ void SceneCombiner::Copy(aiAnimMesh **_dest, const aiAnimMesh *src) {
     GetArrayCopy(dest->mTangents, dest->mNumVertices);
     GetArrayCopy(dest->mBitangents, dest->mNumVertices);
 
-    unsigned int n = 0;
-    while (dest->HasTextureCoords(n))
-        GetArrayCopy(dest->mTextureCoords[n++], dest->mNumVertices);
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        GetArrayCopy(dest->mTextureCoords[n], dest->mNumVertices);
+    }
 
-    n = 0;
-    while (dest->HasVertexColors(n))
-        GetArrayCopy(dest->mColors[n++], dest->mNumVertices);
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+        GetArrayCopy(dest->mColors[n], dest->mNumVertices);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1211,6 +1243,7 @@ void SceneCombiner::Copy(aiAnimation **_dest, const aiAnimation *src) {
 
     // and reallocate all arrays
     CopyPtrArray(dest->mChannels, src->mChannels, dest->mNumChannels);
+    CopyPtrArray(dest->mMeshChannels, src->mMeshChannels, dest->mNumMeshChannels);
     CopyPtrArray(dest->mMorphMeshChannels, src->mMorphMeshChannels, dest->mNumMorphMeshChannels);
 }
 
@@ -1231,6 +1264,22 @@ void SceneCombiner::Copy(aiNodeAnim **_dest, const aiNodeAnim *src) {
     GetArrayCopy(dest->mRotationKeys, dest->mNumRotationKeys);
 }
 
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiMeshAnim **_dest, const aiMeshAnim *src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    aiMeshAnim *dest = *_dest = new aiMeshAnim();
+
+    // get a flat copy
+    *dest = *src;
+
+    // and reallocate all arrays
+    GetArrayCopy(dest->mKeys, dest->mNumKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy(aiMeshMorphAnim **_dest, const aiMeshMorphAnim *src) {
     if (nullptr == _dest || nullptr == src) {
         return;
@@ -1297,6 +1346,7 @@ void SceneCombiner::Copy(aiNode **_dest, const aiNode *src) {
     // get a flat copy
     *dest = *src;
 
+    dest->mMetaData = nullptr;
     if (src->mMetaData) {
         Copy(&dest->mMetaData, src->mMetaData);
     }
@@ -1372,6 +1422,384 @@ void SceneCombiner::Copy(aiString **_dest, const aiString *src) {
     *dest = *src;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Counterpart of the Copy() functions above which takes all memory from an arena. Nothing
+// created here is ever destroyed, so no copy may keep pointers to memory outside of the arena.
+class ArenaCopier {
+public:
+    explicit ArenaCopier(SceneArena &arena) :
+            mArena(arena) {
+        // empty
+    }
+
+    template <typename Type>
+    Type **CopyPtrArray(const Type *const *src, ai_uint num) {
+        if (!num || nullptr == src) {
+            return nullptr;
+        }
+        Type **dest = mArena.NewArray<Type *>(num);
+        for (ai_uint i = 0; i < num; ++i) {
+            dest[i] = Copy(src[i]);
+        }
+        return dest;
+    }
+
+    aiMesh *Copy(const aiMesh *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiMesh *dest = mArena.New<aiMesh>();
+
+        // get a flat copy
+        *dest = *src;
+
+        // and place all arrays in the arena
+        dest->mVertices = mArena.CopyArray(src->mVertices, src->mNumVertices);
+        dest->mNormals = mArena.CopyArray(src->mNormals, src->mNumVertices);
+        dest->mTangents = mArena.CopyArray(src->mTangents, src->mNumVertices);
+        dest->mBitangents = mArena.CopyArray(src->mBitangents, src->mNumVertices);
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+            dest->mTextureCoords[n] = mArena.CopyArray(src->mTextureCoords[n], src->mNumVertices);
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+            dest->mColors[n] = mArena.CopyArray(src->mColors[n], src->mNumVertices);
+        }
+
+        dest->mBones = CopyPtrArray(src->mBones, src->mNumBones);
+        dest->mAnimMeshes = CopyPtrArray(src->mAnimMeshes, src->mNumAnimMeshes);
+
+        // all face indices go to one array, which stays the pool of the
+        // copy if the source had one
+        dest->mFaces = nullptr;
+        dest->mFaceIndices = nullptr;
+        dest->mNumFaceIndices = 0;
+        if (src->mFaces && src->mNumFaces) {
+            size_t numIndices = 0;
+            for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+                numIndices += src->mFaces[i].mNumIndices;
+            }
+            unsigned int *indices = mArena.AllocateArray<unsigned int>(numIndices);
+            if (src->mFaceIndices) {
+                dest->mFaceIndices = indices;
+                dest->mNumFaceIndices = static_cast<unsigned int>(numIndices);
+            }
+            dest->mFaces = mArena.NewArray<aiFace>(src->mNumFaces);
+            for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+                const aiFace &face = src->mFaces[i];
+                if (face.mNumIndices) {
+                    dest->mFaces[i].mNumIndices = face.mNumIndices;
+                    dest->mFaces[i].mIndices = indices;
+                    ::memcpy(indices, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+                    indices += face.mNumIndices;
+                }
+            }
+        }
+
+        if (src->mTextureCoordsNames) {
+            dest->mTextureCoordsNames = mArena.NewArray<aiString *>(AI_MAX_NUMBER_OF_TEXTURECOORDS);
+            for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+                dest->mTextureCoordsNames[i] = Copy(src->mTextureCoordsNames[i]);
+            }
+        }
+        return dest;
+    }
+
+    aiAnimMesh *Copy(const aiAnimMesh *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiAnimMesh *dest = mArena.New<aiAnimMesh>();
+
+        // get a flat copy
+        *dest = *src;
+
+        // and place all arrays in the arena
+        dest->mVertices = mArena.CopyArray(src->mVertices, src->mNumVertices);
+        dest->mNormals = mArena.CopyArray(src->mNormals, src->mNumVertices);
+        dest->mTangents = mArena.CopyArray(src->mTangents, src->mNumVertices);
+        dest->mBitangents = mArena.CopyArray(src->mBitangents, src->mNumVertices);
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+            dest->mTextureCoords[n] = mArena.CopyArray(src->mTextureCoords[n], src->mNumVertices);
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+            dest->mColors[n] = mArena.CopyArray(src->mColors[n], src->mNumVertices);
+        }
+        return dest;
+    }
+
+    aiBone *Copy(const aiBone *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        // the copy constructor of aiBone allocates the weights itself
+        aiBone *dest = mArena.New<aiBone>();
+        dest->mName = src->mName;
+        dest->mNumWeights = src->mNumWeights;
+        dest->mWeights = mArena.CopyArray(src->mWeights, src->mNumWeights);
+        dest->mOffsetMatrix = src->mOffsetMatrix;
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+        mBones.emplace_back(dest, src);
+#endif
+        return dest;
+    }
+
+    aiMaterial *Copy(const aiMaterial *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiMaterial *dest = mArena.New<aiMaterial>();
+
+        // the constructor preallocates a property list and a lookup index
+        // on the heap, lookups on arena materials scan the list instead
+        delete[] dest->mProperties;
+        delete dest->mPropertyIndex;
+        dest->mPropertyIndex = nullptr;
+
+        dest->mNumProperties = dest->mNumAllocated = src->mNumProperties;
+        dest->mProperties = mArena.NewArray<aiMaterialProperty *>(src->mNumProperties);
+        for (unsigned int i = 0; i < src->mNumProperties; ++i) {
+            const aiMaterialProperty *sprop = src->mProperties[i];
+            aiMaterialProperty *prop = dest->mProperties[i] = mArena.New<aiMaterialProperty>();
+            prop->mKey = sprop->mKey;
+            prop->mSemantic = sprop->mSemantic;
+            prop->mIndex = sprop->mIndex;
+            prop->mDataLength = sprop->mDataLength;
+            prop->mType = sprop->mType;
+            prop->mData = mArena.CopyArray(sprop->mData, sprop->mDataLength);
+        }
+        return dest;
+    }
+
+    aiTexture *Copy(const aiTexture *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiTexture *dest = mArena.New<aiTexture>();
+
+        // get a flat copy
+        *dest = *src;
+
+        // compressed textures store their size in mWidth
+        const size_t size = dest->mHeight ? dest->mHeight * dest->mWidth * sizeof(aiTexel) : dest->mWidth;
+        dest->pcData = reinterpret_cast<aiTexel *>(mArena.CopyArray(reinterpret_cast<const char *>(src->pcData), size));
+        return dest;
+    }
+
+    aiAnimation *Copy(const aiAnimation *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiAnimation *dest = mArena.New<aiAnimation>();
+
+        // get a flat copy
+        *dest = *src;
+
+        // and copy all channels
+        dest->mChannels = CopyPtrArray(src->mChannels, src->mNumChannels);
+        dest->mMeshChannels = CopyPtrArray(src->mMeshChannels, src->mNumMeshChannels);
+        dest->mMorphMeshChannels = CopyPtrArray(src->mMorphMeshChannels, src->mNumMorphMeshChannels);
+        return dest;
+    }
+
+    aiNodeAnim *Copy(const aiNodeAnim *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiNodeAnim *dest = mArena.New<aiNodeAnim>();
+
+        // get a flat copy
+        *dest = *src;
+
+        // and place all arrays in the arena
+        dest->mPositionKeys = mArena.CopyArray(src->mPositionKeys, src->mNumPositionKeys);
+        dest->mRotationKeys = mArena.CopyArray(src->mRotationKeys, src->mNumRotationKeys);
+        dest->mScalingKeys = mArena.CopyArray(src->mScalingKeys, src->mNumScalingKeys);
+        return dest;
+    }
+
+    aiMeshAnim *Copy(const aiMeshAnim *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiMeshAnim *dest = mArena.New<aiMeshAnim>();
+        dest->mName = src->mName;
+        dest->mNumKeys = src->mNumKeys;
+        dest->mKeys = mArena.CopyArray(src->mKeys, src->mNumKeys);
+        return dest;
+    }
+
+    aiMeshMorphAnim *Copy(const aiMeshMorphAnim *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiMeshMorphAnim *dest = mArena.New<aiMeshMorphAnim>();
+        dest->mName = src->mName;
+        dest->mNumKeys = src->mNumKeys;
+        dest->mKeys = mArena.NewArray<aiMeshMorphKey>(src->mNumKeys);
+        for (unsigned int i = 0; i < src->mNumKeys; ++i) {
+            const aiMeshMorphKey &in = src->mKeys[i];
+            aiMeshMorphKey &out = dest->mKeys[i];
+            out.mTime = in.mTime;
+            out.mNumValuesAndWeights = in.mNumValuesAndWeights;
+            out.mValues = mArena.CopyArray(in.mValues, in.mNumValuesAndWeights);
+            out.mWeights = mArena.CopyArray(in.mWeights, in.mNumValuesAndWeights);
+        }
+        return dest;
+    }
+
+    aiCamera *Copy(const aiCamera *src) {
+        return src ? mArena.New<aiCamera>(*src) : nullptr;
+    }
+
+    aiLight *Copy(const aiLight *src) {
+        return src ? mArena.New<aiLight>(*src) : nullptr;
+    }
+
+    aiString *Copy(const aiString *src) {
+        return src ? mArena.New<aiString>(*src) : nullptr;
+    }
+
+    aiNode *Copy(const aiNode *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiNode *dest = mArena.New<aiNode>();
+
+        // get a flat copy
+        *dest = *src;
+        mNodes[src] = dest;
+
+        // and copy metadata, mesh references and children
+        dest->mMetaData = Copy(src->mMetaData);
+        dest->mMeshes = mArena.CopyArray(src->mMeshes, src->mNumMeshes);
+        dest->mChildren = CopyPtrArray(src->mChildren, src->mNumChildren);
+        for (unsigned int i = 0; i < dest->mNumChildren; ++i) {
+            dest->mChildren[i]->mParent = dest;
+        }
+        return dest;
+    }
+
+    aiMetadata *Copy(const aiMetadata *src) {
+        if (nullptr == src) {
+            return nullptr;
+        }
+        aiMetadata *dest = mArena.New<aiMetadata>();
+        dest->mNumProperties = src->mNumProperties;
+        dest->mKeys = mArena.CopyArray(src->mKeys, src->mNumProperties);
+        dest->mValues = mArena.NewArray<aiMetadataEntry>(src->mNumProperties);
+        for (unsigned int i = 0; i < src->mNumProperties; ++i) {
+            const aiMetadataEntry &in = src->mValues[i];
+            aiMetadataEntry &out = dest->mValues[i];
+            out.mType = in.mType;
+            switch (in.mType) {
+            case AI_BOOL:
+                out.mData = mArena.New<bool>(*static_cast<bool *>(in.mData));
+                break;
+            case AI_INT32:
+                out.mData = mArena.New<int32_t>(*static_cast<int32_t *>(in.mData));
+                break;
+            case AI_UINT64:
+                out.mData = mArena.New<uint64_t>(*static_cast<uint64_t *>(in.mData));
+                break;
+            case AI_FLOAT:
+                out.mData = mArena.New<float>(*static_cast<float *>(in.mData));
+                break;
+            case AI_DOUBLE:
+                out.mData = mArena.New<double>(*static_cast<double *>(in.mData));
+                break;
+            case AI_AISTRING:
+                out.mData = Copy(static_cast<const aiString *>(in.mData));
+                break;
+            case AI_AIVECTOR3D:
+                out.mData = mArena.New<aiVector3D>(*static_cast<aiVector3D *>(in.mData));
+                break;
+            case AI_AIMETADATA:
+                out.mData = Copy(static_cast<const aiMetadata *>(in.mData));
+                break;
+            case AI_INT64:
+                out.mData = mArena.New<int64_t>(*static_cast<int64_t *>(in.mData));
+                break;
+            case AI_UINT32:
+                out.mData = mArena.New<uint32_t>(*static_cast<uint32_t *>(in.mData));
+                break;
+            default:
+                ai_assert(false);
+                break;
+            }
+        }
+        return dest;
+    }
+
+    // Point the bones to the copies of their nodes, once all nodes are copied
+    void LinkBones() {
+#ifndef ASSIMP_BUILD_NO_ARMATUREPOPULATE_PROCESS
+        for (const auto &bone : mBones) {
+            bone.first->mArmature = FindNode(bone.second->mArmature);
+            bone.first->mNode = FindNode(bone.second->mNode);
+        }
+#endif
+    }
+
+private:
+    aiNode *FindNode(const aiNode *src) const {
+        const auto it = mNodes.find(src);
+        return it == mNodes.end() ? nullptr : it->second;
+    }
+
+    SceneArena &mArena;
+    std::unordered_map<const aiNode *, aiNode *> mNodes;
+    std::vector<std::pair<aiBone *, const aiBone *>> mBones;
+};
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::CopySceneToArena(aiScene **_dest, const aiScene *src, bool allocate) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    if (allocate) {
+        *_dest = new aiScene();
+    }
+    aiScene *dest = *_dest;
+    ai_assert(nullptr != dest);
+
+    ScenePrivateData *priv = ScenePriv(dest);
+    ai_assert(nullptr == priv->mArena);
+    priv->mArena.reset(new SceneArena());
+    ArenaCopier copier(*priv->mArena);
+
+    dest->mMetaData = copier.Copy(src->mMetaData);
+
+    dest->mNumAnimations = src->mNumAnimations;
+    dest->mAnimations = copier.CopyPtrArray(src->mAnimations, src->mNumAnimations);
+
+    dest->mNumTextures = src->mNumTextures;
+    dest->mTextures = copier.CopyPtrArray(src->mTextures, src->mNumTextures);
+
+    dest->mNumMaterials = src->mNumMaterials;
+    dest->mMaterials = copier.CopyPtrArray(src->mMaterials, src->mNumMaterials);
+
+    dest->mNumLights = src->mNumLights;
+    dest->mLights = copier.CopyPtrArray(src->mLights, src->mNumLights);
+
+    dest->mNumCameras = src->mNumCameras;
+    dest->mCameras = copier.CopyPtrArray(src->mCameras, src->mNumCameras);
+
+    dest->mNumMeshes = src->mNumMeshes;
+    dest->mMeshes = copier.CopyPtrArray(src->mMeshes, src->mNumMeshes);
+
+    dest->mRootNode = copier.Copy(src->mRootNode);
+    copier.LinkBones();
+
+    dest->mName = src->mName;
+    dest->mFlags = src->mFlags;
+
+    // source private data might be nullptr if the scene is user-allocated (i.e. for use with the export API)
+    if (src->mPrivate != nullptr) {
+        priv->mPPStepsApplied = ScenePriv(src)->mPPStepsApplied;
+    }
+}
+
 #if (__GNUC__ >= 8 && __GNUC_MINOR__ >= 0)
 #pragma GCC diagnostic pop
 #endif
@@ -45,9 +45,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_SCENEPRIVATE_H_INCLUDED
 #define AI_SCENEPRIVATE_H_INCLUDED
 
+#include "SceneArena.h"
+
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 namespace Assimp {
 
 // Forward declarations
@@ -70,6 +76,15 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Arena holding everything the scene owns, except for the skeletons.
+    // If set, the contents are released in one go with the arena and
+    // must not be modified. See SceneCombiner::CopySceneToArena().
+    std::unique_ptr<SceneArena> mArena;
+
+    // Fingerprints of the meshes at their last successful validation, by
+    // mesh index. See AI_CONFIG_PP_VDS_SKIP_UNCHANGED_MESHES.
+    std::vector<uint64_t> mValidatedMeshes;
 };
 
 inline
@@ -0,0 +1,170 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the uniform grid used as spatial index by SpatialSort and SGSpatialSort */
+
+#include <assimp/SpatialGrid.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Assimp;
+
+// 21 bits per axis fit into a 63 bit Morton code
+static constexpr uint32_t MaxResolution = 1u << 21;
+
+// the grid aims at this many points per occupied cell
+static constexpr ai_real PointsPerCell = 4;
+
+// ------------------------------------------------------------------------------------------------
+// Spread the lower 21 bits of v so there are two zero bits between each of them
+static uint64_t Part1By2(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | (v << 32)) & 0x1f00000000ffffULL;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+    v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t SpatialGrid::MortonKey(uint32_t x, uint32_t y, uint32_t z) {
+    return Part1By2(x) | (Part1By2(y) << 1) | (Part1By2(z) << 2);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGrid::CellCoords(const aiVector3D &pPosition, uint32_t *pCoords) const {
+    const ai_real p[3] = { pPosition.x - mMin.x, pPosition.y - mMin.y, pPosition.z - mMin.z };
+    for (unsigned int i = 0; i < 3; ++i) {
+        const ai_real c = p[i] * mInvCellSize;
+        if (!(c > 0)) {
+            // also catches NaN
+            pCoords[i] = 0;
+        } else if (c >= static_cast<ai_real>(mResolution[i] - 1)) {
+            pCoords[i] = mResolution[i] - 1;
+        } else {
+            pCoords[i] = static_cast<uint32_t>(c);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t SpatialGrid::FindCell(uint64_t key) const {
+    auto it = std::lower_bound(mCells.begin(), mCells.end(), key,
+            [](const Cell &cell, uint64_t k) { return cell.mKey < k; });
+    if (it == mCells.end() || it->mKey != key) {
+        return mCells.size();
+    }
+    return static_cast<size_t>(it - mCells.begin());
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGrid::Clear() {
+    mOrder.clear();
+    mCells.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialGrid::Build(const aiVector3D *pPositions, unsigned int pNumPositions, unsigned int pElementOffset) {
+    Clear();
+    if (0 == pNumPositions) {
+        return;
+    }
+
+    const char *base = reinterpret_cast<const char *>(pPositions);
+    auto position = [base, pElementOffset](unsigned int i) -> const aiVector3D & {
+        return *reinterpret_cast<const aiVector3D *>(base + size_t(i) * pElementOffset);
+    };
+
+    aiVector3D maxVec = position(0);
+    mMin = maxVec;
+    for (unsigned int i = 1; i < pNumPositions; ++i) {
+        const aiVector3D &p = position(i);
+        mMin.x = std::min(mMin.x, p.x);
+        mMin.y = std::min(mMin.y, p.y);
+        mMin.z = std::min(mMin.z, p.z);
+        maxVec.x = std::max(maxVec.x, p.x);
+        maxVec.y = std::max(maxVec.y, p.y);
+        maxVec.z = std::max(maxVec.z, p.z);
+    }
+
+    // cell size from the volume (or area, or length) the points span, ignoring the
+    // dimensions they are flat in
+    const aiVector3D extent = maxVec - mMin;
+    const ai_real maxExtent = std::max(extent.x, std::max(extent.y, extent.z));
+    ai_real measure = 1;
+    int dims = 0;
+    for (unsigned int i = 0; i < 3; ++i) {
+        if (extent[i] > maxExtent * ai_real(1e-4)) {
+            measure *= extent[i];
+            ++dims;
+        }
+    }
+    ai_real cellSize = maxExtent;
+    if (dims > 0 && maxExtent > 0) {
+        const ai_real numCells = std::max(ai_real(1), pNumPositions / PointsPerCell);
+        cellSize = std::pow(measure / numCells, ai_real(1) / dims);
+        // never more than MaxResolution cells along the longest axis
+        cellSize = std::max(cellSize, maxExtent / (MaxResolution - 1));
+    }
+    mInvCellSize = cellSize > 0 ? 1 / cellSize : 0;
+    for (unsigned int i = 0; i < 3; ++i) {
+        mResolution[i] = std::min(MaxResolution, static_cast<uint32_t>(extent[i] * mInvCellSize) + 1);
+    }
+
+    std::vector<std::pair<uint64_t, unsigned int>> keys(pNumPositions);
+    for (unsigned int i = 0; i < pNumPositions; ++i) {
+        uint32_t c[3];
+        CellCoords(position(i), c);
+        keys[i] = std::make_pair(MortonKey(c[0], c[1], c[2]), i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    mOrder.resize(pNumPositions);
+    for (unsigned int i = 0; i < pNumPositions; ++i) {
+        mOrder[i] = keys[i].second;
+        if (0 == i || keys[i].first != keys[i - 1].first) {
+            mCells.push_back(Cell{ keys[i].first, i });
+        }
+    }
+}
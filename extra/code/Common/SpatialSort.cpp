@@ -44,6 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/SpatialSort.h>
 #include <assimp/ai_assert.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace Assimp;
 
 // CHAR_BIT seems to be defined under MVSC, but not under GCC. Pray that the correct value is 8.
@@ -59,7 +63,8 @@ const aiVector3D PlaneInit(0.8523f, 0.34321f, 0.5736f);
 // in the hope that no model spreads all its vertices along this plane.
 SpatialSort::SpatialSort(const aiVector3D *pPositions, unsigned int pNumPositions, unsigned int pElementOffset) :
         mPlaneNormal(PlaneInit),
-        mFinalized(false) {
+        mFinalized(false),
+        mUseGrid(false) {
     mPlaneNormal.Normalize();
     Fill(pPositions, pNumPositions, pElementOffset);
 }
@@ -67,7 +72,8 @@ SpatialSort::SpatialSort(const aiVector3D *pPositions, unsigned int pNumPosition
 // ------------------------------------------------------------------------------------------------
 SpatialSort::SpatialSort() :
         mPlaneNormal(PlaneInit),
-        mFinalized(false) {
+        mFinalized(false),
+        mUseGrid(false) {
     mPlaneNormal.Normalize();
 }
 
@@ -95,10 +101,21 @@ void SpatialSort::Finalize() {
     for (unsigned int i = 0; i < mPositions.size(); i++) {
         mPositions[i].mDistance = CalculateDistance(mPositions[i].mPosition);
     }
-    std::sort(mPositions.begin(), mPositions.end());
+    if (mUseGrid) {
+        mGrid.Build(mPositions.empty() ? nullptr : &mPositions[0].mPosition,
+                static_cast<unsigned int>(mPositions.size()), sizeof(Entry));
+    } else {
+        std::sort(mPositions.begin(), mPositions.end());
+    }
     mFinalized = true;
 }
 
+// ------------------------------------------------------------------------------------------------
+void SpatialSort::SetUseGrid(bool pUseGrid) {
+    ai_assert(!mFinalized && "The index of a SpatialSort cannot be changed after it has been finalized.");
+    mUseGrid = pUseGrid;
+}
+
 // ------------------------------------------------------------------------------------------------
 void SpatialSort::Append(const aiVector3D *pPositions, unsigned int pNumPositions,
         unsigned int pElementOffset,
@@ -124,12 +141,22 @@ void SpatialSort::Append(const aiVector3D *pPositions, unsigned int pNumPosition
 void SpatialSort::FindPositions(const aiVector3D &pPosition,
         ai_real pRadius, std::vector<unsigned int> &poResults) const {
     ai_assert(mFinalized && "The SpatialSort object must be finalized before FindPositions can be called.");
-    const ai_real dist = CalculateDistance(pPosition);
-    const ai_real minDist = dist - pRadius, maxDist = dist + pRadius;
-
     // clear the array
     poResults.clear();
 
+    if (mUseGrid) {
+        const ai_real pSquared = pRadius * pRadius;
+        mGrid.ForEachCandidate(pPosition, pRadius, [&](unsigned int i) {
+            if ((mPositions[i].mPosition - pPosition).SquareLength() < pSquared) {
+                poResults.push_back(mPositions[i].mIndex);
+            }
+        });
+        return;
+    }
+
+    const ai_real dist = CalculateDistance(pPosition);
+    const ai_real minDist = dist - pRadius, maxDist = dist + pRadius;
+
     // quick check for positions outside the range
     if (mPositions.size() == 0)
         return;
@@ -263,6 +290,20 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
     //  subtraction.
     static const int distance3DToleranceInULPs = distanceToleranceInULPs + 1;
 
+    // The grid finds the candidates directly by position. Identical positions are within
+    //  a few ULPs, the query box only has to be wide enough to reach across a cell border.
+    if (mUseGrid) {
+        poResults.resize(0);
+        const ai_real maxCoord = std::max(std::abs(pPosition.x), std::max(std::abs(pPosition.y), std::abs(pPosition.z)));
+        const ai_real tolerance = (maxCoord + 1) * std::numeric_limits<ai_real>::epsilon() * toleranceInULPs;
+        mGrid.ForEachCandidate(pPosition, tolerance, [&](unsigned int i) {
+            if (distance3DToleranceInULPs >= ToBinary((mPositions[i].mPosition - pPosition).SquareLength())) {
+                poResults.push_back(mPositions[i].mIndex);
+            }
+        });
+        return;
+    }
+
     // Convert the plane distance to its signed integer representation so the ULPs tolerance can be
     //  applied. For some reason, VC won't optimize two calls of the bit pattern conversion.
     const BinFloat minDistBinary = ToBinary(CalculateDistance(pPosition)) - distanceToleranceInULPs;
@@ -310,6 +351,28 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
 unsigned int SpatialSort::GenerateMappingTable(std::vector<unsigned int> &fill, ai_real pRadius) const {
     ai_assert(mFinalized && "The SpatialSort object must be finalized before GenerateMappingTable can be called.");
     fill.resize(mPositions.size(), UINT_MAX);
+
+    if (mUseGrid) {
+        // walk the points in cell order, each point not yet mapped starts a new group
+        // with all unmapped points within the radius around it
+        const ai_real pSquared = pRadius * pRadius;
+        unsigned int t = 0;
+        for (unsigned int i : mGrid.GetOrder()) {
+            if (fill[mPositions[i].mIndex] != UINT_MAX) {
+                continue;
+            }
+            const aiVector3D &pos = mPositions[i].mPosition;
+            fill[mPositions[i].mIndex] = t;
+            mGrid.ForEachCandidate(pos, pRadius, [&](unsigned int k) {
+                if (fill[mPositions[k].mIndex] == UINT_MAX && (mPositions[k].mPosition - pos).SquareLength() < pSquared) {
+                    fill[mPositions[k].mIndex] = t;
+                }
+            });
+            ++t;
+        }
+        return t;
+    }
+
     ai_real dist, maxDist;
 
     unsigned int t = 0;
@@ -47,14 +47,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "PostProcessing/ProcessHelper.h"
 
-#include <stdio.h>
+#include "Common/ParallelFor.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <climits>
 
 using namespace Assimp;
 
-void mydummy() {}
-
 #ifdef _MSC_VER
 #pragma warning(disable : 4709)
 #endif // _MSC_VER
@@ -65,44 +64,25 @@ void mydummy() {}
 // ------------------------------------------------------------------------------------------------
 class CatmullClarkSubdivider : public Subdivider {
 public:
+    CatmullClarkSubdivider() :
+            mNumThreads(1) {}
+
     void Subdivide(aiMesh *mesh, aiMesh *&out, unsigned int num, bool discard_input);
     void Subdivide(aiMesh **smesh, size_t nmesh,
             aiMesh **out, unsigned int num, bool discard_input);
-
-    // ---------------------------------------------------------------------------
-    /** Intermediate description of an edge between two corners of a polygon*/
-    // ---------------------------------------------------------------------------
-    struct Edge {
-        Edge() :
-                ref(0) {}
-        Vertex edge_point, midpoint;
-        unsigned int ref;
-    };
+    void SetNumThreads(unsigned int numThreads) {
+        mNumThreads = std::max(1u, numThreads);
+    }
 
     typedef std::vector<unsigned int> UIntVector;
-    typedef std::unordered_map<uint64_t, Edge> EdgeMap;
-
-    // ---------------------------------------------------------------------------
-    // Hashing function to derive an index into an #EdgeMap from two given
-    // 'unsigned int' vertex coordinates (!!distinct coordinates - same
-    // vertex position == same index!!).
-    // NOTE - this leads to rare hash collisions if a) sizeof(unsigned int)>4
-    // and (id[0]>2^32-1 or id[0]>2^32-1).
-    // MAKE_EDGE_HASH() uses temporaries, so INIT_EDGE_HASH() needs to be put
-    // at the head of every function which is about to use MAKE_EDGE_HASH().
-    // Reason is that the hash is that hash construction needs to hold the
-    // invariant id0<id1 to identify an edge - else two hashes would refer
-    // to the same edge.
-    // ---------------------------------------------------------------------------
-#define MAKE_EDGE_HASH(id0, id1) (eh_tmp0__ = id0, eh_tmp1__ = id1, \
-        (eh_tmp0__ < eh_tmp1__ ? std::swap(eh_tmp0__, eh_tmp1__) : mydummy()), (uint64_t)eh_tmp0__ ^ ((uint64_t)eh_tmp1__ << 32u))
-
-#define INIT_EDGE_HASH_TEMPORARIES() \
-    unsigned int eh_tmp0__, eh_tmp1__;
 
 private:
     void InternSubdivide(const aiMesh *const *smesh,
             size_t nmesh, aiMesh **out, unsigned int num);
+    unsigned int SubdivideLevel(const aiMesh *const *smesh,
+            size_t nmesh, aiMesh **out, UIntVector &maptbl, unsigned int num_unique) const;
+
+    unsigned int mNumThreads;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -211,16 +191,47 @@ void CatmullClarkSubdivider::Subdivide(
     }
 }
 
+// Faces, edges and vertices handed to one thread at a time
+static constexpr unsigned int ItemsPerChunk = 1u << 12;
+
+// ------------------------------------------------------------------------------------------------
+// Calls func(begin, end) for consecutive ranges of at most ItemsPerChunk items covering [0, count)
+static void ForEachChunk(unsigned int count, unsigned int numThreads,
+        const std::function<void(unsigned int, unsigned int)> &func) {
+    const unsigned int numChunks = (count + ItemsPerChunk - 1) / ItemsPerChunk;
+    ParallelFor(numChunks, numThreads, [&](unsigned int chunk) {
+        const unsigned int begin = chunk * ItemsPerChunk;
+        func(begin, std::min(begin + ItemsPerChunk, count));
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the items [0, keys.size()) by key with a stable counting sort. On return, the items
+// with key k are items[offsets[k]] to items[offsets[k + 1] - 1], in ascending order.
+static void CountingSort(const std::vector<unsigned int> &keys, unsigned int numKeys,
+        std::vector<unsigned int> &offsets, std::vector<unsigned int> &items) {
+    offsets.assign(numKeys + 1, 0);
+    for (const unsigned int key : keys) {
+        ++offsets[key + 1];
+    }
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    items.resize(keys.size());
+    std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+    for (unsigned int i = 0; i < keys.size(); ++i) {
+        items[cursor[keys[i]]++] = i;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Note - this is an implementation of the standard (recursive) Cm-Cl algorithm without further
-// optimizations (except we're using some nice LUTs). A description of the algorithm can be found
+// optimizations. A description of the algorithm can be found
 // here: http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
 //
-// The code is mostly O(n), however parts are O(nlogn) which is therefore the algorithm's
-// expected total runtime complexity. The implementation is able to work in-place on the same
-// mesh arrays. Calling #InternSubdivide() directly is not encouraged. The code can operate
-// in-place unless 'smesh' and 'out' are equal (no strange overlaps or reorderings).
-// Previous data is replaced/deleted then.
+// The input vertices are welded by position once. Every further level knows which of its output
+// vertices coincide from the topology of the level before, so welding is not repeated. The
+// output meshes of the last level are allocated here, intermediate levels are deleted.
 // ------------------------------------------------------------------------------------------------
 void CatmullClarkSubdivider::InternSubdivide(
         const aiMesh *const *smesh,
@@ -230,358 +241,353 @@ void CatmullClarkSubdivider::InternSubdivide(
     ai_assert(nullptr != smesh);
     ai_assert(nullptr != out);
 
-    INIT_EDGE_HASH_TEMPORARIES();
-
-    // no subdivision requested or end of recursive refinement
+    // no subdivision requested
     if (!num) {
         return;
     }
 
+    // ---------------------------------------------------------------------
+    // Generate a spatially sorted representation of all vertices in all
+    // meshes, indexed continuously, to map them to distinct positions.
+    // ---------------------------------------------------------------------
     UIntVector maptbl;
-    SpatialSort spatial;
+    unsigned int num_unique;
+    {
+        SpatialSort spatial;
+        for (size_t t = 0; t < nmesh; ++t) {
+            spatial.Append(smesh[t]->mVertices, smesh[t]->mNumVertices, sizeof(aiVector3D), false);
+        }
+        spatial.Finalize();
+        num_unique = spatial.GenerateMappingTable(maptbl, ComputePositionEpsilon(smesh, nmesh));
+    }
+
+    MeshArray level(nmesh);
+    num_unique = SubdivideLevel(smesh, nmesh, &level.front(), maptbl, num_unique);
+    for (unsigned int i = 1; i < num; ++i) {
+        MeshArray next(nmesh);
+        num_unique = SubdivideLevel(&level.front(), nmesh, &next.front(), maptbl, num_unique);
+        for (aiMesh *mesh : level) {
+            delete mesh;
+        }
+        level.swap(next);
+    }
+    std::copy(level.begin(), level.end(), out);
+}
 
+// ------------------------------------------------------------------------------------------------
+// One step of refinement. maptbl maps the vertices of all input meshes, indexed continuously,
+// to distinct positions. On return it holds that mapping for the output meshes, the number of
+// distinct positions of the output is returned.
+//
+// The topology is flat: the corners of all faces are numbered continuously in the order of
+// meshes and faces, corner k runs from its vertex to the next one of the face. Edges are found
+// by sorting corners by their smaller distinct vertex. The code is O(n) apart from that, all
+// points are computed on up to mNumThreads threads and do not depend on the thread count.
+// ------------------------------------------------------------------------------------------------
+unsigned int CatmullClarkSubdivider::SubdivideLevel(
+        const aiMesh *const *smesh,
+        size_t nmesh,
+        aiMesh **out,
+        UIntVector &maptbl,
+        unsigned int num_unique) const {
     // ---------------------------------------------------------------------
-    // 0. Offset table to index all meshes continuously, generate a spatially
-    // sorted representation of all vertices in all meshes.
+    // 0. Flatten all faces and corners of all meshes.
     // ---------------------------------------------------------------------
-    typedef std::pair<unsigned int, unsigned int> IntPair;
-    std::vector<IntPair> moffsets(nmesh);
-    unsigned int totfaces = 0, totvert = 0;
+    unsigned int totfaces = 0, totcorners = 0;
     for (size_t t = 0; t < nmesh; ++t) {
         const aiMesh *mesh = smesh[t];
-
-        spatial.Append(mesh->mVertices, mesh->mNumVertices, sizeof(aiVector3D), false);
-        moffsets[t] = IntPair(totfaces, totvert);
-
         totfaces += mesh->mNumFaces;
-        totvert += mesh->mNumVertices;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            totcorners += mesh->mFaces[i].mNumIndices;
+        }
     }
 
-    spatial.Finalize();
-    const unsigned int num_unique = spatial.GenerateMappingTable(maptbl, ComputePositionEpsilon(smesh, nmesh));
+    // per mesh: first face, first vertex and first corner
+    UIntVector meshFaces(nmesh + 1), meshVertices(nmesh + 1), meshCorners(nmesh + 1);
+    // per face: mesh, first corner
+    UIntVector faceMesh(totfaces), faceCorners(totfaces + 1);
+    // per corner: face, distinct vertex
+    UIntVector cornerFace(totcorners), cornerVertex(totcorners);
+    {
+        unsigned int f = 0, k = 0, v = 0;
+        for (size_t t = 0; t < nmesh; ++t) {
+            const aiMesh *mesh = smesh[t];
+            meshFaces[t] = f;
+            meshVertices[t] = v;
+            meshCorners[t] = k;
+            for (unsigned int i = 0; i < mesh->mNumFaces; ++i, ++f) {
+                const aiFace &face = mesh->mFaces[i];
+                faceMesh[f] = static_cast<unsigned int>(t);
+                faceCorners[f] = k;
+                for (unsigned int a = 0; a < face.mNumIndices; ++a, ++k) {
+                    cornerFace[k] = f;
+                    cornerVertex[k] = maptbl[v + face.mIndices[a]];
+                }
+            }
+            v += mesh->mNumVertices;
+        }
+        meshFaces[nmesh] = f;
+        meshVertices[nmesh] = v;
+        meshCorners[nmesh] = k;
+        faceCorners[totfaces] = k;
+    }
 
-#define FLATTEN_VERTEX_IDX(mesh_idx, vert_idx) (moffsets[mesh_idx].second + vert_idx)
-#define FLATTEN_FACE_IDX(mesh_idx, face_idx) (moffsets[mesh_idx].first + face_idx)
+    const auto next = [&](unsigned int k) {
+        return k + 1 == faceCorners[cornerFace[k] + 1] ? faceCorners[cornerFace[k]] : k + 1;
+    };
+    const auto prev = [&](unsigned int k) {
+        return k == faceCorners[cornerFace[k]] ? faceCorners[cornerFace[k] + 1] - 1 : k - 1;
+    };
+    // the input vertex at corner k
+    const auto corner = [&](unsigned int k) {
+        const unsigned int f = cornerFace[k];
+        const aiMesh *mesh = smesh[faceMesh[f]];
+        return Vertex(mesh, mesh->mFaces[f - meshFaces[faceMesh[f]]].mIndices[k - faceCorners[f]]);
+    };
 
     // ---------------------------------------------------------------------
     // 1. Compute the centroid point for all faces
     // ---------------------------------------------------------------------
     std::vector<Vertex> centroids(totfaces);
-    unsigned int nfacesout = 0;
-    for (size_t t = 0, n = 0; t < nmesh; ++t) {
-        const aiMesh *mesh = smesh[t];
-        for (unsigned int i = 0; i < mesh->mNumFaces; ++i, ++n) {
-            const aiFace &face = mesh->mFaces[i];
-            Vertex &c = centroids[n];
-
-            for (unsigned int a = 0; a < face.mNumIndices; ++a) {
-                c += Vertex(mesh, face.mIndices[a]);
+    ForEachChunk(totfaces, mNumThreads, [&](unsigned int begin, unsigned int end) {
+        for (unsigned int f = begin; f < end; ++f) {
+            Vertex &c = centroids[f];
+            for (unsigned int k = faceCorners[f]; k < faceCorners[f + 1]; ++k) {
+                c += corner(k);
             }
-
-            c /= static_cast<float>(face.mNumIndices);
-            nfacesout += face.mNumIndices;
+            c /= static_cast<float>(faceCorners[f + 1] - faceCorners[f]);
         }
-    }
+    });
 
+    // ---------------------------------------------------------------------
+    // 2. Find the edges. Corners are bucketed by the smaller distinct vertex
+    // of their edge, the corners of one edge are in the same bucket then.
+    // Every edge exists twice if there is a neighboring face.
+    // ---------------------------------------------------------------------
+    UIntVector cornerEdge(totcorners);
+    UIntVector edgeCorners[2], edgeRefs;
+    unsigned int numEdges = 0;
     {
-        // we want edges to go away before the recursive calls so begin a new scope
-        EdgeMap edges;
-
-        // ---------------------------------------------------------------------
-        // 2. Set each edge point to be the average of all neighbouring
-        // face points and original points. Every edge exists twice
-        // if there is a neighboring face.
-        // ---------------------------------------------------------------------
-        for (size_t t = 0; t < nmesh; ++t) {
-            const aiMesh *mesh = smesh[t];
+        UIntVector lowVertex(totcorners), highVertex(totcorners), bucketOffsets, bucketCorners;
+        ForEachChunk(totcorners, mNumThreads, [&](unsigned int begin, unsigned int end) {
+            for (unsigned int k = begin; k < end; ++k) {
+                lowVertex[k] = std::min(cornerVertex[k], cornerVertex[next(k)]);
+                highVertex[k] = std::max(cornerVertex[k], cornerVertex[next(k)]);
+            }
+        });
+        CountingSort(lowVertex, num_unique, bucketOffsets, bucketCorners);
 
-            for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
-                const aiFace &face = mesh->mFaces[i];
+        // sorting the corners by the larger vertex and then stably by the smaller one puts the
+        // corners of an edge next to each other, in bucket order. The first of them leads the edge.
+        UIntVector edgeLeader(totcorners), bucketEdges(num_unique + 1, 0);
+        {
+            UIntVector highOffsets, byHigh;
+            CountingSort(highVertex, num_unique, highOffsets, byHigh);
 
-                for (unsigned int p = 0; p < face.mNumIndices; ++p) {
-                    const unsigned int id[] = {
-                        face.mIndices[p],
-                        face.mIndices[p == face.mNumIndices - 1 ? 0 : p + 1]
-                    };
-                    const unsigned int mp[] = {
-                        maptbl[FLATTEN_VERTEX_IDX(t, id[0])],
-                        maptbl[FLATTEN_VERTEX_IDX(t, id[1])]
-                    };
-
-                    Edge &e = edges[MAKE_EDGE_HASH(mp[0], mp[1])];
-                    e.ref++;
-                    if (e.ref <= 2) {
-                        if (e.ref == 1) { // original points (end points) - add only once
-                            e.edge_point = e.midpoint = Vertex(mesh, id[0]) + Vertex(mesh, id[1]);
-                            e.midpoint *= 0.5f;
-                        }
-                        e.edge_point += centroids[FLATTEN_FACE_IDX(t, i)];
+            UIntVector byEdge(totcorners);
+            UIntVector cursor(bucketOffsets.begin(), bucketOffsets.end() - 1);
+            for (const unsigned int k : byHigh) {
+                byEdge[cursor[lowVertex[k]]++] = k;
+            }
+
+            ForEachChunk(num_unique, mNumThreads, [&](unsigned int begin, unsigned int end) {
+                for (unsigned int u = begin; u < end; ++u) {
+                    for (unsigned int j = bucketOffsets[u]; j < bucketOffsets[u + 1]; ++j) {
+                        const unsigned int k = byEdge[j];
+                        const bool first = j == bucketOffsets[u] || highVertex[byEdge[j - 1]] != highVertex[k];
+                        edgeLeader[k] = first ? k : edgeLeader[byEdge[j - 1]];
+                        bucketEdges[u + 1] += first;
                     }
                 }
-            }
+            });
         }
-
-        // ---------------------------------------------------------------------
-        // 3. Normalize edge points
-        // ---------------------------------------------------------------------
-        {
-            unsigned int bad_cnt = 0;
-            for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
-                if ((*it).second.ref < 2) {
-                    ai_assert((*it).second.ref);
-                    ++bad_cnt;
+        for (unsigned int u = 0; u < num_unique; ++u) {
+            bucketEdges[u + 1] += bucketEdges[u];
+        }
+        numEdges = bucketEdges[num_unique];
+
+        // the edges of a bucket are numbered in the order their leading corners appear in it
+        edgeCorners[0].resize(numEdges);
+        edgeCorners[1].assign(numEdges, UINT_MAX);
+        edgeRefs.assign(numEdges, 0);
+        ForEachChunk(num_unique, mNumThreads, [&](unsigned int begin, unsigned int end) {
+            for (unsigned int u = begin; u < end; ++u) {
+                unsigned int e = bucketEdges[u];
+                for (unsigned int j = bucketOffsets[u]; j < bucketOffsets[u + 1]; ++j) {
+                    const unsigned int k = bucketCorners[j];
+                    const unsigned int edge = cornerEdge[k] = edgeLeader[k] == k ? e++ : cornerEdge[edgeLeader[k]];
+                    if (edgeRefs[edge] < 2) {
+                        edgeCorners[edgeRefs[edge]][edge] = k;
+                    }
+                    ++edgeRefs[edge];
                 }
-                (*it).second.edge_point *= 1.f / ((*it).second.ref + 2.f);
             }
+        });
+    }
 
-            if (bad_cnt) {
-                // Report the number of bad edges. bad edges are referenced by less than two
-                // faces in the mesh. They occur at outer model boundaries in non-closed
-                // shapes.
-                ASSIMP_LOG_VERBOSE_DEBUG("Catmull-Clark Subdivider: got ", bad_cnt, " bad edges touching only one face (totally ",
-                        static_cast<unsigned int>(edges.size()), " edges). ");
+    // ---------------------------------------------------------------------
+    // 3. Set each edge point to be the average of all neighbouring
+    // face points and original points.
+    // ---------------------------------------------------------------------
+    // the midpoint of an edge is taken from its first corner, like the original points
+    const auto midpoint = [&](unsigned int e) {
+        const unsigned int k = edgeCorners[0][e];
+        return (corner(k) + corner(next(k))) * 0.5f;
+    };
+
+    std::vector<Vertex> edgePoints(numEdges);
+    ForEachChunk(numEdges, mNumThreads, [&](unsigned int begin, unsigned int end) {
+        for (unsigned int e = begin; e < end; ++e) {
+            // original points (end points) of the first corner
+            const unsigned int k = edgeCorners[0][e];
+            Vertex &point = edgePoints[e];
+            point = corner(k) + corner(next(k));
+            point += centroids[cornerFace[k]];
+            if (edgeRefs[e] >= 2) {
+                point += centroids[cornerFace[edgeCorners[1][e]]];
             }
+            point *= 1.f / (edgeRefs[e] + 2.f);
         }
+    });
+
+    const unsigned int bad_cnt = static_cast<unsigned int>(std::count_if(edgeRefs.begin(), edgeRefs.end(),
+            [](unsigned int ref) { return ref < 2; }));
+    if (bad_cnt) {
+        // Report the number of bad edges. bad edges are referenced by less than two
+        // faces in the mesh. They occur at outer model boundaries in non-closed
+        // shapes.
+        ASSIMP_LOG_VERBOSE_DEBUG("Catmull-Clark Subdivider: got ", bad_cnt, " bad edges touching only one face (totally ",
+                numEdges, " edges). ");
+    }
 
-        // ---------------------------------------------------------------------
-        // 4. Compute a vertex-face adjacency table. We can't reuse the code
-        // from VertexTriangleAdjacency because we need the table for multiple
-        // meshes and out vertex indices need to be mapped to distinct values
-        // first.
-        // ---------------------------------------------------------------------
-        UIntVector faceadjac(nfacesout), cntadjfac(maptbl.size(), 0), ofsadjvec(maptbl.size() + 1, 0);
-        {
-            for (size_t t = 0; t < nmesh; ++t) {
-                const aiMesh *const minp = smesh[t];
-                for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-
-                    const aiFace &f = minp->mFaces[i];
-                    for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                        ++cntadjfac[maptbl[FLATTEN_VERTEX_IDX(t, f.mIndices[n])]];
-                    }
-                }
-            }
-            unsigned int cur = 0;
-            for (size_t i = 0; i < cntadjfac.size(); ++i) {
-                ofsadjvec[i + 1] = cur;
-                cur += cntadjfac[i];
+    // ---------------------------------------------------------------------
+    // 4. Compute the new position of each distinct original point P from
+    // the corners at it:
+    // F := 0
+    // R := 0
+    // n := 0
+    // for each face f containing P
+    //    F := F+ centroid of f
+    //    R := R+ midpoint of edge of f from P to P+1
+    //    n := n+1
+    //
+    // (F+2R+(n-3)P)/n
+    // ---------------------------------------------------------------------
+    UIntVector vertexOffsets, vertexCorners;
+    CountingSort(cornerVertex, num_unique, vertexOffsets, vertexCorners);
+
+    std::vector<Vertex> vertexPoints(num_unique);
+    ForEachChunk(num_unique, mNumThreads, [&](unsigned int begin, unsigned int end) {
+        for (unsigned int u = begin; u < end; ++u) {
+            const unsigned int *adj = vertexCorners.data() + vertexOffsets[u];
+            const unsigned int cnt = vertexOffsets[u + 1] - vertexOffsets[u];
+            if (!cnt) {
+                continue;
             }
-            for (size_t t = 0; t < nmesh; ++t) {
-                const aiMesh *const minp = smesh[t];
-                for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-
-                    const aiFace &f = minp->mFaces[i];
-                    for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                        faceadjac[ofsadjvec[1 + maptbl[FLATTEN_VERTEX_IDX(t, f.mIndices[n])]]++] = FLATTEN_FACE_IDX(t, i);
-                    }
-                }
+            if (cnt < 3) {
+                vertexPoints[u] = corner(adj[0]);
+                continue;
             }
 
-            // check the other way round for consistency
-#ifdef ASSIMP_BUILD_DEBUG
-
-            for (size_t t = 0; t < ofsadjvec.size() - 1; ++t) {
-                for (unsigned int m = 0; m < cntadjfac[t]; ++m) {
-                    const unsigned int fidx = faceadjac[ofsadjvec[t] + m];
-                    ai_assert(fidx < totfaces);
-                    for (size_t n = 1; n < nmesh; ++n) {
-
-                        if (moffsets[n].first > fidx) {
-                            const aiMesh *msh = smesh[--n];
-                            const aiFace &f = msh->mFaces[fidx - moffsets[n].first];
-
-                            bool haveit = false;
-                            for (unsigned int i = 0; i < f.mNumIndices; ++i) {
-                                if (maptbl[FLATTEN_VERTEX_IDX(n, f.mIndices[i])] == (unsigned int)t) {
-                                    haveit = true;
-                                    break;
-                                }
-                            }
-                            ai_assert(haveit);
-                            if (!haveit) {
-                                ASSIMP_LOG_VERBOSE_DEBUG("Catmull-Clark Subdivider: Index not used");
-                            }
-                            break;
-                        }
-                    }
+            Vertex F, R;
+            for (unsigned int o = 0; o < cnt; ++o) {
+                const unsigned int f = cornerFace[adj[o]];
+                F += centroids[f];
+
+                // add *both* edges at the first corner of P in the face. this way, we can be sure
+                // that we add *all* adjacent edges to R. In a closed shape, every edge is added
+                // twice - so we simply leave out the factor 2.f in the above formula and get the
+                // right result.
+                unsigned int m = faceCorners[f];
+                while (cornerVertex[m] != u) {
+                    ++m;
                 }
+                R += midpoint(cornerEdge[prev(m)]) + midpoint(cornerEdge[m]);
             }
 
-#endif
+            const float div = static_cast<float>(cnt), divsq = 1.f / (div * div);
+            vertexPoints[u] = corner(adj[0]) * ((div - 3.f) / div) + R * divsq + F * divsq;
         }
+    });
 
-#define GET_ADJACENT_FACES_AND_CNT(vidx, fstartout, numout) \
-    fstartout = &faceadjac[ofsadjvec[vidx]], numout = cntadjfac[vidx]
-
-        typedef std::pair<bool, Vertex> TouchedOVertex;
-        std::vector<TouchedOVertex> new_points(num_unique, TouchedOVertex(false, Vertex()));
-        // ---------------------------------------------------------------------
-        // 5. Spawn a quad from each face point to the corresponding edge points
-        // the original points being the fourth quad points.
-        // ---------------------------------------------------------------------
-        for (size_t t = 0; t < nmesh; ++t) {
-            const aiMesh *const minp = smesh[t];
-            aiMesh *const mout = out[t] = new aiMesh();
+    // ---------------------------------------------------------------------
+    // 5. Spawn a quad from each face point to the corresponding edge points
+    // the original points being the fourth quad points. The output vertices
+    // are distinct per face point, edge point and original point, which
+    // gives the mapping for the next level.
+    // ---------------------------------------------------------------------
+    for (size_t t = 0; t < nmesh; ++t) {
+        const aiMesh *const minp = smesh[t];
+        aiMesh *const mout = out[t] = new aiMesh();
 
-            for (unsigned int a = 0; a < minp->mNumFaces; ++a) {
-                mout->mNumFaces += minp->mFaces[a].mNumIndices;
-            }
+        // We need random access to the old face buffer, so reuse is not possible.
+        mout->mNumFaces = meshCorners[t + 1] - meshCorners[t];
+        mout->mFaces = new aiFace[mout->mNumFaces];
 
-            // We need random access to the old face buffer, so reuse is not possible.
-            mout->mFaces = new aiFace[mout->mNumFaces];
+        mout->mNumVertices = mout->mNumFaces * 4;
+        mout->mVertices = new aiVector3D[mout->mNumVertices];
 
-            mout->mNumVertices = mout->mNumFaces * 4;
-            mout->mVertices = new aiVector3D[mout->mNumVertices];
+        // quads only, keep material index
+        mout->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mout->mMaterialIndex = minp->mMaterialIndex;
 
-            // quads only, keep material index
-            mout->mPrimitiveTypes = aiPrimitiveType_POLYGON;
-            mout->mMaterialIndex = minp->mMaterialIndex;
+        if (minp->HasNormals()) {
+            mout->mNormals = new aiVector3D[mout->mNumVertices];
+        }
 
-            if (minp->HasNormals()) {
-                mout->mNormals = new aiVector3D[mout->mNumVertices];
-            }
+        if (minp->HasTangentsAndBitangents()) {
+            mout->mTangents = new aiVector3D[mout->mNumVertices];
+            mout->mBitangents = new aiVector3D[mout->mNumVertices];
+        }
 
-            if (minp->HasTangentsAndBitangents()) {
-                mout->mTangents = new aiVector3D[mout->mNumVertices];
-                mout->mBitangents = new aiVector3D[mout->mNumVertices];
-            }
+        for (unsigned int i = 0; minp->HasTextureCoords(i); ++i) {
+            mout->mTextureCoords[i] = new aiVector3D[mout->mNumVertices];
+            mout->mNumUVComponents[i] = minp->mNumUVComponents[i];
+        }
 
-            for (unsigned int i = 0; minp->HasTextureCoords(i); ++i) {
-                mout->mTextureCoords[i] = new aiVector3D[mout->mNumVertices];
-                mout->mNumUVComponents[i] = minp->mNumUVComponents[i];
-            }
+        for (unsigned int i = 0; minp->HasVertexColors(i); ++i) {
+            mout->mColors[i] = new aiColor4D[mout->mNumVertices];
+        }
 
-            for (unsigned int i = 0; minp->HasVertexColors(i); ++i) {
-                mout->mColors[i] = new aiColor4D[mout->mNumVertices];
-            }
+        // keep the face indices in one pool if the input had one
+        if (nullptr != minp->mFaceIndices && mout->mNumVertices) {
+            mout->mFaceIndices = new unsigned int[mout->mNumFaceIndices = mout->mNumVertices];
+        }
+    }
 
-            mout->mNumVertices = mout->mNumFaces << 2u;
-            for (unsigned int i = 0, v = 0, n = 0; i < minp->mNumFaces; ++i) {
-
-                const aiFace &face = minp->mFaces[i];
-                for (unsigned int a = 0; a < face.mNumIndices; ++a) {
-
-                    // Get a clean new face.
-                    aiFace &faceOut = mout->mFaces[n++];
-                    faceOut.mIndices = new unsigned int[faceOut.mNumIndices = 4];
-
-                    // Spawn a new quadrilateral (ccw winding) for this original point between:
-                    // a) face centroid
-                    centroids[FLATTEN_FACE_IDX(t, i)].SortBack(mout, faceOut.mIndices[0] = v++);
-
-                    // b) adjacent edge on the left, seen from the centroid
-                    const Edge &e0 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])],
-                            maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a == face.mNumIndices - 1 ? 0 : a + 1])])]; // fixme: replace with mod face.mNumIndices?
-
-                    // c) adjacent edge on the right, seen from the centroid
-                    const Edge &e1 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])],
-                            maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[!a ? face.mNumIndices - 1 : a - 1])])]; // fixme: replace with mod face.mNumIndices?
-
-                    e0.edge_point.SortBack(mout, faceOut.mIndices[3] = v++);
-                    e1.edge_point.SortBack(mout, faceOut.mIndices[1] = v++);
-
-                    // d= original point P with distinct index i
-                    // F := 0
-                    // R := 0
-                    // n := 0
-                    // for each face f containing i
-                    //    F := F+ centroid of f
-                    //    R := R+ midpoint of edge of f from i to i+1
-                    //    n := n+1
-                    //
-                    // (F+2R+(n-3)P)/n
-                    const unsigned int org = maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])];
-                    TouchedOVertex &ov = new_points[org];
-
-                    if (!ov.first) {
-                        ov.first = true;
-
-                        const unsigned int *adj;
-                        unsigned int cnt;
-                        GET_ADJACENT_FACES_AND_CNT(org, adj, cnt);
-
-                        if (cnt < 3) {
-                            ov.second = Vertex(minp, face.mIndices[a]);
-                        } else {
-
-                            Vertex F, R;
-                            for (unsigned int o = 0; o < cnt; ++o) {
-                                ai_assert(adj[o] < totfaces);
-                                F += centroids[adj[o]];
-
-                                // adj[0] is a global face index - search the face in the mesh list
-                                const aiMesh *mp = nullptr;
-                                size_t nidx;
-
-                                if (adj[o] < moffsets[0].first) {
-                                    mp = smesh[nidx = 0];
-                                } else {
-                                    for (nidx = 1; nidx <= nmesh; ++nidx) {
-                                        if (nidx == nmesh || moffsets[nidx].first > adj[o]) {
-                                            mp = smesh[--nidx];
-                                            break;
-                                        }
-                                    }
-                                }
-
-                                if (mp == nullptr) {
-                                    continue;
-                                }
-
-                                ai_assert(adj[o] - moffsets[nidx].first < mp->mNumFaces);
-                                const aiFace &f = mp->mFaces[adj[o] - moffsets[nidx].first];
-                                bool haveit = false;
-
-                                // find our original point in the face
-                                for (unsigned int m = 0; m < f.mNumIndices; ++m) {
-                                    if (maptbl[FLATTEN_VERTEX_IDX(nidx, f.mIndices[m])] == org) {
-
-                                        // add *both* edges. this way, we can be sure that we add
-                                        // *all* adjacent edges to R. In a closed shape, every
-                                        // edge is added twice - so we simply leave out the
-                                        // factor 2.f in the amove formula and get the right
-                                        // result.
-
-                                        const Edge &c0 = edges[MAKE_EDGE_HASH(org, maptbl[FLATTEN_VERTEX_IDX(
-                                                                                           nidx, f.mIndices[!m ? f.mNumIndices - 1 : m - 1])])];
-                                        // fixme: replace with mod face.mNumIndices?
-
-                                        const Edge &c1 = edges[MAKE_EDGE_HASH(org, maptbl[FLATTEN_VERTEX_IDX(
-                                                                                           nidx, f.mIndices[m == f.mNumIndices - 1 ? 0 : m + 1])])];
-                                        // fixme: replace with mod face.mNumIndices?
-                                        R += c0.midpoint + c1.midpoint;
-
-                                        haveit = true;
-                                        break;
-                                    }
-                                }
-
-                                // this invariant *must* hold if the vertex-to-face adjacency table is valid
-                                ai_assert(haveit);
-                                if (!haveit) {
-                                    ASSIMP_LOG_WARN("OBJ: no name for material library specified.");
-                                }
-                            }
-
-                            const float div = static_cast<float>(cnt), divsq = 1.f / (div * div);
-                            ov.second = Vertex(minp, face.mIndices[a]) * ((div - 3.f) / div) + R * divsq + F * divsq;
-                        }
-                    }
-                    ov.second.SortBack(mout, faceOut.mIndices[2] = v++);
-                }
+    UIntVector nextmap(totcorners * 4);
+    const unsigned int edgeBase = totfaces, vertexBase = totfaces + numEdges;
+    ForEachChunk(totfaces, mNumThreads, [&](unsigned int begin, unsigned int end) {
+        for (unsigned int f = begin; f < end; ++f) {
+            const unsigned int t = faceMesh[f];
+            aiMesh *const mout = out[t];
+            for (unsigned int k = faceCorners[f]; k < faceCorners[f + 1]; ++k) {
+                // Get a clean new face.
+                const unsigned int n = k - meshCorners[t], v = n * 4;
+                aiFace &faceOut = mout->mFaces[n];
+                faceOut.mNumIndices = 4;
+                faceOut.mIndices = mout->mFaceIndices ? mout->mFaceIndices + v : new unsigned int[4];
+
+                // Spawn a new quadrilateral (ccw winding) for this original point between:
+                // a) face centroid
+                centroids[f].SortBack(mout, faceOut.mIndices[0] = v);
+                nextmap[4 * k] = f;
+
+                // b) adjacent edge on the left, seen from the centroid
+                edgePoints[cornerEdge[k]].SortBack(mout, faceOut.mIndices[3] = v + 1);
+                nextmap[4 * k + 1] = edgeBase + cornerEdge[k];
+
+                // c) adjacent edge on the right, seen from the centroid
+                edgePoints[cornerEdge[prev(k)]].SortBack(mout, faceOut.mIndices[1] = v + 2);
+                nextmap[4 * k + 2] = edgeBase + cornerEdge[prev(k)];
+
+                // d) the original point P with its new position
+                vertexPoints[cornerVertex[k]].SortBack(mout, faceOut.mIndices[2] = v + 3);
+                nextmap[4 * k + 3] = vertexBase + cornerVertex[k];
             }
         }
-    } // end of scope for edges, freeing its memory
+    });
 
-    // ---------------------------------------------------------------------
-    // 7. Apply the next subdivision step.
-    // ---------------------------------------------------------------------
-    if (num != 1) {
-        MeshArray tmp(nmesh);
-        InternSubdivide(out, nmesh, &tmp.front(), num - 1);
-        for (size_t i = 0; i < nmesh; ++i) {
-            delete out[i];
-            out[i] = tmp[i];
-        }
-    }
+    maptbl.swap(nextmap);
+    return vertexBase + num_unique;
 }
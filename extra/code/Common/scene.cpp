@@ -66,6 +66,14 @@ aiScene::aiScene() :
 }
 
 aiScene::~aiScene() {
+    Assimp::ScenePrivateData *priv = static_cast<Assimp::ScenePrivateData *>(mPrivate);
+    if (priv && priv->mArena) {
+        // all sub-objects live in the arena and go away with it
+        delete[] mSkeletons;
+        delete priv;
+        return;
+    }
+
     // delete all sub-objects recursively
     delete mRootNode;
 
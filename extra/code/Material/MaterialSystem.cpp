@@ -50,30 +50,51 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h>
 #include <assimp/types.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
 #include <memory>
 
 using namespace Assimp;
 
+namespace {
+
+// Smaller materials are always scanned, the index would not pay off
+const unsigned int MinIndexedProperties = 8;
+
+// Slot of the entries which stand for a proper prefix of a key
+const uint32_t PrefixSlot = UINT32_MAX;
+
+// FNV-1a, so the hashes of all prefixes come for free while hashing a key
+const uint32_t KeyHashSeed = 2166136261u;
+
+inline uint32_t HashKeyChar(uint32_t hash, char c) {
+    return (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+}
+
+inline uint32_t HashKey(const char *pKey) {
+    uint32_t hash = KeyHashSeed;
+    for (; *pKey; ++pKey) {
+        hash = HashKeyChar(hash, *pKey);
+    }
+    return hash;
+}
+
+inline bool EntryLess(const aiMaterialPropertyIndex::Entry &a, const aiMaterialPropertyIndex::Entry &b) {
+    return a.hash < b.hash || (a.hash == b.hash && a.slot < b.slot);
+}
+
 // ------------------------------------------------------------------------------------------------
-// Get a specific property from a material
-aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
+// Search the property list from the front, the reference for all lookups
+aiReturn ScanMaterialProperties(const aiMaterial *pMat,
         const char *pKey,
         unsigned int type,
         unsigned int index,
         const aiMaterialProperty **pPropOut) {
-    ai_assert(pMat != nullptr);
-    ai_assert(pKey != nullptr);
-    ai_assert(pPropOut != nullptr);
-
-    /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
+    const size_t keyLength = strlen(pKey);
     for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
         aiMaterialProperty *prop = pMat->mProperties[i];
 
         if (prop /* just for safety ... */
-                && 0 == strncmp(prop->mKey.data, pKey, strlen(pKey)) && (UINT_MAX == type || prop->mSemantic == type) /* UINT_MAX is a wild-card, but this is undocumented :-) */
+                && 0 == strncmp(prop->mKey.data, pKey, keyLength) && (UINT_MAX == type || prop->mSemantic == type) /* UINT_MAX is a wild-card, but this is undocumented :-) */
                 && (UINT_MAX == index || prop->mIndex == index)) {
             *pPropOut = pMat->mProperties[i];
             return AI_SUCCESS;
@@ -83,27 +104,126 @@ aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
     return AI_FAILURE;
 }
 
-namespace
-{
+// ------------------------------------------------------------------------------------------------
+std::unique_ptr<aiMaterialPropertyIndex::Snapshot> BuildSnapshot(const aiMaterial *mat) {
+    using Entry = aiMaterialPropertyIndex::Entry;
+    std::unique_ptr<aiMaterialPropertyIndex::Snapshot> snapshot(new aiMaterialPropertyIndex::Snapshot());
+    snapshot->properties = mat->mProperties;
+    snapshot->numProperties = mat->mNumProperties;
+
+    std::vector<Entry> &entries = snapshot->entries;
+    for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+        const aiMaterialProperty *prop = mat->mProperties[i];
+        if (nullptr == prop) {
+            continue;
+        }
+        uint32_t hash = KeyHashSeed;
+        for (const char *c = prop->mKey.data; *c; ++c) {
+            entries.push_back({ hash, PrefixSlot });
+            hash = HashKeyChar(hash, *c);
+        }
+        entries.push_back({ hash, i });
+    }
+    std::sort(entries.begin(), entries.end(), EntryLess);
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.hash == b.hash && a.slot == b.slot;
+    }), entries.end());
+    entries.shrink_to_fit();
+
+    // Different keys with the same hash would need a string compare for every
+    // entry, such materials are rare enough to just scan them.
+    for (size_t i = 1; i < entries.size() && !snapshot->collisions; ++i) {
+        const Entry &a = entries[i - 1], &b = entries[i];
+        snapshot->collisions = a.hash == b.hash && PrefixSlot != b.slot &&
+                0 != strcmp(mat->mProperties[a.slot]->mKey.data, mat->mProperties[b.slot]->mKey.data);
+    }
+    return snapshot;
+}
+
+} // namespace
 
 // ------------------------------------------------------------------------------------------------
-// Implementation of functions "aiGetMaterialFloatArray" and "aiGetMaterialFloatFloatArray".
-template <class TReal>
-aiReturn GetMaterialFloatArray(const aiMaterial *pMat,
+const aiMaterialPropertyIndex::Snapshot *aiMaterialPropertyIndex::Acquire(const aiMaterial *mat) {
+    const Snapshot *snapshot = current.load(std::memory_order_acquire);
+    if (nullptr != snapshot && snapshot->properties == mat->mProperties && snapshot->numProperties == mat->mNumProperties) {
+        return snapshot;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    snapshot = current.load(std::memory_order_relaxed);
+    if (nullptr != snapshot && snapshot->properties == mat->mProperties && snapshot->numProperties == mat->mNumProperties) {
+        return snapshot;
+    }
+
+    // The property list was edited directly, other readers may still use the old snapshot
+    snapshots.push_back(BuildSnapshot(mat));
+    snapshot = snapshots.back().get();
+    current.store(snapshot, std::memory_order_release);
+    return snapshot;
+}
+
+// ------------------------------------------------------------------------------------------------
+void aiMaterialPropertyIndex::Invalidate() {
+    if (!snapshots.empty()) {
+        current.store(nullptr, std::memory_order_relaxed);
+        snapshots.clear();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get a specific property from a material
+aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
         const char *pKey,
         unsigned int type,
         unsigned int index,
-        TReal *pOut,
-        unsigned int *pMax) {
-    ai_assert(pOut != nullptr);
+        const aiMaterialProperty **pPropOut) {
     ai_assert(pMat != nullptr);
+    ai_assert(pKey != nullptr);
+    ai_assert(pPropOut != nullptr);
 
-    const aiMaterialProperty *prop;
-    aiGetMaterialProperty(pMat, pKey, type, index, (const aiMaterialProperty **)&prop);
-    if (nullptr == prop) {
-        return AI_FAILURE;
+    aiMaterialPropertyIndex *propertyIndex = pMat->mPropertyIndex;
+    if (nullptr == propertyIndex || pMat->mNumProperties < MinIndexedProperties) {
+        return ScanMaterialProperties(pMat, pKey, type, index, pPropOut);
+    }
+
+    const aiMaterialPropertyIndex::Snapshot *snapshot = propertyIndex->Acquire(pMat);
+    if (snapshot->collisions) {
+        return ScanMaterialProperties(pMat, pKey, type, index, pPropOut);
+    }
+
+    // The entries of a key are sorted by slot, so the first match is the one
+    // a scan would find. A prefix entry means a longer key may match earlier.
+    const uint32_t hash = HashKey(pKey);
+    const aiMaterialProperty *found = nullptr;
+    for (auto it = std::lower_bound(snapshot->entries.begin(), snapshot->entries.end(), aiMaterialPropertyIndex::Entry{ hash, 0 }, EntryLess);
+            it != snapshot->entries.end() && it->hash == hash; ++it) {
+        if (PrefixSlot == it->slot) {
+            return ScanMaterialProperties(pMat, pKey, type, index, pPropOut);
+        }
+        const aiMaterialProperty *prop = pMat->mProperties[it->slot];
+        if (nullptr == found && (UINT_MAX == type || prop->mSemantic == type) && (UINT_MAX == index || prop->mIndex == index)) {
+            found = prop;
+        }
+    }
+
+    if (nullptr != found && 0 != strcmp(found->mKey.data, pKey)) {
+        // hash collision with a key of the material
+        return ScanMaterialProperties(pMat, pKey, type, index, pPropOut);
     }
+    *pPropOut = found;
+    return found ? AI_SUCCESS : AI_FAILURE;
+}
+
+namespace
+{
 
+// ------------------------------------------------------------------------------------------------
+// Convert the value of a property to an array of TReal.
+template <class TReal>
+aiReturn ReadFloatArray(const aiMaterialProperty *prop,
+        const char *pKey,
+        TReal *pOut,
+        unsigned int *pMax) {
     // data is given in floats, convert to TReal
     unsigned int iWrite = 0;
     if (aiPTI_Float == prop->mType || aiPTI_Buffer == prop->mType) {
@@ -178,46 +298,31 @@ aiReturn GetMaterialFloatArray(const aiMaterial *pMat,
 }
 
 // ------------------------------------------------------------------------------------------------
-// Get an array of float typed float values from the material.
-aiReturn aiGetMaterialFloatFloatArray(const aiMaterial *pMat,
-        const char *pKey,
-        unsigned int type,
-        unsigned int index,
-        float *pOut,
-        unsigned int *pMax) {
-    return ::GetMaterialFloatArray(pMat, pKey, type, index, pOut, pMax);
-}
-
-} // namespace
-
-// ------------------------------------------------------------------------------------------------
-// Get an array of floating-point values from the material.
-aiReturn aiGetMaterialFloatArray(const aiMaterial *pMat,
-        const char *pKey,
-        unsigned int type,
-        unsigned int index,
-        ai_real *pOut,
-        unsigned int *pMax) {
-    return ::GetMaterialFloatArray(pMat, pKey, type, index, pOut, pMax);
-}
-
-// ------------------------------------------------------------------------------------------------
-// Get an array if integers from the material
-aiReturn aiGetMaterialIntegerArray(const aiMaterial *pMat,
+// Implementation of functions "aiGetMaterialFloatArray" and "aiGetMaterialFloatFloatArray".
+template <class TReal>
+aiReturn GetMaterialFloatArray(const aiMaterial *pMat,
         const char *pKey,
         unsigned int type,
         unsigned int index,
-        int *pOut,
+        TReal *pOut,
         unsigned int *pMax) {
     ai_assert(pOut != nullptr);
     ai_assert(pMat != nullptr);
 
     const aiMaterialProperty *prop;
     aiGetMaterialProperty(pMat, pKey, type, index, (const aiMaterialProperty **)&prop);
-    if (!prop) {
+    if (nullptr == prop) {
         return AI_FAILURE;
     }
+    return ReadFloatArray(prop, pKey, pOut, pMax);
+}
 
+// ------------------------------------------------------------------------------------------------
+// Convert the value of a property to an array of integers.
+aiReturn ReadIntegerArray(const aiMaterialProperty *prop,
+        const char *pKey,
+        int *pOut,
+        unsigned int *pMax) {
     // data is given in ints, simply copy it
     unsigned int iWrite = 0;
     if (aiPTI_Integer == prop->mType || aiPTI_Buffer == prop->mType) {
@@ -279,6 +384,50 @@ aiReturn aiGetMaterialIntegerArray(const aiMaterial *pMat,
     return AI_SUCCESS;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get an array of float typed float values from the material.
+aiReturn aiGetMaterialFloatFloatArray(const aiMaterial *pMat,
+        const char *pKey,
+        unsigned int type,
+        unsigned int index,
+        float *pOut,
+        unsigned int *pMax) {
+    return ::GetMaterialFloatArray(pMat, pKey, type, index, pOut, pMax);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Get an array of floating-point values from the material.
+aiReturn aiGetMaterialFloatArray(const aiMaterial *pMat,
+        const char *pKey,
+        unsigned int type,
+        unsigned int index,
+        ai_real *pOut,
+        unsigned int *pMax) {
+    return ::GetMaterialFloatArray(pMat, pKey, type, index, pOut, pMax);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get an array if integers from the material
+aiReturn aiGetMaterialIntegerArray(const aiMaterial *pMat,
+        const char *pKey,
+        unsigned int type,
+        unsigned int index,
+        int *pOut,
+        unsigned int *pMax) {
+    ai_assert(pOut != nullptr);
+    ai_assert(pMat != nullptr);
+
+    const aiMaterialProperty *prop;
+    aiGetMaterialProperty(pMat, pKey, type, index, (const aiMaterialProperty **)&prop);
+    if (!prop) {
+        return AI_FAILURE;
+    }
+
+    return ReadIntegerArray(prop, pKey, pOut, pMax);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a color (3 or 4 floats) from the material
 aiReturn aiGetMaterialColor(const aiMaterial *pMat,
@@ -417,12 +566,120 @@ aiReturn aiGetMaterialTexture(const C_STRUCT aiMaterial *mat,
     return AI_SUCCESS;
 }
 
+namespace {
+
+// Key of an AI_MATKEY_XXX triple
+constexpr const char *KeyOf(const char *pKey, unsigned int, unsigned int) {
+    return pKey;
+}
+
+struct PBRKey {
+    const char *key;
+    aiMaterialPBRFlags flag;
+    uint32_t hash;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Read all metallic-roughness parameters in one pass over the property list
+aiReturn aiGetMaterialPBR(const aiMaterial *pMat, aiMaterialPBR *pOut) {
+    ai_assert(pMat != nullptr);
+    ai_assert(pOut != nullptr);
+
+    static const PBRKey keys[] = {
+        { KeyOf(AI_MATKEY_BASE_COLOR), aiMaterialPBRFlags_BaseColor, HashKey(KeyOf(AI_MATKEY_BASE_COLOR)) },
+        { KeyOf(AI_MATKEY_METALLIC_FACTOR), aiMaterialPBRFlags_Metallic, HashKey(KeyOf(AI_MATKEY_METALLIC_FACTOR)) },
+        { KeyOf(AI_MATKEY_ROUGHNESS_FACTOR), aiMaterialPBRFlags_Roughness, HashKey(KeyOf(AI_MATKEY_ROUGHNESS_FACTOR)) },
+        { KeyOf(AI_MATKEY_COLOR_EMISSIVE), aiMaterialPBRFlags_Emissive, HashKey(KeyOf(AI_MATKEY_COLOR_EMISSIVE)) },
+        { KeyOf(AI_MATKEY_EMISSIVE_INTENSITY), aiMaterialPBRFlags_EmissiveIntensity, HashKey(KeyOf(AI_MATKEY_EMISSIVE_INTENSITY)) },
+        { KeyOf(AI_MATKEY_OPACITY), aiMaterialPBRFlags_Opacity, HashKey(KeyOf(AI_MATKEY_OPACITY)) },
+        { KeyOf(AI_MATKEY_TRANSMISSION_FACTOR), aiMaterialPBRFlags_Transmission, HashKey(KeyOf(AI_MATKEY_TRANSMISSION_FACTOR)) },
+        { KeyOf(AI_MATKEY_CLEARCOAT_FACTOR), aiMaterialPBRFlags_Clearcoat, HashKey(KeyOf(AI_MATKEY_CLEARCOAT_FACTOR)) },
+        { KeyOf(AI_MATKEY_CLEARCOAT_ROUGHNESS_FACTOR), aiMaterialPBRFlags_ClearcoatRoughness, HashKey(KeyOf(AI_MATKEY_CLEARCOAT_ROUGHNESS_FACTOR)) },
+        { KeyOf(AI_MATKEY_TWOSIDED), aiMaterialPBRFlags_TwoSided, HashKey(KeyOf(AI_MATKEY_TWOSIDED)) },
+    };
+
+    aiMaterialPBR &out = *pOut;
+    out.mBaseColor = aiColor4D(1.0, 1.0, 1.0, 1.0);
+    out.mMetallicFactor = 1.0;
+    out.mRoughnessFactor = 1.0;
+    out.mEmissiveColor = aiColor4D(0.0, 0.0, 0.0, 1.0);
+    out.mEmissiveIntensity = 1.0;
+    out.mOpacity = 1.0;
+    out.mTransmissionFactor = 0.0;
+    out.mClearcoatFactor = 0.0;
+    out.mClearcoatRoughnessFactor = 0.0;
+    out.mTwoSided = 0;
+    out.mFlags = 0;
+
+    for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
+        const aiMaterialProperty *prop = pMat->mProperties[i];
+        if (nullptr == prop || prop->mSemantic || prop->mIndex) {
+            continue;
+        }
+
+        // like the single getters, the first property with a key wins
+        const uint32_t hash = HashKey(prop->mKey.data);
+        for (const PBRKey &key : keys) {
+            if (key.hash != hash || (out.mFlags & key.flag) || 0 != strcmp(key.key, prop->mKey.data)) {
+                continue;
+            }
+
+            unsigned int iMax = aiMaterialPBRFlags_BaseColor == key.flag || aiMaterialPBRFlags_Emissive == key.flag ? 4 : 1;
+            aiReturn ret = AI_FAILURE;
+            switch (key.flag) {
+            case aiMaterialPBRFlags_BaseColor:
+            case aiMaterialPBRFlags_Emissive: {
+                aiColor4D &clr = aiMaterialPBRFlags_BaseColor == key.flag ? out.mBaseColor : out.mEmissiveColor;
+                ret = ReadFloatArray(prop, key.key, &clr.r, &iMax);
+                if (3 == iMax) {
+                    clr.a = 1.0;
+                }
+                break;
+            }
+            case aiMaterialPBRFlags_Metallic:
+                ret = ReadFloatArray(prop, key.key, &out.mMetallicFactor, &iMax);
+                break;
+            case aiMaterialPBRFlags_Roughness:
+                ret = ReadFloatArray(prop, key.key, &out.mRoughnessFactor, &iMax);
+                break;
+            case aiMaterialPBRFlags_EmissiveIntensity:
+                ret = ReadFloatArray(prop, key.key, &out.mEmissiveIntensity, &iMax);
+                break;
+            case aiMaterialPBRFlags_Opacity:
+                ret = ReadFloatArray(prop, key.key, &out.mOpacity, &iMax);
+                break;
+            case aiMaterialPBRFlags_Transmission:
+                ret = ReadFloatArray(prop, key.key, &out.mTransmissionFactor, &iMax);
+                break;
+            case aiMaterialPBRFlags_Clearcoat:
+                ret = ReadFloatArray(prop, key.key, &out.mClearcoatFactor, &iMax);
+                break;
+            case aiMaterialPBRFlags_ClearcoatRoughness:
+                ret = ReadFloatArray(prop, key.key, &out.mClearcoatRoughnessFactor, &iMax);
+                break;
+            case aiMaterialPBRFlags_TwoSided:
+                ret = ReadIntegerArray(prop, key.key, &out.mTwoSided, &iMax);
+                break;
+            default:
+                break;
+            }
+            if (AI_SUCCESS == ret) {
+                out.mFlags |= key.flag;
+            }
+            break;
+        }
+    }
+    return out.mFlags ? AI_SUCCESS : AI_FAILURE;
+}
+
 static const unsigned int DefaultNumAllocated = 5;
 
 // ------------------------------------------------------------------------------------------------
 // Construction. Actually the one and only way to get an aiMaterial instance
 aiMaterial::aiMaterial() :
-        mProperties(nullptr), mNumProperties(0), mNumAllocated(DefaultNumAllocated) {
+        mProperties(nullptr), mNumProperties(0), mNumAllocated(DefaultNumAllocated), mPropertyIndex(new aiMaterialPropertyIndex()) {
     // Allocate 5 entries by default
     mProperties = new aiMaterialProperty *[DefaultNumAllocated];
 }
@@ -432,6 +689,14 @@ aiMaterial::~aiMaterial() {
     Clear();
 
     delete[] mProperties;
+    delete mPropertyIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+void aiMaterial::InvalidatePropertyIndex() {
+    if (nullptr != mPropertyIndex) {
+        mPropertyIndex->Invalidate();
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -444,6 +709,7 @@ aiString aiMaterial::GetName() const {
 
 // ------------------------------------------------------------------------------------------------
 void aiMaterial::Clear() {
+    InvalidatePropertyIndex();
     for (unsigned int i = 0; i < mNumProperties; ++i) {
         // delete this entry
         delete mProperties[i];
@@ -457,6 +723,7 @@ void aiMaterial::Clear() {
 // ------------------------------------------------------------------------------------------------
 aiReturn aiMaterial::RemoveProperty(const char *pKey, unsigned int type, unsigned int index) {
     ai_assert(nullptr != pKey);
+    InvalidatePropertyIndex();
 
     for (unsigned int i = 0; i < mNumProperties; ++i) {
         aiMaterialProperty *prop = mProperties[i];
@@ -492,6 +759,7 @@ aiReturn aiMaterial::AddBinaryProperty(const void *pInput,
     if (0 == pSizeInBytes) {
         return AI_FAILURE;
     }
+    InvalidatePropertyIndex();
 
     // first search the list whether there is already an entry with this key
     unsigned int iOutIndex(UINT_MAX);
@@ -594,6 +862,7 @@ void aiMaterial::CopyPropertyList(aiMaterial *const pcDest,
     ai_assert(nullptr != pcSrc);
     ai_assert(pcDest->mNumProperties <= pcDest->mNumAllocated);
     ai_assert(pcSrc->mNumProperties <= pcSrc->mNumAllocated);
+    pcDest->InvalidatePropertyIndex();
 
     const unsigned int iOldNum = pcDest->mNumProperties;
     pcDest->mNumAllocated += pcSrc->mNumAllocated;
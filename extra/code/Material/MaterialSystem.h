@@ -47,8 +47,47 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_MATERIALSYSTEM_H_INC
 
 #include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 struct aiMaterial;
+struct aiMaterialProperty;
+
+// ------------------------------------------------------------------------------
+/** Lookup index of a material, see aiMaterial::mPropertyIndex.
+ *
+ *  Each property is entered with the hash of its key and its position in
+ *  aiMaterial::mProperties. Lookups match keys by prefix, so the proper
+ *  prefixes of all keys are entered as well; a lookup which hits one of them
+ *  falls back to scanning the list. Concurrent readers share the index, so a
+ *  snapshot is never modified once published, and replaced snapshots stay
+ *  alive until the material is modified through its member functions.
+ */
+struct aiMaterialPropertyIndex {
+    struct Entry {
+        uint32_t hash;
+        uint32_t slot;
+    };
+
+    struct Snapshot {
+        aiMaterialProperty **properties = nullptr;
+        unsigned int numProperties = 0;
+        bool collisions = false;
+        std::vector<Entry> entries;
+    };
+
+    /** Returns the snapshot for the current property list, builds it if needed. */
+    const Snapshot *Acquire(const aiMaterial *mat);
+
+    /** Drops all snapshots, the caller must have exclusive access. */
+    void Invalidate();
+
+    std::atomic<const Snapshot *> current{ nullptr };
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Snapshot>> snapshots;
+};
 
 namespace Assimp {
 
@@ -102,6 +102,8 @@ private:
     /** Configuration option: maximum smoothing angle, in radians*/
     float configMaxAngle;
     unsigned int configSourceUV;
+    /** Configuration option: find close vertices with a SpatialGrid */
+    bool configUseGrid = false;
 };
 
 } // end of namespace Assimp
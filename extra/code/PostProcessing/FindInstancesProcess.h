@@ -48,6 +48,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/BaseProcess.h"
 #include "PostProcessing/ProcessHelper.h"
 
+#include <algorithm>
+#include <cmath>
+
 class FindInstancesProcessTest;
 
 namespace Assimp {
@@ -66,16 +69,53 @@ inline uint64_t GetMeshHash(aiMesh* in) {
     // ... get an unique value representing the vertex format of the mesh
     const unsigned int fhash = GetMeshVFormatUnique(in);
 
-    // and bake it with number of vertices/faces/bones/matidx/ptypes
-    return ((uint64_t)fhash << 32u) | ((
-        (in->mNumBones << 16u) ^  (in->mNumVertices)       ^
-        (in->mNumFaces<<4u)    ^  (in->mMaterialIndex<<15) ^
-        (in->mPrimitiveTypes<<28)) & 0xffffffff );
+    // and bake it with number of vertices/faces/bones/matidx/ptypes. The
+    // fields are mixed one after another so that they can't cancel out.
+    uint64_t hash = fhash;
+    const unsigned int fields[] = {
+        in->mNumVertices, in->mNumFaces, in->mNumBones, in->mMaterialIndex, in->mPrimitiveTypes
+    };
+    for (unsigned int field : fields) {
+        hash ^= field + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+// -------------------------------------------------------------------------------
+/** @brief Get a geometric fingerprint of a mesh.
+ *
+ *  The fingerprint is the mean projection of a fixed number of vertices,
+ *  sampled evenly from the position array, onto an axis with irrational
+ *  slopes (so that regular grids of parts don't collapse onto the same
+ *  value). The axis has a length of less than 1.5, so if the positions of
+ *  two meshes differ by less than sqrt(e) per vertex their fingerprints
+ *  differ by less than 1.5*sqrt(e). It can be used to narrow down instance
+ *  candidates without missing any of them.
+ *  @param in Input mesh
+ *  @return Fingerprint, 0 for meshes without (finite) positions
+ */
+inline double GetMeshFingerprint(const aiMesh* in) {
+    ai_assert(nullptr != in);
+
+    static const unsigned int NumSamples = 8;
+    if (!in->HasPositions()) {
+        return 0.0;
+    }
+    const unsigned int num = std::min(NumSamples, in->mNumVertices);
+    double sum = 0.0;
+    for (unsigned int i = 0; i < num; ++i) {
+        const aiVector3D& v = in->mVertices[(uint64_t)i * in->mNumVertices / num];
+        sum += (double)v.x + 0.7548776662466927 * v.y + 0.5698402909980532 * v.z;
+    }
+    sum /= num;
+    return std::isfinite(sum) ? sum : 0.0;
 }
 
 // -------------------------------------------------------------------------------
 /** @brief Perform a component-wise comparison of two arrays
  *
+ *  The arrays are compared in blocks. There is no early out inside a block,
+ *  which allows the compiler to vectorize the inner loop.
  *  @param first First array
  *  @param second Second array
  *  @param size Size of both arrays
@@ -84,8 +124,22 @@ inline uint64_t GetMeshHash(aiMesh* in) {
  */
 inline bool CompareArrays(const aiVector3D* first, const aiVector3D* second,
         unsigned int size, float e) {
-    for (const aiVector3D* end = first+size; first != end; ++first,++second) {
-        if ( (*first - *second).SquareLength() >= e)
+    static const unsigned int BlockSize = 16;
+    unsigned int i = 0;
+    for (; i + BlockSize <= size; i += BlockSize) {
+        unsigned int mismatch = 0;
+        for (unsigned int k = i; k < i + BlockSize; ++k) {
+            const ai_real dx = first[k].x - second[k].x;
+            const ai_real dy = first[k].y - second[k].y;
+            const ai_real dz = first[k].z - second[k].z;
+            mismatch |= (dx * dx + dy * dy + dz * dz >= e);
+        }
+        if (mismatch) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if ( (first[i] - second[i]).SquareLength() >= e)
             return false;
     }
     return true;
@@ -95,8 +149,19 @@ inline bool CompareArrays(const aiVector3D* first, const aiVector3D* second,
 inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
     unsigned int size, float e)
 {
-    for (const aiColor4D* end = first+size; first != end; ++first,++second) {
-        if ( GetColorDifference(*first,*second) >= e)
+    static const unsigned int BlockSize = 16;
+    unsigned int i = 0;
+    for (; i + BlockSize <= size; i += BlockSize) {
+        unsigned int mismatch = 0;
+        for (unsigned int k = i; k < i + BlockSize; ++k) {
+            mismatch |= (GetColorDifference(first[k], second[k]) >= e);
+        }
+        if (mismatch) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if ( GetColorDifference(first[i],second[i]) >= e)
             return false;
     }
     return true;
@@ -105,7 +170,7 @@ inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
 // ---------------------------------------------------------------------------
 /** @brief A post-processing steps to search for instanced meshes
 */
-class FindInstancesProcess : public BaseProcess {
+class ASSIMP_API FindInstancesProcess : public BaseProcess {
 public:
     FindInstancesProcess();
     ~FindInstancesProcess() override = default;
@@ -123,6 +188,10 @@ public:
     void SetupProperties(const Importer* pImp) override;
 
 private:
+    // -------------------------------------------------------------------
+    // Check whether inst is an instance of orig, i.e. equal within epsilon
+    bool IsInstance(const aiMesh* orig, const aiMesh* inst, float epsilon) const;
+
     bool configSpeedFlag;
 }; // ! end class FindInstancesProcess
 
@@ -103,6 +103,8 @@ public:
 private:
     /** Configuration option: maximum smoothing angle, in radians*/
     ai_real configMaxAngle;
+    /** Configuration option: find close vertices with a SpatialGrid */
+    bool configUseGrid = false;
     mutable bool force_ = false;
     mutable bool flippedWindingOrder_ = false;
     mutable bool leftHanded_ = false;
@@ -89,10 +89,16 @@ void ImproveCacheLocalityProcess::Execute(aiScene *pScene) {
 
     ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
 
+    std::vector<ai_real> acmr(pScene->mNumMeshes, 0.f);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        acmr[a] = ProcessMesh(pScene->mMeshes[a], a);
+    });
+
+    // sum up in mesh order so the statistics do not depend on the thread count
     float out = 0.f;
     unsigned int numf = 0, numm = 0;
     for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
-        const float res = ProcessMesh(pScene->mMeshes[a], a);
+        const float res = acmr[a];
         if (res) {
             numf += pScene->mMeshes[a]->mNumFaces;
             out += res;
@@ -47,14 +47,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "JoinVerticesProcess.h"
 #include "ProcessHelper.h"
-#include <assimp/Vertex.h>
 #include <assimp/TinyFormatter.h>
 
 #include <stdio.h>
-#include <unordered_set>
-#include <unordered_map>
+#include <cstdint>
+#include <cstring>
 #include <memory>
-#include <map>
+#include <vector>
 
 using namespace Assimp;
 
@@ -77,9 +76,13 @@ void JoinVerticesProcess::Execute( aiScene* pScene) {
     }
 
     // execute the step
+    std::vector<int> numVertices(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        numVertices[a] = ProcessMesh(pScene->mMeshes[a], a);
+    });
     int iNumVertices = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++) {
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+    for (int n : numVertices) {
+        iNumVertices += n;
     }
 
     pScene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
@@ -100,63 +103,122 @@ void JoinVerticesProcess::Execute( aiScene* pScene) {
 
 namespace {
 
-struct CompareVerticesAlmostEqual {
-    bool operator () (const Vertex & a, const Vertex & b) const {
-        static const float epsilon = 1e-5f;
-        static const float squareEpsilon = epsilon * epsilon;
-
-        if ((a.position - b.position).SquareLength() > squareEpsilon) {
-            return false;
+// The attribute streams a mesh actually has, gathered once so that two vertices can be
+// compared in place without copying them into a Vertex first. Missing streams would compare
+// equal anyway (Vertex zero-fills them), so skipping them keeps the result the same.
+struct VertexStreams {
+    const aiVector3D *positions;
+    const aiVector3D *vectors[3 + AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    unsigned int numVectors = 0;
+    const aiColor4D *colors[AI_MAX_NUMBER_OF_COLOR_SETS];
+    unsigned int numColors = 0;
+
+    explicit VertexStreams(const aiMesh *pMesh) :
+            positions(pMesh->mVertices) {
+        if (pMesh->mNormals) {
+            vectors[numVectors++] = pMesh->mNormals;
         }
-
-        // We just test the other attributes even if they're not present in the mesh.
-        // In this case they're initialized to 0 so the comparison succeeds.
-        // By this method the non-present attributes are effectively ignored in the comparison.
-
-        if ((a.normal - b.normal).SquareLength() > squareEpsilon) {
-            return false;
+        if (pMesh->mTangents) {
+            vectors[numVectors++] = pMesh->mTangents;
         }
-
-        if ((a.tangent - b.tangent).SquareLength() > squareEpsilon) {
-            return false;
+        if (pMesh->mBitangents) {
+            vectors[numVectors++] = pMesh->mBitangents;
+        }
+        for (unsigned int i = 0; pMesh->HasTextureCoords(i); ++i) {
+            vectors[numVectors++] = pMesh->mTextureCoords[i];
         }
+        for (unsigned int i = 0; pMesh->HasVertexColors(i); ++i) {
+            colors[numColors++] = pMesh->mColors[i];
+        }
+    }
 
-        if ((a.bitangent - b.bitangent).SquareLength() > squareEpsilon) {
+    bool AlmostEqual(unsigned int a, unsigned int b) const {
+        static const float epsilon = 1e-5f;
+        static const float squareEpsilon = epsilon * epsilon;
+
+        if ((positions[a] - positions[b]).SquareLength() > squareEpsilon) {
             return false;
         }
-
-        for (uint32_t i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; i ++) {
-            if ((a.texcoords[i] - b.texcoords[i]).SquareLength() > squareEpsilon) {
+        for (unsigned int i = 0; i < numVectors; ++i) {
+            if ((vectors[i][a] - vectors[i][b]).SquareLength() > squareEpsilon) {
                 return false;
             }
         }
-
-        for (uint32_t i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; i ++) {
-            if (GetColorDifference(a.colors[i], b.colors[i]) > squareEpsilon) {
+        for (unsigned int i = 0; i < numColors; ++i) {
+            if (GetColorDifference(colors[i][a], colors[i][b]) > squareEpsilon) {
                 return false;
             }
         }
-
-        // If reached this point, they are ~equal
         return true;
     }
 };
 
-struct HashVertex {
-    inline void hash_combine(std::size_t& seed, const ai_real& v) const {
-        std::hash<ai_real> hasher;
-        seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+// Only the position goes into the hash. The other attributes are compared with a tolerance,
+// hashing their bits would keep vertices apart which only differ by less than epsilon there.
+inline uint32_t HashReal(ai_real v) {
+    // 0 and -0 are equal, they need the same hash
+    if (v == ai_real(0)) {
+        v = ai_real(0);
     }
+    uint64_t bits = 0;
+    ::memcpy(&bits, &v, sizeof(v));
+    return static_cast<uint32_t>(bits ^ (bits >> 32));
+}
 
-    size_t operator () (const Vertex & v) const {
-        size_t hash = 0;
+inline uint32_t HashPosition(const aiVector3D &p) {
+    uint32_t h = HashReal(p.x) * 0x9e3779b1u;
+    h = (h ^ HashReal(p.y)) * 0x85ebca6bu;
+    h = (h ^ HashReal(p.z)) * 0xc2b2ae35u;
+    // final mix of murmur3, the low bits select the slot
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
 
-        hash_combine(hash, v.position.x);
-        hash_combine(hash, v.position.y);
-        hash_combine(hash, v.position.z);
+// Open addressing hash set of vertex indices, sized once for the number of used vertices so it
+// never grows. A slot keeps the hash next to the index, most probes are rejected without
+// touching the vertex data.
+class UniqueVertexTable {
+public:
+    explicit UniqueVertexTable(unsigned int maxVertices) {
+        size_t capacity = 16;
+        while (capacity < size_t(maxVertices) * 2) {
+            capacity <<= 1;
+        }
+        mMask = capacity - 1;
+        mSlots.resize(capacity, Slot{ 0, Empty });
+    }
 
-        return hash;
+    // Returns a vertex already in the table which is equal to vertex, or adds vertex and
+    // returns it. Of several equal vertices the one inserted first is found.
+    unsigned int FindOrInsert(unsigned int vertex, const VertexStreams &streams) {
+        const uint32_t hash = HashPosition(streams.positions[vertex]);
+        for (size_t i = hash & mMask;; i = (i + 1) & mMask) {
+            Slot &slot = mSlots[i];
+            if (slot.vertex == Empty) {
+                slot.hash = hash;
+                slot.vertex = vertex;
+                return vertex;
+            }
+            if (slot.hash == hash && streams.AlmostEqual(slot.vertex, vertex)) {
+                return slot.vertex;
+            }
+        }
     }
+
+private:
+    static constexpr uint32_t Empty = 0xffffffff;
+
+    struct Slot {
+        uint32_t hash;
+        uint32_t vertex;
+    };
+
+    std::vector<Slot> mSlots;
+    size_t mMask;
 };
 
 template<class XMesh>
@@ -231,72 +293,53 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
         return 0;
     }
 
+    // For each vertex the index of the vertex it was replaced by.
+    // Since the maximal number of vertices is 2^31-1, the most significand bit can be used to mark
+    //  whether a new vertex was created for the index (true) or if it was replaced by an existing
+    //  unique vertex (false). This saves an additional std::vector<bool> and greatly enhances
+    //  branching performance.
+    static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
+    static constexpr unsigned int UNUSED_VERTEX = 0xffffffff;
+    std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, UNUSED_VERTEX);
+
     // We should care only about used vertices, not all of them
     // (this can happen due to original file vertices buffer being used by
-    // multiple meshes)
-    std::vector<bool> usedVertexIndicesMask;
-    usedVertexIndicesMask.resize(pMesh->mNumVertices, false);
+    // multiple meshes). Used vertices are marked with 0 until they get their index.
+    unsigned int numUsedVertices = 0;
     for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         aiFace& face = pMesh->mFaces[a];
         for (unsigned int b = 0; b < face.mNumIndices; b++) {
-            usedVertexIndicesMask[face.mIndices[b]] = true;
+            unsigned int &replace = replaceIndex[face.mIndices[b]];
+            if (replace == UNUSED_VERTEX) {
+                replace = 0;
+                ++numUsedVertices;
+            }
         }
     }
 
     // We'll never have more vertices afterwards.
     std::vector<int> uniqueVertices;
+    uniqueVertices.reserve(numUsedVertices);
 
-    // For each vertex the index of the vertex it was replaced by.
-    // Since the maximal number of vertices is 2^31-1, the most significand bit can be used to mark
-    //  whether a new vertex was created for the index (true) or if it was replaced by an existing
-    //  unique vertex (false). This saves an additional std::vector<bool> and greatly enhances
-    //  branching performance.
-    static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
-    std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
-
-    // Run an optimized code path if we don't have multiple UVs or vertex colors.
-    // This should yield false in more than 99% of all imports ...
-    const bool hasAnimMeshes = pMesh->mNumAnimMeshes > 0;
+    const VertexStreams streams(pMesh);
+    UniqueVertexTable vertexTable(numUsedVertices);
 
-    // We'll never have more vertices afterwards.
-    std::vector<std::vector<int>> uniqueAnimatedVertices;
-    if (hasAnimMeshes) {
-        uniqueAnimatedVertices.resize(pMesh->mNumAnimMeshes);
-        for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
-            uniqueAnimatedVertices[animMeshIndex].reserve(pMesh->mNumVertices);
-        }
-    }
-    // a map that maps a vertex to its new index
-    std::unordered_map<Vertex, int, HashVertex, CompareVerticesAlmostEqual> vertex2Index = {};
-    // we can not end up with more vertices than we started with
     // Now check each vertex if it brings something new to the table
     int newIndex = 0;
     for( unsigned int a = 0; a < pMesh->mNumVertices; a++)  {
         // if the vertex is unused Do nothing
-        if (!usedVertexIndicesMask[a]) {
+        if (replaceIndex[a] == UNUSED_VERTEX) {
             continue;
         }
-        // collect the vertex data
-        Vertex v(pMesh,a);
-        // is the vertex already in the map?
-        auto it = vertex2Index.find(v);
-        // if the vertex is not in the map then it is a new vertex add it.
-        if (it == vertex2Index.end()) {
-            // this is a new vertex give it a new index
-            vertex2Index.emplace(v, newIndex);
-            // keep track of its index and increment 1
+        const unsigned int found = vertexTable.FindOrInsert(a, streams);
+        if (found == a) {
+            // this is a new vertex, keep track of its index and increment 1
             replaceIndex[a] = newIndex++;
-            // add the vertex to the unique vertices
             uniqueVertices.push_back(a);
-            if (hasAnimMeshes) {
-                for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
-                    uniqueAnimatedVertices[animMeshIndex].emplace_back(a);
-                }
-            }
-        } else{
-            // if the vertex is already there just find the replace index that is appropriate to it
-			// mark it with JOINED_VERTICES_MARK
-            replaceIndex[a] = it->second | JOINED_VERTICES_MARK;
+        } else {
+            // if the vertex is already there just take the index of the one it is replaced by
+            // and mark it with JOINED_VERTICES_MARK
+            replaceIndex[a] = replaceIndex[found] | JOINED_VERTICES_MARK;
         }
     }
 
@@ -315,10 +358,9 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
     }
 
     updateXMeshVertices(pMesh, uniqueVertices);
-    if (hasAnimMeshes) {
-        for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
-            updateXMeshVertices(pMesh->mAnimMeshes[animMeshIndex], uniqueAnimatedVertices[animMeshIndex]);
-        }
+    // the anim meshes keep the same vertices as the mesh
+    for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
+        updateXMeshVertices(pMesh->mAnimMeshes[animMeshIndex], uniqueVertices);
     }
 
     // adjust the indices in all faces
@@ -59,6 +59,9 @@ using namespace Assimp;
 static const unsigned int NotSet   = 0xffffffff;
 static const unsigned int DeadBeef = 0xdeadbeef;
 
+// Meshes a node may have before its batches are looked up in a map
+static const unsigned int MaxLinearSearch = 32;
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 OptimizeMeshesProcess::OptimizeMeshesProcess()
@@ -109,12 +112,15 @@ void OptimizeMeshesProcess::Execute( aiScene* pScene)
     mScene = pScene;
 
     // need to clear persistent members from previous runs
-    merge_list.resize( 0 );
     output.resize( 0 );
+    batches.resize( 0 );
+    batch_entries.resize( 0 );
+    open_batches.clear();
 
     // ensure we have the right sizes
-    merge_list.reserve(pScene->mNumMeshes);
     output.reserve(pScene->mNumMeshes);
+    batches.reserve(pScene->mNumMeshes);
+    batch_entries.reserve(pScene->mNumMeshes);
 
     // Prepare lookup tables
     meshes.resize(pScene->mNumMeshes);
@@ -132,13 +138,17 @@ void OptimizeMeshesProcess::Execute( aiScene* pScene)
         }
     }
 
-    // and process all nodes in the scenegraph recursively
+    // group the meshes of all nodes in the scenegraph recursively, then merge each group once
     ProcessNode(pScene->mRootNode);
     if (!output.size()) {
         throw DeadlyImportError("OptimizeMeshes: No meshes remaining; there's definitely something wrong");
     }
+    MergeBatches();
 
     meshes.resize( 0 );
+    batches.resize( 0 );
+    batch_entries.resize( 0 );
+    open_batches.clear();
     ai_assert(output.size() <= num_old);
 
     mScene->mNumMeshes = static_cast<unsigned int>(output.size());
@@ -152,48 +162,88 @@ void OptimizeMeshesProcess::Execute( aiScene* pScene)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Process meshes for a single node
+size_t OptimizeMeshesProcess::JoinKeyHash::operator () (const JoinKey& key) const
+{
+    size_t hash = key.material;
+    for (unsigned int value : { key.vertex_format, key.primitive_types }) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Assign the meshes of a single node to batches
 void OptimizeMeshesProcess::ProcessNode( aiNode* pNode)
 {
+    // Nodes with few meshes search their batches, larger ones use a map.
+    const unsigned int first_batch = static_cast<unsigned int>(batches.size());
+    const bool use_map = pNode->mNumMeshes > MaxLinearSearch;
+
+    unsigned int num_kept = 0;
     for (unsigned int i = 0; i < pNode->mNumMeshes;++i) {
-        unsigned int& im = pNode->mMeshes[i];
+        const unsigned int im = pNode->mMeshes[i];
 
         if (meshes[im].instance_cnt > 1) {
-            im = meshes[im].output_id;
+            pNode->mMeshes[num_kept++] = meshes[im].output_id;
+            continue;
         }
-        else  {
-            merge_list.resize( 0 );
-            unsigned int verts = 0, faces = 0;
-
-            // Find meshes to merge with us
-            for (unsigned int a = i+1; a < pNode->mNumMeshes;++a) {
-                unsigned int am = pNode->mMeshes[a];
-                if (meshes[am].instance_cnt == 1 && CanJoin(im,am,verts,faces)) {
-
-                    merge_list.push_back(mScene->mMeshes[am]);
-                    verts += mScene->mMeshes[am]->mNumVertices;
-                    faces += mScene->mMeshes[am]->mNumFaces;
-
-                    pNode->mMeshes[a] = pNode->mMeshes[pNode->mNumMeshes - 1];
-                    --pNode->mNumMeshes;
-                    --a;
-                }
-            }
 
-            // and merge all meshes which we found, replace the old ones
-            if (!merge_list.empty()) {
-                merge_list.push_back(mScene->mMeshes[im]);
+        if (1 == pNode->mNumMeshes) {
+            // nothing to join with, don't touch the mesh at all
+            pNode->mMeshes[num_kept++] = static_cast<unsigned int>(output.size());
+            output.push_back(mScene->mMeshes[im]);
+            continue;
+        }
 
-                aiMesh* out;
-                SceneCombiner::MergeMeshes(&out,0,merge_list.begin(),merge_list.end());
-                output.push_back(out);
+        // Meshes join the latest batch of their key as long as it stays within
+        // the size limits, a mesh which doesn't fit opens a new batch.
+        aiMesh* mesh = mScene->mMeshes[im];
+        const JoinKey key = { mesh->mMaterialIndex, meshes[im].vertex_format, pts ? mesh->mPrimitiveTypes : 0u };
+        const bool skinned = mesh->HasBones();
+        unsigned int batch = NotSet;
+        if (!skinned) {
+            if (use_map) {
+                const auto it = open_batches.find(key);
+                if (it != open_batches.end()) {
+                    batch = it->second;
+                }
             } else {
-                output.push_back(mScene->mMeshes[im]);
+                for (unsigned int b = static_cast<unsigned int>(batches.size()); b-- > first_batch;) {
+                    if (!batches[b].skinned && batches[b].key == key) {
+                        batch = b;
+                        break;
+                    }
+                }
+            }
+            if (NotSet != batch &&
+                ((NotSet != max_verts && batches[batch].verts + mesh->mNumVertices > max_verts) ||
+                 (NotSet != max_faces && batches[batch].faces + mesh->mNumFaces > max_faces))) {
+                batch = NotSet;
             }
-            im = static_cast<unsigned int>(output.size()-1);
         }
+
+        if (NotSet == batch) {
+            batch = static_cast<unsigned int>(batches.size());
+            batches.push_back({ key, skinned, static_cast<unsigned int>(output.size()), 0, 0, 0 });
+            output.push_back(mesh);
+            pNode->mMeshes[num_kept++] = batches.back().output_id;
+            if (use_map && !skinned) {
+                open_batches[key] = batch;
+            }
+        }
+
+        Batch& b = batches[batch];
+        ++b.num_meshes;
+        b.verts += mesh->mNumVertices;
+        b.faces += mesh->mNumFaces;
+        batch_entries.emplace_back(batch, im);
     }
+    pNode->mNumMeshes = num_kept;
 
+    // erase the keys one by one, clearing the whole map costs its bucket count
+    for (unsigned int b = first_batch; use_map && b < batches.size(); ++b) {
+        open_batches.erase(batches[b].key);
+    }
 
     for( unsigned int i = 0; i < pNode->mNumChildren; ++i ) {
         ProcessNode( pNode->mChildren[ i ] );
@@ -201,35 +251,32 @@ void OptimizeMeshesProcess::ProcessNode( aiNode* pNode)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Check whether two meshes can be joined
-bool OptimizeMeshesProcess::CanJoin ( unsigned int a, unsigned int b, unsigned int verts, unsigned int faces )
+// Merge the meshes of every batch with more than one mesh
+void OptimizeMeshesProcess::MergeBatches()
 {
-    if (meshes[a].vertex_format != meshes[b].vertex_format)
-        return false;
-
-    aiMesh* ma = mScene->mMeshes[a], *mb = mScene->mMeshes[b];
-
-    if ((NotSet != max_verts && verts+mb->mNumVertices > max_verts) ||
-        (NotSet != max_faces && faces+mb->mNumFaces    > max_faces)) {
-        return false;
+    if (batch_entries.size() == batches.size()) {
+        // every mesh stays on its own
+        return;
     }
 
-    // Never merge unskinned meshes with skinned meshes
-    if (ma->mMaterialIndex != mb->mMaterialIndex || ma->HasBones() != mb->HasBones())
-        return false;
-
-    // Never merge meshes with different kinds of primitives if SortByPType did already
-    // do its work. We would destroy everything again ...
-    if (pts && ma->mPrimitiveTypes != mb->mPrimitiveTypes)
-        return false;
-
-    // If both meshes are skinned, check whether we have many bones defined in both meshes.
-    // If yes, we can join them.
-    if (ma->HasBones()) {
-        // TODO
-        return false;
+    // sort the meshes by batch, keeping their order
+    std::vector<unsigned int> first(batches.size() + 1, 0);
+    for (size_t i = 0; i < batches.size(); ++i) {
+        first[i + 1] = first[i] + batches[i].num_meshes;
     }
-    return true;
+    std::vector<aiMesh*> sorted(batch_entries.size());
+    std::vector<unsigned int> cursor(first.begin(), first.end() - 1);
+    for (const auto& entry : batch_entries) {
+        sorted[cursor[entry.first]++] = mScene->mMeshes[entry.second];
+    }
+
+    ForEachMesh(static_cast<unsigned int>(batches.size()), [&](unsigned int i) {
+        if (batches[i].num_meshes > 1) {
+            aiMesh* out;
+            SceneCombiner::MergeMeshes(&out, 0, sorted.cbegin() + first[i], sorted.cbegin() + first[i + 1]);
+            output[batches[i].output_id] = out;
+        }
+    });
 }
 
 // ------------------------------------------------------------------------------------------------
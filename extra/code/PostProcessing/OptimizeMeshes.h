@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/types.h>
 
+#include <unordered_map>
 #include <vector>
 
 struct aiMesh;
@@ -65,7 +66,7 @@ namespace Assimp {
  *
  *  @note Instanced meshes are currently not processed.
  */
-class OptimizeMeshesProcess : public BaseProcess {
+class ASSIMP_API OptimizeMeshesProcess : public BaseProcess {
 public:
     // -------------------------------------------------------------------
     /// The default class constructor / destructor.
@@ -136,19 +137,16 @@ public:
 protected:
 
     // -------------------------------------------------------------------
-    /** @brief Do the actual optimization on all meshes of this node
+    /** @brief Groups the meshes of this node and its children into
+     *   batches of meshes which can be joined
      *  @param pNode Node we're working with
      */
     void ProcessNode( aiNode* pNode);
 
     // -------------------------------------------------------------------
-    /** @brief Returns true if b can be joined with a
-     *
-     *  @param verts Number of output verts up to now
-     *  @param faces Number of output faces up to now
+    /** @brief Merges the meshes of every batch into one output mesh
      */
-    bool CanJoin ( unsigned int a, unsigned int b,
-        unsigned int verts, unsigned int faces );
+    void MergeBatches();
 
     // -------------------------------------------------------------------
     /** @brief Find instanced meshes, for the moment we're excluding
@@ -158,6 +156,39 @@ protected:
 
 private:
 
+    /** @brief Meshes of the same node can be joined if they share the
+     *   material, the vertex format and, with SortByPType, the primitive
+     *   types
+     */
+    struct JoinKey {
+        unsigned int material, vertex_format, primitive_types;
+
+        bool operator == (const JoinKey& other) const {
+            return material == other.material && vertex_format == other.vertex_format &&
+                primitive_types == other.primitive_types;
+        }
+    };
+
+    /** @brief Meshes of a node which end up in the same output mesh
+     */
+    struct Batch {
+        //! Meshes of the batch
+        JoinKey key;
+
+        //! Skinned meshes are never joined
+        bool skinned;
+
+        //! Index in the output list
+        unsigned int output_id;
+
+        //! Number of meshes, vertices and faces collected so far
+        unsigned int num_meshes, verts, faces;
+    };
+
+    struct JoinKeyHash {
+        size_t operator () (const JoinKey& key) const;
+    };
+
     //! Scene we're working with
     aiScene* mScene;
 
@@ -173,8 +204,14 @@ private:
     //! @see SetPreferredMeshSizeLimit
     mutable unsigned int max_verts,max_faces;
 
-    //! Temporary storage
-    std::vector<aiMesh*> merge_list;
+    //! Batches in the order of their output meshes
+    std::vector<Batch> batches;
+
+    //! Batch and mesh index of all meshes which are joined, in scene graph order
+    std::vector<std::pair<unsigned int, unsigned int>> batch_entries;
+
+    //! The batch which takes further meshes of a key, for nodes with many meshes
+    std::unordered_map<JoinKey, unsigned int, JoinKeyHash> open_batches;
 };
 
 } // end of namespace Assimp
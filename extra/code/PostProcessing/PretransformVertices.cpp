@@ -45,45 +45,86 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PretransformVertices.h"
 #include "ConvertToLHProcess.h"
 #include "ProcessHelper.h"
+#include "Common/FaceIndexAllocator.h"
 #include <assimp/Exceptional.h>
 #include <assimp/SceneCombiner.h>
 
-using namespace Assimp;
+#include <map>
+#include <unordered_map>
 
-// some array offsets
-#define AI_PTVS_VERTEX 0x0
-#define AI_PTVS_FACE 0x1
+using namespace Assimp;
 
 namespace {
 
-// Get a bitwise combination identifying the vertex format of a mesh
-static unsigned int GetMeshVFormat(aiMesh *pcMesh)  {
-	// the vertex format is stored in aiMesh::mBones for later retrieval.
-	// there isn't a good reason to compute it a few hundred times
-	// from scratch. The pointer is unused as animations are lost
-	// during PretransformVertices.
-	if (pcMesh->mBones)
-		return (unsigned int)(uint64_t)pcMesh->mBones;
-
-	const unsigned int iRet = GetMeshVFormatUnique(pcMesh);
+// Transform positions by the affine part of a matrix. The vertices do not
+// depend on each other and the matrix is kept in locals, which allows the
+// compiler to process several vertices at once with SIMD instructions.
+void TransformPositions(const aiMatrix4x4 &m, const aiVector3D *in, aiVector3D *out, unsigned int num) {
+	const ai_real a1 = m.a1, a2 = m.a2, a3 = m.a3, a4 = m.a4;
+	const ai_real b1 = m.b1, b2 = m.b2, b3 = m.b3, b4 = m.b4;
+	const ai_real c1 = m.c1, c2 = m.c2, c3 = m.c3, c4 = m.c4;
+	for (unsigned int i = 0; i < num; ++i) {
+		const ai_real x = in[i].x, y = in[i].y, z = in[i].z;
+		out[i].x = a1 * x + a2 * y + a3 * z + a4;
+		out[i].y = b1 * x + b2 * y + b3 * z + b4;
+		out[i].z = c1 * x + c2 * y + c3 * z + c4;
+	}
+}
 
-	// store the value for later use
-	pcMesh->mBones = (aiBone **)(uint64_t)iRet;
-	return iRet;
+// Transform normals or tangents and normalize them again, same as
+// (m * v).Normalize() but in a form the compiler can vectorize
+void TransformDirections(const aiMatrix3x3 &m, const aiVector3D *in, aiVector3D *out, unsigned int num) {
+	const ai_real a1 = m.a1, a2 = m.a2, a3 = m.a3;
+	const ai_real b1 = m.b1, b2 = m.b2, b3 = m.b3;
+	const ai_real c1 = m.c1, c2 = m.c2, c3 = m.c3;
+	for (unsigned int i = 0; i < num; ++i) {
+		const ai_real x = in[i].x, y = in[i].y, z = in[i].z;
+		const ai_real tx = a1 * x + a2 * y + a3 * z;
+		const ai_real ty = b1 * x + b2 * y + b3 * z;
+		const ai_real tz = c1 * x + c2 * y + c3 * z;
+		const ai_real len = std::sqrt(tx * tx + ty * ty + tz * tz);
+		const ai_real inv = len == ai_real(0.0) ? ai_real(1.0) : ai_real(1.0) / len;
+		out[i].x = tx * inv;
+		out[i].y = ty * inv;
+		out[i].z = tz * inv;
+	}
 }
 
-// Get a list of all vertex formats that occur for a given material index
-// The output list contains duplicate elements
-static void GetVFormatList(const aiScene *pcScene, unsigned int iMat, std::list<unsigned int> &aiOut)  {
-	for (unsigned int i = 0; i < pcScene->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[i];
-		if (iMat == pcMesh->mMaterialIndex) {
-			aiOut.push_back(GetMeshVFormat(pcMesh));
+// All references of the meshes with one material and vertex format, they
+// are merged into one output mesh in the order of the node graph
+struct MergedMesh {
+	std::vector<unsigned int> mRefs;
+	unsigned int mNumVertices = 0;
+	unsigned int mNumFaces = 0;
+	size_t mNumIndices = 0;
+};
+
+// A mesh together with the transformation of a node referencing it
+struct PlacedMesh {
+	unsigned int mMesh;
+	aiMatrix4x4 mTransformation;
+
+	bool operator==(const PlacedMesh &other) const {
+		return mMesh == other.mMesh && mTransformation == other.mTransformation;
+	}
+};
+
+struct PlacedMeshHash {
+	size_t operator()(const PlacedMesh &placed) const {
+		size_t hash = placed.mMesh;
+		for (unsigned int row = 0; row < 4; ++row) {
+			for (unsigned int col = 0; col < 4; ++col) {
+				// 0 and -0 compare equal, so they must hash equal
+				const ai_real value = placed.mTransformation[row][col];
+				hash = hash * 31 + std::hash<ai_real>()(value == ai_real(0.0) ? ai_real(0.0) : value);
+			}
 		}
+		return hash;
 	}
-}
+};
+
+} // namespace
 
-}
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 PretransformVertices::PretransformVertices() :
@@ -124,170 +165,190 @@ unsigned int PretransformVertices::CountNodes(const aiNode *pcNode) const {
 }
 
 // ------------------------------------------------------------------------------------------------
-// Count the number of vertices in the whole scene and a given material index
-void PretransformVertices::CountVerticesAndFaces(const aiScene *pcScene, const aiNode *pcNode, unsigned int iMat,
-		unsigned int iVFormat, unsigned int *piFaces, unsigned int *piVertices) const {
+// Compute the absolute transformation matrices of each node and collect the mesh references
+void PretransformVertices::CollectMeshRefs(aiNode *pcNode, std::vector<MeshRef> &refs) const {
+	if (pcNode->mParent) {
+		pcNode->mTransformation = pcNode->mParent->mTransformation * pcNode->mTransformation;
+	}
+
 	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[pcNode->mMeshes[i]];
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh)) {
-			*piVertices += pcMesh->mNumVertices;
-			*piFaces += pcMesh->mNumFaces;
-		}
+		refs.push_back({ pcNode, i });
 	}
+
 	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		CountVerticesAndFaces(pcScene, pcNode->mChildren[i], iMat, iVFormat, piFaces, piVertices);
+		CollectMeshRefs(pcNode->mChildren[i], refs);
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
-// Collect vertex/face data
-void PretransformVertices::CollectData(const aiScene *pcScene, const aiNode *pcNode, unsigned int iMat,
-		unsigned int iVFormat, aiMesh *pcMeshOut,
-		unsigned int aiCurrent[2], unsigned int *num_refs) const {
-	// No need to multiply if there's no transformation
-	const bool identity = pcNode->mTransformation.IsIdentity();
-	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[pcNode->mMeshes[i]];
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh)) {
-			// Decrement mesh reference counter
-			unsigned int &num_ref = num_refs[pcNode->mMeshes[i]];
-			ai_assert(0 != num_ref);
-			--num_ref;
-			// Save the name of the last mesh
-			if (num_ref == 0) {
-				pcMeshOut->mName = pcMesh->mName;
-			}
+// Merge the meshes per material and vertex format, in world space
+void PretransformVertices::BuildMergedMeshes(aiScene *pScene, const std::vector<MeshRef> &refs, MeshArray &out) const {
+	const unsigned int numMeshes = pScene->mNumMeshes;
+
+	// vertex format and number of face indices of each input mesh
+	std::vector<unsigned int> formats(numMeshes);
+	std::vector<size_t> numIndices(numMeshes);
+	ForEachMesh(numMeshes, [&](unsigned int i) {
+		const aiMesh *mesh = pScene->mMeshes[i];
+		formats[i] = GetMeshVFormatUnique(mesh);
+		size_t num = 0;
+		for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
+			num += mesh->mFaces[a].mNumIndices;
+		}
+		numIndices[i] = num;
+	});
+
+	// keep the face indices in a pool if the input meshes had one
+	bool pooled = false;
+	for (unsigned int i = 0; i < numMeshes; ++i) {
+		pooled |= nullptr != pScene->mMeshes[i]->mFaceIndices;
+	}
+
+	// the last reference to a mesh may take over its face index arrays
+	std::vector<unsigned int> lastRefs(numMeshes, UINT_MAX);
+	for (unsigned int r = 0; r < refs.size(); ++r) {
+		lastRefs[refs[r].mNode->mMeshes[refs[r].mIndex]] = r;
+	}
+
+	// one output mesh per material and vertex format, sorted by both
+	std::map<std::pair<unsigned int, unsigned int>, MergedMesh> merged;
+	for (unsigned int r = 0; r < refs.size(); ++r) {
+		const unsigned int index = refs[r].mNode->mMeshes[refs[r].mIndex];
+		const aiMesh *mesh = pScene->mMeshes[index];
+		if (mesh->mMaterialIndex >= pScene->mNumMaterials) {
+			continue;
+		}
+		MergedMesh &target = merged[std::make_pair(mesh->mMaterialIndex, formats[index])];
+		target.mRefs.push_back(r);
+		target.mNumVertices += mesh->mNumVertices;
+		target.mNumFaces += mesh->mNumFaces;
+		target.mNumIndices += numIndices[index];
+	}
 
-			if (identity) {
-				// copy positions without modifying them
-				::memcpy(pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mVertices,
-						pcMesh->mNumVertices * sizeof(aiVector3D));
+	std::vector<std::pair<std::pair<unsigned int, unsigned int>, const MergedMesh *>> targets;
+	for (const auto &entry : merged) {
+		if (0 != entry.second.mNumFaces && 0 != entry.second.mNumVertices) {
+			targets.emplace_back(entry.first, &entry.second);
+		}
+	}
 
+	// the output meshes are independent of each other, every input mesh
+	// is read by exactly one of them
+	out.resize(targets.size());
+	ForEachMesh(static_cast<unsigned int>(targets.size()), [&](unsigned int k) {
+		const unsigned int iVFormat = targets[k].first.second;
+		const MergedMesh &target = *targets[k].second;
+
+		aiMesh *pcMesh = out[k] = new aiMesh();
+		pcMesh->mNumFaces = target.mNumFaces;
+		pcMesh->mNumVertices = target.mNumVertices;
+		pcMesh->mFaces = new aiFace[target.mNumFaces];
+		pcMesh->mVertices = new aiVector3D[target.mNumVertices];
+		pcMesh->mMaterialIndex = targets[k].first.first;
+		if (iVFormat & 0x2) pcMesh->mNormals = new aiVector3D[target.mNumVertices];
+		if (iVFormat & 0x4) {
+			pcMesh->mTangents = new aiVector3D[target.mNumVertices];
+			pcMesh->mBitangents = new aiVector3D[target.mNumVertices];
+		}
+		unsigned int numUV = 0;
+		while (iVFormat & (0x100 << numUV)) {
+			pcMesh->mTextureCoords[numUV] = new aiVector3D[target.mNumVertices];
+			pcMesh->mNumUVComponents[numUV] = (iVFormat & (0x10000 << numUV)) ? 3 : 2;
+			++numUV;
+		}
+		unsigned int numColors = 0;
+		while (iVFormat & (0x1000000 << numColors)) {
+			pcMesh->mColors[numColors++] = new aiColor4D[target.mNumVertices];
+		}
+
+		FaceIndexAllocator indices(pooled, target.mNumIndices);
+		unsigned int firstVertex = 0, firstFace = 0;
+		for (const unsigned int r : target.mRefs) {
+			const aiMatrix4x4 &mat = refs[r].mNode->mTransformation;
+			const unsigned int index = refs[r].mNode->mMeshes[refs[r].mIndex];
+			aiMesh *mesh = pScene->mMeshes[index];
+			const unsigned int numVertices = mesh->mNumVertices;
+
+			if (mat.IsIdentity()) {
+				// no need to multiply if there's no transformation
+				::memcpy(pcMesh->mVertices + firstVertex, mesh->mVertices, numVertices * sizeof(aiVector3D));
 				if (iVFormat & 0x2) {
-					// copy normals without modifying them
-					::memcpy(pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mNormals,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
+					::memcpy(pcMesh->mNormals + firstVertex, mesh->mNormals, numVertices * sizeof(aiVector3D));
 				}
 				if (iVFormat & 0x4) {
-					// copy tangents without modifying them
-					::memcpy(pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mTangents,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
-					// copy bitangents without modifying them
-					::memcpy(pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mBitangents,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
+					::memcpy(pcMesh->mTangents + firstVertex, mesh->mTangents, numVertices * sizeof(aiVector3D));
+					::memcpy(pcMesh->mBitangents + firstVertex, mesh->mBitangents, numVertices * sizeof(aiVector3D));
 				}
 			} else {
-				// copy positions, transform them to worldspace
-				for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-					pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX] + n] = pcNode->mTransformation * pcMesh->mVertices[n];
-				}
-				aiMatrix4x4 mWorldIT = pcNode->mTransformation;
-				mWorldIT.Inverse().Transpose();
-
-				// TODO: implement Inverse() for aiMatrix3x3
-				aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
-
-				if (iVFormat & 0x2) {
-					// copy normals, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX] + n] =
-								(m * pcMesh->mNormals[n]).Normalize();
+				TransformPositions(mat, mesh->mVertices, pcMesh->mVertices + firstVertex, numVertices);
+				if (iVFormat & 0x6) {
+					aiMatrix4x4 mWorldIT = mat;
+					mWorldIT.Inverse().Transpose();
+
+					// TODO: implement Inverse() for aiMatrix3x3
+					const aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
+					if (iVFormat & 0x2) {
+						TransformDirections(m, mesh->mNormals, pcMesh->mNormals + firstVertex, numVertices);
 					}
-				}
-				if (iVFormat & 0x4) {
-					// copy tangents and bitangents, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mTangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mTangents[n]).Normalize();
-						pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mBitangents[n]).Normalize();
+					if (iVFormat & 0x4) {
+						TransformDirections(m, mesh->mTangents, pcMesh->mTangents + firstVertex, numVertices);
+						TransformDirections(m, mesh->mBitangents, pcMesh->mBitangents + firstVertex, numVertices);
 					}
 				}
 			}
-			unsigned int p = 0;
-			while (iVFormat & (0x100 << p)) {
-				// copy texture coordinates
-				memcpy(pcMeshOut->mTextureCoords[p] + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mTextureCoords[p],
-						pcMesh->mNumVertices * sizeof(aiVector3D));
-				++p;
+			for (unsigned int p = 0; p < numUV; ++p) {
+				::memcpy(pcMesh->mTextureCoords[p] + firstVertex, mesh->mTextureCoords[p], numVertices * sizeof(aiVector3D));
 			}
-			p = 0;
-			while (iVFormat & (0x1000000 << p)) {
-				// copy vertex colors
-				memcpy(pcMeshOut->mColors[p] + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mColors[p],
-						pcMesh->mNumVertices * sizeof(aiColor4D));
-				++p;
+			for (unsigned int p = 0; p < numColors; ++p) {
+				::memcpy(pcMesh->mColors[p] + firstVertex, mesh->mColors[p], numVertices * sizeof(aiColor4D));
 			}
-			// now we need to copy all faces. since we will delete the source mesh afterwards,
-			// we don't need to reallocate the array of indices except if this mesh is
-			// referenced multiple times.
-			for (unsigned int planck = 0; planck < pcMesh->mNumFaces; ++planck) {
-				aiFace &f_src = pcMesh->mFaces[planck];
-				aiFace &f_dst = pcMeshOut->mFaces[aiCurrent[AI_PTVS_FACE] + planck];
-
-				const unsigned int num_idx = f_src.mNumIndices;
-
-				f_dst.mNumIndices = num_idx;
-
-				unsigned int *pi;
-				if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
-					pi = f_dst.mIndices = f_src.mIndices;
 
-					// offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
-						pi[hahn] += aiCurrent[AI_PTVS_VERTEX];
+			// now copy all faces. since the source mesh is deleted afterwards, its index
+			// arrays are taken over on its last reference unless they go into a pool
+			const bool lastRef = lastRefs[index] == r;
+			for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
+				aiFace &f_src = mesh->mFaces[a];
+				aiFace &f_dst = pcMesh->mFaces[firstFace + a];
+				const unsigned int num_idx = f_dst.mNumIndices = f_src.mNumIndices;
+
+				if (lastRef && !indices.IsPooled() && !mesh->IsPooledFaceIndices(f_src.mIndices)) {
+					unsigned int *pi = f_dst.mIndices = f_src.mIndices;
+					f_src.mIndices = nullptr;
+					f_src.mNumIndices = 0;
+					for (unsigned int i = 0; i < num_idx; ++i) {
+						pi[i] += firstVertex;
 					}
 				} else {
-					pi = f_dst.mIndices = new unsigned int[num_idx];
-
-					// copy and offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
-						pi[hahn] = f_src.mIndices[hahn] + aiCurrent[AI_PTVS_VERTEX];
+					unsigned int *pi = f_dst.mIndices = indices.Allocate(num_idx);
+					for (unsigned int i = 0; i < num_idx; ++i) {
+						pi[i] = f_src.mIndices[i] + firstVertex;
 					}
 				}
 
 				// Update the mPrimitiveTypes member of the mesh
-				switch (pcMesh->mFaces[planck].mNumIndices) {
+				switch (num_idx) {
 					case 0x1:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POINT;
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
 						break;
 					case 0x2:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_LINE;
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
 						break;
 					case 0x3:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
 						break;
 					default:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+						pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
 						break;
 				};
 			}
-			aiCurrent[AI_PTVS_VERTEX] += pcMesh->mNumVertices;
-			aiCurrent[AI_PTVS_FACE] += pcMesh->mNumFaces;
-		}
-	}
+			firstVertex += numVertices;
+			firstFace += mesh->mNumFaces;
 
-	// append all children of us
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		CollectData(pcScene, pcNode->mChildren[i], iMat,
-				iVFormat, pcMeshOut, aiCurrent, num_refs);
-	}
-}
-
-// ------------------------------------------------------------------------------------------------
-// Compute the absolute transformation matrices of each node
-void PretransformVertices::ComputeAbsoluteTransform(aiNode *pcNode) {
-	if (pcNode->mParent) {
-		pcNode->mTransformation = pcNode->mParent->mTransformation * pcNode->mTransformation;
-	}
-
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		ComputeAbsoluteTransform(pcNode->mChildren[i]);
-	}
+			// the output is named after the last mesh
+			pcMesh->mName = mesh->mName;
+		}
+		indices.Attach(pcMesh);
+	});
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -306,9 +367,7 @@ void PretransformVertices::ApplyTransform(aiMesh *mesh, const aiMatrix4x4 &mat)
 
 	// Update positions
 	if (mesh->HasPositions()) {
-		for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-			mesh->mVertices[i] = mat * mesh->mVertices[i];
-		}
+		TransformPositions(mat, mesh->mVertices, mesh->mVertices, mesh->mNumVertices);
 	}
 
 	// Update normals and tangents
@@ -316,72 +375,78 @@ void PretransformVertices::ApplyTransform(aiMesh *mesh, const aiMatrix4x4 &mat)
 		const aiMatrix3x3 m = aiMatrix3x3(mat).Inverse().Transpose();
 
 		if (mesh->HasNormals()) {
-			for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                mesh->mNormals[i] = (m * mesh->mNormals[i]).Normalize();
-            }
+			TransformDirections(m, mesh->mNormals, mesh->mNormals, mesh->mNumVertices);
 		}
 
 		if (mesh->HasTangentsAndBitangents()) {
-			for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-				mesh->mTangents[i] = (m * mesh->mTangents[i]).Normalize();
-				mesh->mBitangents[i] = (m * mesh->mBitangents[i]).Normalize();
-			}
+			TransformDirections(m, mesh->mTangents, mesh->mTangents, mesh->mNumVertices);
+			TransformDirections(m, mesh->mBitangents, mesh->mBitangents, mesh->mNumVertices);
 		}
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
-// Simple routine to build meshes in worldspace, no further optimization
-void PretransformVertices::BuildWCSMeshes(MeshArray &out, aiMesh **in,
-		unsigned int numIn, aiNode *node) const {
-	// NOTE:
-	//  aiMesh::mNumBones store original source mesh, or UINT_MAX if not a copy
-	//  aiMesh::mBones store reference to abs. transform we multiplied with
-
-	// process meshes
-	for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-		aiMesh *mesh = in[node->mMeshes[i]];
-
-		// check whether we can operate on this mesh
-		if (!mesh->mBones || *reinterpret_cast<aiMatrix4x4 *>(mesh->mBones) == node->mTransformation) {
-			// yes, we can.
-			mesh->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
-			mesh->mNumBones = UINT_MAX;
-			continue;
-		}
+static void appendNewMeshesToScene(aiScene *pScene, std::vector<aiMesh*> &apcOutMeshes) {
+	ai_assert(pScene != nullptr);
 
-		// try to find us in the list of newly created meshes
-		for (unsigned int n = 0; n < out.size(); ++n) {
-			aiMesh *ctz = out[n];
-			if (ctz->mNumBones == node->mMeshes[i] && *reinterpret_cast<aiMatrix4x4 *>(ctz->mBones) == node->mTransformation) {
+	if (apcOutMeshes.empty()) {
+		return;
+	}
 
-				// ok, use this one. Update node mesh index
-				node->mMeshes[i] = numIn + n;
-			}
-		}
-		if (node->mMeshes[i] < numIn) {
-			// Worst case. Need to operate on a full copy of the mesh
-			ASSIMP_LOG_INFO("PretransformVertices: Copying mesh due to mismatching transforms");
-			aiMesh *ntz;
+	aiMesh **npp = new aiMesh *[pScene->mNumMeshes + apcOutMeshes.size()];
 
-			const unsigned int cacheNumBones = mesh->mNumBones; //
-			mesh->mNumBones = 0;
-			SceneCombiner::Copy(&ntz, mesh);
-			mesh->mNumBones = cacheNumBones;
+	::memcpy(npp, pScene->mMeshes, sizeof(aiMesh *) * pScene->mNumMeshes);
+	::memcpy(npp + pScene->mNumMeshes, &apcOutMeshes[0], sizeof(aiMesh *) * apcOutMeshes.size());
 
-			ntz->mNumBones = node->mMeshes[i];
-			ntz->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
+	pScene->mNumMeshes += static_cast<unsigned int>(apcOutMeshes.size());
+	delete[] pScene->mMeshes;
+	pScene->mMeshes = npp;
+}
 
-			out.push_back(ntz);
+// ------------------------------------------------------------------------------------------------
+// Transform the meshes in place, copy those referenced with different transformations
+void PretransformVertices::BuildWCSMeshes(aiScene *pScene, const std::vector<MeshRef> &refs) const {
+	const unsigned int numIn = pScene->mNumMeshes;
+
+	// the transformation to apply to each mesh, orphaned meshes keep theirs
+	std::vector<const aiMatrix4x4 *> transforms(numIn, nullptr);
+
+	// the first reference decides the transformation of a mesh itself, all
+	// other references with the same transformation share one copy
+	std::vector<unsigned int> sources;
+	std::unordered_map<PlacedMesh, unsigned int, PlacedMeshHash> copies;
+	for (const MeshRef &ref : refs) {
+		unsigned int &index = ref.mNode->mMeshes[ref.mIndex];
+		const aiMatrix4x4 &mat = ref.mNode->mTransformation;
+		if (nullptr == transforms[index] || *transforms[index] == mat) {
+			transforms[index] = &mat;
+			continue;
+		}
 
-			node->mMeshes[i] = static_cast<unsigned int>(numIn + out.size() - 1);
+		const auto it = copies.emplace(PlacedMesh{ index, mat }, numIn + static_cast<unsigned int>(sources.size()));
+		if (it.second) {
+			sources.push_back(index);
+			transforms.push_back(&mat);
 		}
+		index = it.first->second;
 	}
 
-	// call children
-	for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-		BuildWCSMeshes(out, in, numIn, node->mChildren[i]);
+	// ... if new meshes are needed, append them to the end of the scene
+	if (!sources.empty()) {
+		ASSIMP_LOG_INFO("PretransformVertices: Copying ", sources.size(), " meshes due to mismatching transforms");
+		MeshArray apcOutMeshes(sources.size());
+		ForEachMesh(static_cast<unsigned int>(sources.size()), [&](unsigned int i) {
+			SceneCombiner::Copy(&apcOutMeshes[i], pScene->mMeshes[sources[i]]);
+		});
+		appendNewMeshesToScene(pScene, apcOutMeshes);
 	}
+
+	// now transform all meshes to world-space
+	ForEachMesh(pScene->mNumMeshes, [&](unsigned int i) {
+		if (nullptr != transforms[i]) {
+			ApplyTransform(pScene->mMeshes[i], *transforms[i]);
+		}
+	});
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -395,36 +460,6 @@ void PretransformVertices::MakeIdentityTransform(aiNode *nd) const {
 	}
 }
 
-// ------------------------------------------------------------------------------------------------
-// Build reference counters for all meshes
-void PretransformVertices::BuildMeshRefCountArray(const aiNode *nd, unsigned int *refs) const {
-	for (unsigned int i = 0; i < nd->mNumMeshes; ++i)
-		refs[nd->mMeshes[i]]++;
-
-	// call children
-	for (unsigned int i = 0; i < nd->mNumChildren; ++i) {
-		BuildMeshRefCountArray(nd->mChildren[i], refs);
-	}
-}
-
-// ------------------------------------------------------------------------------------------------
-static void appendNewMeshesToScene(aiScene *pScene, std::vector<aiMesh*> &apcOutMeshes) {
-	ai_assert(pScene != nullptr);
-
-	if (apcOutMeshes.empty()) {
-		return;
-	}
-
-	aiMesh **npp = new aiMesh *[pScene->mNumMeshes + apcOutMeshes.size()];
-
-	::memcpy(npp, pScene->mMeshes, sizeof(aiMesh *) * pScene->mNumMeshes);
-	::memcpy(npp + pScene->mNumMeshes, &apcOutMeshes[0], sizeof(aiMesh *) * apcOutMeshes.size());
-
-	pScene->mNumMeshes += static_cast<unsigned int>(apcOutMeshes.size());
-	delete[] pScene->mMeshes;
-	pScene->mMeshes = npp;
-}
-
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void PretransformVertices::Execute(aiScene *pScene) {
@@ -442,12 +477,14 @@ void PretransformVertices::Execute(aiScene *pScene) {
 		pScene->mRootNode->mTransformation = mConfigTransformation * pScene->mRootNode->mTransformation;
 	}
 
-	// first compute absolute transformation matrices for all nodes
-	ComputeAbsoluteTransform(pScene->mRootNode);
+	// first compute absolute transformation matrices for all nodes and
+	// collect all mesh references in one pass over the node graph
+	std::vector<MeshRef> refs;
+	refs.reserve(pScene->mNumMeshes);
+	CollectMeshRefs(pScene->mRootNode, refs);
 
-	// Delete aiMesh::mBones for all meshes. The bones are
-	// removed during this step and we need the pointer as
-	// temporary storage
+	// Delete aiMesh::mBones for all meshes, the bones are
+	// removed during this step
 	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 		aiMesh *mesh = pScene->mMeshes[i];
 
@@ -456,99 +493,29 @@ void PretransformVertices::Execute(aiScene *pScene) {
 
 		delete[] mesh->mBones;
         mesh->mBones = nullptr;
+		mesh->mNumBones = 0;
 	}
 
-	// now build a list of output meshes
-	MeshArray apcOutMeshes;
-
 	// Keep scene hierarchy? It's an easy job in this case ...
 	// we go on and transform all meshes, if one is referenced by nodes
 	// with different absolute transformations a depth copy of the mesh
 	// is required.
 	if (mConfigKeepHierarchy) {
-
-		// Hack: store the matrix we're transforming a mesh with in aiMesh::mBones
-		BuildWCSMeshes(apcOutMeshes, pScene->mMeshes, pScene->mNumMeshes, pScene->mRootNode);
-
-		// ... if new meshes have been generated, append them to the end of the scene
-		appendNewMeshesToScene(pScene, apcOutMeshes);
-
-		// now iterate through all meshes and transform them to world-space
-		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-			ApplyTransform(pScene->mMeshes[i], *reinterpret_cast<aiMatrix4x4 *>(pScene->mMeshes[i]->mBones));
-
-			// prevent improper destruction
-            pScene->mMeshes[i]->mBones = nullptr;
-			pScene->mMeshes[i]->mNumBones = 0;
-		}
+		BuildWCSMeshes(pScene, refs);
 	} else {
-		apcOutMeshes.reserve(static_cast<size_t>(pScene->mNumMaterials) << 1u);
-		std::list<unsigned int> aiVFormats;
-
-		std::vector<unsigned int> s(pScene->mNumMeshes, 0);
-		BuildMeshRefCountArray(pScene->mRootNode, &s[0]);
-
-		for (unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
-			// get the list of all vertex formats for this material
-			aiVFormats.clear();
-			GetVFormatList(pScene, i, aiVFormats);
-			aiVFormats.sort();
-			aiVFormats.unique();
-			for (std::list<unsigned int>::const_iterator j = aiVFormats.begin(); j != aiVFormats.end(); ++j) {
-				unsigned int numVertices = 0u;
-				unsigned int numFaces = 0u;
-				CountVerticesAndFaces(pScene, pScene->mRootNode, i, *j, &numFaces, &numVertices);
-				if (0 != numFaces && 0 != numVertices) {
-					apcOutMeshes.push_back(new aiMesh());
-					aiMesh *pcMesh = apcOutMeshes.back();
-					pcMesh->mNumFaces = numFaces;
-					pcMesh->mNumVertices = numVertices;
-					pcMesh->mFaces = new aiFace[numFaces];
-					pcMesh->mVertices = new aiVector3D[numVertices];
-					pcMesh->mMaterialIndex = i;
-					if ((*j) & 0x2) pcMesh->mNormals = new aiVector3D[numVertices];
-					if ((*j) & 0x4) {
-						pcMesh->mTangents = new aiVector3D[numVertices];
-						pcMesh->mBitangents = new aiVector3D[numVertices];
-					}
-					numFaces = 0;
-					while ((*j) & (0x100 << numFaces)) {
-						pcMesh->mTextureCoords[numFaces] = new aiVector3D[numVertices];
-						if ((*j) & (0x10000 << numFaces)) {
-							pcMesh->mNumUVComponents[numFaces] = 3;
-						} else {
-							pcMesh->mNumUVComponents[numFaces] = 2;
-						}
-						++numFaces;
-					}
-					numFaces = 0;
-					while ((*j) & (0x1000000 << numFaces))
-						pcMesh->mColors[numFaces++] = new aiColor4D[numVertices];
-
-					// fill the mesh ...
-					unsigned int aiTemp[2] = { 0, 0 };
-					CollectData(pScene, pScene->mRootNode, i, *j, pcMesh, aiTemp, &s[0]);
-				}
-			}
-		}
+		// now build a list of output meshes
+		MeshArray apcOutMeshes;
+		BuildMergedMeshes(pScene, refs, apcOutMeshes);
 
 		// If no meshes are referenced in the node graph it is possible that we get no output meshes.
 		if (apcOutMeshes.empty()) {
 
 			throw DeadlyImportError("No output meshes: all meshes are orphaned and are not referenced by any nodes");
 		} else {
-			// now delete all meshes in the scene and build a new mesh list
+			// now delete all meshes in the scene and build a new mesh list,
+			// face index arrays taken over by the output are already unset
 			for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 				aiMesh *mesh = pScene->mMeshes[i];
-				mesh->mNumBones = 0;
-                mesh->mBones = nullptr;
-
-				// we're reusing the face index arrays. avoid destruction
-				for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
-					mesh->mFaces[a].mNumIndices = 0;
-                    mesh->mFaces[a].mIndices = nullptr;
-				}
-
 				delete mesh;
 
 				// Invalidate the contents of the old mesh array. We will most
@@ -50,7 +50,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 
-#include <list>
 #include <vector>
 
 // Forward declarations
@@ -101,46 +100,29 @@ public:
 	}
 
 private:
+	// A mesh reference, mNode->mMeshes[mIndex]
+	struct MeshRef {
+		aiNode *mNode;
+		unsigned int mIndex;
+	};
+
 	// -------------------------------------------------------------------
 	// Count the number of nodes
 	unsigned int CountNodes(const aiNode *pcNode) const;
 
 	// -------------------------------------------------------------------
-	// Get a bitwise combination identifying the vertex format of a mesh
-	//unsigned int GetMeshVFormat(aiMesh *pcMesh) const;
-
-	// -------------------------------------------------------------------
-	// Count the number of vertices in the whole scene and a given
-	// material index
-	void CountVerticesAndFaces(const aiScene *pcScene, const aiNode *pcNode,
-			unsigned int iMat,
-			unsigned int iVFormat,
-			unsigned int *piFaces,
-			unsigned int *piVertices) const;
-
-	// -------------------------------------------------------------------
-	// Collect vertex/face data
-	void CollectData(const aiScene *pcScene, const aiNode *pcNode,
-			unsigned int iMat,
-			unsigned int iVFormat,
-			aiMesh *pcMeshOut,
-			unsigned int aiCurrent[2],
-			unsigned int *num_refs) const;
+	// Compute the absolute transformation matrices of each node and
+	// collect all mesh references in the order of the node graph
+	void CollectMeshRefs(aiNode *pcNode, std::vector<MeshRef> &refs) const;
 
 	// -------------------------------------------------------------------
-	// Get a list of all vertex formats that occur for a given material
-	// The output list contains duplicate elements
-	/*void GetVFormatList(const aiScene *pcScene, unsigned int iMat,
-			std::list<unsigned int> &aiOut) const;*/
+	// Merge the meshes per material and vertex format, in world space
+	void BuildMergedMeshes(aiScene *pScene, const std::vector<MeshRef> &refs, MeshArray &out) const;
 
 	// -------------------------------------------------------------------
-	// Compute the absolute transformation matrices of each node
-	void ComputeAbsoluteTransform(aiNode *pcNode);
-
-	// -------------------------------------------------------------------
-	// Simple routine to build meshes in worldspace, no further optimization
-	void BuildWCSMeshes(MeshArray &out, aiMesh **in,
-			unsigned int numIn, aiNode *node) const;
+	// Transform the meshes in place, copy those referenced by nodes with
+	// different absolute transformations
+	void BuildWCSMeshes(aiScene *pScene, const std::vector<MeshRef> &refs) const;
 
 	// -------------------------------------------------------------------
 	// Apply the node transformation to a mesh
@@ -150,10 +132,6 @@ private:
 	// Reset transformation matrices to identity
 	void MakeIdentityTransform(aiNode *nd) const;
 
-	// -------------------------------------------------------------------
-	// Build reference counters for all meshes
-	void BuildMeshRefCountArray(const aiNode *nd, unsigned int *refs) const;
-
 	//! Configuration option: keep scene hierarchy as long as possible
 	bool mConfigKeepHierarchy;
 	bool mConfigNormalize;
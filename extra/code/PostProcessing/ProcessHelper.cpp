@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /** Implement shared utility functions for postprocessing steps */
 
 #include "ProcessHelper.h"
+#include "Common/FaceIndexAllocator.h"
 
 #include <limits>
 
@@ -241,11 +242,12 @@ aiMesh *MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
     aiMesh *oMesh = new aiMesh();
     std::vector<unsigned int> vMap(pMesh->mNumVertices, UINT_MAX);
 
-    size_t numSubVerts = 0;
+    size_t numSubVerts = 0, numSubIndices = 0;
     size_t numSubFaces = subMeshFaces.size();
 
     for (unsigned int i = 0; i < numSubFaces; i++) {
         const aiFace &f = pMesh->mFaces[subMeshFaces[i]];
+        numSubIndices += f.mNumIndices;
 
         for (unsigned int j = 0; j < f.mNumIndices; j++) {
             if (vMap[f.mIndices[j]] == UINT_MAX) {
@@ -284,19 +286,21 @@ aiMesh *MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
 
     // and copy over the data, generating faces with linear indices along the way
     oMesh->mFaces = new aiFace[numSubFaces];
+    FaceIndexAllocator faceIndices(nullptr != pMesh->mFaceIndices, numSubIndices);
 
     for (unsigned int a = 0; a < numSubFaces; ++a) {
 
         const aiFace &srcFace = pMesh->mFaces[subMeshFaces[a]];
         aiFace &dstFace = oMesh->mFaces[a];
         dstFace.mNumIndices = srcFace.mNumIndices;
-        dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+        dstFace.mIndices = faceIndices.Allocate(dstFace.mNumIndices);
 
         // accumulate linearly all the vertices of the source face
         for (size_t b = 0; b < dstFace.mNumIndices; ++b) {
             dstFace.mIndices[b] = vMap[srcFace.mIndices[b]];
         }
     }
+    faceIndices.Attach(oMesh);
 
     for (unsigned int srcIndex = 0; srcIndex < pMesh->mNumVertices; ++srcIndex) {
         unsigned int nvi = vMap[srcIndex];
@@ -52,6 +52,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/BaseProcess.h"
 #include <assimp/ParsingUtils.h>
 #include <assimp/SpatialSort.h>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 #include <list>
 
@@ -339,22 +341,29 @@ class ComputeSpatialSortProcess : public BaseProcess {
                                                            aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
+    void SetupProperties(const Importer *pImp) {
+        useGrid = pImp->GetPropertyBool(AI_CONFIG_GLOB_SPATIAL_GRID, false);
+    }
+
     void Execute(aiScene *pScene) {
         typedef std::pair<SpatialSort, ai_real> _Type;
         ASSIMP_LOG_DEBUG("Generate spatially-sorted vertex cache");
 
         std::vector<_Type> *p = new std::vector<_Type>(pScene->mNumMeshes);
-        std::vector<_Type>::iterator it = p->begin();
 
-        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it) {
+        // the meshes are independent, build their indices in parallel
+        ForEachMesh(pScene->mNumMeshes, [&](unsigned int i) {
             aiMesh *mesh = pScene->mMeshes[i];
-            _Type &blubb = *it;
+            _Type &blubb = (*p)[i];
+            blubb.first.SetUseGrid(useGrid);
             blubb.first.Fill(mesh->mVertices, mesh->mNumVertices, sizeof(aiVector3D));
             blubb.second = ComputePositionEpsilon(mesh);
-        }
+        });
 
         shared->AddProperty(AI_SPP_SPATIAL_SORT, p);
     }
+
+    bool useGrid = false;
 };
 
 // -------------------------------------------------------------------------------
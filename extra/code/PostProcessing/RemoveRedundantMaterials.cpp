@@ -47,8 +47,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ParsingUtils.h>
 #include "ProcessHelper.h"
 #include "Material/MaterialSystem.h"
+#include "Common/ParallelFor.h"
 #include <assimp/Exceptional.h>
 #include <stdio.h>
+#include <unordered_map>
 
 using namespace Assimp;
 
@@ -121,11 +123,18 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene) {
     }
     unsigned int iNewNum = 0;
 
-    // Iterate through all materials and calculate a hash for them
-    // store all hashes in a list and so a quick search whether
-    // we do already have a specific hash. This allows us to
-    // determine which materials are identical.
+    // Calculate a hash for all referenced materials, they don't depend on each other.
     uint32_t *aiHashes = new uint32_t[ pScene->mNumMaterials ];
+    ParallelFor(pScene->mNumMaterials, mNumThreads, [&](unsigned int i) {
+        if (abReferenced[i]) {
+            aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
+        }
+    });
+
+    // The first material with a specific hash is kept, all later materials
+    // with the same hash are deleted and refer to its index instead.
+    std::unordered_map<uint32_t, unsigned int> firstWithHash;
+    firstWithHash.reserve(pScene->mNumMaterials);
     for (unsigned int i = 0; i < pScene->mNumMaterials;++i) {
         // No mesh is referencing this material, remove it.
         if (!abReferenced[i]) {
@@ -135,21 +144,14 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene) {
             continue;
         }
 
-        // Check all previously mapped materials for a matching hash.
-        // On a match we can delete this material and just make it ref to the same index.
-        uint32_t me = aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
-        for (unsigned int a = 0; a < i;++a) {
-            if (abReferenced[a] && me == aiHashes[a]) {
-                ++redundantRemoved;
-                me = 0;
-                aiMappingTable[i] = aiMappingTable[a];
-                delete pScene->mMaterials[i];
-                pScene->mMaterials[i] = nullptr;
-                break;
-            }
-        }
-        // This is a new material that is referenced, add to the map.
-        if (me) {
+        const auto it = firstWithHash.emplace(aiHashes[i], i);
+        if (!it.second) {
+            ++redundantRemoved;
+            aiMappingTable[i] = aiMappingTable[it.first->second];
+            delete pScene->mMaterials[i];
+            pScene->mMaterials[i] = nullptr;
+        } else {
+            // This is a new material that is referenced, add to the map.
             aiMappingTable[i] = iNewNum++;
         }
     }
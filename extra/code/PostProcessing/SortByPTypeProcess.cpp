@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "SortByPTypeProcess.h"
 #include "ProcessHelper.h"
+#include "Common/FaceIndexAllocator.h"
 #include <assimp/Exceptional.h>
 
 using namespace Assimp;
@@ -222,6 +223,7 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
             aiFace *outFaces = out->mFaces = new aiFace[out->mNumFaces];
 
             out->mNumVertices = (3 == real ? numPolyVerts : out->mNumFaces * (real + 1));
+            FaceIndexAllocator faceIndices(nullptr != mesh->mFaceIndices, out->mNumVertices);
 
             aiVector3D *vert(nullptr), *nor(nullptr), *tan(nullptr), *bit(nullptr);
             aiVector3D *uv[AI_MAX_NUMBER_OF_TEXTURECOORDS];
@@ -312,10 +314,10 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
                 }
 
                 outFaces->mNumIndices = in.mNumIndices;
-                outFaces->mIndices = in.mIndices;
+                outFaces->mIndices = faceIndices.Move(in);
 
-                for (unsigned int q = 0; q < in.mNumIndices; ++q) {
-                    unsigned int idx = in.mIndices[q];
+                for (unsigned int q = 0; q < outFaces->mNumIndices; ++q) {
+                    unsigned int idx = outFaces->mIndices[q];
 
                     // process all bones of this index
                     if (avw) {
@@ -372,13 +374,13 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
                     if (pp == mesh->mNumAnimMeshes)
                         ++amIdx;
 
-                    in.mIndices[q] = outIdx++;
+                    outFaces->mIndices[q] = outIdx++;
                 }
 
-                in.mIndices = nullptr;
                 ++outFaces;
             }
             ai_assert(outFaces == out->mFaces + out->mNumFaces);
+            faceIndices.Attach(out);
 
             // now generate output bones
             for (unsigned int q = 0; q < mesh->mNumBones; ++q) {
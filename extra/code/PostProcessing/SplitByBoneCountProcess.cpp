@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers of the post-processing framework
 #include "SplitByBoneCountProcess.h"
+#include "Common/FaceIndexAllocator.h"
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 
@@ -246,13 +247,14 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 
         // and copy over the data, generating faces with linear indices along the way
         newMesh->mFaces = new aiFace[subMeshFaces.size()];
+        FaceIndexAllocator faceIndices(nullptr != pMesh->mFaceIndices, numSubMeshVertices);
         unsigned int nvi = 0; // next vertex index
         IndexArray previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
         for( unsigned int a = 0; a < subMeshFaces.size(); ++a ) {
             const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
             aiFace& dstFace = newMesh->mFaces[a];
             dstFace.mNumIndices = srcFace.mNumIndices;
-            dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+            dstFace.mIndices = faceIndices.Allocate(dstFace.mNumIndices);
 
             // accumulate linearly all the vertices of the source face
             for( unsigned int b = 0; b < dstFace.mNumIndices; ++b ) {
@@ -284,6 +286,7 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
         }
 
         ai_assert( nvi == numSubMeshVertices );
+        faceIndices.Attach(newMesh);
 
         // Create the bones for the new submesh: first create the bone array
         newMesh->mNumBones = 0;
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers of the post-processing framework
 #include "SplitLargeMeshes.h"
 #include "ProcessHelper.h"
+#include "Common/FaceIndexAllocator.h"
 
 using namespace Assimp;
 
@@ -171,6 +172,7 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
                 iCnt += pMesh->mFaces[p].mNumIndices;
             }
             pcMesh->mNumVertices = iCnt;
+            FaceIndexAllocator faceIndices(nullptr != pMesh->mFaceIndices, iCnt);
 
             // allocate storage
             if (pMesh->mVertices != nullptr) {
@@ -257,7 +259,7 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
                 // setup face type and number of indices
                 pcMesh->mFaces[p].mNumIndices = iNumIndices;
                 unsigned int* pi = pMesh->mFaces[iTemp].mIndices;
-                unsigned int* piOut = pcMesh->mFaces[p].mIndices = new unsigned int[iNumIndices];
+                unsigned int* piOut = pcMesh->mFaces[p].mIndices = faceIndices.Allocate(iNumIndices);
 
                 // need to update the output primitive types
                 switch (iNumIndices) {
@@ -310,6 +312,7 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
                     }
                 }
             }
+            faceIndices.Attach(pcMesh);
 
             // add the newly created mesh to the list
             avList.emplace_back(pcMesh,a);
@@ -432,8 +435,8 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                 }
             }
 
-            // output vectors
-            std::vector<aiFace> vFaces;
+            // output vectors, the indices of all faces are stored back to back
+            std::vector<unsigned int> vFaceSizes, vIndices;
 
             // reserve enough storage for most cases
             if (pMesh->HasPositions()) {
@@ -453,7 +456,8 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                 pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
                 pcMesh->mTextureCoords[c] = new aiVector3D[iOutVertexNum];
             }
-            vFaces.reserve(iEstimatedSize);
+            vFaceSizes.reserve(iEstimatedSize);
+            vIndices.reserve(iEstimatedSize * 3);
 
             // (we will also need to copy the array of indices)
             while (iBase < pMesh->mNumFaces) {
@@ -475,15 +479,11 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                     break;
                 }
 
-                vFaces.emplace_back();
-                aiFace& rFace = vFaces.back();
-
                 // setup face type and number of indices
-                rFace.mNumIndices = iNumIndices;
-                rFace.mIndices = new unsigned int[iNumIndices];
+                vFaceSizes.push_back(iNumIndices);
 
                 // need to update the output primitive types
-                switch (rFace.mNumIndices) {
+                switch (iNumIndices) {
                 case 1:
                     pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
                     break;
@@ -503,7 +503,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 
                     // check whether we do already have this vertex
                     if (0xFFFFFFFF != avWasCopied[iIndex]) {
-                        rFace.mIndices[v] = avWasCopied[iIndex];
+                        vIndices.push_back(avWasCopied[iIndex]);
                         continue;
                     }
 
@@ -534,7 +534,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
                         }
                     }
                     // check whether we have bone weights assigned to this vertex
-                    rFace.mIndices[v] = pcMesh->mNumVertices;
+                    vIndices.push_back(pcMesh->mNumVertices);
                     if (avPerVertexWeights) {
                         VertexWeightTable& table = avPerVertexWeights[ pcMesh->mNumVertices ];
                         if( !table.empty() ) {
@@ -588,12 +588,19 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
             }
 
             // copy the face list to the mesh
-            pcMesh->mFaces = new aiFace[vFaces.size()];
-            pcMesh->mNumFaces = (unsigned int)vFaces.size();
+            pcMesh->mFaces = new aiFace[vFaceSizes.size()];
+            pcMesh->mNumFaces = (unsigned int)vFaceSizes.size();
 
+            FaceIndexAllocator faceIndices(nullptr != pMesh->mFaceIndices, vIndices.size());
+            const unsigned int* piIndex = vIndices.data();
             for (unsigned int p = 0; p < pcMesh->mNumFaces;++p) {
-                pcMesh->mFaces[p] = vFaces[p];
+                aiFace& face = pcMesh->mFaces[p];
+                face.mNumIndices = vFaceSizes[p];
+                face.mIndices = faceIndices.Allocate(face.mNumIndices);
+                ::memcpy(face.mIndices, piIndex, face.mNumIndices * sizeof(unsigned int));
+                piIndex += face.mNumIndices;
             }
+            faceIndices.Attach(pcMesh);
 
             // add the newly created mesh to the list
             avList.emplace_back(pcMesh,a);
@@ -250,6 +250,7 @@ void TextureTransformStep::Execute( aiScene* pScene) {
                         }
 
                         delete prop2;
+                        mat->InvalidatePropertyIndex();
 
                         // Warn: could be an underflow, but this does not invoke undefined behaviour
                         --a2;
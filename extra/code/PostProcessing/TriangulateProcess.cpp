@@ -62,10 +62,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/TriangulateProcess.h"
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/PolyTools.h"
+#include "Common/FaceIndexAllocator.h"
+#include "Common/ParallelFor.h"
 #include "contrib/earcut-hpp/earcut.hpp"
 
+#include <assimp/Profiler.h>
+
+#include <algorithm>
 #include <memory>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 //#define AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
 //#define AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -156,6 +163,34 @@ namespace {
             mLastNGONFirstIndex = tri1->mIndices[0];
         }
 
+        /**
+         * @brief Encode the fan triangulation of a convex polygon, and make sure it is seen as a single ngon.
+         *
+         * @param tris First triangle of the fan.
+         * @param num Number of triangles.
+         *
+         * @pre All triangles start at the same corner of the polygon and follow its winding.
+         */
+        void ngonEncodeFan(aiFace *tris, unsigned int num) {
+            if (isConsideredSameAsLastNgon(tris)) {
+                // Fan from the next corner instead, a convex polygon allows any of them
+                mPolygon.clear();
+                mPolygon.push_back(tris[0].mIndices[0]);
+                mPolygon.push_back(tris[0].mIndices[1]);
+                for (unsigned int i = 0; i < num; ++i) {
+                    mPolygon.push_back(tris[i].mIndices[2]);
+                }
+                const size_t size = mPolygon.size();
+                for (unsigned int i = 0; i < num; ++i) {
+                    tris[i].mIndices[0] = mPolygon[1];
+                    tris[i].mIndices[1] = mPolygon[i + 2];
+                    tris[i].mIndices[2] = mPolygon[(i + 3) % size];
+                }
+            }
+
+            mLastNGONFirstIndex = tris->mIndices[0];
+        }
+
         /**
          * @brief Check whether this triangle would be considered part of the lastly emitted ngon or not.
          *
@@ -170,122 +205,172 @@ namespace {
 
     private:
         unsigned int mLastNGONFirstIndex;
+        std::vector<unsigned int> mPolygon;
     };
 
-}
+    // Polygons handed to one thread at a time when a mesh is split up
+    static constexpr unsigned int PolygonsPerBatch = 1u << 12;
 
-// ------------------------------------------------------------------------------------------------
-// Returns whether the processing step is present in the given flag field.
-bool TriangulateProcess::IsActive( unsigned int pFlags) const {
-    return (pFlags & aiProcess_Triangulate) != 0;
-}
+    // How the triangles of a face were made, decides their ngon encoding
+    enum class FaceKind : unsigned char {
+        Copy,
+        Quad,
+        Fan,
+        Polygon
+    };
 
-// ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void TriangulateProcess::Execute( aiScene* pScene) {
-    ASSIMP_LOG_DEBUG("TriangulateProcess begin");
+    // A mesh being triangulated. Every input face owns a fixed range of the
+    // output faces and of the index pool, so the faces can be triangulated
+    // in any order; the ngon encoding is done afterwards in order.
+    struct MeshTriangulation {
+        aiMesh *mesh;
+        bool fanConvex;
+        unsigned int maxIndices;
+        aiFace *out;
+        std::vector<unsigned int> firstOut;
+        std::vector<size_t> firstIndex;
+        std::vector<unsigned int> numOut;
+        std::vector<FaceKind> kinds;
+        std::unique_ptr<FaceIndexAllocator> faceIndices;
 
-    bool bHas = false;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-    {
-        if (pScene->mMeshes[ a ]) {
-            if ( TriangulateMesh( pScene->mMeshes[ a ] ) ) {
-                bHas = true;
+#ifdef AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
+        aiColor4D *clr;
+#endif
+#ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
+        FILE *fout;
+#endif
+    };
+
+    // Temporary storage for the polygons of one batch
+    struct PolygonScratch {
+        explicit PolygonScratch(unsigned int maxIndices) :
+                verts3d(maxIndices + 2), poly(1) {
+            poly[0].reserve(maxIndices + 2);
+        }
+
+        std::vector<aiVector3D> verts3d;
+        std::vector<std::vector<aiVector2D>> poly; /* for earcut.hpp */
+    };
+
+    // Whether a projected polygon turns left at every corner and winds
+    // only once, so a fan from any corner covers it.
+    bool IsConvex(const std::vector<aiVector2D> &poly) {
+        const size_t num = poly.size();
+
+        // a star turns left everywhere too, but changes its x direction
+        // more than twice on the way around
+        float lastDx = 0.f;
+        for (size_t i = num; i-- > 0 && lastDx == 0.f;) {
+            lastDx = poly[(i + 1) % num].x - poly[i].x;
+        }
+
+        unsigned int flips = 0;
+        for (size_t i = 0; i < num; ++i) {
+            const aiVector2D &a = poly[i], &b = poly[(i + 1) % num], &c = poly[(i + 2) % num];
+            const float cross = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+            if (!(cross > 0.f)) {
+                return false;
+            }
+            const float dx = b.x - a.x;
+            if (dx * lastDx < 0.f && ++flips > 2) {
+                return false;
+            }
+            if (dx != 0.f) {
+                lastDx = dx;
             }
         }
+        return true;
     }
-    if ( bHas ) {
-        ASSIMP_LOG_INFO( "TriangulateProcess finished. All polygons have been triangulated." );
-    } else {
-        ASSIMP_LOG_DEBUG( "TriangulateProcess finished. There was nothing to be done." );
-    }
-}
 
-// ------------------------------------------------------------------------------------------------
-// Triangulates the given mesh.
-bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
-    // Now we have aiMesh::mPrimitiveTypes, so this is only here for test cases
-    if (!pMesh->mPrimitiveTypes)    {
-        bool bNeed = false;
+    // Sets up the output of a mesh, returns false if it has nothing to triangulate
+    bool PrepareMesh(MeshTriangulation &job) {
+        aiMesh *pMesh = job.mesh;
 
-        for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
-            const aiFace& face = pMesh->mFaces[a];
-            if( face.mNumIndices != 3)  {
-                bNeed = true;
+        // Now we have aiMesh::mPrimitiveTypes, so this is only here for test cases
+        if (!pMesh->mPrimitiveTypes)    {
+            bool bNeed = false;
+
+            for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
+                const aiFace& face = pMesh->mFaces[a];
+                if( face.mNumIndices != 3)  {
+                    bNeed = true;
+                }
+            }
+            if (!bNeed) {
+                return false;
             }
         }
-        if (!bNeed) {
+        else if (!(pMesh->mPrimitiveTypes & aiPrimitiveType_POLYGON)) {
             return false;
         }
-    }
-    else if (!(pMesh->mPrimitiveTypes & aiPrimitiveType_POLYGON)) {
-        return false;
-    }
 
-    // Find out how many output faces we'll get
-    uint32_t numOut = 0, max_out = 0;
-    bool get_normals = true;
-    for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
-        aiFace& face = pMesh->mFaces[a];
-        if (face.mNumIndices <= 4) {
-            get_normals = false;
-        }
-        if( face.mNumIndices <= 3) {
-            ++numOut;
-        } else {
-            numOut += face.mNumIndices-2;
-            max_out = std::max(max_out,face.mNumIndices);
+        // Find out how many output faces we'll get, and where those of each face start
+        uint32_t numOut = 0, max_out = 0;
+        size_t numIndicesOut = 0;
+        job.firstOut.resize(pMesh->mNumFaces);
+        job.firstIndex.resize(pMesh->mNumFaces);
+        for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
+            aiFace& face = pMesh->mFaces[a];
+            job.firstOut[a] = numOut;
+            job.firstIndex[a] = numIndicesOut;
+            if( face.mNumIndices <= 3) {
+                ++numOut;
+                numIndicesOut += face.mNumIndices;
+            } else {
+                numOut += face.mNumIndices-2;
+                numIndicesOut += (face.mNumIndices-2) * 3;
+                max_out = std::max(max_out,face.mNumIndices);
+            }
         }
-    }
 
-    // Just another check whether aiMesh::mPrimitiveTypes is correct
-    if (numOut == pMesh->mNumFaces) {
-        ASSIMP_LOG_ERROR( "Invalidation detected in the number of indices: does not fit to the primitive type." );
-        return false;
-    }
-
-    aiVector3D *nor_out = nullptr;
-
-    // if we don't have normals yet, but expect them to be a cheap side
-    // product of triangulation anyway, allocate storage for them.
-    if (!pMesh->mNormals && get_normals) {
-        // XXX need a mechanism to inform the GenVertexNormals process to treat these normals as preprocessed per-face normals
-    //  nor_out = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-    }
+        // Just another check whether aiMesh::mPrimitiveTypes is correct
+        if (numOut == pMesh->mNumFaces) {
+            ASSIMP_LOG_ERROR( "Invalidation detected in the number of indices: does not fit to the primitive type." );
+            return false;
+        }
 
-    // the output mesh will contain triangles, but no polys anymore
-    pMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-    pMesh->mPrimitiveTypes &= ~aiPrimitiveType_POLYGON;
+        // XXX Per-face normals are a cheap side product of triangulating polygon-only meshes,
+        // but we need a mechanism to inform the GenVertexNormals process to treat these normals
+        // as preprocessed per-face normals first.
 
-    // The mesh becomes NGON encoded now, during the triangulation process.
-    pMesh->mPrimitiveTypes |= aiPrimitiveType_NGONEncodingFlag;
+        // the output mesh will contain triangles, but no polys anymore
+        pMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+        pMesh->mPrimitiveTypes &= ~aiPrimitiveType_POLYGON;
 
-    aiFace* out = new aiFace[numOut](), *curOut = out;
-    std::vector<aiVector3D> temp_verts3d(max_out+2); /* temporary storage for vertices */
-    std::vector<std::vector<aiVector2D>> temp_poly(1); /* temporary storage for earcut.hpp */
-    std::vector<aiVector2D>& temp_verts = temp_poly[0];
-    temp_verts.reserve(max_out + 2);
+        // The mesh becomes NGON encoded now, during the triangulation process.
+        pMesh->mPrimitiveTypes |= aiPrimitiveType_NGONEncodingFlag;
 
-    NGONEncoder ngonEncoder;
+        job.maxIndices = max_out;
+        job.out = new aiFace[numOut]();
+        job.numOut.resize(pMesh->mNumFaces);
+        job.kinds.resize(pMesh->mNumFaces);
+        job.faceIndices.reset(new FaceIndexAllocator(nullptr != pMesh->mFaceIndices, numIndicesOut));
 
-    // Apply vertex colors to represent the face winding?
+        // Apply vertex colors to represent the face winding?
 #ifdef AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
-    if (!pMesh->mColors[0])
-        pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-    else
-        new(pMesh->mColors[0]) aiColor4D[pMesh->mNumVertices];
+        if (!pMesh->mColors[0])
+            pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+        else
+            new(pMesh->mColors[0]) aiColor4D[pMesh->mNumVertices];
 
-    aiColor4D* clr = pMesh->mColors[0];
+        job.clr = pMesh->mColors[0];
 #endif
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
-    FILE* fout = fopen(POLY_OUTPUT_FILE,"a");
+        job.fout = fopen(POLY_OUTPUT_FILE,"a");
 #endif
+        return true;
+    }
 
-    const aiVector3D* verts = pMesh->mVertices;
-
-    for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
-        aiFace& face = pMesh->mFaces[a];
+    // Triangulates face a of a mesh into its range of output faces,
+    // returns the number of triangles made
+    unsigned int TriangulateFace(MeshTriangulation &job, unsigned int a, PolygonScratch &scratch) {
+        aiFace& face = job.mesh->mFaces[a];
+        const aiVector3D* verts = job.mesh->mVertices;
+        FaceIndexAllocator& faceIndices = *job.faceIndices;
+        size_t indexOffset = job.firstIndex[a];
+        aiFace* const first = job.out + job.firstOut[a];
+        aiFace* curOut = first;
 
         unsigned int* idx = face.mIndices;
         unsigned int num = face.mNumIndices;
@@ -293,26 +378,22 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
         // Apply vertex colors to represent the face winding?
 #ifdef AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
         for (unsigned int i = 0; i < face.mNumIndices; ++i) {
-            aiColor4D& c = clr[idx[i]];
+            aiColor4D& c = job.clr[idx[i]];
             c.r = (i+1) / (float)max;
             c.b = 1.f - c.r;
         }
 #endif
 
-        aiFace* const last_face = curOut;
-
         // if it's a simple point,line or triangle: just copy it
         if( face.mNumIndices <= 3)
         {
             aiFace& nface = *curOut++;
             nface.mNumIndices = face.mNumIndices;
-            nface.mIndices    = face.mIndices;
-            face.mIndices = nullptr;
+            nface.mIndices    = faceIndices.MoveAt(indexOffset, face);
 
             // points and lines don't require ngon encoding (and are not supported either!)
-            if (nface.mNumIndices == 3) ngonEncoder.ngonEncodeTriangle(&nface);
-
-            continue;
+            job.kinds[a] = FaceKind::Copy;
+            return 1;
         }
         // optimized code for quadrilaterals
         else if ( face.mNumIndices == 4) {
@@ -348,7 +429,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
 
             aiFace& nface = *curOut++;
             nface.mNumIndices = 3;
-            nface.mIndices = face.mIndices;
+            nface.mIndices = faceIndices.ReuseAt(indexOffset, face, 3);
 
             nface.mIndices[0] = temp[start_vertex];
             nface.mIndices[1] = temp[(start_vertex + 1) % 4];
@@ -356,151 +437,285 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
 
             aiFace& sface = *curOut++;
             sface.mNumIndices = 3;
-            sface.mIndices = new unsigned int[3];
+            sface.mIndices = faceIndices.AllocateAt(indexOffset, 3);
 
             sface.mIndices[0] = temp[start_vertex];
             sface.mIndices[1] = temp[(start_vertex + 2) % 4];
             sface.mIndices[2] = temp[(start_vertex + 3) % 4];
 
-            // prevent double deletion of the indices field
-            face.mIndices = nullptr;
+            job.kinds[a] = FaceKind::Quad;
+            return 2;
+        }
 
-            ngonEncoder.ngonEncodeQuad(&nface, &sface);
+        // A polygon with more than 3 vertices can be either concave or convex.
+        // Usually everything we're getting is convex and we could easily
+        // triangulate by tri-fanning. However, LightWave is probably the only
+        // modeling suite to make extensive use of highly concave, monster polygons ...
+        // so we need to apply the full 'ear cutting' algorithm to get it right.
 
-            continue;
-        }
-        else
-        {
-            // A polygon with more than 3 vertices can be either concave or convex.
-            // Usually everything we're getting is convex and we could easily
-            // triangulate by tri-fanning. However, LightWave is probably the only
-            // modeling suite to make extensive use of highly concave, monster polygons ...
-            // so we need to apply the full 'ear cutting' algorithm to get it right.
-
-            // REQUIREMENT: polygon is expected to be simple and *nearly* planar.
-            // We project it onto a plane to get a 2d triangle.
-
-            // Collect all vertices of of the polygon.
-            for (unsigned int tmp = 0; tmp < num; ++tmp) {
-                temp_verts3d[tmp] = verts[idx[tmp]];
-            }
+        // REQUIREMENT: polygon is expected to be simple and *nearly* planar.
+        // We project it onto a plane to get a 2d triangle.
 
-            // Get newell normal of the polygon. Store it for future use if it's a polygon-only mesh
-            aiVector3D n;
-            NewellNormal<3, 3, 3>(n, num, &temp_verts3d.front().x, &temp_verts3d.front().y, &temp_verts3d.front().z);
-            if (nor_out) {
-                for (unsigned int tmp = 0; tmp < num; ++tmp)
-                    nor_out[idx[tmp]] = n;
-            }
+        // Collect all vertices of of the polygon.
+        std::vector<aiVector3D>& temp_verts3d = scratch.verts3d;
+        for (unsigned int tmp = 0; tmp < num; ++tmp) {
+            temp_verts3d[tmp] = verts[idx[tmp]];
+        }
 
-            // Select largest normal coordinate to ignore for projection
-            const float ax = (n.x>0 ? n.x : -n.x);
-            const float ay = (n.y>0 ? n.y : -n.y);
-            const float az = (n.z>0 ? n.z : -n.z);
-
-            unsigned int ac = 0, bc = 1; /* no z coord. projection to xy */
-            float inv = n.z;
-            if (ax > ay) {
-                if (ax > az) { /* no x coord. projection to yz */
-                    ac = 1; bc = 2;
-                    inv = n.x;
-                }
-            }
-            else if (ay > az) { /* no y coord. projection to zy */
-                ac = 2; bc = 0;
-                inv = n.y;
+        // Get newell normal of the polygon.
+        aiVector3D n;
+        NewellNormal<3, 3, 3>(n, num, &temp_verts3d.front().x, &temp_verts3d.front().y, &temp_verts3d.front().z);
+
+        // Select largest normal coordinate to ignore for projection
+        const float ax = (n.x>0 ? n.x : -n.x);
+        const float ay = (n.y>0 ? n.y : -n.y);
+        const float az = (n.z>0 ? n.z : -n.z);
+
+        unsigned int ac = 0, bc = 1; /* no z coord. projection to xy */
+        float inv = n.z;
+        if (ax > ay) {
+            if (ax > az) { /* no x coord. projection to yz */
+                ac = 1; bc = 2;
+                inv = n.x;
             }
+        }
+        else if (ay > az) { /* no y coord. projection to zy */
+            ac = 2; bc = 0;
+            inv = n.y;
+        }
 
-            // Swap projection axes to take the negated projection vector into account
-            if (inv < 0.f) {
-                std::swap(ac,bc);
-            }
+        // Swap projection axes to take the negated projection vector into account
+        if (inv < 0.f) {
+            std::swap(ac,bc);
+        }
 
-            temp_verts.resize(num);
-            for (unsigned int tmp = 0; tmp < num; ++tmp) {
-                temp_verts[tmp].x = verts[idx[tmp]][ac];
-                temp_verts[tmp].y = verts[idx[tmp]][bc];
-            }
+        std::vector<aiVector2D>& temp_verts = scratch.poly[0];
+        temp_verts.resize(num);
+        for (unsigned int tmp = 0; tmp < num; ++tmp) {
+            temp_verts[tmp].x = verts[idx[tmp]][ac];
+            temp_verts[tmp].y = verts[idx[tmp]][bc];
+        }
 
-            auto indices = mapbox::earcut(temp_poly);
-            for (size_t i = 0; i < indices.size(); i += 3) {
+        // The projection winds counter-clockwise, so a convex polygon
+        // can simply be fanned from its first corner
+        if (job.fanConvex && IsConvex(temp_verts)) {
+            for (unsigned int i = 1; i + 1 < num; ++i) {
                 aiFace& nface = *curOut++;
-                nface.mIndices = new unsigned int[3];
+                nface.mIndices = faceIndices.AllocateAt(indexOffset, 3);
                 nface.mNumIndices = 3;
-                nface.mIndices[0] = indices[i];
-                nface.mIndices[1] = indices[i + 1];
-                nface.mIndices[2] = indices[i + 2];
+                nface.mIndices[0] = idx[0];
+                nface.mIndices[1] = idx[i];
+                nface.mIndices[2] = idx[i + 1];
             }
+            job.kinds[a] = FaceKind::Fan;
+            return num - 2;
+        }
+
+        auto indices = mapbox::earcut(scratch.poly);
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            aiFace& nface = *curOut++;
+            nface.mIndices = faceIndices.AllocateAt(indexOffset, 3);
+            nface.mNumIndices = 3;
+            nface.mIndices[0] = idx[indices[i]];
+            nface.mIndices[1] = idx[indices[i + 1]];
+            nface.mIndices[2] = idx[indices[i + 2]];
+        }
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
-            // plot the plane onto which we mapped the polygon to a 2D ASCII pic
-            aiVector2D bmin,bmax;
-            ArrayBounds(&temp_verts[0],max,bmin,bmax);
-
-            char grid[POLY_GRID_Y][POLY_GRID_X+POLY_GRID_XPAD];
-            std::fill_n((char*)grid,POLY_GRID_Y*(POLY_GRID_X+POLY_GRID_XPAD),' ');
-
-            for (int i =0; i < max; ++i) {
-                const aiVector2D& v = (temp_verts[i] - bmin) / (bmax-bmin);
-                const size_t x = static_cast<size_t>(v.x*(POLY_GRID_X-1)), y = static_cast<size_t>(v.y*(POLY_GRID_Y-1));
-                char* loc = grid[y]+x;
-                if (grid[y][x] != ' ') {
-                    for(;*loc != ' '; ++loc);
-                    *loc++ = '_';
-                }
-                *(loc+::ai_snprintf(loc, POLY_GRID_XPAD,"%i",i)) = ' ';
+        FILE* fout = job.fout;
+
+        // plot the plane onto which we mapped the polygon to a 2D ASCII pic
+        aiVector2D bmin,bmax;
+        ArrayBounds(&temp_verts[0],max,bmin,bmax);
+
+        char grid[POLY_GRID_Y][POLY_GRID_X+POLY_GRID_XPAD];
+        std::fill_n((char*)grid,POLY_GRID_Y*(POLY_GRID_X+POLY_GRID_XPAD),' ');
+
+        for (int i =0; i < max; ++i) {
+            const aiVector2D& v = (temp_verts[i] - bmin) / (bmax-bmin);
+            const size_t x = static_cast<size_t>(v.x*(POLY_GRID_X-1)), y = static_cast<size_t>(v.y*(POLY_GRID_Y-1));
+            char* loc = grid[y]+x;
+            if (grid[y][x] != ' ') {
+                for(;*loc != ' '; ++loc);
+                *loc++ = '_';
             }
+            *(loc+::ai_snprintf(loc, POLY_GRID_XPAD,"%i",i)) = ' ';
+        }
 
 
-            for(size_t y = 0; y < POLY_GRID_Y; ++y) {
-                grid[y][POLY_GRID_X+POLY_GRID_XPAD-1] = '\0';
-                fprintf(fout,"%s\n",grid[y]);
-            }
-
-            fprintf(fout,"\ntriangulation sequence: ");
-#endif
+        for(size_t y = 0; y < POLY_GRID_Y; ++y) {
+            grid[y][POLY_GRID_X+POLY_GRID_XPAD-1] = '\0';
+            fprintf(fout,"%s\n",grid[y]);
         }
 
-#ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
+        fprintf(fout,"\ntriangulation sequence: ");
 
-        for(aiFace* f = last_face; f != curOut; ++f) {
+        for(aiFace* f = first; f != curOut; ++f) {
             unsigned int* i = f->mIndices;
             fprintf(fout," (%i %i %i)",i[0],i[1],i[2]);
         }
 
         fprintf(fout,"\n*********************************************************************\n");
         fflush(fout);
+#endif
+
+        job.kinds[a] = FaceKind::Polygon;
+        return static_cast<unsigned int>(curOut - first);
+    }
 
+    // Packs the triangles of all faces together, ngon encodes them in order
+    // and hands them over to the mesh
+    void FinishMesh(MeshTriangulation &job) {
+        aiMesh *pMesh = job.mesh;
+        NGONEncoder ngonEncoder;
+
+        aiFace *curOut = job.out;
+        for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+            // ear cutting may skip degenerated triangles, close the gap they leave
+            aiFace *tris = job.out + job.firstOut[a];
+            const unsigned int num = job.numOut[a];
+            if (tris != curOut) {
+                for (unsigned int i = 0; i < num; ++i) {
+                    curOut[i].mNumIndices = tris[i].mNumIndices;
+                    curOut[i].mIndices = tris[i].mIndices;
+                    tris[i].mNumIndices = 0;
+                    tris[i].mIndices = nullptr;
+                }
+            }
+
+            switch (job.kinds[a]) {
+            case FaceKind::Copy:
+                if (curOut->mNumIndices == 3) ngonEncoder.ngonEncodeTriangle(curOut);
+                break;
+            case FaceKind::Quad:
+                ngonEncoder.ngonEncodeQuad(curOut, curOut + 1);
+                break;
+            case FaceKind::Fan:
+                ngonEncoder.ngonEncodeFan(curOut, num);
+                break;
+            case FaceKind::Polygon:
+                // IMPROVEMENT: Polygons are not supported yet by this ngon encoding + triangulation step.
+                //              So we encode polygons as regular triangles. No way to reconstruct the original
+                //              polygon in this case.
+                for (unsigned int i = 0; i < num; ++i) {
+                    ngonEncoder.ngonEncodeTriangle(curOut + i);
+                }
+                break;
+            }
+            curOut += num;
+        }
+
+#ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
+        fclose(job.fout);
 #endif
 
-        for(aiFace* f = last_face; f != curOut; ) {
-            unsigned int* i = f->mIndices;
+        // kill the old faces
+        pMesh->DeleteFaces();
+
+        // ... and store the new ones
+        pMesh->mFaces    = job.out;
+        pMesh->mNumFaces = (unsigned int)(curOut-job.out); /* not necessarily equal to numOut */
+        job.faceIndices->Attach(pMesh);
+    }
+
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool TriangulateProcess::IsActive( unsigned int pFlags) const {
+    return (pFlags & aiProcess_Triangulate) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup properties for the step
+void TriangulateProcess::SetupProperties(const Importer* pImp) {
+    mFanConvex = pImp->GetPropertyBool(AI_CONFIG_PP_TRI_FAN_CONVEX, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void TriangulateProcess::Execute( aiScene* pScene) {
+    ASSIMP_LOG_DEBUG("TriangulateProcess begin");
 
-            i[0] = idx[i[0]];
-            i[1] = idx[i[1]];
-            i[2] = idx[i[2]];
+    // Large meshes are done one after the other, each on all threads. The
+    // small ones go to the threads as a whole, as many at a time as there are.
+    std::vector<unsigned int> small;
+    std::vector<char> done(pScene->mNumMeshes, 0);
+    std::vector<int64_t> times(pScene->mNumMeshes * 2, 0);
+    std::vector<unsigned int> facesIn(pScene->mNumMeshes, 0);
+
+    auto triangulate = [&](unsigned int a, unsigned int numThreads) {
+        aiMesh *mesh = pScene->mMeshes[a];
+        facesIn[a] = mesh->mNumFaces;
+        times[a * 2] = mProfiler ? mProfiler->GetTime() : 0;
+        done[a] = TriangulateMesh(mesh, numThreads);
+        times[a * 2 + 1] = mProfiler ? mProfiler->GetTime() : 0;
+    };
 
-            // IMPROVEMENT: Polygons are not supported yet by this ngon encoding + triangulation step.
-            //              So we encode polygons as regular triangles. No way to reconstruct the original
-            //              polygon in this case.
-            ngonEncoder.ngonEncodeTriangle(f);
-            ++f;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        if (nullptr == pScene->mMeshes[a]) {
+            continue;
         }
+        if (mNumThreads > 1 && pScene->mMeshes[a]->mNumFaces > PolygonsPerBatch) {
+            triangulate(a, mNumThreads);
+        } else {
+            small.push_back(a);
+        }
+    }
+    ForEachMesh(static_cast<unsigned int>(small.size()), [&](unsigned int i) {
+        triangulate(small[i], 1);
+    });
 
-        delete[] face.mIndices;
-        face.mIndices = nullptr;
+    bool bHas = false;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        if (!done[a]) {
+            continue;
+        }
+        bHas = true;
+        if (mProfiler) {
+            mProfiler->AddRegion("mesh " + std::to_string(a), times[a * 2], times[a * 2 + 1], {
+                { "faces_in", facesIn[a] },
+                { "faces_out", pScene->mMeshes[a]->mNumFaces } });
+        }
+    }
+
+    if ( bHas ) {
+        ASSIMP_LOG_INFO( "TriangulateProcess finished. All polygons have been triangulated." );
+    } else {
+        ASSIMP_LOG_DEBUG( "TriangulateProcess finished. There was nothing to be done." );
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Triangulates the given mesh.
+bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
+    return TriangulateMesh(pMesh, mNumThreads);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TriangulateProcess::TriangulateMesh(aiMesh* pMesh, unsigned int numThreads) {
+    MeshTriangulation job;
+    job.mesh = pMesh;
+    job.fanConvex = mFanConvex;
+    if (!PrepareMesh(job)) {
+        return false;
     }
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
-    fclose(fout);
+    // the polygons are dumped in order
+    numThreads = 1;
 #endif
 
-    // kill the old faces
-    delete [] pMesh->mFaces;
+    const unsigned int numBatches = (pMesh->mNumFaces + PolygonsPerBatch - 1) / PolygonsPerBatch;
+    ParallelFor(numBatches, numThreads, [&](unsigned int batch) {
+        PolygonScratch scratch(job.maxIndices);
+        const unsigned int end = std::min(pMesh->mNumFaces, (batch + 1) * PolygonsPerBatch);
+        for (unsigned int a = batch * PolygonsPerBatch; a < end; ++a) {
+            job.numOut[a] = TriangulateFace(job, a, scratch);
+        }
+    });
 
-    // ... and store the new ones
-    pMesh->mFaces    = out;
-    pMesh->mNumFaces = (unsigned int)(curOut-out); /* not necessarily equal to numOut */
+    FinishMesh(job);
     return true;
 }
 
@@ -80,11 +80,34 @@ public:
     */
     void Execute( aiScene* pScene) override;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp) override;
+
     // -------------------------------------------------------------------
     /** Triangulates the given mesh.
      * @param pMesh The mesh to triangulate.
      */
     bool TriangulateMesh( aiMesh* pMesh);
+
+    // -------------------------------------------------------------------
+    /** Fan triangulate convex polygons, see #AI_CONFIG_PP_TRI_FAN_CONVEX.
+     * @param fan Whether to use fans.
+     */
+    void SetFanConvex(bool fan) {
+        mFanConvex = fan;
+    }
+
+private:
+    // -------------------------------------------------------------------
+    /** Triangulates the given mesh, large meshes in batches of
+     *  polygons on up to numThreads threads. */
+    bool TriangulateMesh(aiMesh* pMesh, unsigned int numThreads);
+
+    bool mFanConvex = false;
 };
 
 } // end of namespace Assimp
@@ -47,8 +47,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "ValidateDataStructure.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
+#include "Common/ScenePrivate.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/fast_atof.h>
+#include <algorithm>
 #include <memory>
 
 // CRT headers
@@ -56,9 +59,80 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
+namespace {
+
+// Warnings of the mesh validated on this thread, logged in mesh order afterwards
+thread_local std::vector<std::string> *gCollectedWarnings = nullptr;
+
+// ------------------------------------------------------------------------------------------------
+// Largest of num indices. Four independent maxima without branches, so the
+// compiler can keep them in vector registers.
+unsigned int MaxIndex(const unsigned int *indices, size_t num) {
+    unsigned int m0 = 0, m1 = 0, m2 = 0, m3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        m0 = std::max(m0, indices[i]);
+        m1 = std::max(m1, indices[i + 1]);
+        m2 = std::max(m2, indices[i + 2]);
+        m3 = std::max(m3, indices[i + 3]);
+    }
+    for (; i < num; ++i) {
+        m0 = std::max(m0, indices[i]);
+    }
+    return std::max(std::max(m0, m1), std::max(m2, m3));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hash of everything the validation of a mesh depends on, except for array contents
+uint64_t MeshFingerprint(const aiScene *scene, const aiMesh *mesh) {
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](uint64_t value) {
+        hash = (hash ^ value) * 1099511628211ull;
+    };
+    auto addPtr = [&add](const void *ptr) {
+        add(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)));
+    };
+
+    add(scene->mFlags);
+    add(scene->mNumMaterials);
+    addPtr(mesh);
+    add(mesh->mPrimitiveTypes);
+    add(mesh->mNumVertices);
+    add(mesh->mNumFaces);
+    add(mesh->mMaterialIndex);
+    addPtr(mesh->mVertices);
+    addPtr(mesh->mNormals);
+    addPtr(mesh->mTangents);
+    addPtr(mesh->mBitangents);
+    addPtr(mesh->mFaces);
+    addPtr(mesh->mFaceIndices);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        addPtr(mesh->mColors[i]);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        addPtr(mesh->mTextureCoords[i]);
+        add(mesh->mNumUVComponents[i]);
+    }
+    add(mesh->mName.length);
+    addPtr(mesh->mBones);
+    add(mesh->mNumBones);
+    for (unsigned int i = 0; mesh->mBones && i < mesh->mNumBones; ++i) {
+        const aiBone *bone = mesh->mBones[i];
+        addPtr(bone);
+        if (bone) {
+            addPtr(bone->mWeights);
+            add(bone->mNumWeights);
+            add(bone->mName.length);
+        }
+    }
+    return hash;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ValidateDSProcess::ValidateDSProcess() : mScene(nullptr) {}
+ValidateDSProcess::ValidateDSProcess() : mScene(nullptr), mSkipUnchanged(false) {}
 
 // ------------------------------------------------------------------------------------------------
 // Returns whether the processing step is present in the given flag field.
@@ -92,9 +166,18 @@ void ValidateDSProcess::ReportWarning(const char *msg, ...) {
     ai_assert(iLen > 0);
 
     va_end(args);
+    if (gCollectedWarnings) {
+        gCollectedWarnings->emplace_back(szBuffer, iLen);
+        return;
+    }
     ASSIMP_LOG_WARN("Validation warning: ", std::string(szBuffer, iLen));
 }
 
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::SetupProperties(const Importer *pImp) {
+    mSkipUnchanged = pImp->GetPropertyBool(AI_CONFIG_PP_VDS_SKIP_UNCHANGED_MESHES, false);
+}
+
 // ------------------------------------------------------------------------------------------------
 inline int HasNameMatch(const aiString &in, aiNode *node) {
     int result = (node->mName == in ? 1 : 0);
@@ -189,7 +272,7 @@ void ValidateDSProcess::Execute(aiScene *pScene) {
 
     // validate all meshes
     if (pScene->mNumMeshes) {
-        DoValidation(pScene->mMeshes, pScene->mNumMeshes, "mMeshes", "mNumMeshes");
+        ValidateMeshes();
     } else if (!(mScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)) {
         ReportError("aiScene::mNumMeshes is 0. At least one mesh must be there");
     } else if (pScene->mMeshes) {
@@ -240,6 +323,60 @@ void ValidateDSProcess::Execute(aiScene *pScene) {
     ASSIMP_LOG_DEBUG("ValidateDataStructureProcess end");
 }
 
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::ValidateMeshes() {
+    const unsigned int numMeshes = mScene->mNumMeshes;
+    if (!mScene->mMeshes) {
+        ReportError("aiScene::mMeshes is nullptr (aiScene::mNumMeshes is %i)", numMeshes);
+    }
+
+    ScenePrivateData *priv = ScenePriv(mScene);
+    std::vector<uint64_t> fingerprints(numMeshes, 0);
+    std::vector<std::vector<std::string>> warnings(numMeshes);
+
+    // Meshes are validated on their own, the error of the first broken one
+    // is reported just like without threads
+    try {
+        ForEachMesh(numMeshes, [&](unsigned int i) {
+            const aiMesh *mesh = mScene->mMeshes[i];
+            if (!mesh) {
+                ReportError("aiScene::mMeshes[%i] is nullptr (aiScene::mNumMeshes is %i)", i, numMeshes);
+            }
+            if (priv) {
+                fingerprints[i] = MeshFingerprint(mScene, mesh);
+                if (mSkipUnchanged && i < priv->mValidatedMeshes.size() && priv->mValidatedMeshes[i] == fingerprints[i]) {
+                    return;
+                }
+            }
+
+            gCollectedWarnings = &warnings[i];
+            try {
+                Validate(mesh);
+            } catch (...) {
+                gCollectedWarnings = nullptr;
+                throw;
+            }
+            gCollectedWarnings = nullptr;
+        });
+    } catch (...) {
+        for (const std::vector<std::string> &list : warnings) {
+            for (const std::string &warning : list) {
+                ASSIMP_LOG_WARN("Validation warning: ", warning);
+            }
+        }
+        throw;
+    }
+
+    for (const std::vector<std::string> &list : warnings) {
+        for (const std::string &warning : list) {
+            ASSIMP_LOG_WARN("Validation warning: ", warning);
+        }
+    }
+    if (priv) {
+        priv->mValidatedMeshes.swap(fingerprints);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate(const aiLight *pLight) {
     if (pLight->mType == aiLightSource_UNDEFINED)
@@ -279,46 +416,58 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
 
     Validate(&pMesh->mName);
 
+    // Collect the primitive types of all faces first, the faces are only
+    // looked at one by one to tell which one is wrong
+    static const unsigned int FaceTypes[4] = { 0x80000000u, aiPrimitiveType_POINT, aiPrimitiveType_LINE, aiPrimitiveType_TRIANGLE };
+    unsigned int faceTypes = 0;
+    bool missingIndices = false;
     for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
-        aiFace &face = pMesh->mFaces[i];
+        const aiFace &face = pMesh->mFaces[i];
+        faceTypes |= face.mNumIndices < 4 ? FaceTypes[face.mNumIndices] : aiPrimitiveType_POLYGON;
+        missingIndices |= !face.mIndices;
+    }
+    if (missingIndices || (pMesh->mPrimitiveTypes && (faceTypes & ~pMesh->mPrimitiveTypes))) {
+        for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+            aiFace &face = pMesh->mFaces[i];
+
+            if (pMesh->mPrimitiveTypes) {
+                switch (face.mNumIndices) {
+                case 0:
+                    ReportError("aiMesh::mFaces[%i].mNumIndices is 0", i);
+                case 1:
+                    if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_POINT)) {
+                        ReportError("aiMesh::mFaces[%i] is a POINT but aiMesh::mPrimitiveTypes "
+                                    "does not report the POINT flag",
+                                i);
+                    }
+                    break;
+                case 2:
+                    if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_LINE)) {
+                        ReportError("aiMesh::mFaces[%i] is a LINE but aiMesh::mPrimitiveTypes "
+                                    "does not report the LINE flag",
+                                i);
+                    }
+                    break;
+                case 3:
+                    if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE)) {
+                        ReportError("aiMesh::mFaces[%i] is a TRIANGLE but aiMesh::mPrimitiveTypes "
+                                    "does not report the TRIANGLE flag",
+                                i);
+                    }
+                    break;
+                default:
+                    if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_POLYGON)) {
+                        this->ReportError("aiMesh::mFaces[%i] is a POLYGON but aiMesh::mPrimitiveTypes "
+                                          "does not report the POLYGON flag",
+                                i);
+                    }
+                    break;
+                };
+            }
 
-        if (pMesh->mPrimitiveTypes) {
-            switch (face.mNumIndices) {
-            case 0:
-                ReportError("aiMesh::mFaces[%i].mNumIndices is 0", i);
-            case 1:
-                if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_POINT)) {
-                    ReportError("aiMesh::mFaces[%i] is a POINT but aiMesh::mPrimitiveTypes "
-                                "does not report the POINT flag",
-                            i);
-                }
-                break;
-            case 2:
-                if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_LINE)) {
-                    ReportError("aiMesh::mFaces[%i] is a LINE but aiMesh::mPrimitiveTypes "
-                                "does not report the LINE flag",
-                            i);
-                }
-                break;
-            case 3:
-                if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE)) {
-                    ReportError("aiMesh::mFaces[%i] is a TRIANGLE but aiMesh::mPrimitiveTypes "
-                                "does not report the TRIANGLE flag",
-                            i);
-                }
-                break;
-            default:
-                if (0 == (pMesh->mPrimitiveTypes & aiPrimitiveType_POLYGON)) {
-                    this->ReportError("aiMesh::mFaces[%i] is a POLYGON but aiMesh::mPrimitiveTypes "
-                                      "does not report the POLYGON flag",
-                            i);
-                }
-                break;
-            };
+            if (!face.mIndices)
+                ReportError("aiMesh::mFaces[%i].mIndices is nullptr", i);
         }
-
-        if (!face.mIndices)
-            ReportError("aiMesh::mFaces[%i].mIndices is nullptr", i);
     }
 
     // positions must always be there ...
@@ -345,9 +494,8 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
 
     // now check whether the face indexing layout is correct:
     // unique vertices, pseudo-indexed.
-    std::vector<bool> abRefList;
-    abRefList.resize(pMesh->mNumVertices, false);
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+    std::vector<unsigned char> abRefList(pMesh->mNumVertices, 0);
+    auto checkFace = [&](unsigned int i) {
         aiFace &face = pMesh->mFaces[i];
         if (face.mNumIndices > AI_MAX_FACE_INDICES) {
             ReportError("Face %u has too many faces: %u, but the limit is %u", i, face.mNumIndices, AI_MAX_FACE_INDICES);
@@ -357,17 +505,35 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
             if (face.mIndices[a] >= pMesh->mNumVertices) {
                 ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range", i, a);
             }
-            abRefList[face.mIndices[a]] = true;
+            abRefList[face.mIndices[a]] = 1;
         }
+    };
+
+    // Faces whose indices follow each other in memory, as they do in a
+    // pool, are range checked in one go. Only if that fails they are looked
+    // at one by one to tell which index is wrong.
+    for (unsigned int i = 0; i < pMesh->mNumFaces;) {
+        const unsigned int *begin = pMesh->mFaces[i].mIndices, *end = begin;
+        unsigned int j = i;
+        for (; j < pMesh->mNumFaces && pMesh->mFaces[j].mIndices == end &&
+                pMesh->mFaces[j].mNumIndices <= AI_MAX_FACE_INDICES; ++j) {
+            end += pMesh->mFaces[j].mNumIndices;
+        }
+
+        if (j == i || (end != begin && MaxIndex(begin, end - begin) >= pMesh->mNumVertices)) {
+            for (j = std::max(j, i + 1); i < j; ++i) {
+                checkFace(i);
+            }
+            continue;
+        }
+        for (const unsigned int *idx = begin; idx != end; ++idx) {
+            abRefList[*idx] = 1;
+        }
+        i = j;
     }
 
     // check whether there are vertices that aren't referenced by a face
-    bool b = false;
-    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
-        if (!abRefList[i]) b = true;
-    }
-    abRefList.clear();
-    if (b) {
+    if (std::find(abRefList.begin(), abRefList.end(), 0) != abRefList.end()) {
         ReportWarning("There are unreferenced vertices");
     }
 
@@ -68,7 +68,7 @@ namespace Assimp {
 /** Validates the whole ASSIMP scene data structure for correctness.
  *  ImportErrorException is thrown of the scene is corrupt.*/
 // --------------------------------------------------------------------------------------
-class ValidateDSProcess : public BaseProcess {
+class ASSIMP_API ValidateDSProcess : public BaseProcess {
 public:
     // -------------------------------------------------------------------
     /// The default class constructor / destructor.
@@ -81,6 +81,9 @@ public:
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene) override;
 
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer* pImp) override;
+
 protected:
     // -------------------------------------------------------------------
     /** Report a validation error. This will throw an exception,
@@ -166,6 +169,10 @@ protected:
     void Validate( const aiString* pString);
 
 private:
+    // -------------------------------------------------------------------
+    /** Validates all meshes of the scene, on several threads and
+     *  skipping unchanged ones if so configured. */
+    void ValidateMeshes();
 
     // template to validate one of the aiScene::mXXX arrays
     template <typename T>
@@ -184,6 +191,9 @@ private:
         const char* firstName, const char* secondName);
 
     aiScene* mScene;
+
+    /** See #AI_CONFIG_PP_VDS_SKIP_UNCHANGED_MESHES */
+    bool mSkipUnchanged;
 };
 
 
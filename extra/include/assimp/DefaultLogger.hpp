@@ -56,10 +56,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NullLogger.hpp"
 #include <vector>
 
-#ifndef ASSIMP_BUILD_SINGLETHREADED
 #include <mutex>
-#include <thread>
-#endif
 
 namespace Assimp {
 // ------------------------------------------------------------------------------------
@@ -189,9 +186,7 @@ private:
     //! Attached streams
     StreamArray m_StreamArray;
 
-#ifndef ASSIMP_BUILD_SINGLETHREADED
     std::mutex m_arrayMutex;
-#endif
 
     bool noRepeatMsg;
     char lastMsg[MAX_LOG_MESSAGE_LENGTH * 2];
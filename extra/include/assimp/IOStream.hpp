@@ -124,6 +124,19 @@ public:
      *  See fflush() for more details.
      */
     virtual void Flush() = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Returns the whole contents of the file if they are already
+     *  in memory, e.g. for memory mapped or memory backed streams.
+     *
+     *  The pointer covers FileSize() bytes and stays valid until the
+     *  stream is closed, independent of the read cursor. Loaders use it
+     *  to parse in place instead of copying the file into a buffer of
+     *  their own. The default implementation returns nullptr, callers
+     *  must fall back to Read() then. */
+    virtual const uint8_t *GetMappedData() const {
+        return nullptr;
+    }
 }; //! class IOStream
 
 } //!namespace Assimp
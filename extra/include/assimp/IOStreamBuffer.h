@@ -116,6 +116,13 @@ public:
     /// @return true if successful.
     bool getNextBlock(std::vector<T> &buffer);
 
+    /// @brief  Hands out the rest of the file in place if the stream is memory mapped,
+    ///         see IOStream::GetMappedData(). Consumes the remaining data.
+    /// @param  data        Will point to the first unread element.
+    /// @param  count       Will receive the number of unread elements.
+    /// @return true if successful, false if the stream is not mapped.
+    bool getMappedRemainder(const T *&data, size_t &count);
+
 private:
     IOStream *m_stream;
     size_t m_filesize;
@@ -345,6 +352,25 @@ AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextBlock(std::vector<T> &buffer) {
     return true;
 }
 
+template <class T>
+AI_FORCE_INLINE bool IOStreamBuffer<T>::getMappedRemainder(const T *&data, size_t &count) {
+    const uint8_t *mapped = nullptr != m_stream ? m_stream->GetMappedData() : nullptr;
+    if (nullptr == mapped) {
+        return false;
+    }
+
+    // m_filePos is the end of the current block, nothing was read yet if it is zero
+    const size_t pos = 0 == m_filePos ? 0 : m_filePos - m_cacheSize + m_cachePos;
+    data = reinterpret_cast<const T *>(mapped) + pos;
+    count = m_filesize / sizeof(T) - pos;
+
+    // the next block read hits the end of the file
+    m_filePos = m_filesize;
+    m_cachePos = 0;
+
+    return true;
+}
+
 } // namespace Assimp
 
 #endif // AI_IOSTREAMBUFFER_H_INC
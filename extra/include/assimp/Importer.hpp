@@ -78,6 +78,10 @@ class ProgressHandler;
 class BaseImporter;
 class BaseProcess;
 class SharedPostProcessInfo;
+
+namespace Profiling {
+class Profiler;
+}
 class BatchLoader;
 
 // =======================================================================
@@ -644,6 +648,19 @@ public:
      *   is (naturally) not included.*/
     void GetMemoryRequirements(aiMemoryInfo &in) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the timings recorded for the last ReadFile() and any
+     *  post processing applied afterwards.
+     *
+     * Recording is enabled with #AI_CONFIG_GLOB_MEASURE_TIME. The regions
+     * cover the import, preprocessing, validation and every single post
+     * processing step, with counters for the bytes read and the meshes,
+     * vertices and faces going into and out of each step.
+     * Use Profiling::Profiler::WriteChromeTrace() to view them in
+     * chrome://tracing or Perfetto.
+     * @return nullptr if recording was never enabled for this importer.*/
+    const Profiling::Profiler *GetProfiler() const;
+
     // -------------------------------------------------------------------
     /** Enables "extra verbose" mode.
      *
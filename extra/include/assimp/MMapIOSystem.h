@@ -0,0 +1,126 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/**
+ *  @file MMapIOSystem.h
+ *  @brief IOSystem that maps files into memory instead of reading them
+ */
+#pragma once
+#ifndef AI_MMAPIOSYSTEM_H_INC
+#define AI_MMAPIOSYSTEM_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+
+namespace Assimp {
+
+// ----------------------------------------------------------------------------------
+//! @class  MMapIOStream
+//! @brief  Read-only stream over a file mapped into memory.
+//!
+//! Read() copies out of the mapping, GetMappedData() hands out the mapping
+//! itself. The pages are mapped copy-on-write, so a loader that patches the
+//! data in place never writes back to the file.
+class ASSIMP_API MMapIOStream : public IOStream {
+    friend class MMapIOSystem;
+
+protected:
+    /// @brief The class constructor, takes ownership of the mapping.
+    MMapIOStream(const uint8_t *data, size_t size) AI_NO_EXCEPT;
+
+public:
+    /// @brief The class destructor, unmaps the file.
+    ~MMapIOStream() override;
+
+    // -------------------------------------------------------------------
+    /// Read from stream
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override;
+
+    // -------------------------------------------------------------------
+    /// Write to stream, always fails
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override;
+
+    // -------------------------------------------------------------------
+    /// Seek specific position
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+
+    // -------------------------------------------------------------------
+    /// Get current seek position
+    size_t Tell() const override;
+
+    // -------------------------------------------------------------------
+    /// Get size of file
+    size_t FileSize() const override;
+
+    // -------------------------------------------------------------------
+    /// Flush file contents, nothing to do
+    void Flush() override;
+
+    // -------------------------------------------------------------------
+    /// Returns the mapped file
+    const uint8_t *GetMappedData() const override;
+
+private:
+    const uint8_t *mData;
+    size_t mSize;
+    size_t mPos;
+};
+
+// ---------------------------------------------------------------------------
+/** IOSystem that maps files opened for reading into memory. Files opened
+ *  for writing, empty files and files that cannot be mapped are handled by
+ *  DefaultIOSystem. Pass an instance to Importer::SetIOHandler() to let the
+ *  loaders that support it parse in place, see IOStream::GetMappedData().
+ */
+class ASSIMP_API MMapIOSystem : public DefaultIOSystem {
+public:
+    // -------------------------------------------------------------------
+    /** Open a new file with a given path. */
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override;
+};
+
+} // namespace Assimp
+
+#endif // AI_MMAPIOSYSTEM_H_INC
@@ -0,0 +1,107 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file PointBatchHandler.hpp
+ *  @brief Abstract base class 'PointBatchHandler'.
+ */
+#pragma once
+#ifndef AI_POINTBATCHHANDLER_H_INC
+#define AI_POINTBATCHHANDLER_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Abstract interface to receive the points of a point cloud
+ *  while it is being read, instead of as one mesh of the final scene.
+ *
+ *  Point clouds from scanners easily contain hundreds of millions of points,
+ *  which don't fit into memory as an #aiMesh. Pass an instance of your
+ *  implementation to #Importer::SetPropertyPointer() with the
+ *  #AI_CONFIG_IMPORT_POINT_BATCH_HANDLER key. Loaders which support it hand
+ *  the points over in consecutive batches of bounded size and return a scene
+ *  without meshes, flagged with #AI_SCENE_FLAGS_INCOMPLETE.
+ *
+ *  Currently the PLY loader supports it for binary files without faces. */
+class ASSIMP_API PointBatchHandler
+#ifndef SWIG
+    : public Intern::AllocateFromAssimpHeap
+#endif
+{
+protected:
+    /// @brief  Default constructor
+    PointBatchHandler() AI_NO_EXCEPT = default;
+
+public:
+    /// @brief  Virtual destructor.
+    virtual ~PointBatchHandler() = default;
+
+    // -------------------------------------------------------------------
+    /** @brief Batch callback, called in file order from the thread which
+     *  runs the import.
+     *  @param firstPoint Index of the first point of the batch in the file.
+     *  @param numPoints Number of points in the batch.
+     *  @param positions Positions of the points.
+     *  @param normals Normals of the points, nullptr if the file has none.
+     *  @param colors Colors of the points, nullptr if the file has none.
+     *  @param textureCoords Texture coordinates of the points, nullptr if
+     *    the file has none.
+     *
+     *  The arrays are only valid during the call, copy what you need.
+     *
+     *  @return Return false to abort loading, #Importer::ReadFile()
+     *   returns nullptr then.
+     *   */
+    virtual bool HandleBatch(size_t firstPoint, unsigned int numPoints,
+            const aiVector3D *positions, const aiVector3D *normals,
+            const aiColor4D *colors, const aiVector3D *textureCoords) = 0;
+}; // !class PointBatchHandler
+
+// ------------------------------------------------------------------------------------
+
+} // Namespace Assimp
+
+#endif // AI_POINTBATCHHANDLER_H_INC
@@ -54,7 +54,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/TinyFormatter.h>
 
-#include <map>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace Assimp {
 namespace Profiling {
@@ -62,39 +67,228 @@ namespace Profiling {
 using namespace Formatter;
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** Records nested, named regions of the import on a steady clock.
+ *
+ *  Regions form a tree: a region begun while another one is open becomes its
+ *  child. Each region can carry named integer counters (vertices in/out, bytes
+ *  read, ...). Begin and end are still written to the debug log; the complete
+ *  tree can be read back with GetRegions() or written as a Chrome trace
+ *  (chrome://tracing, https://ui.perfetto.dev) with WriteChromeTrace().
+ *  A profiler is not thread-safe, it is owned by the thread doing the import.
  */
 class Profiler {
 public:
-    Profiler() = default;
+    /** A named value attached to a region */
+    struct Counter {
+        std::string name;
+        int64_t value;
+    };
 
+    /** One measured region, times are in nanoseconds since the profiler was
+     *  created or cleared. end is -1 while the region is open. */
+    struct Region {
+        std::string name;
+        unsigned int parent;
+        unsigned int depth;
+        int64_t begin;
+        int64_t end;
+        std::vector<Counter> counters;
 
-    /** Start a named timer */
+        double Seconds() const {
+            return end < begin ? 0.0 : (end - begin) * 1e-9;
+        }
+    };
+
+    /** Parent of the top level regions */
+    static constexpr unsigned int NoParent = ~0u;
+
+    Profiler() : start(Clock::now()) {}
+
+
+    /** Start a named timer, nested in the innermost open one */
     void BeginRegion(const std::string& region) {
-        regions[region] = std::chrono::system_clock::now();
+        Region r;
+        r.name = region;
+        r.parent = open.empty() ? NoParent : open.back();
+        r.depth = static_cast<unsigned int>(open.size());
+        r.begin = Now();
+        r.end = -1;
+        open.push_back(static_cast<unsigned int>(regions.size()));
+        regions.push_back(r);
         ASSIMP_LOG_DEBUG("START `",region,"`");
     }
 
 
-    /** End a specific named timer and write its end time to the log */
+    /** End a specific named timer and write its end time to the log.
+     *  Regions opened inside it and not yet ended are ended with it. */
     void EndRegion(const std::string& region) {
-        RegionMap::const_iterator it = regions.find(region);
-        if (it == regions.end()) {
+        size_t i = open.size();
+        while (i > 0 && regions[open[i - 1]].name != region) {
+            --i;
+        }
+        if (i == 0) {
+            return;
+        }
+
+        const unsigned int index = open[i - 1];
+        const int64_t now = Now();
+        while (open.size() >= i) {
+            regions[open.back()].end = now;
+            open.pop_back();
+        }
+
+        ASSIMP_LOG_DEBUG("END   `",region,"`, dt= ", regions[index].Seconds()," s");
+    }
+
+
+    /** Add value to the counter name of the innermost open region. Does
+     *  nothing if no region is open. */
+    void AddCounter(const std::string& name, int64_t value) {
+        if (open.empty()) {
             return;
         }
+        std::vector<Counter>& counters = regions[open.back()].counters;
+        for (Counter& c : counters) {
+            if (c.name == name) {
+                c.value += value;
+                return;
+            }
+        }
+        counters.push_back(Counter{ name, value });
+    }
+
+
+    /** Record a region which has already ended as a child of the innermost
+     *  open region, e.g. work done on other threads. begin and end are
+     *  taken with GetTime(). */
+    void AddRegion(const std::string& region, int64_t begin, int64_t end,
+            const std::vector<Counter>& counters = std::vector<Counter>()) {
+        Region r;
+        r.name = region;
+        r.parent = open.empty() ? NoParent : open.back();
+        r.depth = static_cast<unsigned int>(open.size());
+        r.begin = begin;
+        r.end = end;
+        r.counters = counters;
+        regions.push_back(r);
+        ASSIMP_LOG_DEBUG("ADD   `",region,"`, dt= ", r.Seconds()," s");
+    }
+
+
+    /** Current time in nanoseconds since the profiler was created or
+     *  cleared. Unlike the rest, this may be called from any thread. */
+    int64_t GetTime() const {
+        return Now();
+    }
+
+
+    /** All regions in the order they were begun, parents come first */
+    const std::vector<Region>& GetRegions() const {
+        return regions;
+    }
+
+
+    /** Forget all regions and restart the clock */
+    void Clear() {
+        regions.clear();
+        open.clear();
+        start = Clock::now();
+    }
+
+
+    /** Write the regions in the Chrome trace event format. Every region is
+     *  a complete ("X") event, its counters become the event args. */
+    void WriteChromeTrace(std::ostream& out) const {
+        out << "{\"traceEvents\":[";
+        for (size_t i = 0; i < regions.size(); ++i) {
+            const Region& r = regions[i];
+            const int64_t end = r.end < r.begin ? Now() : r.end;
+            out << (i ? ",\n" : "\n") << "{\"name\":";
+            WriteJsonString(out, r.name);
+            out << ",\"cat\":\"assimp\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+                << ",\"ts\":" << Microseconds(r.begin)
+                << ",\"dur\":" << Microseconds(end - r.begin)
+                << ",\"args\":{";
+            for (size_t c = 0; c < r.counters.size(); ++c) {
+                out << (c ? "," : "");
+                WriteJsonString(out, r.counters[c].name);
+                out << ":" << r.counters[c].value;
+            }
+            out << "}}";
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
 
-        std::chrono::duration<double> elapsedSeconds = std::chrono::system_clock::now() - regions[region];
-        ASSIMP_LOG_DEBUG("END   `",region,"`, dt= ", elapsedSeconds.count()," s");
+    /** Same as WriteChromeTrace(), as a string */
+    std::string GetChromeTrace() const {
+        std::ostringstream out;
+        WriteChromeTrace(out);
+        return out.str();
     }
 
 private:
-    typedef std::map<std::string,std::chrono::time_point<std::chrono::system_clock>> RegionMap;
-    RegionMap regions;
+    typedef std::chrono::steady_clock Clock;
+
+    int64_t Now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    static std::string Microseconds(int64_t ns) {
+        char buffer[32];
+        ::snprintf(buffer, sizeof(buffer), "%.3f", ns * 1e-3);
+        return buffer;
+    }
+
+    static void WriteJsonString(std::ostream& out, const std::string& s) {
+        out << '"';
+        for (const char ch : s) {
+            const unsigned char c = static_cast<unsigned char>(ch);
+            if (c == '"' || c == '\\') {
+                out << '\\' << ch;
+            } else if (c < 0x20) {
+                char buffer[8];
+                ::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                out << buffer;
+            } else {
+                out << ch;
+            }
+        }
+        out << '"';
+    }
+
+    Clock::time_point start;
+    std::vector<Region> regions;
+    std::vector<unsigned int> open;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Begins a region on construction and ends it on destruction. The profiler
+ *  may be nullptr, then nothing is recorded. */
+class ScopedRegion {
+public:
+    ScopedRegion(Profiler* profiler, const std::string& region) :
+            profiler(profiler), region(region) {
+        if (profiler) {
+            profiler->BeginRegion(region);
+        }
+    }
+
+    ~ScopedRegion() {
+        if (profiler) {
+            profiler->EndRegion(region);
+        }
+    }
+
+    ScopedRegion(const ScopedRegion&) = delete;
+    ScopedRegion& operator=(const ScopedRegion&) = delete;
+
+private:
+    Profiler* profiler;
+    std::string region;
 };
 
 }
 }
 
 #endif // AI_INCLUDED_PROFILER_H
-
@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <assimp/types.h>
+#include <assimp/SpatialGrid.h>
 #include <vector>
 #include <stdint.h>
 
@@ -86,6 +87,15 @@ public:
      */
     void Prepare();
 
+    // -------------------------------------------------------------------
+    /** Index the positions with a uniform grid (see #SpatialGrid) instead
+     *  of sorting them along a plane. Call before Prepare().
+     *  @see AI_CONFIG_GLOB_SPATIAL_GRID
+     */
+    void SetUseGrid(bool useGrid) {
+        mUseGrid = useGrid;
+    }
+
     /** Destructor */
     ~SGSpatialSort() = default;
 
@@ -145,6 +155,12 @@ protected:
 
     // all positions, sorted by distance to the sorting plane
     std::vector<Entry> mPositions;
+
+    // true if mGrid is used for the queries, mPositions is not sorted then
+    bool mUseGrid = false;
+
+    // indices into mPositions, only built if mUseGrid is set
+    SpatialGrid mGrid;
 };
 
 } // end of namespace Assimp
@@ -71,6 +71,7 @@ struct aiMesh;
 struct aiAnimMesh;
 struct aiAnimation;
 struct aiNodeAnim;
+struct aiMeshAnim;
 struct aiMeshMorphAnim;
 
 namespace Assimp {
@@ -337,6 +338,22 @@ public:
      */
     static void CopySceneFlat(aiScene **dest, const aiScene *source);
 
+    // -------------------------------------------------------------------
+    /** Get a deep copy of a scene whose contents live in one arena
+     *
+     *  Everything the copy owns, apart from the skeletons, is allocated
+     *  from a monotonic arena kept in the private data of the scene, so
+     *  deleting the scene releases it in one go instead of object by
+     *  object. The contents of such a scene must not be modified, freed
+     *  or moved to another scene; get a regular copy with CopyScene()
+     *  for that. See #AI_CONFIG_IMPORT_SCENE_ARENA.
+     *  @param dest     Receives a pointer to the destination scene
+     *  @param source   Source scene - remains unmodified.
+     *  @param allocate true for allocation a new scene, otherwise dest
+     *    must point to an empty scene
+     */
+    static void CopySceneToArena(aiScene **dest, const aiScene *source, bool allocate = true);
+
     // -------------------------------------------------------------------
     /** Get a deep copy of a mesh
      *
@@ -354,6 +371,7 @@ public:
     static void Copy(aiBone **dest, const aiBone *src);
     static void Copy(aiLight **dest, const aiLight *src);
     static void Copy(aiNodeAnim **dest, const aiNodeAnim *src);
+    static void Copy(aiMeshAnim **dest, const aiMeshAnim *src);
     static void Copy(aiMeshMorphAnim **dest, const aiMeshMorphAnim *src);
     static void Copy(aiMetadata **dest, const aiMetadata *src);
     static void Copy(aiString **dest, const aiString *src);
@@ -102,9 +102,11 @@ struct MeshWithSmoothingGroups
 
 // ---------------------------------------------------------------------------
 /** Computes normal vectors for the mesh
+ *  @param useGrid Find the vertices at the same position with a SpatialGrid,
+ *    see #AI_CONFIG_GLOB_SPATIAL_GRID
  */
 template <class T>
-void ComputeNormalsWithSmoothingsGroups(MeshWithSmoothingGroups<T>& sMesh);
+void ComputeNormalsWithSmoothingsGroups(MeshWithSmoothingGroups<T>& sMesh, bool useGrid = false);
 
 
 // include implementations
@@ -57,7 +57,7 @@ using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 template <class T>
-void ComputeNormalsWithSmoothingsGroups(MeshWithSmoothingGroups<T>& sMesh)
+void ComputeNormalsWithSmoothingsGroups(MeshWithSmoothingGroups<T>& sMesh, bool useGrid)
 {
     // First generate face normals
     sMesh.mNormals.resize(sMesh.mPositions.size(),aiVector3D());
@@ -94,6 +94,7 @@ void ComputeNormalsWithSmoothingsGroups(MeshWithSmoothingGroups<T>& sMesh)
 
     // now generate the spatial sort tree
     SGSpatialSort sSort;
+    sSort.SetUseGrid(useGrid);
     for( typename std::vector<T>::iterator i =  sMesh.mFaces.begin();
         i != sMesh.mFaces.end();++i)
     {
@@ -0,0 +1,156 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SpatialGrid.h
+ *  Uniform grid over a point set, cells stored in Morton order.
+ */
+#pragma once
+#ifndef AI_SPATIALGRID_H_INC
+#define AI_SPATIALGRID_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+#include <vector>
+#include <stdint.h>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Alternative to sorting along a plane for SpatialSort and SGSpatialSort.
+ *
+ *  The bounding box of the points is divided into cubic cells of roughly four points each
+ *  and the points are sorted by the Morton code of their cell, so a cell is one contiguous
+ *  range. A radius query only visits the handful of cells overlapping the query box,
+ *  independent of how the points are laid out. Sorting along a plane degrades to scanning
+ *  most of the mesh when many points have the same distance to that plane, which is common
+ *  for large planar, axis-aligned architectural meshes.
+ *
+ *  Dimensions the points do not extend in (a flat floor) get a single layer of cells, so
+ *  planar meshes still end up with about four points per cell.
+ */
+class ASSIMP_API SpatialGrid {
+public:
+    SpatialGrid() = default;
+    ~SpatialGrid() = default;
+
+    // ------------------------------------------------------------------------------------
+    /** Build the grid over the given points.
+     *  @param pPositions Pointer to the first position.
+     *  @param pNumPositions Number of points.
+     *  @param pElementOffset Distance in bytes between two positions, this allows to build
+     *    the grid directly over an array of structs. */
+    void Build(const aiVector3D *pPositions, unsigned int pNumPositions, unsigned int pElementOffset);
+
+    // ------------------------------------------------------------------------------------
+    /** Remove all points. */
+    void Clear();
+
+    // ------------------------------------------------------------------------------------
+    /** Call f(i) for the index i of every point in a cell overlapping the box
+     *  [pPosition - pRadius, pPosition + pRadius]. This is a superset of the points within
+     *  pRadius, the caller does the exact test. */
+    template <class F>
+    void ForEachCandidate(const aiVector3D &pPosition, ai_real pRadius, F f) const {
+        if (mCells.empty()) {
+            return;
+        }
+        uint32_t lo[3], hi[3];
+        CellCoords(pPosition - aiVector3D(pRadius, pRadius, pRadius), lo);
+        CellCoords(pPosition + aiVector3D(pRadius, pRadius, pRadius), hi);
+
+        // large radius: looking up every cell of the box would cost more than visiting all points
+        const uint64_t numQueryCells = uint64_t(hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1);
+        if (numQueryCells > mCells.size()) {
+            for (unsigned int i : mOrder) {
+                f(i);
+            }
+            return;
+        }
+
+        for (uint32_t z = lo[2]; z <= hi[2]; ++z) {
+            for (uint32_t y = lo[1]; y <= hi[1]; ++y) {
+                for (uint32_t x = lo[0]; x <= hi[0]; ++x) {
+                    const size_t c = FindCell(MortonKey(x, y, z));
+                    if (c == mCells.size()) {
+                        continue;
+                    }
+                    const unsigned int end = c + 1 < mCells.size() ? mCells[c + 1].mBegin : static_cast<unsigned int>(mOrder.size());
+                    for (unsigned int k = mCells[c].mBegin; k < end; ++k) {
+                        f(mOrder[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------------------
+    /** Indices of all points, grouped by cell in Morton order. Neighbouring entries are
+     *  close in space. */
+    const std::vector<unsigned int> &GetOrder() const {
+        return mOrder;
+    }
+
+protected:
+    void CellCoords(const aiVector3D &pPosition, uint32_t *pCoords) const;
+    static uint64_t MortonKey(uint32_t x, uint32_t y, uint32_t z);
+    size_t FindCell(uint64_t key) const;
+
+    struct Cell {
+        uint64_t mKey; ///< Morton code of the cell coordinates
+        unsigned int mBegin; ///< First entry of the cell in mOrder
+    };
+
+    aiVector3D mMin;
+    ai_real mInvCellSize = 1;
+    uint32_t mResolution[3] = { 1, 1, 1 };
+
+    /// point indices sorted by cell
+    std::vector<unsigned int> mOrder;
+    /// occupied cells sorted by key
+    std::vector<Cell> mCells;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_SPATIALGRID_H_INC
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <assimp/types.h>
+#include <assimp/SpatialGrid.h>
 #include <vector>
 #include <limits>
 
@@ -110,6 +111,13 @@ public:
      *  can be called to query the spatial sort.*/
     void Finalize();
 
+    // ------------------------------------------------------------------------------------
+    /** Index the positions with a uniform grid (see #SpatialGrid) instead of sorting them
+     *  along a plane. The queries return the same positions, possibly in a different order.
+     *  Must be called before the positions are finalized.
+     *  @see AI_CONFIG_GLOB_SPATIAL_GRID */
+    void SetUseGrid(bool pUseGrid);
+
     // ------------------------------------------------------------------------------------
     /** Returns an iterator for all positions close to the given position.
      * @param pPosition The position to look for vertices.
@@ -182,6 +190,12 @@ protected:
 
     /// false until the Finalize method is called.
     bool mFinalized;
+
+    /// true if mGrid is used for the queries, mPositions is not sorted then
+    bool mUseGrid;
+
+    /// indices into mPositions, only built if mUseGrid is set
+    SpatialGrid mGrid;
 };
 
 } // end of namespace Assimp
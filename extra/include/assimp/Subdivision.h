@@ -119,6 +119,15 @@ public:
         unsigned int num,
         bool discard_input = false) = 0;
 
+    // ---------------------------------------------------------------
+    /** Set the number of threads a subdivision may use. The result
+     *  does not depend on it.
+     *
+     *  @param numThreads Number of threads, 1 by default. */
+    virtual void SetNumThreads(unsigned int numThreads) {
+        (void)numThreads;
+    }
+
 };
 
 inline Subdivider::~Subdivider() = default;
@@ -375,6 +375,21 @@ ASSIMP_API void aiGetMemoryRequirements(
         const C_STRUCT aiScene *pIn,
         C_STRUCT aiMemoryInfo *in);
 
+// --------------------------------------------------------------------------------
+/** Write the timings recorded while importing an asset as a Chrome trace
+ * (JSON, open it in chrome://tracing or Perfetto).
+ *
+ * Recording must have been enabled by setting #AI_CONFIG_GLOB_MEASURE_TIME
+ * in the property store passed to aiImportFileExWithProperties().
+ * @param pIn Input asset.
+ * @param pFile Path of the file to write.
+ * @return aiReturn_FAILURE if nothing was recorded or the file could not
+ *   be written.
+ */
+ASSIMP_API C_ENUM aiReturn aiWriteProfilerTrace(
+        const C_STRUCT aiScene *pIn,
+        const char *pFile);
+
 // --------------------------------------------------------------------------------
 /** Returns an embedded texture, or nullptr.
  * @param pIn Input asset.
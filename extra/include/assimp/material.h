@@ -712,6 +712,10 @@ struct aiMaterialProperty {
 } // We need to leave the "C" block here to allow template member functions
 #endif
 
+// Lookup index of a material, private to the library
+struct aiMaterialPropertyIndex;
+struct aiMaterialPBR;
+
 // ---------------------------------------------------------------------------
 /** @brief Data structure for a material
 *
@@ -850,6 +854,11 @@ public:
             aiTextureOp *op = NULL,
             aiTextureMapMode *mapmode = NULL) const;
 
+    // -------------------------------------------------------------------
+    /** Reads the metallic-roughness parameters of the material in one
+     *  pass over its properties, see #aiGetMaterialPBR(). */
+    aiReturn GetPBR(aiMaterialPBR &pOut) const;
+
     // Setters
 
     // ------------------------------------------------------------------------------
@@ -963,6 +972,14 @@ public:
     static void CopyPropertyList(aiMaterial *pcDest,
             const aiMaterial *pcSrc);
 
+    // ------------------------------------------------------------------------------
+    /** @brief Drops the lookup index of the material.
+     *
+     *  The member functions keep the index up to date. Code which edits
+     *  #mProperties directly must call this afterwards, unless it replaces
+     *  the array or changes #mNumProperties. */
+    void InvalidatePropertyIndex();
+
 #endif
 
     /** List of all material properties loaded. */
@@ -973,6 +990,10 @@ public:
 
     /** Storage allocated */
     unsigned int mNumAllocated;
+
+    /** Lookup index over the property keys, built on demand by the
+     *  material functions. Opaque and owned by the library, may be NULL. */
+    C_STRUCT aiMaterialPropertyIndex *mPropertyIndex;
 };
 
 // Go back to extern "C" again
@@ -1716,6 +1737,82 @@ C_ENUM aiReturn aiGetMaterialTexture(const C_STRUCT aiMaterial *mat,
         unsigned int *flags /*= NULL*/);
 #endif // !#ifdef __cplusplus
 
+// ---------------------------------------------------------------------------
+/** @brief Tells which members of #aiMaterialPBR were read from the material.
+ */
+enum aiMaterialPBRFlags {
+    aiMaterialPBRFlags_BaseColor = 0x1,
+    aiMaterialPBRFlags_Metallic = 0x2,
+    aiMaterialPBRFlags_Roughness = 0x4,
+    aiMaterialPBRFlags_Emissive = 0x8,
+    aiMaterialPBRFlags_EmissiveIntensity = 0x10,
+    aiMaterialPBRFlags_Opacity = 0x20,
+    aiMaterialPBRFlags_Transmission = 0x40,
+    aiMaterialPBRFlags_Clearcoat = 0x80,
+    aiMaterialPBRFlags_ClearcoatRoughness = 0x100,
+    aiMaterialPBRFlags_TwoSided = 0x200,
+
+#ifndef SWIG
+    _aiMaterialPBRFlags_Force32Bit = INT_MAX
+#endif
+};
+
+// ---------------------------------------------------------------------------
+/** @brief The metallic-roughness parameters of a material.
+ *
+ *  Members which are not defined by the material keep the glTF 2.0
+ *  defaults given below.
+ */
+struct aiMaterialPBR {
+    /** #AI_MATKEY_BASE_COLOR, defaults to opaque white. */
+    C_STRUCT aiColor4D mBaseColor;
+
+    /** #AI_MATKEY_METALLIC_FACTOR, defaults to 1. */
+    ai_real mMetallicFactor;
+
+    /** #AI_MATKEY_ROUGHNESS_FACTOR, defaults to 1. */
+    ai_real mRoughnessFactor;
+
+    /** #AI_MATKEY_COLOR_EMISSIVE, defaults to opaque black. */
+    C_STRUCT aiColor4D mEmissiveColor;
+
+    /** #AI_MATKEY_EMISSIVE_INTENSITY, defaults to 1. */
+    ai_real mEmissiveIntensity;
+
+    /** #AI_MATKEY_OPACITY, defaults to 1. */
+    ai_real mOpacity;
+
+    /** #AI_MATKEY_TRANSMISSION_FACTOR, defaults to 0. */
+    ai_real mTransmissionFactor;
+
+    /** #AI_MATKEY_CLEARCOAT_FACTOR, defaults to 0. */
+    ai_real mClearcoatFactor;
+
+    /** #AI_MATKEY_CLEARCOAT_ROUGHNESS_FACTOR, defaults to 0. */
+    ai_real mClearcoatRoughnessFactor;
+
+    /** #AI_MATKEY_TWOSIDED, defaults to 0. */
+    int mTwoSided;
+
+    /** Combination of #aiMaterialPBRFlags for the members which were
+     *  read from the material. */
+    unsigned int mFlags;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Reads the metallic-roughness parameters of a material.
+ *
+ *  Walks the properties once instead of looking up every key on its own,
+ *  which is cheaper when a renderer translates many materials.
+ *
+ *  @param[in] pMat Pointer to the input material. May not be NULL
+ *  @param[out] pOut Receives the parameters, see #aiMaterialPBR.
+ *  @return AI_SUCCESS if at least one parameter was read from the material,
+ *    AI_FAILURE if all members hold their defaults. */
+// ---------------------------------------------------------------------------
+ASSIMP_API C_ENUM aiReturn aiGetMaterialPBR(const C_STRUCT aiMaterial *pMat,
+        C_STRUCT aiMaterialPBR *pOut);
+
 #ifdef __cplusplus
 }
 
@@ -78,6 +78,11 @@ AI_FORCE_INLINE unsigned int aiMaterial::GetTextureCount(aiTextureType type) con
     return ::aiGetMaterialTextureCount(this,type);
 }
 
+// ---------------------------------------------------------------------------
+AI_FORCE_INLINE aiReturn aiMaterial::GetPBR(aiMaterialPBR &pOut) const {
+    return ::aiGetMaterialPBR(this,&pOut);
+}
+
 // ---------------------------------------------------------------------------
 template <typename Type>
 AI_FORCE_INLINE aiReturn aiMaterial::Get(const char* pKey,unsigned int type,
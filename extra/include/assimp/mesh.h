@@ -826,6 +826,21 @@ struct aiMesh {
      */
     C_STRUCT aiString **mTextureCoordsNames;
 
+    /**
+     * @brief Contiguous storage for the indices of all faces, nullptr if
+     * each face owns its own index array (the default).
+     *
+     * If present, the mIndices members of the faces point into this array,
+     * which is released together with the faces. Reading faces works the
+     * same in both cases. Enabled by #AI_CONFIG_IMPORT_FACE_INDEX_POOL.
+     */
+    unsigned int *mFaceIndices;
+
+    /**
+     * The size of the mFaceIndices array.
+     */
+    unsigned int mNumFaceIndices;
+
 #ifdef __cplusplus
 
     //! The default class constructor.
@@ -848,7 +863,9 @@ struct aiMesh {
               mAnimMeshes(nullptr),
               mMethod(aiMorphingMethod_UNKNOWN),
               mAABB(),
-              mTextureCoordsNames(nullptr) {
+              mTextureCoordsNames(nullptr),
+              mFaceIndices(nullptr),
+              mNumFaceIndices(0) {
         // empty
     }
 
@@ -894,7 +911,61 @@ struct aiMesh {
             delete[] mAnimMeshes;
         }
 
+        DeleteFaces();
+    }
+
+    //! @brief Check whether an index array is part of the face index pool.
+    //! @param indices Index array of a face
+    //! @return true, if the array is owned by the pool and not by the face.
+    bool IsPooledFaceIndices(const unsigned int *indices) const {
+        return mFaceIndices != nullptr && indices >= mFaceIndices && indices < mFaceIndices + mNumFaceIndices;
+    }
+
+    //! @brief Move the indices of all faces into one contiguous pool.
+    //!
+    //! The mNumIndices member of each face must be set. Faces without
+    //! an index array yet get zero-initialized storage, so importers can
+    //! set the index counts first and fill in the indices afterwards.
+    void PoolFaceIndices() {
+        size_t numIndices = 0;
+        for (unsigned int i = 0; i < mNumFaces; ++i) {
+            numIndices += mFaces[i].mNumIndices;
+        }
+        unsigned int *pool = new unsigned int[numIndices];
+        unsigned int *cur = pool;
+        for (unsigned int i = 0; i < mNumFaces; ++i) {
+            aiFace &face = mFaces[i];
+            if (face.mIndices) {
+                ::memcpy(cur, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+                if (!IsPooledFaceIndices(face.mIndices)) {
+                    delete[] face.mIndices;
+                }
+            } else {
+                ::memset(cur, 0, face.mNumIndices * sizeof(unsigned int));
+            }
+            face.mIndices = face.mNumIndices ? cur : nullptr;
+            cur += face.mNumIndices;
+        }
+        delete[] mFaceIndices;
+        mFaceIndices = pool;
+        mNumFaceIndices = static_cast<unsigned int>(numIndices);
+    }
+
+    //! @brief Delete all faces along with the face index pool.
+    void DeleteFaces() {
+        if (mFaceIndices) {
+            for (unsigned int i = 0; mFaces && i < mNumFaces; ++i) {
+                if (IsPooledFaceIndices(mFaces[i].mIndices)) {
+                    mFaces[i].mIndices = nullptr;
+                }
+            }
+            delete[] mFaceIndices;
+            mFaceIndices = nullptr;
+            mNumFaceIndices = 0;
+        }
         delete[] mFaces;
+        mFaces = nullptr;
+        mNumFaces = 0;
     }
 
     //! @brief Check whether the mesh contains positions. Provided no special
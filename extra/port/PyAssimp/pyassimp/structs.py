@@ -540,6 +540,9 @@ class Material(Structure):
 
             # Storage allocated
             ("mNumAllocated", c_uint),
+
+            # Lookup index over the property keys, owned by the library
+            ("mPropertyIndex", c_void_p),
         ]
 
 class Bone(Structure):
@@ -777,7 +780,14 @@ class Mesh(Structure):
             ("mAABB", 2 * Vector3D),
 
             # Vertex UV stream names. Pointer to array of size AI_MAX_NUMBER_OF_TEXTURECOORDS
-            ("mTextureCoordsNames", POINTER(POINTER(String)))
+            ("mTextureCoordsNames", POINTER(POINTER(String))),
+
+            # Optional pool holding the indices of all faces, see
+            # AI_CONFIG_IMPORT_FACE_INDEX_POOL.
+            ("mFaceIndices", POINTER(c_uint)),
+
+            # The size of the mFaceIndices array.
+            ("mNumFaceIndices", c_uint)
 
         ]
 
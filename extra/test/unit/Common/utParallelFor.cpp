@@ -0,0 +1,132 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+#include "UnitTestPCH.h"
+
+#include "Common/ParallelFor.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Assimp;
+
+class utParallelFor : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utParallelFor, getNumThreadsTest) {
+    EXPECT_EQ(1u, GetNumThreads(1));
+    EXPECT_EQ(1u, GetNumThreads(-3));
+    EXPECT_EQ(4u, GetNumThreads(4));
+    EXPECT_LE(1u, GetNumThreads(0));
+}
+
+TEST_F(utParallelFor, visitsEveryItemOnceTest) {
+    for (unsigned int numThreads : { 1u, 2u, 7u }) {
+        std::vector<std::atomic<int>> visits(1000);
+        for (auto &v : visits) {
+            v = 0;
+        }
+        ParallelFor(1000, numThreads, [&](unsigned int i) {
+            ++visits[i];
+        });
+        for (unsigned int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(1, visits[i].load());
+        }
+    }
+}
+
+TEST_F(utParallelFor, rethrowsLowestIndexTest) {
+    std::string what;
+    try {
+        ParallelFor(64, 4, [](unsigned int i) {
+            if (i == 5 || i == 40) {
+                throw std::runtime_error(std::to_string(i));
+            }
+        });
+    } catch (const std::runtime_error &e) {
+        what = e.what();
+    }
+    EXPECT_EQ("5", what);
+}
+
+static void ImportWithThreads(Importer &importer, int numThreads) {
+    importer.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, numThreads);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace |
+            aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+}
+
+TEST_F(utParallelFor, postProcessingMatchesSerialTest) {
+    Importer serial, parallel;
+    ImportWithThreads(serial, 1);
+    ImportWithThreads(parallel, 4);
+    const aiScene *a = serial.GetScene();
+    const aiScene *b = parallel.GetScene();
+    ASSERT_NE(nullptr, a);
+    ASSERT_NE(nullptr, b);
+    ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+    EXPECT_LT(1u, a->mNumMeshes);
+
+    for (unsigned int m = 0; m < a->mNumMeshes; ++m) {
+        const aiMesh *ma = a->mMeshes[m];
+        const aiMesh *mb = b->mMeshes[m];
+        ASSERT_EQ(ma->mNumVertices, mb->mNumVertices);
+        ASSERT_EQ(ma->mNumFaces, mb->mNumFaces);
+        for (unsigned int i = 0; i < ma->mNumVertices; ++i) {
+            EXPECT_EQ(ma->mVertices[i], mb->mVertices[i]);
+            EXPECT_EQ(ma->mNormals[i], mb->mNormals[i]);
+        }
+        for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+            ASSERT_EQ(ma->mFaces[f].mNumIndices, mb->mFaces[f].mNumIndices);
+            for (unsigned int i = 0; i < ma->mFaces[f].mNumIndices; ++i) {
+                EXPECT_EQ(ma->mFaces[f].mIndices[i], mb->mFaces[f].mIndices[i]);
+            }
+        }
+    }
+}
@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/SpatialSort.h>
 
+#include <algorithm>
+
 using namespace Assimp;
 
 class utSpatialSort : public ::testing::Test {
@@ -118,3 +120,54 @@ TEST_F(utSpatialSort, highlyDisplacedPositionsTest) {
     }
     delete[] positions;
 }
+
+TEST_F(utSpatialSort, gridMatchesPlaneSortTest) {
+    SpatialSort planeSort;
+    planeSort.Fill(vecs, 100, sizeof(aiVector3D));
+    SpatialSort gridSort;
+    gridSort.SetUseGrid(true);
+    gridSort.Fill(vecs, 100, sizeof(aiVector3D));
+
+    std::vector<unsigned int> expected, indices;
+    for (unsigned int i = 0; i < 100; ++i) {
+        planeSort.FindPositions(vecs[i], 0.25f, expected);
+        gridSort.FindPositions(vecs[i], 0.25f, indices);
+        std::sort(expected.begin(), expected.end());
+        std::sort(indices.begin(), indices.end());
+        EXPECT_EQ(expected, indices);
+
+        planeSort.FindIdenticalPositions(vecs[i], expected);
+        gridSort.FindIdenticalPositions(vecs[i], indices);
+        std::sort(expected.begin(), expected.end());
+        std::sort(indices.begin(), indices.end());
+        EXPECT_EQ(expected, indices);
+    }
+
+    std::vector<unsigned int> fill;
+    EXPECT_EQ(100u, gridSort.GenerateMappingTable(fill, 1e-6f));
+    ASSERT_EQ(100u, fill.size());
+}
+
+TEST_F(utSpatialSort, gridDuplicatesTest) {
+    // Every position appears twice, so the mapping table has half as many entries.
+    std::vector<aiVector3D> doubled(vecs, vecs + 100);
+    doubled.insert(doubled.end(), vecs, vecs + 100);
+
+    SpatialSort sSort;
+    sSort.SetUseGrid(true);
+    sSort.Fill(doubled.data(), 200, sizeof(aiVector3D));
+
+    std::vector<unsigned int> indices;
+    sSort.FindIdenticalPositions(vecs[7], indices);
+    std::sort(indices.begin(), indices.end());
+    ASSERT_EQ(2u, indices.size());
+    EXPECT_EQ(7u, indices[0]);
+    EXPECT_EQ(107u, indices[1]);
+
+    std::vector<unsigned int> fill;
+    EXPECT_EQ(100u, sSort.GenerateMappingTable(fill, 1e-6f));
+    ASSERT_EQ(200u, fill.size());
+    for (unsigned int i = 0; i < 100; ++i) {
+        EXPECT_EQ(fill[i], fill[i + 100]);
+    }
+}
@@ -44,6 +44,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/Importer.h"
 #include "TestIOSystem.h"
 
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/GenericProperty.h>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
 using namespace ::Assimp;
 
 class BatchLoaderTest : public ::testing::Test {
@@ -79,3 +85,62 @@ TEST_F( BatchLoaderTest, validateAccessTest ) {
     BatchLoader loader2( m_io, true );
     EXPECT_TRUE( loader2.getValidation() );
 }
+
+TEST_F( BatchLoaderTest, numThreadsAccessTest ) {
+    BatchLoader loader( m_io );
+    EXPECT_EQ( 1u, loader.getNumThreads() );
+    loader.setNumThreads( 4 );
+    EXPECT_EQ( 4u, loader.getNumThreads() );
+}
+
+TEST_F( BatchLoaderTest, dedupRequestsTest ) {
+    BatchLoader loader( m_io );
+    BatchLoader::PropertyMap props;
+    SetGenericProperty( props.ints, AI_CONFIG_PP_SBP_REMOVE, 1 );
+
+    const unsigned int plain = loader.AddLoadRequest( "box.obj" );
+    EXPECT_EQ( plain, loader.AddLoadRequest( "box.obj" ) );
+    EXPECT_NE( plain, loader.AddLoadRequest( "box.obj", aiProcess_Triangulate ) );
+    EXPECT_NE( plain, loader.AddLoadRequest( "box.obj", 0, &props ) );
+    EXPECT_EQ( loader.AddLoadRequest( "box.obj", 0, &props ), loader.AddLoadRequest( "box.obj", 0, &props ) );
+}
+
+TEST_F( BatchLoaderTest, loadAllThreadedTest ) {
+    static const char *files[] = {
+        ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj",
+        ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply",
+        ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl",
+        ASSIMP_TEST_MODELS_DIR "/OFF/Cube.off",
+        ASSIMP_TEST_MODELS_DIR "/OFF/doesnotexist.off"
+    };
+    const size_t numFiles = sizeof( files ) / sizeof( files[ 0 ] );
+
+    // the same requests loaded on the calling thread and on three threads
+    DefaultIOSystem io;
+    BatchLoader serial( &io, true ), threaded( &io, true );
+    threaded.setNumThreads( 3 );
+    std::vector<unsigned int> serialIds, threadedIds;
+    for ( const char *file : files ) {
+        serialIds.push_back( serial.AddLoadRequest( file, aiProcess_Triangulate ) );
+        threadedIds.push_back( threaded.AddLoadRequest( file, aiProcess_Triangulate ) );
+    }
+    serial.LoadAll();
+    threaded.LoadAll();
+
+    for ( size_t i = 0; i < numFiles; ++i ) {
+        std::unique_ptr<aiScene> expected( serial.GetImport( serialIds[ i ] ) );
+        std::unique_ptr<aiScene> actual( threaded.GetImport( threadedIds[ i ] ) );
+        if ( i + 1 == numFiles ) {
+            EXPECT_EQ( nullptr, expected );
+            EXPECT_EQ( nullptr, actual );
+            continue;
+        }
+        ASSERT_NE( nullptr, expected );
+        ASSERT_NE( nullptr, actual );
+        ASSERT_EQ( expected->mNumMeshes, actual->mNumMeshes );
+        for ( unsigned int m = 0; m < expected->mNumMeshes; ++m ) {
+            EXPECT_EQ( expected->mMeshes[ m ]->mNumVertices, actual->mMeshes[ m ]->mNumVertices );
+            EXPECT_EQ( expected->mMeshes[ m ]->mNumFaces, actual->mMeshes[ m ]->mNumFaces );
+        }
+    }
+}
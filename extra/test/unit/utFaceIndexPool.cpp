@@ -0,0 +1,149 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+using namespace Assimp;
+
+class FaceIndexPoolTest : public ::testing::Test {
+protected:
+    static void ExpectSameFaces(const aiMesh *expected, const aiMesh *actual) {
+        ASSERT_EQ(expected->mNumFaces, actual->mNumFaces);
+        for (unsigned int i = 0; i < expected->mNumFaces; ++i) {
+            const aiFace &a = expected->mFaces[i], &b = actual->mFaces[i];
+            ASSERT_EQ(a.mNumIndices, b.mNumIndices);
+            for (unsigned int n = 0; n < a.mNumIndices; ++n) {
+                EXPECT_EQ(a.mIndices[n], b.mIndices[n]);
+            }
+        }
+    }
+
+    static void ExpectPooled(const aiMesh *mesh) {
+        ASSERT_NE(nullptr, mesh->mFaceIndices);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            const aiFace &face = mesh->mFaces[i];
+            if (face.mNumIndices) {
+                EXPECT_TRUE(mesh->IsPooledFaceIndices(face.mIndices));
+                EXPECT_TRUE(mesh->IsPooledFaceIndices(face.mIndices + face.mNumIndices - 1));
+            }
+        }
+    }
+
+    static void CheckImport(const char *file, unsigned int flags) {
+        Importer regular, pooled;
+        pooled.SetPropertyBool(AI_CONFIG_IMPORT_FACE_INDEX_POOL, true);
+        const aiScene *expected = regular.ReadFile(file, flags);
+        const aiScene *actual = pooled.ReadFile(file, flags);
+        ASSERT_NE(nullptr, expected);
+        ASSERT_NE(nullptr, actual);
+        ASSERT_EQ(expected->mNumMeshes, actual->mNumMeshes);
+        for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+            EXPECT_EQ(nullptr, expected->mMeshes[i]->mFaceIndices);
+            ExpectPooled(actual->mMeshes[i]);
+            ExpectSameFaces(expected->mMeshes[i], actual->mMeshes[i]);
+        }
+    }
+};
+
+TEST_F(FaceIndexPoolTest, poolExistingFaces) {
+    aiMesh mesh;
+    mesh.mNumFaces = 3;
+    mesh.mFaces = new aiFace[3];
+    for (unsigned int i = 0; i < 3; ++i) {
+        mesh.mFaces[i].mNumIndices = i + 1;
+        mesh.mFaces[i].mIndices = new unsigned int[i + 1];
+        for (unsigned int n = 0; n <= i; ++n) {
+            mesh.mFaces[i].mIndices[n] = i * 10 + n;
+        }
+    }
+
+    mesh.PoolFaceIndices();
+    ASSERT_EQ(6u, mesh.mNumFaceIndices);
+    ExpectPooled(&mesh);
+    for (unsigned int i = 0; i < 3; ++i) {
+        ASSERT_EQ(i + 1, mesh.mFaces[i].mNumIndices);
+        for (unsigned int n = 0; n <= i; ++n) {
+            EXPECT_EQ(i * 10 + n, mesh.mFaces[i].mIndices[n]);
+        }
+    }
+}
+
+TEST_F(FaceIndexPoolTest, importPLY) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/PLY/cube_binary.ply", aiProcess_Triangulate | aiProcess_SortByPType);
+}
+
+TEST_F(FaceIndexPoolTest, importSTL) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_JoinIdenticalVertices);
+}
+
+TEST_F(FaceIndexPoolTest, importOBJ) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate | aiProcess_SplitLargeMeshes);
+}
+
+TEST_F(FaceIndexPoolTest, importGLTF2) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", aiProcess_PreTransformVertices);
+}
+
+TEST_F(FaceIndexPoolTest, importFBX) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/FBX/box.fbx", aiProcess_Triangulate | aiProcess_OptimizeMeshes);
+}
+
+TEST_F(FaceIndexPoolTest, copyPooledScene) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FACE_INDEX_POOL, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+
+    aiScene *copy = nullptr;
+    SceneCombiner::CopyScene(&copy, scene);
+    ASSERT_NE(nullptr, copy);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        ExpectPooled(copy->mMeshes[i]);
+        EXPECT_NE(scene->mMeshes[i]->mFaceIndices, copy->mMeshes[i]->mFaceIndices);
+        ExpectSameFaces(scene->mMeshes[i], copy->mMeshes[i]);
+    }
+    delete copy;
+}
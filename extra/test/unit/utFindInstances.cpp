@@ -0,0 +1,132 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/FindInstancesProcess.h"
+
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class FindInstancesProcessTest : public ::testing::Test {
+protected:
+    // A quad made of two triangles, moved by offset
+    static aiMesh *CreateQuad(const aiVector3D &offset, unsigned int materialIndex) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mMaterialIndex = materialIndex;
+        mesh->mNumVertices = 6;
+        mesh->mVertices = new aiVector3D[6];
+        const aiVector3D corners[] = { aiVector3D(0, 0, 0), aiVector3D(1, 0, 0), aiVector3D(1, 1, 0),
+            aiVector3D(0, 0, 0), aiVector3D(1, 1, 0), aiVector3D(0, 1, 0) };
+        for (unsigned int i = 0; i < 6; ++i) {
+            mesh->mVertices[i] = corners[i] + offset;
+        }
+        mesh->mNumFaces = 2;
+        mesh->mFaces = new aiFace[2];
+        for (unsigned int f = 0; f < 2; ++f) {
+            mesh->mFaces[f].mNumIndices = 3;
+            mesh->mFaces[f].mIndices = new unsigned int[3];
+            for (unsigned int n = 0; n < 3; ++n) {
+                mesh->mFaces[f].mIndices[n] = f * 3 + n;
+            }
+        }
+        return mesh;
+    }
+
+    static aiScene *CreateScene(std::vector<aiMesh *> &meshes) {
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+        scene->mMeshes = new aiMesh *[meshes.size()];
+        std::copy(meshes.begin(), meshes.end(), scene->mMeshes);
+        scene->mRootNode = new aiNode();
+        scene->mRootNode->mNumMeshes = scene->mNumMeshes;
+        scene->mRootNode->mMeshes = new unsigned int[scene->mNumMeshes];
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            scene->mRootNode->mMeshes[i] = i;
+        }
+        return scene;
+    }
+};
+
+TEST_F(FindInstancesProcessTest, findInstancesTest) {
+    std::vector<aiMesh *> meshes;
+    meshes.push_back(CreateQuad(aiVector3D(0, 0, 0), 0));
+    meshes.push_back(CreateQuad(aiVector3D(5, 0, 0), 0));
+    // equal to the first one within the epsilon
+    meshes.push_back(CreateQuad(aiVector3D(1e-6f, 0, 0), 0));
+    // same geometry, other material
+    meshes.push_back(CreateQuad(aiVector3D(0, 0, 0), 1));
+    meshes.push_back(CreateQuad(aiVector3D(5, 0, 0), 0));
+    aiScene *scene = CreateScene(meshes);
+
+    FindInstancesProcess process;
+    process.Execute(scene);
+
+    EXPECT_EQ(3u, scene->mNumMeshes);
+    const unsigned int expected[] = { 0, 1, 0, 2, 1 };
+    for (unsigned int i = 0; i < 5; ++i) {
+        EXPECT_EQ(expected[i], scene->mRootNode->mMeshes[i]);
+    }
+    delete scene;
+}
+
+TEST_F(FindInstancesProcessTest, manyMeshesTest) {
+    // A grid of distinct quads, every one of them used twice
+    static const unsigned int NumQuads = 2000;
+    std::vector<aiMesh *> meshes;
+    for (unsigned int pass = 0; pass < 2; ++pass) {
+        for (unsigned int i = 0; i < NumQuads; ++i) {
+            meshes.push_back(CreateQuad(aiVector3D((float)(i % 50) * 2.0f, (float)(i / 50) * 2.0f, 0), 0));
+        }
+    }
+    aiScene *scene = CreateScene(meshes);
+
+    FindInstancesProcess process;
+    process.Execute(scene);
+
+    EXPECT_EQ(NumQuads, scene->mNumMeshes);
+    for (unsigned int i = 0; i < NumQuads; ++i) {
+        EXPECT_EQ(i, scene->mRootNode->mMeshes[i]);
+        EXPECT_EQ(i, scene->mRootNode->mMeshes[i + NumQuads]);
+    }
+    delete scene;
+}
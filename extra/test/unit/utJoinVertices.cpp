@@ -140,3 +140,50 @@ TEST_F(utJoinVertices, testProcess) {
     }
     EXPECT_EQ(150.f * 299.f * 3.f, fSum); // gaussian sum equation
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utJoinVertices, toleranceAndUnusedVertices) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mNumVertices = 6;
+    mesh->mVertices = new aiVector3D[6];
+    mesh->mNormals = new aiVector3D[6];
+    for (unsigned int i = 0; i < 6; ++i) {
+        mesh->mNormals[i] = aiVector3D(0.f, 0.f, 1.f);
+    }
+
+    // 0 and 1 only differ by the sign of zero, 2 by less than the tolerance in the normal
+    mesh->mVertices[0] = aiVector3D(0.f, 1.f, 2.f);
+    mesh->mVertices[1] = aiVector3D(-0.f, 1.f, 2.f);
+    mesh->mVertices[2] = aiVector3D(0.f, 1.f, 2.f);
+    mesh->mNormals[2] = aiVector3D(0.f, 1e-7f, 1.f);
+    // same position as 0 but a different normal
+    mesh->mVertices[3] = aiVector3D(0.f, 1.f, 2.f);
+    mesh->mNormals[3] = aiVector3D(1.f, 0.f, 0.f);
+    // 4 is not referenced by any face
+    mesh->mVertices[4] = aiVector3D(5.f, 5.f, 5.f);
+    mesh->mVertices[5] = aiVector3D(6.f, 6.f, 6.f);
+
+    const unsigned int indices[6] = { 0, 1, 2, 3, 5, 0 };
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        aiFace &face = mesh->mFaces[i];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        for (unsigned int a = 0; a < 3; ++a) {
+            face.mIndices[a] = indices[3 * i + a];
+        }
+    }
+
+    EXPECT_EQ(3, piProcess->ProcessMesh(mesh, 0));
+    ASSERT_EQ(3U, mesh->mNumVertices);
+    EXPECT_EQ(0U, mesh->mFaces[0].mIndices[0]);
+    EXPECT_EQ(0U, mesh->mFaces[0].mIndices[1]);
+    EXPECT_EQ(0U, mesh->mFaces[0].mIndices[2]);
+    EXPECT_EQ(1U, mesh->mFaces[1].mIndices[0]);
+    EXPECT_EQ(2U, mesh->mFaces[1].mIndices[1]);
+    EXPECT_EQ(0U, mesh->mFaces[1].mIndices[2]);
+    EXPECT_EQ(aiVector3D(1.f, 0.f, 0.f), mesh->mNormals[1]);
+    EXPECT_EQ(aiVector3D(6.f, 6.f, 6.f), mesh->mVertices[2]);
+
+    delete mesh;
+}
@@ -0,0 +1,170 @@
+/*-------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+-------------------------------------------------------------------------*/
+#include "UnitTestPCH.h"
+
+#include "AssetLib/glTF2/glTF2Asset.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/Importer.hpp>
+#include <assimp/MMapIOSystem.h>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utMMapIOSystem : public ::testing::Test {
+protected:
+    // Imports the file once through fread() and once through the mapping
+    static void ExpectSameScene(const char *file) {
+        Importer reference;
+        const aiScene *expected = reference.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, expected) << file;
+
+        Importer mapped;
+        mapped.SetIOHandler(new MMapIOSystem);
+        const aiScene *scene = mapped.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, scene) << file;
+
+        ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes) << file;
+        EXPECT_EQ(expected->mNumMaterials, scene->mNumMaterials) << file;
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *a = expected->mMeshes[i];
+            const aiMesh *b = scene->mMeshes[i];
+            ASSERT_EQ(a->mNumVertices, b->mNumVertices) << file;
+            ASSERT_EQ(a->mNumFaces, b->mNumFaces) << file;
+            for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+                EXPECT_EQ(a->mVertices[v], b->mVertices[v]) << file;
+            }
+        }
+    }
+};
+
+TEST_F(utMMapIOSystem, streamTest) {
+    const char *file = ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl";
+
+    DefaultIOSystem reference;
+    std::unique_ptr<IOStream> in(reference.Open(file, "rb"));
+    ASSERT_NE(nullptr, in);
+    std::vector<uint8_t> contents(in->FileSize());
+    ASSERT_EQ(1u, in->Read(contents.data(), contents.size(), 1));
+    EXPECT_EQ(nullptr, in->GetMappedData());
+
+    MMapIOSystem io;
+    std::unique_ptr<IOStream> stream(io.Open(file, "rb"));
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(contents.size(), stream->FileSize());
+    const uint8_t *data = stream->GetMappedData();
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(0, memcmp(contents.data(), data, contents.size()));
+
+    uint8_t header[84];
+    EXPECT_EQ(1u, stream->Read(header, sizeof(header), 1));
+    EXPECT_EQ(sizeof(header), stream->Tell());
+    EXPECT_EQ(0, memcmp(contents.data(), header, sizeof(header)));
+
+    // reads stop at the end of the file
+    EXPECT_EQ(AI_SUCCESS, stream->Seek(10, aiOrigin_END));
+    EXPECT_EQ(0u, stream->Read(header, 20, 1));
+    EXPECT_EQ(10u, stream->Read(header, 1, 20));
+    EXPECT_EQ(AI_FAILURE, stream->Seek(1, aiOrigin_CUR));
+    EXPECT_EQ(AI_FAILURE, stream->Seek(contents.size() + 1, aiOrigin_SET));
+    EXPECT_EQ(0u, stream->Write(header, 1, 1));
+
+    // the mapping does not move with the cursor
+    EXPECT_EQ(data, stream->GetMappedData());
+
+    // text mode and missing files are not mapped
+    std::unique_ptr<IOStream> text(io.Open(file, "rt"));
+    ASSERT_NE(nullptr, text);
+    EXPECT_EQ(nullptr, text->GetMappedData());
+    EXPECT_EQ(nullptr, io.Open(ASSIMP_TEST_MODELS_DIR "/STL/does_not_exist.stl", "rb"));
+}
+
+TEST_F(utMMapIOSystem, importFromMappingTest) {
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/PLY/cube_binary.ply");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/PLY/cube_binary_header_with_RN_newline.ply");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/PLY/cube.ply");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF-Binary/BoxTextured.glb");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/FBX/boxWithCompressedCTypeArray.FBX");
+    ExpectSameScene(ASSIMP_TEST_MODELS_DIR "/FBX/embedded_ascii/box.FBX");
+}
+
+TEST_F(utMMapIOSystem, importFromMemoryTest) {
+    // ReadFileFromMemory() hands the loaders the caller's buffer the same way
+    DefaultIOSystem reference;
+    std::unique_ptr<IOStream> in(reference.Open(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", "rb"));
+    ASSERT_NE(nullptr, in);
+    std::vector<uint8_t> contents(in->FileSize());
+    ASSERT_EQ(1u, in->Read(contents.data(), contents.size(), 1));
+
+    Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(contents.data(), contents.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_LT(0u, scene->mNumMeshes);
+}
+
+#if !defined(ASSIMP_BUILD_NO_GLTF_IMPORTER) && !defined(ASSIMP_BUILD_NO_GLTF2_IMPORTER)
+TEST_F(utMMapIOSystem, glTF2BufferAliasIsReadOnly) {
+    // A glTF2 buffer reads the caller's memory in place, writing to it goes to a copy
+    std::vector<uint8_t> contents = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    std::shared_ptr<IOStream> stream = std::make_shared<MemoryIOStream>(contents.data(), contents.size());
+
+    glTF2::Buffer buffer;
+    ASSERT_TRUE(buffer.LoadFromStream(stream, 4, 2));
+    EXPECT_EQ(contents.data() + 2, buffer.GetData());
+
+    uint8_t *writable = buffer.GetPointer();
+    ASSERT_NE(nullptr, writable);
+    EXPECT_NE(contents.data() + 2, writable);
+    writable[0] = 42;
+    EXPECT_EQ(3u, contents[2]);
+    EXPECT_EQ(42u, buffer.GetData()[0]);
+    EXPECT_EQ(4u, buffer.GetData()[1]);
+}
+#endif
@@ -217,6 +217,109 @@ TEST_F(MaterialSystemTest, testCastSmallFloatProperty) {
     EXPECT_EQ(false, valBool);
 }
 
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testIndexedLookupMatchesScan) {
+    // "k1" is a prefix of "k10" ... "k19", lookups match keys by prefix
+    for (int i = 0; i < 40; ++i) {
+        const std::string key = "k" + std::to_string(i);
+        EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&i, 1, key.c_str(), i % 3, i % 2));
+    }
+
+    const char *queries[] = { "k0", "k1", "k10", "k19", "k25", "k39", "k4", "k40", "k", "x" };
+    for (const char *query : queries) {
+        for (unsigned int type : { 0u, 1u, 2u, UINT_MAX }) {
+            for (unsigned int index : { 0u, 1u, UINT_MAX }) {
+                const aiMaterialProperty *expected = nullptr;
+                for (unsigned int i = 0; i < pcMat->mNumProperties && !expected; ++i) {
+                    const aiMaterialProperty *prop = pcMat->mProperties[i];
+                    if (0 == strncmp(prop->mKey.data, query, strlen(query)) && (UINT_MAX == type || prop->mSemantic == type) &&
+                            (UINT_MAX == index || prop->mIndex == index)) {
+                        expected = prop;
+                    }
+                }
+
+                const aiMaterialProperty *prop = nullptr;
+                EXPECT_EQ(expected ? AI_SUCCESS : AI_FAILURE, aiGetMaterialProperty(pcMat, query, type, index, &prop));
+                EXPECT_EQ(expected, prop) << query << " " << type << " " << index;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testIndexedLookupAfterChanges) {
+    for (int i = 0; i < 20; ++i) {
+        const std::string key = "$mat.key" + std::to_string(i);
+        EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&i, 1, key.c_str()));
+    }
+    int value = 0;
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$mat.key7", 0, 0, value));
+    EXPECT_EQ(7, value);
+
+    // overwrite, remove and add through the member functions
+    value = 70;
+    EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&value, 1, "$mat.key7"));
+    EXPECT_EQ(AI_SUCCESS, pcMat->RemoveProperty("$mat.key8"));
+    value = 20;
+    EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&value, 1, "$mat.key20"));
+
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$mat.key7", 0, 0, value));
+    EXPECT_EQ(70, value);
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$mat.key8", 0, 0, value));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$mat.key20", 0, 0, value));
+    EXPECT_EQ(20, value);
+
+    // drop the last property behind the back of the material
+    delete pcMat->mProperties[--pcMat->mNumProperties];
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$mat.key20", 0, 0, value));
+
+    // replace a property in place
+    aiMaterialProperty *prop = new aiMaterialProperty();
+    prop->mKey.Set("$mat.other");
+    prop->mType = aiPTI_Integer;
+    prop->mDataLength = sizeof(int);
+    prop->mData = new char[sizeof(int)];
+    memcpy(prop->mData, &value, sizeof(int));
+    delete pcMat->mProperties[3];
+    pcMat->mProperties[3] = prop;
+    pcMat->InvalidatePropertyIndex();
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$mat.other", 0, 0, value));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$mat.key3", 0, 0, value));
+
+    pcMat->Clear();
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$mat.key1", 0, 0, value));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testGetPBR) {
+    aiMaterialPBR pbr;
+    EXPECT_EQ(AI_FAILURE, pcMat->GetPBR(pbr));
+    EXPECT_EQ(0u, pbr.mFlags);
+    EXPECT_EQ(aiColor4D(1.0, 1.0, 1.0, 1.0), pbr.mBaseColor);
+    EXPECT_EQ(1.0, pbr.mRoughnessFactor);
+
+    const aiColor3D base(0.5f, 0.25f, 0.125f);
+    const ai_real metallic = 0.75f, roughness = 0.5f, texture = 0.1f;
+    const int twoSided = 1;
+    pcMat->AddProperty(&texture, 1, AI_MATKEY_TEXTURE_DIFFUSE(0));
+    pcMat->AddProperty(&texture, 1, "$mat.metallicFactor", aiTextureType_DIFFUSE, 0);
+    pcMat->AddProperty(&base, 1, AI_MATKEY_BASE_COLOR);
+    pcMat->AddProperty(&metallic, 1, AI_MATKEY_METALLIC_FACTOR);
+    pcMat->AddProperty(&roughness, 1, AI_MATKEY_ROUGHNESS_FACTOR);
+    pcMat->AddProperty(&twoSided, 1, AI_MATKEY_TWOSIDED);
+
+    EXPECT_EQ(AI_SUCCESS, pcMat->GetPBR(pbr));
+    EXPECT_EQ(unsigned(aiMaterialPBRFlags_BaseColor | aiMaterialPBRFlags_Metallic |
+                       aiMaterialPBRFlags_Roughness | aiMaterialPBRFlags_TwoSided),
+            pbr.mFlags);
+    EXPECT_EQ(aiColor4D(0.5f, 0.25f, 0.125f, 1.0f), pbr.mBaseColor);
+    EXPECT_EQ(metallic, pbr.mMetallicFactor);
+    EXPECT_EQ(roughness, pbr.mRoughnessFactor);
+    EXPECT_EQ(1, pbr.mTwoSided);
+    EXPECT_EQ(aiColor4D(0.0, 0.0, 0.0, 1.0), pbr.mEmissiveColor);
+    EXPECT_EQ(1.0, pbr.mOpacity);
+}
+
 // ------------------------------------------------------------------------------------------------
 #if defined(_MSC_VER)
 // Refuse to compile on Windows if any enum values are not explicitly handled in the switch
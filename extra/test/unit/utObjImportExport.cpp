@@ -526,6 +526,44 @@ TEST_F(utObjImportExport, import_with_line_continuations) {
     EXPECT_NEAR(vertices[2].z, -0.5f, threshold);
 }
 
+TEST_F(utObjImportExport, faces_of_different_size_Test) {
+    static const char *curObjModel =
+            "v 0 0 0\n"
+            "v 1 0 0\n"
+            "v 1 1 0\n"
+            "v 0 1 0\n"
+            "vt 0 0\n"
+            "vt 1 0\n"
+            "vt 1 1\n"
+            "vt 0 1\n"
+            "vn 0 0 1\n"
+            "vn 0 0 -1\n"
+            "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+            "f 4/4/2 3/3/2 1/1/2\n";
+
+    Assimp::Importer myImporter;
+    const aiScene *scene = myImporter.ReadFileFromMemory(curObjModel, strlen(curObjModel), aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(scene->mNumMeshes, 1U);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(mesh->mNumFaces, 2U);
+    ASSERT_EQ(mesh->mNumVertices, 7U);
+    EXPECT_EQ(mesh->mFaces[0].mNumIndices, 4U);
+    EXPECT_EQ(mesh->mFaces[1].mNumIndices, 3U);
+    ASSERT_NE(nullptr, mesh->mNormals);
+    ASSERT_NE(nullptr, mesh->mTextureCoords[0]);
+
+    // the second face starts after the four indices of the first one
+    EXPECT_EQ(aiVector3D(0, 1, 0), mesh->mVertices[4]);
+    EXPECT_EQ(aiVector3D(1, 1, 0), mesh->mVertices[5]);
+    EXPECT_EQ(aiVector3D(0, 0, 0), mesh->mVertices[6]);
+    EXPECT_EQ(aiVector3D(0, 0, 1), mesh->mNormals[3]);
+    EXPECT_EQ(aiVector3D(0, 0, -1), mesh->mNormals[4]);
+    EXPECT_EQ(aiVector3D(1, 1, 0), mesh->mTextureCoords[0][5]);
+    EXPECT_EQ(aiVector3D(0, 0, 0), mesh->mTextureCoords[0][6]);
+}
+
 TEST_F(utObjImportExport, issue2355_mtl_texture_prefix) {
     ::Assimp::Importer importer;
     const aiScene *const scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/mtl_different_folder.obj", aiProcess_ValidateDataStructure);
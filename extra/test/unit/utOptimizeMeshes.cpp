@@ -0,0 +1,200 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/OptimizeMeshes.h"
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class OptimizeMeshesTest : public ::testing::Test {
+protected:
+    class ThreadedProcess : public OptimizeMeshesProcess {
+    public:
+        explicit ThreadedProcess(unsigned int numThreads) {
+            mNumThreads = numThreads;
+        }
+    };
+
+    // A mesh of numTris separate triangles, or points if numTris is 0
+    static aiMesh *MakeMesh(unsigned int material, unsigned int numTris, bool normals = false) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mMaterialIndex = material;
+        mesh->mPrimitiveTypes = numTris ? aiPrimitiveType_TRIANGLE : aiPrimitiveType_POINT;
+        const unsigned int perFace = numTris ? 3 : 1;
+        mesh->mNumFaces = numTris ? numTris : 3;
+        mesh->mNumVertices = mesh->mNumFaces * perFace;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        if (normals) {
+            mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+        }
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            aiFace &face = mesh->mFaces[i];
+            face.mNumIndices = perFace;
+            face.mIndices = new unsigned int[perFace];
+            for (unsigned int n = 0; n < perFace; ++n) {
+                face.mIndices[n] = i * perFace + n;
+            }
+        }
+        return mesh;
+    }
+
+    static aiNode *MakeNode(aiNode *parent, std::initializer_list<unsigned int> meshes) {
+        aiNode *node = new aiNode();
+        node->mNumMeshes = static_cast<unsigned int>(meshes.size());
+        node->mMeshes = new unsigned int[meshes.size()];
+        std::copy(meshes.begin(), meshes.end(), node->mMeshes);
+        if (parent) {
+            parent->addChildren(1, &node);
+        }
+        return node;
+    }
+
+    static aiScene *MakeScene(std::initializer_list<aiMesh *> meshes) {
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+        scene->mMeshes = new aiMesh *[meshes.size()];
+        std::copy(meshes.begin(), meshes.end(), scene->mMeshes);
+        return scene;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeMeshesTest, joinsMeshesOfNodeByMaterial) {
+    for (unsigned int numThreads : { 1u, 4u }) {
+        aiScene *scene = MakeScene({ MakeMesh(0, 1), MakeMesh(1, 2), MakeMesh(0, 1), MakeMesh(1, 1), MakeMesh(0, 1), MakeMesh(0, 1) });
+        scene->mRootNode = MakeNode(nullptr, { 0, 1, 2, 3, 4 });
+        aiNode *child = MakeNode(scene->mRootNode, { 5 });
+
+        ThreadedProcess process(numThreads);
+        process.Execute(scene);
+
+        // meshes of different nodes are never joined
+        ASSERT_EQ(3u, scene->mNumMeshes);
+        ASSERT_EQ(2u, scene->mRootNode->mNumMeshes);
+        EXPECT_EQ(0u, scene->mRootNode->mMeshes[0]);
+        EXPECT_EQ(1u, scene->mRootNode->mMeshes[1]);
+        ASSERT_EQ(1u, child->mNumMeshes);
+        EXPECT_EQ(2u, child->mMeshes[0]);
+
+        const aiMesh *joined = scene->mMeshes[0];
+        EXPECT_EQ(0u, joined->mMaterialIndex);
+        EXPECT_EQ(9u, joined->mNumVertices);
+        ASSERT_EQ(3u, joined->mNumFaces);
+        for (unsigned int i = 0; i < joined->mNumFaces; ++i) {
+            for (unsigned int n = 0; n < 3; ++n) {
+                EXPECT_EQ(i * 3 + n, joined->mFaces[i].mIndices[n]);
+            }
+        }
+        EXPECT_EQ(1u, scene->mMeshes[1]->mMaterialIndex);
+        EXPECT_EQ(3u, scene->mMeshes[1]->mNumFaces);
+        EXPECT_EQ(1u, scene->mMeshes[2]->mNumFaces);
+        delete scene;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeMeshesTest, keepsVertexFormatsApart) {
+    aiScene *scene = MakeScene({ MakeMesh(0, 1), MakeMesh(0, 1, true), MakeMesh(0, 1) });
+    scene->mRootNode = MakeNode(nullptr, { 0, 1, 2 });
+
+    OptimizeMeshesProcess process;
+    process.Execute(scene);
+
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    EXPECT_EQ(nullptr, scene->mMeshes[0]->mNormals);
+    EXPECT_EQ(2u, scene->mMeshes[0]->mNumFaces);
+    EXPECT_NE(nullptr, scene->mMeshes[1]->mNormals);
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeMeshesTest, respectsSizeLimit) {
+    aiScene *scene = MakeScene({ MakeMesh(0, 1), MakeMesh(0, 1), MakeMesh(0, 1), MakeMesh(0, 1), MakeMesh(0, 1) });
+    scene->mRootNode = MakeNode(nullptr, { 0, 1, 2, 3, 4 });
+
+    OptimizeMeshesProcess process;
+    process.SetPreferredMeshSizeLimit(6, 100);
+    process.Execute(scene);
+
+    ASSERT_EQ(3u, scene->mNumMeshes);
+    EXPECT_EQ(6u, scene->mMeshes[0]->mNumVertices);
+    EXPECT_EQ(6u, scene->mMeshes[1]->mNumVertices);
+    EXPECT_EQ(3u, scene->mMeshes[2]->mNumVertices);
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeMeshesTest, keepsInstancedMeshes) {
+    aiMesh *instanced = MakeMesh(0, 1);
+    aiScene *scene = MakeScene({ instanced, MakeMesh(0, 1), MakeMesh(0, 1) });
+    scene->mRootNode = MakeNode(nullptr, { 1, 0, 2 });
+    aiNode *child = MakeNode(scene->mRootNode, { 0 });
+
+    OptimizeMeshesProcess process;
+    process.Execute(scene);
+
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    EXPECT_EQ(instanced, scene->mMeshes[0]);
+    ASSERT_EQ(2u, scene->mRootNode->mNumMeshes);
+    EXPECT_EQ(1u, scene->mRootNode->mMeshes[0]);
+    EXPECT_EQ(0u, scene->mRootNode->mMeshes[1]);
+    EXPECT_EQ(2u, scene->mMeshes[1]->mNumFaces);
+    ASSERT_EQ(1u, child->mNumMeshes);
+    EXPECT_EQ(0u, child->mMeshes[0]);
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(OptimizeMeshesTest, primitiveTypeSorting) {
+    for (bool sorting : { false, true }) {
+        aiScene *scene = MakeScene({ MakeMesh(0, 1), MakeMesh(0, 0), MakeMesh(0, 1) });
+        scene->mRootNode = MakeNode(nullptr, { 0, 1, 2 });
+
+        OptimizeMeshesProcess process;
+        process.EnablePrimitiveTypeSorting(sorting);
+        process.Execute(scene);
+
+        EXPECT_EQ(sorting ? 2u : 1u, scene->mNumMeshes);
+        delete scene;
+    }
+}
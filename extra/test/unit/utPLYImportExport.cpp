@@ -45,6 +45,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/PointBatchHandler.hpp>
+
+#include <fstream>
+#include <string>
 
 using namespace ::Assimp;
 
@@ -282,3 +286,164 @@ TEST_F(utPLYImportExport, parseInvalidDoubleCustomProperty) {
     const aiScene *scene = importer.ReadFileFromMemory(data, sizeof(data), 0);
     EXPECT_EQ(nullptr, scene);
 }
+
+// Binary PLY with numVertices vertices (float x y z, uchar red green blue) and,
+// if requested, numVertices / 3 triangles. The last face is a quad if withQuad is set.
+static std::string MakeBinaryPly(bool bigEndian, unsigned int numVertices, bool withFaces, bool withQuad = false) {
+    const unsigned int numFaces = withFaces ? numVertices / 3 : 0;
+    std::string ply = std::string("ply\nformat ") + (bigEndian ? "binary_big_endian" : "binary_little_endian") + " 1.0\n";
+    ply += "element vertex " + std::to_string(numVertices) + "\n";
+    ply += "property float x\nproperty float y\nproperty float z\n";
+    ply += "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    if (withFaces) {
+        ply += "element face " + std::to_string(numFaces) + "\n";
+        ply += "property list uchar int vertex_indices\n";
+    }
+    ply += "end_header\n";
+
+    const uint16_t probe = 1;
+    const bool hostIsBigEndian = *reinterpret_cast<const uint8_t *>(&probe) == 0;
+    auto append = [&](const void *value, size_t size) {
+        const char *bytes = static_cast<const char *>(value);
+        for (size_t i = 0; i < size; ++i) {
+            ply += bytes[bigEndian != hostIsBigEndian ? size - 1 - i : i];
+        }
+    };
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const float position[3] = { static_cast<float>(i), -0.5f * i, 1.0f };
+        for (float f : position) {
+            append(&f, sizeof(f));
+        }
+        ply += static_cast<char>(i % 256);
+        ply += static_cast<char>((i * 7) % 256);
+        ply += static_cast<char>(255);
+    }
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        const bool quad = withQuad && i + 1 == numFaces;
+        ply += static_cast<char>(quad ? 4 : 3);
+        for (int32_t index = 3 * i; index < static_cast<int32_t>(3 * i + (quad ? 4 : 3)); ++index) {
+            const int32_t wrapped = index % static_cast<int32_t>(numVertices);
+            append(&wrapped, sizeof(wrapped));
+        }
+    }
+    return ply;
+}
+
+static void ExpectBinaryPlyVertex(const aiVector3D &position, const aiColor4D &color, unsigned int i) {
+    EXPECT_EQ(static_cast<ai_real>(i), position.x);
+    EXPECT_EQ(static_cast<ai_real>(-0.5f * i), position.y);
+    EXPECT_EQ(1.0f, position.z);
+    EXPECT_EQ(static_cast<ai_real>(i % 256) / static_cast<ai_real>(0xFF), color.r);
+    EXPECT_EQ(static_cast<ai_real>((i * 7) % 256) / static_cast<ai_real>(0xFF), color.g);
+    EXPECT_EQ(1.0f, color.b);
+    EXPECT_EQ(1.0f, color.a);
+}
+
+TEST_F(utPLYImportExport, binaryBatchesAndThreadsTest) {
+    // more than one batch of vertices and, with three threads, more than one window of faces
+    const unsigned int numVertices = 3 * 70000;
+    for (bool bigEndian : { false, true }) {
+        const std::string ply = MakeBinaryPly(bigEndian, numVertices, true);
+        for (int numThreads : { 1, 3 }) {
+            Assimp::Importer importer;
+            importer.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, numThreads);
+            const aiScene *scene = importer.ReadFileFromMemory(ply.data(), ply.size(), aiProcess_ValidateDataStructure);
+            ASSERT_NE(nullptr, scene);
+            ASSERT_EQ(1u, scene->mNumMeshes);
+            const aiMesh *mesh = scene->mMeshes[0];
+            ASSERT_EQ(numVertices, mesh->mNumVertices);
+            ASSERT_EQ(numVertices / 3, mesh->mNumFaces);
+            ASSERT_TRUE(mesh->HasVertexColors(0));
+            for (unsigned int i = 0; i < numVertices; i += 997) {
+                ExpectBinaryPlyVertex(mesh->mVertices[i], mesh->mColors[0][i], i);
+            }
+            ExpectBinaryPlyVertex(mesh->mVertices[numVertices - 1], mesh->mColors[0][numVertices - 1], numVertices - 1);
+            for (unsigned int i = 0; i < mesh->mNumFaces; i += 991) {
+                ASSERT_EQ(3u, mesh->mFaces[i].mNumIndices);
+                EXPECT_EQ(3 * i, mesh->mFaces[i].mIndices[0]);
+                EXPECT_EQ(3 * i + 2, mesh->mFaces[i].mIndices[2]);
+            }
+        }
+    }
+}
+
+TEST_F(utPLYImportExport, binaryMixedFacesFromFileTest) {
+    // read from disk block by block instead of from memory, the last face is a quad
+    const unsigned int numVertices = 3 * 70000;
+    const std::string ply = MakeBinaryPly(true, numVertices, true, true);
+    const char *fileName = ASSIMP_TEST_MODELS_DIR "/PLY/mixed_faces_out.ply";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file.write(ply.data(), ply.size());
+    }
+
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 2);
+    const aiScene *scene = importer.ReadFile(fileName, 0);
+    ASSERT_NE(nullptr, scene);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(numVertices, mesh->mNumVertices);
+    ASSERT_EQ(numVertices / 3, mesh->mNumFaces);
+    ExpectBinaryPlyVertex(mesh->mVertices[123457], mesh->mColors[0][123457], 123457);
+    EXPECT_EQ(3u, mesh->mFaces[0].mNumIndices);
+    EXPECT_EQ(3u, mesh->mFaces[mesh->mNumFaces - 2].mNumIndices);
+    const aiFace &quad = mesh->mFaces[mesh->mNumFaces - 1];
+    ASSERT_EQ(4u, quad.mNumIndices);
+    EXPECT_EQ(numVertices - 3, quad.mIndices[0]);
+    EXPECT_EQ(0u, quad.mIndices[3]);
+}
+
+namespace {
+
+class PointCounter : public PointBatchHandler {
+public:
+    bool HandleBatch(size_t firstPoint, unsigned int numPoints, const aiVector3D *positions,
+            const aiVector3D *normals, const aiColor4D *colors, const aiVector3D *textureCoords) override {
+        EXPECT_EQ(mNumPoints, firstPoint);
+        EXPECT_EQ(nullptr, normals);
+        EXPECT_EQ(nullptr, textureCoords);
+        EXPECT_NE(nullptr, colors);
+        for (unsigned int i = 0; i < numPoints; i += 101) {
+            ExpectBinaryPlyVertex(positions[i], colors[i], static_cast<unsigned int>(firstPoint + i));
+        }
+        mNumPoints += numPoints;
+        ++mNumBatches;
+        return mNumBatches < mMaxBatches;
+    }
+
+    size_t mNumPoints = 0;
+    unsigned int mNumBatches = 0;
+    unsigned int mMaxBatches = ~0u;
+};
+
+} // namespace
+
+TEST_F(utPLYImportExport, pointBatchHandlerTest) {
+    const unsigned int numVertices = 200000;
+    const std::string ply = MakeBinaryPly(false, numVertices, false);
+
+    PointCounter counter;
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 2);
+    importer.SetPropertyPointer(AI_CONFIG_IMPORT_POINT_BATCH_HANDLER, &counter);
+    const aiScene *scene = importer.ReadFileFromMemory(ply.data(), ply.size(), 0);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(0u, scene->mNumMeshes);
+    EXPECT_NE(0u, scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE);
+    EXPECT_EQ(numVertices, counter.mNumPoints);
+    EXPECT_LT(1u, counter.mNumBatches);
+
+    // returning false aborts the import
+    PointCounter aborting;
+    aborting.mMaxBatches = 1;
+    importer.SetPropertyPointer(AI_CONFIG_IMPORT_POINT_BATCH_HANDLER, &aborting);
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(ply.data(), ply.size(), 0));
+    EXPECT_EQ(1u, aborting.mNumBatches);
+
+    // meshes with faces are loaded as usual
+    const std::string mesh = MakeBinaryPly(false, 300, true);
+    scene = importer.ReadFileFromMemory(mesh.data(), mesh.size(), 0);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(1u, scene->mNumMeshes);
+    EXPECT_EQ(1u, aborting.mNumBatches);
+}
@@ -41,7 +41,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include "PostProcessing/PretransformVertices.h"
+#include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <assimp/Importer.hpp>
 
 using namespace std;
 using namespace Assimp;
@@ -155,3 +157,113 @@ TEST_F(PretransformVerticesTest, testProcessKeepHierarchy) {
     EXPECT_EQ(5U, mScene->mNumMaterials);
     EXPECT_EQ(49U, mScene->mNumMeshes); // see note on mesh 12 above
 }
+
+// ------------------------------------------------------------------------------------------------
+// One mesh with a point, a normal and a triangle, referenced by num nodes below the root
+static aiScene *BuildInstancedScene(unsigned int num) {
+    aiScene *scene = new aiScene();
+    scene->mMaterials = new aiMaterial *[scene->mNumMaterials = 1];
+    scene->mMaterials[0] = new aiMaterial();
+
+    scene->mMeshes = new aiMesh *[scene->mNumMeshes = 1];
+    aiMesh *mesh = scene->mMeshes[0] = new aiMesh();
+    mesh->mName.Set("instanced");
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices = 3];
+    mesh->mNormals = new aiVector3D[3];
+    for (unsigned int i = 0; i < 3; ++i) {
+        mesh->mVertices[i] = aiVector3D((float)i, 0.f, 0.f);
+        mesh->mNormals[i] = aiVector3D(0.f, 0.f, 1.f);
+    }
+    mesh->mFaces = new aiFace[mesh->mNumFaces = 1];
+    mesh->mFaces[0].mIndices = new unsigned int[mesh->mFaces[0].mNumIndices = 3]{ 0, 1, 2 };
+
+    scene->mRootNode = new aiNode("Root");
+    scene->mRootNode->mChildren = new aiNode *[scene->mRootNode->mNumChildren = num];
+    for (unsigned int i = 0; i < num; ++i) {
+        aiNode *nd = scene->mRootNode->mChildren[i] = new aiNode();
+        nd->mParent = scene->mRootNode;
+        nd->mMeshes = new unsigned int[nd->mNumMeshes = 1]{ 0 };
+    }
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testMergeInstances) {
+    delete mScene;
+    mScene = BuildInstancedScene(2);
+    aiMatrix4x4::Translation(aiVector3D(0.f, 5.f, 0.f), mScene->mRootNode->mChildren[1]->mTransformation);
+    aiMatrix4x4::RotationX((float)AI_MATH_HALF_PI, mScene->mRootNode->mChildren[0]->mTransformation);
+
+    mProcess->KeepHierarchy(false);
+    mProcess->Execute(mScene);
+
+    ASSERT_EQ(1U, mScene->mNumMeshes);
+    const aiMesh *mesh = mScene->mMeshes[0];
+    EXPECT_EQ(aiString("instanced"), mesh->mName);
+    ASSERT_EQ(6U, mesh->mNumVertices);
+    ASSERT_EQ(2U, mesh->mNumFaces);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(i, mesh->mFaces[0].mIndices[i]);
+        EXPECT_EQ(i + 3, mesh->mFaces[1].mIndices[i]);
+
+        // rotated instance
+        EXPECT_NEAR((float)i, mesh->mVertices[i].x, 1e-5);
+        EXPECT_NEAR(-1.f, mesh->mNormals[i].y, 1e-5);
+        EXPECT_NEAR(0.f, mesh->mNormals[i].z, 1e-5);
+
+        // translated instance
+        EXPECT_EQ(aiVector3D((float)i, 5.f, 0.f), mesh->mVertices[i + 3]);
+        EXPECT_EQ(aiVector3D(0.f, 0.f, 1.f), mesh->mNormals[i + 3]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testKeepHierarchySharesCopies) {
+    delete mScene;
+    mScene = BuildInstancedScene(4);
+    aiMatrix4x4::Translation(aiVector3D(1.f, 0.f, 0.f), mScene->mRootNode->mChildren[1]->mTransformation);
+    aiMatrix4x4::Translation(aiVector3D(1.f, 0.f, 0.f), mScene->mRootNode->mChildren[3]->mTransformation);
+
+    mProcess->KeepHierarchy(true);
+    mProcess->Execute(mScene);
+
+    // nodes 0 and 2 keep the original mesh, 1 and 3 share one copy
+    ASSERT_EQ(2U, mScene->mNumMeshes);
+    aiNode **nodes = mScene->mRootNode->mChildren;
+    EXPECT_EQ(0U, nodes[0]->mMeshes[0]);
+    EXPECT_EQ(0U, nodes[2]->mMeshes[0]);
+    EXPECT_EQ(1U, nodes[1]->mMeshes[0]);
+    EXPECT_EQ(1U, nodes[3]->mMeshes[0]);
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_EQ(aiVector3D((float)i, 0.f, 0.f), mScene->mMeshes[0]->mVertices[i]);
+        EXPECT_EQ(aiVector3D(i + 1.f, 0.f, 0.f), mScene->mMeshes[1]->mVertices[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testThreadsGiveSameResult) {
+    for (int keep = 0; keep < 2; ++keep) {
+        Importer single, multi;
+        single.SetPropertyInteger(AI_CONFIG_PP_PTV_KEEP_HIERARCHY, keep);
+        multi.SetPropertyInteger(AI_CONFIG_PP_PTV_KEEP_HIERARCHY, keep);
+        multi.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 4);
+        const aiScene *expected = single.ReadFile(ASSIMP_TEST_MODELS_DIR "/Collada/teapot_instancenodes.DAE", aiProcess_PreTransformVertices);
+        const aiScene *actual = multi.ReadFile(ASSIMP_TEST_MODELS_DIR "/Collada/teapot_instancenodes.DAE", aiProcess_PreTransformVertices);
+        ASSERT_NE(nullptr, expected);
+        ASSERT_NE(nullptr, actual);
+        ASSERT_EQ(expected->mNumMeshes, actual->mNumMeshes);
+        for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+            const aiMesh *a = expected->mMeshes[i], *b = actual->mMeshes[i];
+            EXPECT_EQ(a->mName, b->mName);
+            ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+            for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+                EXPECT_EQ(a->mVertices[v], b->mVertices[v]);
+            }
+            ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+            for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+                EXPECT_EQ(a->mFaces[f], b->mFaces[f]);
+            }
+        }
+    }
+}
@@ -42,6 +42,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UTLogStream.h"
 #include <assimp/Profiler.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
 
 using namespace ::Assimp;
 using namespace ::Assimp::Profiling;
@@ -61,3 +64,126 @@ TEST_F( utProfiler, addRegion_success ) {
     }
     myProfiler.EndRegion( "t1" );
 }
+
+TEST_F( utProfiler, nestedRegions_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "outer" );
+    myProfiler.BeginRegion( "inner" );
+    myProfiler.AddCounter( "vertices", 3 );
+    myProfiler.AddCounter( "vertices", 4 );
+    myProfiler.EndRegion( "inner" );
+    myProfiler.AddCounter( "bytes", 10 );
+    myProfiler.EndRegion( "outer" );
+
+    const std::vector<Profiler::Region> &regions = myProfiler.GetRegions();
+    ASSERT_EQ( 2u, regions.size() );
+    EXPECT_EQ( "outer", regions[0].name );
+    EXPECT_EQ( Profiler::NoParent, regions[0].parent );
+    EXPECT_EQ( 0u, regions[1].parent );
+    EXPECT_EQ( 1u, regions[1].depth );
+    EXPECT_LE( regions[0].begin, regions[1].begin );
+    EXPECT_LE( regions[1].end, regions[0].end );
+
+    ASSERT_EQ( 1u, regions[1].counters.size() );
+    EXPECT_EQ( 7, regions[1].counters[0].value );
+    ASSERT_EQ( 1u, regions[0].counters.size() );
+    EXPECT_EQ( "bytes", regions[0].counters[0].name );
+}
+
+TEST_F( utProfiler, endOuterClosesInner_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "outer" );
+    myProfiler.BeginRegion( "inner" );
+    myProfiler.EndRegion( "outer" );
+    myProfiler.EndRegion( "unknown" );
+
+    const std::vector<Profiler::Region> &regions = myProfiler.GetRegions();
+    ASSERT_EQ( 2u, regions.size() );
+    EXPECT_GE( regions[1].end, 0 );
+    EXPECT_EQ( regions[0].end, regions[1].end );
+}
+
+TEST_F( utProfiler, addEndedRegion_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "outer" );
+    const int64_t begin = myProfiler.GetTime();
+    const int64_t end = myProfiler.GetTime();
+    myProfiler.AddRegion( "worker", begin, end, { { "faces", 12 } } );
+    myProfiler.EndRegion( "outer" );
+
+    const std::vector<Profiler::Region> &regions = myProfiler.GetRegions();
+    ASSERT_EQ( 2u, regions.size() );
+    EXPECT_EQ( "worker", regions[1].name );
+    EXPECT_EQ( 0u, regions[1].parent );
+    EXPECT_EQ( begin, regions[1].begin );
+    EXPECT_EQ( end, regions[1].end );
+    ASSERT_EQ( 1u, regions[1].counters.size() );
+    EXPECT_EQ( 12, regions[1].counters[0].value );
+}
+
+TEST_F( utProfiler, chromeTrace_success ) {
+    Profiler myProfiler;
+    {
+        ScopedRegion region( &myProfiler, "with \"quotes\"" );
+        myProfiler.AddCounter( "meshes_in", 2 );
+    }
+    const std::string trace = myProfiler.GetChromeTrace();
+    EXPECT_EQ( 0u, trace.find( "{\"traceEvents\":[" ) );
+    EXPECT_NE( std::string::npos, trace.find( "\"name\":\"with \\\"quotes\\\"\"" ) );
+    EXPECT_NE( std::string::npos, trace.find( "\"ph\":\"X\"" ) );
+    EXPECT_NE( std::string::npos, trace.find( "\"args\":{\"meshes_in\":2}" ) );
+}
+
+TEST_F( utProfiler, importerRecordsSteps_success ) {
+    Importer importer;
+    EXPECT_EQ( nullptr, importer.GetProfiler() );
+
+    importer.SetPropertyBool( AI_CONFIG_GLOB_MEASURE_TIME, true );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+            aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    const Profiler *profiler = importer.GetProfiler();
+    ASSERT_NE( nullptr, profiler );
+
+    bool hasImport = false, hasJoin = false;
+    for ( const Profiler::Region &region : profiler->GetRegions() ) {
+        EXPECT_GE( region.end, region.begin );
+        if ( region.name == "import" ) {
+            hasImport = true;
+            EXPECT_EQ( 0u, region.parent );
+            ASSERT_FALSE( region.counters.empty() );
+            EXPECT_EQ( "file_size", region.counters[0].name );
+            EXPECT_EQ( "bytes_read", region.counters[1].name );
+            EXPECT_LT( 0, region.counters[1].value );
+        }
+        if ( region.name == "JoinVerticesProcess" ) {
+            hasJoin = true;
+            EXPECT_EQ( "postprocess", profiler->GetRegions()[region.parent].name );
+        }
+    }
+    EXPECT_TRUE( hasImport );
+    EXPECT_TRUE( hasJoin );
+}
+
+TEST_F( utProfiler, importerRecordsMeshes_success ) {
+    Importer importer;
+    importer.SetPropertyBool( AI_CONFIG_GLOB_MEASURE_TIME, true );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/box.obj", aiProcess_Triangulate );
+    ASSERT_NE( nullptr, scene );
+
+    const Profiler *profiler = importer.GetProfiler();
+    ASSERT_NE( nullptr, profiler );
+
+    unsigned int meshes = 0;
+    for ( const Profiler::Region &region : profiler->GetRegions() ) {
+        if ( region.name.compare( 0, 5, "mesh " ) == 0 ) {
+            ++meshes;
+            EXPECT_EQ( "TriangulateProcess", profiler->GetRegions()[region.parent].name );
+            EXPECT_GE( region.end, region.begin );
+            ASSERT_EQ( 2u, region.counters.size() );
+            EXPECT_EQ( "faces_out", region.counters[1].name );
+        }
+    }
+    EXPECT_EQ( scene->mNumMeshes, meshes );
+}
@@ -175,3 +175,23 @@ TEST_F(RemoveRedundantMatsTest, testRedundantMaterialsWithExcludeList) {
     EXPECT_EQ(AI_SUCCESS, aiGetMaterialString(pcScene1->mMaterials[3], AI_MATKEY_NAME, &sName));
     EXPECT_STREQ("Complex material name", sName.data);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RemoveRedundantMatsTest, testManyRedundantMaterials) {
+    aiScene scene;
+    scene.mNumMaterials = scene.mNumMeshes = 300;
+    scene.mMaterials = new aiMaterial *[scene.mNumMaterials];
+    scene.mMeshes = new aiMesh *[scene.mNumMeshes];
+    for (unsigned int i = 0; i < scene.mNumMaterials; ++i) {
+        aiMaterial *(*const unique[])() = { getUniqueMaterial1, getUniqueMaterial2, getUniqueMaterial3 };
+        scene.mMaterials[i] = unique[i % 3]();
+        scene.mMeshes[i] = new aiMesh();
+        scene.mMeshes[i]->mMaterialIndex = i;
+    }
+
+    piProcess->Execute(&scene);
+    ASSERT_EQ(3U, scene.mNumMaterials);
+    for (unsigned int i = 0; i < scene.mNumMeshes; ++i) {
+        EXPECT_EQ(i % 3, scene.mMeshes[i]->mMaterialIndex);
+    }
+}
@@ -99,6 +99,81 @@ TEST_F(utSTLImporterExporter, test_with_empty_solid) {
     EXPECT_EQ(nullptr, scene2);
 }
 
+// Binary STL of a n x n grid of quads in the z = 0 plane, every 7th facet has a color
+static std::vector<char> MakeBinaryGrid(unsigned int n) {
+    const uint32_t numFacets = 2 * n * n;
+    std::vector<char> data(84 + numFacets * 50u, 0);
+    ::memcpy(&data[80], &numFacets, sizeof(numFacets));
+    char *facet = &data[84];
+    for (unsigned int y = 0; y < n; ++y) {
+        for (unsigned int x = 0; x < n; ++x) {
+            const float quad[4][3] = { { float(x), float(y), 0 }, { float(x + 1), float(y), 0 },
+                { float(x + 1), float(y + 1), 0 }, { float(x), float(y + 1), 0 } };
+            const int corners[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+            for (const auto &triangle : corners) {
+                const float normal[3] = { 0, 0, 1 };
+                ::memcpy(facet, normal, sizeof(normal));
+                for (int k = 0; k < 3; ++k) {
+                    ::memcpy(facet + 12 + k * 12, quad[triangle[k]], sizeof(quad[0]));
+                }
+                const uint16_t color = ((facet - &data[84]) / 50) % 7 == 0 ? 0x801f : 0;
+                ::memcpy(facet + 48, &color, sizeof(color));
+                facet += 50;
+            }
+        }
+    }
+    return data;
+}
+
+TEST_F(utSTLImporterExporter, binaryWeldAndThreadsTest) {
+    // more facets than one work item of the reader
+    const unsigned int n = 200;
+    const std::vector<char> data = MakeBinaryGrid(n);
+
+    Assimp::Importer reference;
+    const aiScene *expected = reference.ReadFileFromMemory(data.data(), data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, expected);
+    const aiMesh *flat = expected->mMeshes[0];
+    ASSERT_EQ(2 * n * n, flat->mNumFaces);
+    ASSERT_EQ(3 * flat->mNumFaces, flat->mNumVertices);
+    ASSERT_NE(nullptr, flat->mColors[0]);
+
+    Assimp::Importer threaded;
+    threaded.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 4);
+    const aiScene *scene = threaded.ReadFileFromMemory(data.data(), data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, scene);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(flat->mNumVertices, mesh->mNumVertices);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(flat->mVertices[i], mesh->mVertices[i]);
+        EXPECT_EQ(flat->mNormals[i], mesh->mNormals[i]);
+        EXPECT_EQ(flat->mColors[0][i], mesh->mColors[0][i]);
+    }
+
+    Assimp::Importer welder;
+    welder.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, 4);
+    welder.SetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, true);
+    scene = welder.ReadFileFromMemory(data.data(), data.size(), aiProcess_ValidateDataStructure, "stl");
+    ASSERT_NE(nullptr, scene);
+    mesh = scene->mMeshes[0];
+    EXPECT_EQ((n + 1) * (n + 1), mesh->mNumVertices);
+    ASSERT_EQ(flat->mNumFaces, mesh->mNumFaces);
+    ASSERT_NE(nullptr, mesh->mColors[0]);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        ASSERT_EQ(3u, mesh->mFaces[f].mNumIndices);
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int v = mesh->mFaces[f].mIndices[k];
+            EXPECT_EQ(flat->mVertices[f * 3 + k], mesh->mVertices[v]);
+            EXPECT_EQ(aiVector3D(0, 0, 1), mesh->mNormals[v]);
+        }
+    }
+    // vertices are numbered by their first use
+    EXPECT_EQ(0u, mesh->mFaces[0].mIndices[0]);
+    EXPECT_EQ(1u, mesh->mFaces[0].mIndices[1]);
+    EXPECT_EQ(2u, mesh->mFaces[0].mIndices[2]);
+    EXPECT_EQ(flat->mColors[0][0], mesh->mColors[0][0]);
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utSTLImporterExporter, exporterTest) {
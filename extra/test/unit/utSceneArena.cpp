@@ -0,0 +1,238 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/SceneArena.h"
+#include "Common/ScenePrivate.h"
+
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+using namespace Assimp;
+
+class SceneArenaTest : public ::testing::Test {
+protected:
+    static bool InArena(const aiScene *scene) {
+        return nullptr != ScenePriv(scene)->mArena;
+    }
+
+    static void ExpectSameNodes(const aiNode *expected, const aiNode *actual) {
+        EXPECT_EQ(expected->mName, actual->mName);
+        EXPECT_EQ(expected->mTransformation, actual->mTransformation);
+        ASSERT_EQ(expected->mNumMeshes, actual->mNumMeshes);
+        for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+            EXPECT_EQ(expected->mMeshes[i], actual->mMeshes[i]);
+        }
+        ASSERT_EQ(expected->mNumChildren, actual->mNumChildren);
+        for (unsigned int i = 0; i < expected->mNumChildren; ++i) {
+            EXPECT_EQ(actual, actual->mChildren[i]->mParent);
+            ExpectSameNodes(expected->mChildren[i], actual->mChildren[i]);
+        }
+    }
+
+    static void ExpectSameMeshes(const aiMesh *expected, const aiMesh *actual) {
+        ASSERT_EQ(expected->mNumVertices, actual->mNumVertices);
+        for (unsigned int i = 0; i < expected->mNumVertices; ++i) {
+            EXPECT_EQ(expected->mVertices[i], actual->mVertices[i]);
+        }
+        EXPECT_EQ(expected->HasNormals(), actual->HasNormals());
+        EXPECT_EQ(expected->GetNumUVChannels(), actual->GetNumUVChannels());
+        ASSERT_EQ(expected->mNumFaces, actual->mNumFaces);
+        for (unsigned int i = 0; i < expected->mNumFaces; ++i) {
+            EXPECT_EQ(expected->mFaces[i], actual->mFaces[i]);
+        }
+        ASSERT_EQ(expected->mNumBones, actual->mNumBones);
+        for (unsigned int i = 0; i < expected->mNumBones; ++i) {
+            const aiBone *a = expected->mBones[i], *b = actual->mBones[i];
+            EXPECT_EQ(a->mName, b->mName);
+            EXPECT_EQ(a->mOffsetMatrix, b->mOffsetMatrix);
+            ASSERT_EQ(a->mNumWeights, b->mNumWeights);
+            for (unsigned int w = 0; w < a->mNumWeights; ++w) {
+                EXPECT_EQ(a->mWeights[w].mVertexId, b->mWeights[w].mVertexId);
+                EXPECT_EQ(a->mWeights[w].mWeight, b->mWeights[w].mWeight);
+            }
+        }
+        EXPECT_EQ(expected->mNumAnimMeshes, actual->mNumAnimMeshes);
+    }
+
+    static void ExpectSameScenes(const aiScene *expected, const aiScene *actual) {
+        ASSERT_EQ(expected->mNumMeshes, actual->mNumMeshes);
+        for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+            ExpectSameMeshes(expected->mMeshes[i], actual->mMeshes[i]);
+        }
+        ASSERT_EQ(expected->mNumMaterials, actual->mNumMaterials);
+        for (unsigned int i = 0; i < expected->mNumMaterials; ++i) {
+            const aiMaterial *a = expected->mMaterials[i], *b = actual->mMaterials[i];
+            ASSERT_EQ(a->mNumProperties, b->mNumProperties);
+            for (unsigned int p = 0; p < a->mNumProperties; ++p) {
+                EXPECT_EQ(a->mProperties[p]->mKey, b->mProperties[p]->mKey);
+                ASSERT_EQ(a->mProperties[p]->mDataLength, b->mProperties[p]->mDataLength);
+                EXPECT_EQ(0, memcmp(a->mProperties[p]->mData, b->mProperties[p]->mData, a->mProperties[p]->mDataLength));
+            }
+        }
+        ASSERT_EQ(expected->mNumAnimations, actual->mNumAnimations);
+        for (unsigned int i = 0; i < expected->mNumAnimations; ++i) {
+            EXPECT_EQ(expected->mAnimations[i]->mNumChannels, actual->mAnimations[i]->mNumChannels);
+            EXPECT_EQ(expected->mAnimations[i]->mNumMorphMeshChannels, actual->mAnimations[i]->mNumMorphMeshChannels);
+        }
+        EXPECT_EQ(expected->mNumTextures, actual->mNumTextures);
+        EXPECT_EQ(expected->mNumCameras, actual->mNumCameras);
+        EXPECT_EQ(expected->mNumLights, actual->mNumLights);
+        ASSERT_EQ(nullptr == expected->mMetaData, nullptr == actual->mMetaData);
+        if (expected->mMetaData) {
+            EXPECT_EQ(*expected->mMetaData, *actual->mMetaData);
+        }
+        ExpectSameNodes(expected->mRootNode, actual->mRootNode);
+    }
+
+    static void CheckImport(const char *file, unsigned int flags) {
+        Importer regular, arena;
+        arena.SetPropertyBool(AI_CONFIG_IMPORT_SCENE_ARENA, true);
+        const aiScene *expected = regular.ReadFile(file, flags);
+        const aiScene *actual = arena.ReadFile(file, flags);
+        ASSERT_NE(nullptr, expected);
+        ASSERT_NE(nullptr, actual);
+        EXPECT_FALSE(InArena(expected));
+        EXPECT_TRUE(InArena(actual));
+        ExpectSameScenes(expected, actual);
+    }
+};
+
+TEST_F(SceneArenaTest, allocate) {
+    SceneArena arena(256);
+    char *a = static_cast<char *>(arena.Allocate(3, 1));
+    double *b = arena.NewArray<double>(4);
+    EXPECT_EQ(0u, reinterpret_cast<size_t>(b) % alignof(double));
+    for (unsigned int i = 0; i < 4; ++i) {
+        EXPECT_EQ(0.0, b[i]);
+    }
+
+    // larger than the block size
+    const std::vector<int> values(1000, 7);
+    int *c = arena.CopyArray(values.data(), values.size());
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), c));
+    EXPECT_EQ(nullptr, arena.CopyArray<int>(nullptr, 5));
+    EXPECT_EQ(nullptr, arena.AllocateArray<int>(0));
+
+    ::memset(a, 1, 3);
+    EXPECT_EQ(3 + 4 * sizeof(double) + 1000 * sizeof(int), arena.GetAllocatedBytes());
+}
+
+TEST_F(SceneArenaTest, importOBJ) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate);
+}
+
+TEST_F(SceneArenaTest, importSkinned) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/X/anim_test.x", aiProcess_PopulateArmatureData);
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_SCENE_ARENA, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/X/anim_test.x", aiProcess_PopulateArmatureData);
+    ASSERT_NE(nullptr, scene);
+
+    // the bones point into the copied node graph
+    unsigned int numLinked = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        for (unsigned int b = 0; b < scene->mMeshes[i]->mNumBones; ++b) {
+            const aiBone *bone = scene->mMeshes[i]->mBones[b];
+            if (nullptr == bone->mNode) {
+                continue;
+            }
+            EXPECT_EQ(bone->mNode, scene->mRootNode->FindNode(bone->mName));
+            ASSERT_NE(nullptr, bone->mArmature);
+            EXPECT_EQ(bone->mArmature, scene->mRootNode->FindNode(bone->mArmature->mName));
+            ++numLinked;
+        }
+    }
+    EXPECT_LT(0u, numLinked);
+}
+
+TEST_F(SceneArenaTest, importMorphAnimation) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/glTF2/AnimatedMorphCube/glTF/AnimatedMorphCube.gltf", 0);
+}
+
+TEST_F(SceneArenaTest, importEmbeddedTexture) {
+    CheckImport(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF-Embedded/BoxTextured.gltf", aiProcess_EmbedTextures);
+}
+
+TEST_F(SceneArenaTest, postProcessArenaScene) {
+    Importer regular, arena;
+    arena.SetPropertyBool(AI_CONFIG_IMPORT_SCENE_ARENA, true);
+    const aiScene *expected = regular.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0);
+    const aiScene *scene = arena.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0);
+    ASSERT_NE(nullptr, expected);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_TRUE(InArena(scene));
+
+    // the scene is taken out of the arena for the steps and put back afterwards
+    expected = regular.ApplyPostProcessing(aiProcess_Triangulate | aiProcess_JoinIdenticalVertices);
+    EXPECT_EQ(scene, arena.ApplyPostProcessing(aiProcess_Triangulate | aiProcess_JoinIdenticalVertices));
+    EXPECT_TRUE(InArena(scene));
+    ExpectSameScenes(expected, scene);
+
+    arena.SetPropertyBool(AI_CONFIG_IMPORT_SCENE_ARENA, false);
+    EXPECT_EQ(scene, arena.ApplyPostProcessing(aiProcess_GenBoundingBoxes));
+    EXPECT_FALSE(InArena(scene));
+}
+
+TEST_F(SceneArenaTest, copyScene) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/simple_skin/simple_skin.gltf", 0);
+    ASSERT_NE(nullptr, scene);
+
+    aiScene *arenaCopy = nullptr;
+    SceneCombiner::CopySceneToArena(&arenaCopy, scene);
+    ASSERT_NE(nullptr, arenaCopy);
+    EXPECT_TRUE(InArena(arenaCopy));
+    ExpectSameScenes(scene, arenaCopy);
+
+    // a regular copy of an arena scene owns its contents again
+    aiScene *copy = nullptr;
+    SceneCombiner::CopyScene(&copy, arenaCopy);
+    delete arenaCopy;
+    ASSERT_NE(nullptr, copy);
+    EXPECT_FALSE(InArena(copy));
+    ExpectSameScenes(scene, copy);
+    delete copy;
+}
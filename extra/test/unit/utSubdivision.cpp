@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2025, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Subdivision.h>
+#include <assimp/mesh.h>
+
+#include <cmath>
+#include <memory>
+
+using namespace Assimp;
+
+class SubdivisionTest : public ::testing::Test {
+protected:
+    // Unit cube made of six unwelded quads, as the loaders hand it over
+    static aiMesh *CreateCube() {
+        static const float corners[8][3] = {
+            { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+            { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 }
+        };
+        static const unsigned int quads[6][4] = {
+            { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 },
+            { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 }
+        };
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mesh->mNumVertices = 24;
+        mesh->mVertices = new aiVector3D[24];
+        mesh->mNumFaces = 6;
+        mesh->mFaces = new aiFace[6];
+        for (unsigned int i = 0, v = 0; i < 6; ++i) {
+            aiFace &face = mesh->mFaces[i];
+            face.mNumIndices = 4;
+            face.mIndices = new unsigned int[4];
+            for (unsigned int n = 0; n < 4; ++n, ++v) {
+                const float *c = corners[quads[i][n]];
+                mesh->mVertices[v] = aiVector3D(c[0], c[1], c[2]);
+                face.mIndices[n] = v;
+            }
+        }
+        return mesh;
+    }
+
+    static aiMesh *Subdivide(aiMesh *mesh, unsigned int levels, unsigned int numThreads = 1) {
+        std::unique_ptr<Subdivider> div(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+        div->SetNumThreads(numThreads);
+        aiMesh *out = nullptr;
+        div->Subdivide(mesh, out, levels, true);
+        return out;
+    }
+
+    static void ExpectSameMesh(const aiMesh *expected, const aiMesh *actual) {
+        ASSERT_EQ(expected->mNumVertices, actual->mNumVertices);
+        ASSERT_EQ(expected->mNumFaces, actual->mNumFaces);
+        for (unsigned int i = 0; i < expected->mNumVertices; ++i) {
+            EXPECT_FLOAT_EQ(expected->mVertices[i].x, actual->mVertices[i].x);
+            EXPECT_FLOAT_EQ(expected->mVertices[i].y, actual->mVertices[i].y);
+            EXPECT_FLOAT_EQ(expected->mVertices[i].z, actual->mVertices[i].z);
+        }
+        for (unsigned int i = 0; i < expected->mNumFaces; ++i) {
+            const aiFace &a = expected->mFaces[i], &b = actual->mFaces[i];
+            ASSERT_EQ(a.mNumIndices, b.mNumIndices);
+            for (unsigned int n = 0; n < a.mNumIndices; ++n) {
+                EXPECT_EQ(a.mIndices[n], b.mIndices[n]);
+            }
+        }
+    }
+};
+
+TEST_F(SubdivisionTest, subdivideCube) {
+    std::unique_ptr<aiMesh> one(Subdivide(CreateCube(), 1));
+    ASSERT_NE(nullptr, one);
+    EXPECT_EQ(24u, one->mNumFaces);
+    EXPECT_EQ(96u, one->mNumVertices);
+
+    std::unique_ptr<aiMesh> two(Subdivide(CreateCube(), 2));
+    ASSERT_NE(nullptr, two);
+    EXPECT_EQ(96u, two->mNumFaces);
+
+    // the limit surface of a cube stays inside of it
+    for (unsigned int i = 0; i < two->mNumVertices; ++i) {
+        const aiVector3D &v = two->mVertices[i];
+        EXPECT_TRUE(v.x > 0.f && v.x < 1.f && v.y > 0.f && v.y < 1.f && v.z > 0.f && v.z < 1.f);
+    }
+}
+
+TEST_F(SubdivisionTest, levelsMatchRepeatedCalls) {
+    std::unique_ptr<aiMesh> once(Subdivide(CreateCube(), 3));
+    std::unique_ptr<aiMesh> repeated(Subdivide(Subdivide(Subdivide(CreateCube(), 1), 1), 1));
+    ASSERT_NE(nullptr, once);
+    ASSERT_NE(nullptr, repeated);
+    ExpectSameMesh(repeated.get(), once.get());
+}
+
+TEST_F(SubdivisionTest, threadsGiveSameResult) {
+    std::unique_ptr<aiMesh> single(Subdivide(CreateCube(), 6, 1));
+    std::unique_ptr<aiMesh> multi(Subdivide(CreateCube(), 6, 4));
+    ASSERT_NE(nullptr, single);
+    ASSERT_NE(nullptr, multi);
+    ExpectSameMesh(single.get(), multi.get());
+}
+
+TEST_F(SubdivisionTest, subdivideHighValencePole) {
+    // A closed fan of triangles around one pole, every edge at the pole shares its bucket
+    const unsigned int numFaces = 20000;
+    aiMesh *fan = new aiMesh();
+    fan->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    fan->mNumVertices = numFaces * 3;
+    fan->mVertices = new aiVector3D[fan->mNumVertices];
+    fan->mNumFaces = numFaces;
+    fan->mFaces = new aiFace[numFaces];
+    const float step = 6.2831853f / numFaces;
+    for (unsigned int i = 0, v = 0; i < numFaces; ++i) {
+        aiFace &face = fan->mFaces[i];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        fan->mVertices[v] = aiVector3D(0.f, 0.f, 0.f);
+        fan->mVertices[v + 1] = aiVector3D(std::cos(i * step), std::sin(i * step), 0.f);
+        fan->mVertices[v + 2] = aiVector3D(std::cos((i + 1) % numFaces * step), std::sin((i + 1) % numFaces * step), 0.f);
+        for (unsigned int n = 0; n < 3; ++n, ++v) {
+            face.mIndices[n] = v;
+        }
+    }
+
+    std::unique_ptr<aiMesh> out(Subdivide(fan, 1));
+    ASSERT_NE(nullptr, out);
+    ASSERT_EQ(numFaces * 3, out->mNumFaces);
+    // the corner at the pole of the first face keeps the pole in the middle of the fan
+    const aiVector3D &pole = out->mVertices[3];
+    EXPECT_NEAR(0.f, pole.x, 1e-3f);
+    EXPECT_NEAR(0.f, pole.y, 1e-3f);
+    for (unsigned int i = 0; i < out->mNumVertices; ++i) {
+        EXPECT_LE(out->mVertices[i].Length(), 1.001f);
+    }
+}
@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/scene.h>
 
+#include <memory>
+
 #include "PostProcessing/TriangulateProcess.h"
 
 using namespace std;
@@ -135,3 +137,114 @@ TEST_F(TriangulateProcessTest, testTriangulation) {
     // we should have no valid normal vectors now because we aren't a pure polygon mesh
     EXPECT_TRUE(pcMesh->mNormals == nullptr);
 }
+
+TEST_F(TriangulateProcessTest, testFanConvexPolygons) {
+    piProcess->SetFanConvex(true);
+    piProcess->TriangulateMesh(pcMesh);
+    EXPECT_TRUE((pcMesh->mPrimitiveTypes & aiPrimitiveType_NGONEncodingFlag) != 0);
+
+    // every polygon becomes one fan, which is recognized as one ngon
+    unsigned int lastFirst = ~0u;
+    for (unsigned int m = 0, t = 0, q = 4; m < pcMesh->mNumFaces; ++m) {
+        if (++t != 4) {
+            continue;
+        }
+        t = 0;
+        const unsigned int first = pcMesh->mFaces[m].mIndices[0];
+        EXPECT_NE(lastFirst, first);
+        for (unsigned int i = 0; i < q - 2; ++i) {
+            const aiFace &face = pcMesh->mFaces[m + i];
+            ASSERT_EQ(3u, face.mNumIndices);
+            EXPECT_EQ(first, face.mIndices[0]);
+        }
+        lastFirst = first;
+        m += q - 3;
+        if (++q == 10) {
+            q = 4;
+        }
+    }
+}
+
+TEST_F(TriangulateProcessTest, testFanConvexKeepsConcavePolygons) {
+    // L-shaped hexagon, a fan from its first corner would overlap itself
+    static const float corners[6][2] = { { 0, 0 }, { 2, 0 }, { 2, 1 }, { 1, 1 }, { 1, 2 }, { 0, 2 } };
+    aiMesh mesh;
+    mesh.mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh.mNumVertices = 6;
+    mesh.mVertices = new aiVector3D[6];
+    mesh.mNumFaces = 1;
+    mesh.mFaces = new aiFace[1];
+    mesh.mFaces[0].mNumIndices = 6;
+    mesh.mFaces[0].mIndices = new unsigned int[6];
+    for (unsigned int i = 0; i < 6; ++i) {
+        mesh.mVertices[i] = aiVector3D(corners[i][0], corners[i][1], 0.f);
+        mesh.mFaces[0].mIndices[i] = i;
+    }
+
+    piProcess->SetFanConvex(true);
+    ASSERT_TRUE(piProcess->TriangulateMesh(&mesh));
+    ASSERT_EQ(4u, mesh.mNumFaces);
+
+    // all triangles keep the winding and cover the polygon exactly once
+    float area = 0.f;
+    for (unsigned int i = 0; i < mesh.mNumFaces; ++i) {
+        const unsigned int *idx = mesh.mFaces[i].mIndices;
+        const aiVector3D e0 = mesh.mVertices[idx[1]] - mesh.mVertices[idx[0]];
+        const aiVector3D e1 = mesh.mVertices[idx[2]] - mesh.mVertices[idx[0]];
+        const float doubleArea = e0.x * e1.y - e0.y * e1.x;
+        EXPECT_GT(doubleArea, 0.f);
+        area += doubleArea * 0.5f;
+    }
+    EXPECT_FLOAT_EQ(3.f, area);
+}
+
+namespace {
+
+class ThreadedTriangulateProcess : public TriangulateProcess {
+public:
+    explicit ThreadedTriangulateProcess(unsigned int numThreads) {
+        mNumThreads = numThreads;
+    }
+};
+
+// Many polygons of 3 to 9 corners, every third one made concave
+aiMesh *CreatePolygonMesh(unsigned int numFaces) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE | aiPrimitiveType_POLYGON;
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    mesh->mVertices = new aiVector3D[numFaces * 9];
+    for (unsigned int m = 0; m < numFaces; ++m) {
+        aiFace &face = mesh->mFaces[m];
+        face.mNumIndices = 3 + m % 7;
+        face.mIndices = new unsigned int[face.mNumIndices];
+        for (unsigned int p = 0; p < face.mNumIndices; ++p) {
+            const float radius = (m % 3 == 0 && p == 1) ? 0.2f : 1.f;
+            const float angle = p * (float)AI_MATH_TWO_PI / face.mNumIndices;
+            face.mIndices[p] = mesh->mNumVertices;
+            mesh->mVertices[mesh->mNumVertices++] = aiVector3D(radius * cos(angle), radius * sin(angle), (float)m);
+        }
+    }
+    return mesh;
+}
+
+} // namespace
+
+TEST_F(TriangulateProcessTest, testThreadsGiveSameResult) {
+    std::unique_ptr<aiMesh> single(CreatePolygonMesh(20000)), multi(CreatePolygonMesh(20000));
+    ThreadedTriangulateProcess singleProcess(1), multiProcess(4);
+    singleProcess.SetFanConvex(true);
+    multiProcess.SetFanConvex(true);
+    ASSERT_TRUE(singleProcess.TriangulateMesh(single.get()));
+    ASSERT_TRUE(multiProcess.TriangulateMesh(multi.get()));
+
+    ASSERT_EQ(single->mNumFaces, multi->mNumFaces);
+    for (unsigned int i = 0; i < single->mNumFaces; ++i) {
+        const aiFace &a = single->mFaces[i], &b = multi->mFaces[i];
+        ASSERT_EQ(3u, a.mNumIndices);
+        ASSERT_EQ(3u, b.mNumIndices);
+        for (unsigned int n = 0; n < 3; ++n) {
+            EXPECT_EQ(a.mIndices[n], b.mIndices[n]);
+        }
+    }
+}
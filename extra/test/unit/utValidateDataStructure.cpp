@@ -44,7 +44,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
-#include <ValidateDataStructure.h>
+#include <assimp/Exceptional.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include "PostProcessing/ValidateDataStructure.h"
+
+#include <string>
 
 using namespace std;
 using namespace Assimp;
@@ -90,6 +95,98 @@ void ValidateDataStructureTest::TearDown()
 
 
 
+// ------------------------------------------------------------------------------------------------
+namespace {
+
+class ThreadedValidateDSProcess : public ValidateDSProcess {
+public:
+    explicit ThreadedValidateDSProcess(unsigned int numThreads) {
+        mNumThreads = numThreads;
+    }
+};
+
+// Strip of numFaces triangles, with the indices in one pool if pooled
+aiMesh *CreateStrip(unsigned int numFaces, bool pooled) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = numFaces + 2;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mVertices[i] = aiVector3D((float)(i / 2), (float)(i % 2), 0.f);
+    }
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        mesh->mFaces[i].mNumIndices = 3;
+        mesh->mFaces[i].mIndices = new unsigned int[3]{ i, i + 1, i + 2 };
+    }
+    if (pooled) {
+        mesh->PoolFaceIndices();
+    }
+    return mesh;
+}
+
+std::string ValidationError(ValidateDSProcess &process, aiScene *scene) {
+    try {
+        process.Execute(scene);
+    } catch (const DeadlyImportError &err) {
+        return err.what();
+    }
+    return std::string();
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, outOfRangeIndexIsReported) {
+    for (bool pooled : { false, true }) {
+        aiScene *broken = new aiScene();
+        broken->mRootNode = new aiNode();
+        broken->mNumMeshes = 1;
+        broken->mMeshes = new aiMesh *[1]{ CreateStrip(100, pooled) };
+        EXPECT_EQ(std::string(), ValidationError(*vds, broken));
+
+        broken->mMeshes[0]->mFaces[57].mIndices[1] = 102;
+        EXPECT_NE(std::string::npos, ValidationError(*vds, broken).find("aiMesh::mFaces[57]::mIndices[1] is out of range"));
+        delete broken;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, threadsReportFirstError) {
+    scene->mNumMeshes = 8;
+    scene->mMeshes = new aiMesh *[8];
+    for (unsigned int i = 0; i < 8; ++i) {
+        scene->mMeshes[i] = CreateStrip(1000, i % 2 == 0);
+    }
+    ThreadedValidateDSProcess threaded(4);
+    EXPECT_EQ(std::string(), ValidationError(threaded, scene));
+
+    scene->mMeshes[3]->mFaces[10].mIndices[0] = 5000;
+    scene->mMeshes[6]->DeleteFaces();
+
+    const std::string expected = ValidationError(*vds, scene);
+    EXPECT_NE(std::string::npos, expected.find("aiMesh::mFaces[10]::mIndices[0] is out of range"));
+    EXPECT_EQ(expected, ValidationError(threaded, scene));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, skipUnchangedMeshes) {
+    for (bool skip : { false, true }) {
+        Importer importer;
+        importer.SetPropertyBool(AI_CONFIG_PP_VDS_SKIP_UNCHANGED_MESHES, skip);
+        const aiScene *imported = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+                aiProcess_ValidateDataStructure | aiProcess_Triangulate);
+        ASSERT_NE(nullptr, imported);
+        ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+
+        // changing the index array in place goes unnoticed by design, which
+        // shows whether the mesh was looked at again
+        imported->mMeshes[0]->mFaces[0].mIndices[0] = imported->mMeshes[0]->mNumVertices;
+        EXPECT_EQ(skip, nullptr != importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 //Template
 //TEST_F(ScenePreprocessorTest, test)
@@ -195,5 +292,3 @@ void ValidateDataStructureTest::TearDown()
 //965: ReportError("aiString::length is too large (%i, maximum is %lu)",
 //974: ReportError("aiString::data is invalid: the terminal zero is at a wrong offset");
 //979: ReportError("aiString::data is invalid. There is no terminal character");
-}
-
@@ -866,6 +866,125 @@ TEST_F(utglTF2ImportExport, allIndicesOutOfRange) {
     ASSERT_NE(error.find("Mesh \"Mesh\" has no faces"), std::string::npos);
 }
 
+TEST_F(utglTF2ImportExport, sharedVertexAccessor) {
+    // Three primitives index the same four positions: the first uses three of them in
+    // order, the second uses them out of order and the third uses all of them in order,
+    // which needs no remapping at all.
+    static const char gltf[] = R"({
+        "asset": { "version": "2.0" },
+        "scene": 0,
+        "scenes": [ { "nodes": [ 0 ] } ],
+        "nodes": [ { "mesh": 0 } ],
+        "meshes": [ { "primitives": [
+            { "attributes": { "POSITION": 0 }, "indices": 1 },
+            { "attributes": { "POSITION": 0 }, "indices": 2 },
+            { "attributes": { "POSITION": 0 }, "indices": 3 } ] } ],
+        "buffers": [ { "byteLength": 76, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAACAPwAAgD8AAAAAAAAAAAAAgD8AAAAAAAABAAIAAAACAAMAAAAAAAAAAQACAAAAAgADAA==" } ],
+        "bufferViews": [
+            { "buffer": 0, "byteOffset": 0, "byteLength": 48 },
+            { "buffer": 0, "byteOffset": 48, "byteLength": 6 },
+            { "buffer": 0, "byteOffset": 56, "byteLength": 6 },
+            { "buffer": 0, "byteOffset": 64, "byteLength": 12 } ],
+        "accessors": [
+            { "bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3", "min": [ 0, 0, 0 ], "max": [ 1, 1, 0 ] },
+            { "bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR" },
+            { "bufferView": 2, "componentType": 5123, "count": 3, "type": "SCALAR" },
+            { "bufferView": 3, "componentType": 5123, "count": 6, "type": "SCALAR" } ]
+    })";
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(gltf, sizeof(gltf) - 1, aiProcess_ValidateDataStructure, "gltf");
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->mNumMeshes, 3u);
+
+    const aiVector3D quad[4] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } };
+    const unsigned int used[3][4] = { { 0, 1, 2 }, { 2, 3, 0 }, { 0, 1, 2, 3 } };
+    const unsigned int numUsed[3] = { 3, 3, 4 };
+    for (unsigned int m = 0; m < 3; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        ASSERT_EQ(mesh->mNumVertices, numUsed[m]);
+        for (unsigned int v = 0; v < numUsed[m]; ++v) {
+            EXPECT_EQ(mesh->mVertices[v], quad[used[m][v]]);
+        }
+    }
+    ASSERT_EQ(scene->mMeshes[2]->mNumFaces, 2u);
+    EXPECT_EQ(scene->mMeshes[2]->mFaces[1].mIndices[2], 3u);
+}
+
+// The fallback buffer has no data, all three buffer views are decoded from the
+// compressed buffer: positions as exponential encoded attributes, the indices of the
+// first primitive as triangles and the ones of the second as an index sequence.
+static const char MeshoptGltf[] = R"({
+        "asset": { "version": "2.0" },
+        "extensionsUsed": [ "EXT_meshopt_compression" ],
+        "extensionsRequired": [ "EXT_meshopt_compression" ],
+        "scene": 0,
+        "scenes": [ { "nodes": [ 0 ] } ],
+        "nodes": [ { "mesh": 0 } ],
+        "meshes": [ { "primitives": [
+            { "attributes": { "POSITION": 0 }, "indices": 1 },
+            { "attributes": { "POSITION": 0 }, "indices": 2 } ] } ],
+        "buffers": [
+            { "byteLength": 84, "uri": "data:application/octet-stream;base64,oAEhAAAAAAAAAQgAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAADh/hAAAAAAAAAAAAAAAAAAAAAAANEABAQAAggAAAAA" },
+            { "byteLength": 72, "extensions": { "EXT_meshopt_compression": { "fallback": true } } } ],
+        "bufferViews": [
+            { "buffer": 1, "byteOffset": 0, "byteLength": 48, "byteStride": 12,
+              "extensions": { "EXT_meshopt_compression": { "buffer": 0, "byteOffset": 0, "byteLength": 53, "byteStride": 12, "count": 4, "mode": "ATTRIBUTES", "filter": "EXPONENTIAL" } } },
+            { "buffer": 1, "byteOffset": 48, "byteLength": 12,
+              "extensions": { "EXT_meshopt_compression": { "buffer": 0, "byteOffset": 53, "byteLength": 20, "byteStride": 2, "count": 6, "mode": "TRIANGLES" } } },
+            { "buffer": 1, "byteOffset": 60, "byteLength": 12,
+              "extensions": { "EXT_meshopt_compression": { "buffer": 0, "byteOffset": 73, "byteLength": 11, "byteStride": 2, "count": 6, "mode": "INDICES" } } } ],
+        "accessors": [
+            { "bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3", "min": [ 0, 0, 0 ], "max": [ 1, 1, 0 ] },
+            { "bufferView": 1, "componentType": 5123, "count": 6, "type": "SCALAR" },
+            { "bufferView": 2, "componentType": 5123, "count": 6, "type": "SCALAR" } ]
+})";
+
+TEST_F(utglTF2ImportExport, meshoptCompressedBufferViews) {
+    const aiVector3D quad[4] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } };
+    const unsigned int faces[2][3] = { { 0, 1, 2 }, { 2, 1, 3 } };
+    for (int numThreads : { 1, 2 }) {
+        Assimp::Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_NUM_THREADS, numThreads);
+        const aiScene *scene = importer.ReadFileFromMemory(MeshoptGltf, sizeof(MeshoptGltf) - 1, aiProcess_ValidateDataStructure, "gltf");
+        ASSERT_NE(scene, nullptr);
+        ASSERT_EQ(scene->mNumMeshes, 2u);
+        for (unsigned int m = 0; m < 2; ++m) {
+            const aiMesh *mesh = scene->mMeshes[m];
+            ASSERT_EQ(mesh->mNumVertices, 4u);
+            for (unsigned int v = 0; v < 4; ++v) {
+                EXPECT_EQ(mesh->mVertices[v], quad[v]);
+            }
+            ASSERT_EQ(mesh->mNumFaces, 2u);
+            for (unsigned int f = 0; f < 2; ++f) {
+                ASSERT_EQ(mesh->mFaces[f].mNumIndices, 3u);
+                for (unsigned int i = 0; i < 3; ++i) {
+                    EXPECT_EQ(mesh->mFaces[f].mIndices[i], faces[f][i]);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(utglTF2ImportExport, meshoptFallbackBufferBounds) {
+    const auto replaced = [](const std::string &from, const std::string &to) {
+        std::string gltf = MeshoptGltf;
+        gltf.replace(gltf.find(from), from.size(), to);
+        return gltf;
+    };
+
+    // The stated length of a fallback buffer is not allocated, only what its views decode to
+    const std::string huge = replaced("{ \"byteLength\": 72, \"extensions\"", "{ \"byteLength\": 1000000000000000, \"extensions\"");
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(huge.c_str(), huge.size(), aiProcess_ValidateDataStructure, "gltf");
+    ASSERT_NE(scene, nullptr);
+    EXPECT_EQ(scene->mNumMeshes, 2u);
+
+    // Offset and length which only fit the compressed buffer once their sum wraps around
+    const std::string wrapped = replaced("\"byteOffset\": 73, \"byteLength\": 11", "\"byteOffset\": 18446744073709551608, \"byteLength\": 20");
+    EXPECT_EQ(importer.ReadFileFromMemory(wrapped.c_str(), wrapped.size(), aiProcess_ValidateDataStructure, "gltf"), nullptr);
+}
+
 /////////////////////////////////
 // Draco decoding
 
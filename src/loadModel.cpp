@@ -2,15 +2,19 @@
 #include <vector>
 #include <cstring>
 #include <iostream>
+#include <map>
+#include <tuple>
 
 #include "../glm/ext/vector_float2.hpp"
 #include "../glm/ext/vector_float3.hpp"
+#include "meshOptimizer.hpp"
 
 
 bool loadObj(const char* path,
             std::vector<float> &outVertices,
             std::vector<float> &outUvs,
-            std::vector<float> &outNormals)
+            std::vector<float> &outNormals,
+            std::vector<unsigned int> &outIndices)
 {
   FILE* fp = fopen(path, "r");
   if (fp == NULL)
@@ -79,33 +83,50 @@ bool loadObj(const char* path,
   fclose(fp);
 
   // Processing data
+  // Every unique v/vt/vn combination becomes one vertex, faces only index them
+  std::map<std::tuple<unsigned int, unsigned int, unsigned int>, unsigned int> vertexMap;
   for (unsigned int i = 0; i < vertexIndices.size(); i++)
   {
-    unsigned int index = vertexIndices[i];
-    glm::vec3 vertex = temp_vertices[index - 1];
+    std::tuple<unsigned int, unsigned int, unsigned int> key(vertexIndices[i], uvIndices[i], normalIndices[i]);
+    auto found = vertexMap.find(key);
+    if (found != vertexMap.end())
+    {
+      outIndices.push_back(found->second);
+      continue;
+    }
+
+    unsigned int newIndex = outVertices.size() / 3;
+    vertexMap[key] = newIndex;
+    outIndices.push_back(newIndex);
+
+    glm::vec3 vertex = temp_vertices[vertexIndices[i] - 1];
     outVertices.push_back(vertex.x);
     outVertices.push_back(vertex.y);
     outVertices.push_back(vertex.z);
-  }
 
-  for (unsigned int i = 0; i < uvIndices.size(); i++)
-  {
-    unsigned int index = uvIndices[i];
-    glm::vec2 uv = temp_uvs[index - 1];
+    glm::vec3 uv = temp_uvs[uvIndices[i] - 1];
     outUvs.push_back(uv.x);
     outUvs.push_back(uv.y);
-  }
 
-  for (unsigned int i = 0; i < normalIndices.size(); i++)
-  {
-    unsigned int index = normalIndices[i];
-    glm::vec3 normal = temp_normals[index - 1];
-   
+    glm::vec3 normal = temp_normals[normalIndices[i] - 1];
     outNormals.push_back(normal.x);
     outNormals.push_back(normal.y);
     outNormals.push_back(normal.z);
   }
-    
+
+  if (outIndices.empty())
+    return true;
+
+  // Reorder for the vertex cache and overdraw, then renumber vertices in draw order
+  std::vector<int> clusters;
+  Optimize_Vertex_Cache(outIndices.data(), outIndices.size(), &clusters);
+  Optimize_Overdraw(outIndices.data(), outIndices.size(), outVertices.data(), clusters);
+
+  std::vector<int> remap = Optimize_Vertex_Fetch(outIndices.data(), outIndices.size(), outVertices.size() / 3);
+  Remap_Vertices(outVertices, remap, 3);
+  Remap_Vertices(outUvs, remap, 2);
+  Remap_Vertices(outNormals, remap, 3);
+
   // std::cout << "In load model file" << std::endl;
   // std::cout << "Size of vertexIndex: " << vertexIndices.size() << std::endl;
   // std::cout << "Size of uvIndex: " << uvIndices.size() << std::endl;
@@ -5,4 +5,5 @@
 bool loadObj(const char* path,
              std::vector<float> &outVertices,
              std::vector<float> &outUvs,
-             std::vector<float> &outNormals);
+             std::vector<float> &outNormals,
+             std::vector<unsigned int> &outIndices);
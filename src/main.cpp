@@ -62,6 +62,7 @@ struct Mesh3D
   GLuint mPositionVertexBufferObject = 0;
   GLuint mUvVertexBufferObject = 0;
   GLuint mNormalVertexBufferObject = 0;
+  GLuint mIndexBufferObject = 0;
 
   GLuint mTextureObject = 0;
   
@@ -69,6 +70,7 @@ struct Mesh3D
   std::vector<T> mVertexData; 
   std::vector<T> mUvData; // T can cause problem here
   std::vector<T> mNormalData;
+  std::vector<GLuint> mIndexData;
 
   glm::vec3 mOffset = glm::vec3(0.0f);
   GLfloat mRotate = 0.0f;
@@ -248,8 +250,9 @@ bool meshCreate(const char* path, Mesh3D<T> *mesh)
   std::vector<float> vertexData;
   std::vector<float> uvData;
   std::vector<float> normalData;
+  std::vector<GLuint> indexData;
 
-  if(loadObj(path, vertexData, uvData, normalData) == false)
+  if(loadObj(path, vertexData, uvData, normalData, indexData) == false)
   {
     std::cout << "Problem occured in loading model" << std::endl;
     return false;
@@ -258,6 +261,7 @@ bool meshCreate(const char* path, Mesh3D<T> *mesh)
   mesh->mVertexData = vertexData;
   mesh->mUvData = uvData;
   mesh->mNormalData = normalData;
+  mesh->mIndexData = indexData;
 
   return true;
 }
@@ -364,6 +368,15 @@ void meshCTGdataTransfer(Mesh3D<T>* mesh)
                         false,
                         0,
                         (void*)0);
+
+  // 4. start generating our index buffer, stays bound to the VAO
+  glGenBuffers(1, &mesh->mIndexBufferObject);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->mIndexBufferObject);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+              mesh->mIndexData.size() * sizeof(GLuint),
+              mesh->mIndexData.data(),
+              GL_STATIC_DRAW);
+
   glBindVertexArray(0);
   glDisableVertexAttribArray(0); 
   glDisableVertexAttribArray(1);
@@ -552,7 +565,7 @@ void Draw(Mesh3D<T>* mesh)
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, mesh->mTextureObject);
   glBindVertexArray(mesh->mVertexArrayObject);
-  glDrawArrays(GL_TRIANGLES, 0, mesh->mVertexData.size() / 3);
+  glDrawElements(GL_TRIANGLES, mesh->mIndexData.size(), GL_UNSIGNED_INT, (void*)0);
 }
 
 
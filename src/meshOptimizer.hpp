@@ -0,0 +1,336 @@
+#ifndef _MESH_OPTIMIZER_H_
+#define _MESH_OPTIMIZER_H_
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+#include <iostream>
+
+//Index buffer reordering for the post-transform vertex cache, overdraw and
+//vertex fetch. Only the standard library is used, there is no GL or glm in
+//here, so any loader that ends up with an index buffer and packed xyz
+//positions can run it. Functions are templates on the index type because
+//the OpenGL-Object-Loading demo uses int and loadModel.cpp uses unsigned int.
+//
+//The demo keeps the same code in its own Mesh_Optimizer.h so it builds
+//outside this tree. Change both together.
+
+//FIFO size the optimizer targets and the stats are measured with.
+//Tipsify is not very sensitive to it, 16 is a safe guess for current GPUs
+#define VERTEX_CACHE_SIZE 16
+
+struct Vertex_Cache_Stats
+{
+	int triangles = 0;
+	int vertices = 0;//unique vertices referenced by the index
+	int misses = 0;//vertices transformed with a FIFO of VERTEX_CACHE_SIZE
+
+	//average cache miss ratio, misses per triangle. 0.5 is the best a large
+	//grid can get, 3 means no reuse at all
+	float Acmr() const { return triangles > 0 ? (float)misses / triangles : 0.0f; }
+	//average transform to vertex ratio, 1 means every vertex is shaded once
+	float Atvr() const { return vertices > 0 ? (float)misses / vertices : 0.0f; }
+
+	void Add(const Vertex_Cache_Stats& s)
+	{
+		triangles += s.triangles;
+		vertices += s.vertices;
+		misses += s.misses;
+	}
+};
+
+//Sorted list of the vertices used by index, local ids are positions in it.
+//Lets the passes below work on a sub range of a big mesh without allocating
+//per vertex tables the size of the whole mesh
+template <class I>
+static std::vector<I> Used_Vertices(const I* index, int index_count)
+{
+	std::vector<I> used(index, index + index_count);
+	std::sort(used.begin(), used.end());
+	used.erase(std::unique(used.begin(), used.end()), used.end());
+	return used;
+}
+
+template <class I>
+static std::vector<int> Local_Index(const I* index, int index_count, const std::vector<I>& used)
+{
+	std::vector<int> local(index_count);
+	for (int i = 0; i < index_count; ++i)
+		local[i] = std::lower_bound(used.begin(), used.end(), index[i]) - used.begin();
+	return local;
+}
+
+template <class I>
+static Vertex_Cache_Stats Analyze_Vertex_Cache(const I* index, int index_count, int cache_size = VERTEX_CACHE_SIZE)
+{
+	Vertex_Cache_Stats stats;
+	if (index_count < 3)
+		return stats;
+
+	std::vector<I> used = Used_Vertices(index, index_count);
+	std::vector<int> local = Local_Index(index, index_count, used);
+
+	//a vertex is in the FIFO if fewer than cache_size misses happened since
+	//it was pushed
+	std::vector<int> pushed(used.size(), -cache_size - 1);
+	for (int i = 0; i < index_count; ++i)
+	{
+		int v = local[i];
+		if (stats.misses - pushed[v] > cache_size)
+		{
+			pushed[v] = stats.misses;
+			stats.misses++;
+		}
+	}
+
+	stats.triangles = index_count / 3;
+	stats.vertices = used.size();
+	return stats;
+}
+
+//Tipsify, Sander, Nehab and Barczak 2007, "Fast Triangle Reordering for Vertex
+//Locality and Reduced Overdraw". Walks the mesh emitting the fan of triangles
+//around one vertex at a time and picks the next fan center among the vertices
+//that are still in the cache. Linear time, Forsyth's scoring gets a few
+//percent lower ACMR but is several times slower on San Miguel sized meshes.
+//If clusters is given it receives the first triangle of every run that
+//started after a cache flush, the pieces Optimize_Overdraw can sort.
+template <class I>
+static void Optimize_Vertex_Cache(I* index, int index_count, std::vector<int>* clusters = NULL, int cache_size = VERTEX_CACHE_SIZE)
+{
+	int num_triangle = index_count / 3;
+	if (clusters)
+		clusters->clear();
+	if (num_triangle == 0)
+		return;
+
+	std::vector<I> used = Used_Vertices(index, num_triangle * 3);
+	std::vector<int> local = Local_Index(index, num_triangle * 3, used);
+	int num_vertex = used.size();
+
+	//triangles around each vertex, flattened
+	std::vector<int> live(num_vertex, 0);
+	for (int i = 0; i < num_triangle * 3; ++i)
+		live[local[i]]++;
+	std::vector<int> offset(num_vertex + 1, 0);
+	for (int v = 0; v < num_vertex; ++v)
+		offset[v + 1] = offset[v] + live[v];
+	std::vector<int> adjacency(num_triangle * 3);
+	std::vector<int> fill(offset.begin(), offset.end() - 1);
+	for (int i = 0; i < num_triangle * 3; ++i)
+		adjacency[fill[local[i]]++] = i / 3;
+
+	std::vector<int> timestamp(num_vertex, 0);
+	std::vector<char> emitted(num_triangle, 0);
+	std::vector<int> dead_end;
+	std::vector<int> candidates;
+	std::vector<int> output;
+	output.reserve(num_triangle * 3);
+
+	int time = cache_size + 1;
+	int cursor = 1;
+	int fan = 0;
+	bool flushed = true;
+	while (fan >= 0)
+	{
+		if (flushed && clusters)
+			clusters->emplace_back(output.size() / 3);
+
+		candidates.clear();
+		for (int k = offset[fan]; k < offset[fan + 1]; ++k)
+		{
+			int t = adjacency[k];
+			if (emitted[t])
+				continue;
+			for (int j = 0; j < 3; ++j)
+			{
+				int v = local[3 * t + j];
+				output.emplace_back(v);
+				dead_end.emplace_back(v);
+				candidates.emplace_back(v);
+				live[v]--;
+				if (time - timestamp[v] > cache_size)
+					timestamp[v] = time++;
+			}
+			emitted[t] = 1;
+		}
+
+		//the candidate that stays in the cache longest while its remaining
+		//triangles are emitted
+		int next = -1;
+		int best = -1;
+		for (size_t k = 0; k < candidates.size(); ++k)
+		{
+			int v = candidates[k];
+			if (live[v] <= 0)
+				continue;
+			int priority = 0;
+			if (time - timestamp[v] + 2 * live[v] <= cache_size)
+				priority = time - timestamp[v];
+			if (priority > best)
+			{
+				best = priority;
+				next = v;
+			}
+		}
+
+		flushed = next < 0;
+		if (next < 0)
+		{
+			//dead end, go back to a recently used vertex
+			while (!dead_end.empty())
+			{
+				int v = dead_end.back();
+				dead_end.pop_back();
+				if (live[v] > 0)
+				{
+					next = v;
+					break;
+				}
+			}
+			flushed = next < 0 || time - timestamp[next] > cache_size;
+		}
+		if (next < 0)
+		{
+			//nothing nearby is left, continue in input order
+			while (cursor < num_vertex && live[cursor] <= 0)
+				++cursor;
+			if (cursor < num_vertex)
+				next = cursor;
+		}
+		fan = next;
+	}
+
+	for (size_t i = 0; i < output.size(); ++i)
+		index[i] = used[output[i]];
+}
+
+//Sort clusters of triangles so the ones facing out of the mesh are drawn first,
+//they are the likeliest to hide the rest. This is the view independent sort
+//from the Tipsify paper: key is dot(cluster centroid - mesh centroid, cluster
+//normal), both area weighted. Triangles inside a cluster keep their order so
+//the cache efficiency is not lost. positions is xyz per vertex.
+//clusters holds the first triangle of each cluster in increasing order, if
+//order is given it receives the old cluster number of each new position.
+template <class I>
+static void Optimize_Overdraw(I* index, int index_count, const float* positions, const std::vector<int>& clusters, std::vector<int>* order = NULL)
+{
+	int num_triangle = index_count / 3;
+	int num_cluster = clusters.size();
+	if (order)
+		order->clear();
+	if (num_triangle == 0 || num_cluster == 0)
+		return;
+
+	std::vector<float> cluster_data(num_cluster * 7, 0.0f);//centroid xyz, normal xyz, area
+	float mesh_centroid[3] = { 0.0f, 0.0f, 0.0f };
+	float mesh_area = 0.0f;
+	for (int c = 0; c < num_cluster; ++c)
+	{
+		int end = c + 1 < num_cluster ? clusters[c + 1] : num_triangle;
+		float* d = &cluster_data[7 * c];
+		for (int t = clusters[c]; t < end; ++t)
+		{
+			const float* p0 = positions + 3 * index[3 * t];
+			const float* p1 = positions + 3 * index[3 * t + 1];
+			const float* p2 = positions + 3 * index[3 * t + 2];
+			float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * 0.5f;
+
+			for (int k = 0; k < 3; ++k)
+			{
+				float centroid = (p0[k] + p1[k] + p2[k]) / 3.0f;
+				d[k] += centroid * area;
+				d[3 + k] += n[k] * 0.5f;//|n| / 2 is the area, so this is area weighted
+				mesh_centroid[k] += centroid * area;
+			}
+			d[6] += area;
+			mesh_area += area;
+		}
+	}
+	for (int k = 0; k < 3; ++k)
+		mesh_centroid[k] = mesh_area > 0.0f ? mesh_centroid[k] / mesh_area : 0.0f;
+
+	std::vector<std::pair<float, int>> keys(num_cluster);
+	for (int c = 0; c < num_cluster; ++c)
+	{
+		const float* d = &cluster_data[7 * c];
+		float key = 0.0f;
+		if (d[6] > 0.0f)
+		{
+			for (int k = 0; k < 3; ++k)
+				key += (d[k] / d[6] - mesh_centroid[k]) * d[3 + k];
+		}
+		//descending, ties keep their order
+		keys[c] = std::make_pair(-key, c);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	std::vector<I> sorted;
+	sorted.reserve(num_triangle * 3);
+	for (int i = 0; i < num_cluster; ++i)
+	{
+		int c = keys[i].second;
+		int end = c + 1 < num_cluster ? clusters[c + 1] : num_triangle;
+		sorted.insert(sorted.end(), index + 3 * clusters[c], index + 3 * end);
+		if (order)
+			order->emplace_back(c);
+	}
+	std::copy(sorted.begin(), sorted.end(), index);
+}
+
+//Renumber vertices in the order the index first uses them so the vertex fetch
+//walks memory forward. Returns old vertex -> new vertex, -1 for vertices the
+//index never references, they are dropped by Remap_Vertices.
+template <class I>
+static std::vector<int> Optimize_Vertex_Fetch(I* index, int index_count, int num_vertex)
+{
+	std::vector<int> remap(num_vertex, -1);
+	int next = 0;
+	for (int i = 0; i < index_count; ++i)
+	{
+		int v = index[i];
+		if (remap[v] < 0)
+			remap[v] = next++;
+		index[i] = remap[v];
+	}
+	return remap;
+}
+
+//Apply the table from Optimize_Vertex_Fetch to one attribute array.
+//stride is the number of T per vertex, 1 for vector<vec3>, 3 for packed floats.
+//An empty array is a stream the mesh does not have and is left empty
+template <class T>
+static void Remap_Vertices(std::vector<T>& data, const std::vector<int>& remap, int stride = 1)
+{
+	int num_vertex = remap.size();
+	if (data.empty())
+		return;
+	if (data.size() < remap.size() * stride)
+	{
+		//a short attribute cannot follow the new vertex order, leaving it
+		//alone would pair every vertex with some other vertex's data
+		std::cerr << "Remap_Vertices: attribute has " << data.size() / stride
+		          << " vertices, index uses " << num_vertex << std::endl;
+		assert(!"attribute array shorter than the vertex count");
+		return;
+	}
+
+	int count = 0;
+	for (int v = 0; v < num_vertex; ++v)
+		count = remap[v] + 1 > count ? remap[v] + 1 : count;
+
+	std::vector<T> out(count * stride);
+	for (int v = 0; v < num_vertex; ++v)
+	{
+		if (remap[v] < 0)
+			continue;
+		for (int k = 0; k < stride; ++k)
+			out[remap[v] * stride + k] = data[v * stride + k];
+	}
+	data.swap(out);
+}
+
+#endif // !_MESH_OPTIMIZER_H_